@@ -17,6 +17,8 @@
 #include "arcane/utils/OStringStream.h"
 #include "arcane/utils/ValueChecker.h"
 #include "arcane/utils/SimdOperation.h"
+#include "arcane/utils/MemoryUtils.h"
+#include "arcane/utils/ValueConvert.h"
 
 #include "arcane/IUnitTest.h"
 #include "arcane/ITimeLoopMng.h"
@@ -54,6 +56,9 @@
 #include "arcane/materials/MeshMaterialVariableSynchronizerList.h"
 #include "arcane/materials/ComponentSimd.h"
 #include "arcane/materials/MeshMaterialInfo.h"
+#include "arcane/materials/MeshMaterialLoadBalanceCriterion.h"
+#include "arcane/materials/CellMaterialPresenceView.h"
+#include "arcane/materials/MeshMaterialBackup.h"
 
 #include "arcane/tests/ArcaneTestGlobal.h"
 #include "arcane/tests/IMaterialEquationOfState.h"
@@ -65,6 +70,7 @@
 #include <functional>
 #include <atomic>
 #include <map>
+#include <algorithm>
 
 /*---------------------------------------------------------------------------*/
 /*---------------------------------------------------------------------------*/
@@ -125,6 +131,8 @@ class MeshMaterialTesterModule
   MaterialVariableCellInt32 m_mat_int32;
   //! Variable pour tester la bonne prise en compte de setUsed(false)
   MaterialVariableCellReal m_mat_not_used_real;
+  //! Variable pour tester le compactage automatique des valeurs partielles
+  MaterialVariableCellReal m_mat_compact_check;
   VariableScalarInt64 m_nb_starting_cell; //<! Nombre de mailles au démarrage
   IMeshMaterial* m_mat1;
   IMeshMaterial* m_mat2;
@@ -135,6 +143,10 @@ class MeshMaterialTesterModule
   // Si non nul, indique qu'il faut vérifier les valeurs spectral
   // car on a fait un repartitionnement
   Integer m_check_spectral_values_iteration;
+  //! Vrai si le compactage des valeurs partielles est automatique
+  bool m_is_auto_compact_partial_values = false;
+  //! uniqueId() des mailles de chaque constituant lors du dernier appel à _checkAutoCompactPartialValues()
+  UniqueArray<UniqueArray<Int64>> m_compact_check_cells;
  private:
 
   void _computeDensity();
@@ -182,6 +194,12 @@ class MeshMaterialTesterModule
   void _applyEos(bool is_init);
   void _testDumpProperties();
   void _checkNullComponentItem();
+  void _checkLoadBalanceCriterion();
+  void _checkMaterialPresence();
+  void _checkCompactPartialValues();
+  void _checkAutoCompactPartialValues();
+  void _checkMaterialCells(ConstArrayView<UniqueArray<Int32>> expected_cells);
+  void _checkIncrementalBackup();
 };
 
 /*---------------------------------------------------------------------------*/
@@ -201,6 +219,7 @@ MeshMaterialTesterModule(const ModuleBuildInfo& mbi)
 , m_present_material(VariableBuildInfo(this,"PresentMaterial"))
 , m_mat_int32(VariableBuildInfo(this,"PresentMaterial"))
 , m_mat_not_used_real(VariableBuildInfo(this,"NotUsedRealVariable"))
+, m_mat_compact_check(VariableBuildInfo(this,"CompactCheckReal",IVariable::PNoDump))
 , m_nb_starting_cell(VariableBuildInfo(this,"NbStartingCell"))
 , m_mat1(nullptr)
 , m_mat2(nullptr)
@@ -280,6 +299,11 @@ buildInit()
 
   m_material_mng->setMeshModificationNotified(true);
 
+  // Si le compactage automatique des valeurs partielles est actif, il ne
+  // faut pas le forcer à chaque itération pour qu'il soit testé.
+  if (auto v = Convert::Type<Real>::tryParseFromEnvironment("ARCANE_MATERIALMNG_PARTIAL_VALUES_COMPACTION_RATIO", true))
+    m_is_auto_compact_partial_values = (v.value() >= 0.0);
+
   // En parallèle, test la création de variables milieux aussi sur les matériaux
   if (parallelMng()->isParallel())
     m_material_mng->setAllocateScalarEnvironmentVariableAsMaterial(true);
@@ -721,6 +745,8 @@ startInit()
   _applyEos(true);
   _testDumpProperties();
   _checkNullComponentItem();
+  _checkLoadBalanceCriterion();
+  _checkMaterialPresence();
 }
 
 /*---------------------------------------------------------------------------*/
@@ -748,6 +774,233 @@ _checkNullComponentItem()
 /*---------------------------------------------------------------------------*/
 /*---------------------------------------------------------------------------*/
 
+void MeshMaterialTesterModule::
+_checkLoadBalanceCriterion()
+{
+  MeshMaterialLoadBalanceCriterion criterion(m_material_mng);
+  criterion.setImpureFactor(3.0);
+  criterion.computeCosts();
+  VariableCellReal& costs = criterion.costs();
+
+  ValueChecker vc(A_FUNCINFO);
+  CellToAllEnvCellConverter all_env_cell_converter(m_material_mng);
+  ENUMERATE_CELL(icell,allCells()){
+    AllEnvCell all_env_cell = all_env_cell_converter[*icell];
+    Int32 nb_env = all_env_cell.nbEnvironment();
+    Int32 nb_mat = 0;
+    ENUMERATE_CELL_ENVCELL(ienvcell,all_env_cell){
+      nb_mat += (*ienvcell).nbMaterial();
+    }
+    Real factor = (nb_env>1 || nb_mat>1) ? 3.0 : 1.0;
+    Real expected_cost = 1.0 + factor * (nb_env + nb_mat);
+    vc.areEqual(costs[icell],expected_cost,"LoadBalanceCost");
+  }
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+void MeshMaterialTesterModule::
+_checkMaterialPresence()
+{
+  CellMaterialPresenceView presence(m_material_mng);
+  Int32 nb_mat = m_material_mng->materials().size();
+  CellToAllEnvCellConverter all_env_cell_converter(m_material_mng);
+  Integer nb_error = 0;
+  UniqueArray<bool> has_mat(nb_mat);
+  ENUMERATE_CELL(icell,allCells()){
+    has_mat.fill(false);
+    AllEnvCell all_env_cell = all_env_cell_converter[*icell];
+    ENUMERATE_CELL_ENVCELL(ienvcell,all_env_cell){
+      ENUMERATE_CELL_MATCELL(imatcell,(*ienvcell)){
+        has_mat[(*imatcell).materialId()] = true;
+      }
+    }
+    for( Int32 i=0; i<nb_mat; ++i ){
+      if (presence.hasMaterial(icell.itemLocalId(),i)!=has_mat[i]){
+        ++nb_error;
+        if (nb_error<10)
+          info() << "Bad material presence cell=" << ItemPrinter(*icell) << " mat_id=" << i
+                 << " expected=" << has_mat[i];
+      }
+    }
+  }
+  if (nb_error!=0)
+    ARCANE_FATAL("Bad material presence nb_error={0}",nb_error);
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*!
+ * \brief Vérifie que le compactage des valeurs partielles conserve les valeurs.
+ *
+ * Si le compactage automatique est actif, le compactage n'est pas forcé
+ * (voir _checkAutoCompactPartialValues()).
+ */
+void MeshMaterialTesterModule::
+_checkCompactPartialValues()
+{
+  if (m_is_auto_compact_partial_values){
+    _checkAutoCompactPartialValues();
+    return;
+  }
+
+  UniqueArray<Real> saved_values;
+  ENUMERATE_ENV(ienv,m_material_mng){
+    ENUMERATE_ENVCELL(ienvcell,(*ienv)){
+      saved_values.add(m_mat_density[ienvcell]);
+    }
+    ENUMERATE_MAT(imat,(*ienv)){
+      ENUMERATE_MATCELL(imatcell,(*imat)){
+        saved_values.add(m_mat_density[imatcell]);
+      }
+    }
+  }
+
+  m_material_mng->compactPartialValues();
+
+  ValueChecker vc(A_FUNCINFO);
+  Integer index = 0;
+  ENUMERATE_ENV(ienv,m_material_mng){
+    ENUMERATE_ENVCELL(ienvcell,(*ienv)){
+      vc.areEqual(m_mat_density[ienvcell],saved_values[index],"CompactEnvValue");
+      ++index;
+    }
+    ENUMERATE_MAT(imat,(*ienv)){
+      ENUMERATE_MATCELL(imatcell,(*imat)){
+        vc.areEqual(m_mat_density[imatcell],saved_values[index],"CompactMatValue");
+        ++index;
+      }
+    }
+  }
+  vc.areEqual(index,saved_values.size(),"CompactNbValue");
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*!
+ * \brief Vérifie les valeurs après les compactages automatiques.
+ *
+ * Le compactage a lieu lors des modifications des matériaux. Chaque valeur
+ * de la variable 'CompactCheckReal' vaut uniqueId()+1 de la maille
+ * correspondante. Les valeurs des mailles déjà présentes dans un constituant
+ * lors de l'appel précédent doivent donc être conservées. Les mailles
+ * ajoutées depuis peuvent aussi avoir une valeur nulle.
+ */
+void MeshMaterialTesterModule::
+_checkAutoCompactPartialValues()
+{
+  MeshComponentList components = m_material_mng->components();
+  const Int32 nb_component = components.size();
+  m_compact_check_cells.resize(nb_component);
+  Integer nb_error = 0;
+  for( Int32 i=0; i<nb_component; ++i ){
+    IMeshComponent* c = components[i];
+    ConstArrayView<Int64> old_cells = m_compact_check_cells[i];
+    ENUMERATE_COMPONENTCELL(iccell,c){
+      Cell cell = (*iccell).globalCell();
+      Real expected_value = static_cast<Real>(cell.uniqueId().asInt64() + 1);
+      Real value = m_mat_compact_check[iccell];
+      if (value==expected_value)
+        continue;
+      bool is_new = !std::binary_search(old_cells.begin(),old_cells.end(),cell.uniqueId().asInt64());
+      if (is_new && value==0.0)
+        continue;
+      ++nb_error;
+      if (nb_error<10)
+        info() << "Bad value after compaction component=" << c->name()
+               << " cell=" << ItemPrinter(cell) << " value=" << value
+               << " expected=" << expected_value;
+    }
+  }
+  if (nb_error!=0)
+    ARCANE_FATAL("Bad values after automatic compaction of partial values nb_error={0}",nb_error);
+
+  // Positionne les valeurs et conserve la liste des mailles pour l'appel suivant.
+  ENUMERATE_CELL(icell,allCells()){
+    m_mat_compact_check[icell] = static_cast<Real>((*icell).uniqueId().asInt64() + 1);
+  }
+  for( Int32 i=0; i<nb_component; ++i ){
+    IMeshComponent* c = components[i];
+    UniqueArray<Int64>& cells = m_compact_check_cells[i];
+    cells.clear();
+    ENUMERATE_COMPONENTCELL(iccell,c){
+      Cell cell = (*iccell).globalCell();
+      m_mat_compact_check[iccell] = static_cast<Real>(cell.uniqueId().asInt64() + 1);
+      cells.add(cell.uniqueId().asInt64());
+    }
+    std::sort(cells.begin(),cells.end());
+  }
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*!
+ * \brief Vérifie la sauvegarde/restauration incrémentale des valeurs.
+ *
+ * Effectue plusieurs cycles de sauvegarde/restauration avec la même instance
+ * de MeshMaterialBackup. Entre deux sauvegardes, la variable
+ * 'TestIncrementalBackup1' est modifiée et les autres variables ne doivent
+ * donc pas être conservées à nouveau. Au deuxième cycle, la variable
+ * 'TestIncrementalBackup2' est aussi modifiée. Les modifications ne sont pas
+ * signalées via setUpToDate() et doivent quand même être détectées.
+ */
+void MeshMaterialTesterModule::
+_checkIncrementalBackup()
+{
+  MaterialVariableCellReal var1(MaterialVariableBuildInfo(m_material_mng,"TestIncrementalBackup1"));
+  MaterialVariableCellReal var2(MaterialVariableBuildInfo(m_material_mng,"TestIncrementalBackup2"));
+  Real value2 = 2.0;
+  var2.fill(value2);
+
+  auto check_values = [&](MaterialVariableCellReal& var,Real expected_value,const char* name)
+  {
+    ValueChecker vc(A_FUNCINFO);
+    ENUMERATE_ENV(ienv,m_material_mng){
+      ENUMERATE_ENVCELL(ienvcell,(*ienv)){
+        vc.areEqual(var[ienvcell],expected_value,name);
+      }
+      ENUMERATE_MAT(imat,(*ienv)){
+        ENUMERATE_MATCELL(imatcell,(*imat)){
+          vc.areEqual(var[imatcell],expected_value,name);
+        }
+      }
+    }
+  };
+
+  MeshMaterialBackup backup(m_material_mng,false);
+  // Pas de compression pour que la taille économisée ne dépende que
+  // des variables non recopiées.
+  backup.setCompressorServiceName(String());
+  backup.setIncremental(true);
+  for( Integer k=0; k<3; ++k ){
+    const Real value1 = 10.0 + static_cast<Real>(k);
+    var1.fill(value1);
+    if (k==1){
+      value2 = 3.0;
+      var2.fill(value2);
+    }
+    backup.saveValues();
+    info() << "IncrementalBackup cycle=" << k << " stored_size=" << backup.storedMemorySize()
+           << " saved_size=" << backup.savedMemorySize();
+    if (k==0 && backup.savedMemorySize()!=0)
+      ARCANE_FATAL("Bad saved memory size for first incremental backup v={0}",backup.savedMemorySize());
+    if (k>0 && backup.savedMemorySize()==0)
+      ARCANE_FATAL("Unchanged variables have been copied in incremental backup cycle={0}",k);
+
+    // Modifie les valeurs sans l'indiquer et vérifie que la restauration
+    // remet les valeurs sauvegardées.
+    var1.fill(-1.0);
+    var2.fill(-2.0);
+    backup.restoreValues();
+    check_values(var1,value1,"IncrementalBackupVar1");
+    check_values(var2,value2,"IncrementalBackupVar2");
+  }
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
 void MeshMaterialTesterModule::
 _testDumpProperties()
 {
@@ -1657,6 +1910,9 @@ compute()
 
   // Teste le remplissage des valeurs partielles.
   _checkFillPartialValues();
+  _checkMaterialPresence();
+  _checkCompactPartialValues();
+  _checkIncrementalBackup();
 
   IMeshMaterialVariable* nv = m_material_mng->findVariable(m_pressure.variable()->fullName());
   if (!nv)
@@ -2055,6 +2311,23 @@ _computeDensity()
   
   Int32UniqueArray mat_to_add_array;
   Int32UniqueArray mat_to_remove_array;
+
+  // Une itération sur deux, les modifications de tous les matériaux sont
+  // faites en un seul appel à MeshMaterialModifier::modifyCells(). On vérifie
+  // alors que le résultat est le même qu'avec addCells() et removeCells().
+  const bool use_modify_cells = (m_global_iteration() % 2)==0;
+  IMemoryAllocator* allocator = MemoryUtils::getDefaultDataAllocator();
+  UniqueArray<Int32> modify_mat_ids(allocator);
+  UniqueArray<Int32> modify_cell_ids(allocator);
+  UniqueArray<bool> modify_is_add(allocator);
+  UniqueArray<UniqueArray<Int32>> expected_cells(m_material_mng->materials().size());
+  auto add_modification = [&](IMeshMaterial* mat,Int32 cell_lid,bool is_add)
+  {
+    modify_mat_ids.add(mat->id());
+    modify_cell_ids.add(cell_lid);
+    modify_is_add.add(is_add);
+  };
+
   // Calcul les mailles dans lesquelles il faut ajouter ou supprimer des matériaux
   {
     Materials::MeshMaterialModifier modifier(m_material_mng);
@@ -2069,12 +2342,40 @@ _computeDensity()
                << " mat=" << mat->name()
                << " nb_to_add=" << mat_to_add_array.size()
                << " nb_to_remove=" << mat_to_remove_array.size();
-        
-        modifier.removeCells(mat,mat_to_remove_array);
-        modifier.addCells(mat,mat_to_add_array);
+
+        if (!use_modify_cells){
+          modifier.removeCells(mat,mat_to_remove_array);
+          modifier.addCells(mat,mat_to_add_array);
+          continue;
+        }
+
+        // Calcule les mailles attendues pour ce matériau après modification.
+        UniqueArray<bool> is_in_mat(mesh()->cellFamily()->maxLocalId(),false);
+        ENUMERATE_MATCELL(imatcell,mat){
+          is_in_mat[(*imatcell).globalCell().localId()] = true;
+        }
+        for( Int32 lid : mat_to_remove_array ){
+          is_in_mat[lid] = false;
+          add_modification(mat,lid,false);
+        }
+        for( Int32 lid : mat_to_add_array ){
+          is_in_mat[lid] = true;
+          // Ajoute d'abord une suppression de la maille qui doit être ignorée
+          // car seule la dernière occurrence d'un couple est prise en compte.
+          add_modification(mat,lid,false);
+          add_modification(mat,lid,true);
+        }
+        UniqueArray<Int32>& mat_expected_cells = expected_cells[mat->id()];
+        for( Int32 lid=0, n=is_in_mat.size(); lid<n; ++lid )
+          if (is_in_mat[lid])
+            mat_expected_cells.add(lid);
       }
     }
+    if (use_modify_cells)
+      modifier.modifyCells(modify_mat_ids,modify_cell_ids,modify_is_add);
   }
+  if (use_modify_cells)
+    _checkMaterialCells(expected_cells);
 
   // Met à jour les valeurs.
   {
@@ -2092,6 +2393,30 @@ _computeDensity()
   m_mat_density.synchronize();
 }
 
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*!
+ * \brief Vérifie que les mailles de chaque matériau sont celles de \a expected_cells.
+ *
+ * \a expected_cells contient pour chaque matériau la liste triée des
+ * numéros locaux des mailles attendues.
+ */
+void MeshMaterialTesterModule::
+_checkMaterialCells(ConstArrayView<UniqueArray<Int32>> expected_cells)
+{
+  ValueChecker vc(A_FUNCINFO);
+  ENUMERATE_MAT(imat,m_material_mng){
+    IMeshMaterial* mat = *imat;
+    UniqueArray<Int32> current_cells;
+    ENUMERATE_MATCELL(imatcell,mat){
+      current_cells.add((*imatcell).globalCell().localId());
+    }
+    std::sort(current_cells.begin(),current_cells.end());
+    vc.areEqualArray(current_cells.constView(),expected_cells[mat->id()].constView(),
+                     String("ModifyCells_")+mat->name());
+  }
+}
+
 /*---------------------------------------------------------------------------*/
 /*---------------------------------------------------------------------------*/
 
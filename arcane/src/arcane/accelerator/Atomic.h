@@ -16,6 +16,8 @@
 
 #include "arcane/utils/ArcaneCxx20.h"
 
+#include "arcane/core/DataView.h"
+
 #if defined(ARCCORE_DEVICE_TARGET_CUDA) || defined(ARCCORE_DEVICE_TARGET_HIP)
 #include "arcane/accelerator/CommonCudaHipAtomicImpl.h"
 #endif
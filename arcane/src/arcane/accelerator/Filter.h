@@ -23,6 +23,7 @@
 
 #include "arcane/accelerator/AcceleratorGlobal.h"
 #include "arcane/accelerator/CommonUtils.h"
+#include "arcane/accelerator/MultiThreadAlgo.h"
 #include "arcane/accelerator/RunCommandLaunchInfo.h"
 #include "arcane/accelerator/RunCommandLoop.h"
 #include "arcane/accelerator/ScanImpl.h"
@@ -293,9 +294,15 @@ class GenericFilteringFlag
       SyclGenericFilteringImpl::apply(s, nb_item, iter2, out, filter_lambda);
     } break;
 #endif
-    case eExecutionPolicy::Thread:
-      // Pas encore implémenté en multi-thread
-      [[fallthrough]];
+    case eExecutionPolicy::Thread: {
+      RunCommand command = makeCommand(*queue);
+      impl::RunCommandLaunchInfo launch_info(command, nb_item);
+      launch_info.beginExecute();
+      MultiThreadAlgo algo(launch_info.computeParallelLoopOptions());
+      auto filter_lambda = [&](Int32 input_index) -> bool { return flag[input_index] != 0; };
+      s.m_host_nb_out_storage[0] = algo.doFilter(nb_item, input_data, output_data, filter_lambda);
+      launch_info.endExecute();
+    } break;
     case eExecutionPolicy::Sequential: {
       Int32 index = 0;
       for (Int32 i = 0; i < nb_item; ++i) {
@@ -378,9 +385,11 @@ class GenericFilteringIf
       SyclGenericFilteringImpl::apply(s, nb_item, input_iter, output_iter, select_lambda);
     } break;
 #endif
-    case eExecutionPolicy::Thread:
-      // Pas encore implémenté en multi-thread
-      [[fallthrough]];
+    case eExecutionPolicy::Thread: {
+      MultiThreadAlgo algo(launch_info.computeParallelLoopOptions());
+      auto filter_lambda = [&](Int32 input_index) -> bool { return select_lambda(input_iter[input_index]); };
+      s.m_host_nb_out_storage[0] = algo.doFilter(nb_item, input_iter, output_iter, filter_lambda);
+    } break;
     case eExecutionPolicy::Sequential: {
       Int32 index = 0;
       for (Int32 i = 0; i < nb_item; ++i) {
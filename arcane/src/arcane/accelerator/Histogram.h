@@ -0,0 +1,314 @@
+﻿// -*- tab-width: 2; indent-tabs-mode: nil; coding: utf-8-with-signature -*-
+//-----------------------------------------------------------------------------
+// Copyright 2000-2024 CEA (www.cea.fr) IFPEN (www.ifpenergiesnouvelles.com)
+// See the top-level COPYRIGHT file for details.
+// SPDX-License-Identifier: Apache-2.0
+//-----------------------------------------------------------------------------
+/*---------------------------------------------------------------------------*/
+/* Histogram.h                                                 (C) 2000-2024 */
+/*                                                                           */
+/* Algorithme de calcul d'histogramme.                                       */
+/*---------------------------------------------------------------------------*/
+#ifndef ARCANE_ACCELERATOR_HISTOGRAM_H
+#define ARCANE_ACCELERATOR_HISTOGRAM_H
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+#include "arcane/utils/ArrayView.h"
+#include "arcane/utils/FatalErrorException.h"
+#include "arcane/utils/TraceInfo.h"
+
+#include "arcane/accelerator/core/RunQueue.h"
+
+#include "arcane/accelerator/AcceleratorGlobal.h"
+#include "arcane/accelerator/CommonUtils.h"
+#include "arcane/accelerator/RunCommandLaunchInfo.h"
+#include "arcane/accelerator/RunCommandLoop.h"
+#include "arcane/accelerator/Atomic.h"
+
+#include <type_traits>
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+namespace Arcane::Accelerator::impl
+{
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*!
+ * \internal
+ * \brief Calcul de l'intervalle d'une valeur pour un histogramme à pas constant.
+ *
+ * Retourne -1 si la valeur est en dehors de l'intervalle `[lower,upper[`.
+ */
+template <typename SampleType>
+class HistogramEvenBinComputer
+{
+ public:
+
+  HistogramEvenBinComputer(SampleType lower, SampleType upper, Int32 nb_bin)
+  : m_lower(lower)
+  , m_upper(upper)
+  , m_nb_bin(nb_bin)
+  {}
+
+ public:
+
+  constexpr ARCCORE_HOST_DEVICE Int32 operator()(SampleType v) const
+  {
+    if (!(v >= m_lower && v < m_upper))
+      return (-1);
+    Int32 bin = 0;
+    if constexpr (std::is_floating_point_v<SampleType>)
+      bin = static_cast<Int32>(((v - m_lower) * m_nb_bin) / (m_upper - m_lower));
+    else
+      bin = static_cast<Int32>((static_cast<Int64>(v - m_lower) * m_nb_bin) / static_cast<Int64>(m_upper - m_lower));
+    return (bin < m_nb_bin) ? bin : (m_nb_bin - 1);
+  }
+
+ private:
+
+  SampleType m_lower;
+  SampleType m_upper;
+  Int32 m_nb_bin;
+};
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*!
+ * \internal
+ * \brief Classe de base pour effectuer le calcul d'un histogramme.
+ *
+ * Conserve la mémoire temporaire nécessaire à l'algorithme pour pouvoir
+ * la réutiliser entre deux appels.
+ */
+class ARCANE_ACCELERATOR_EXPORT GenericHistogramBase
+{
+  friend class GenericHistogramImpl;
+
+ public:
+
+  explicit GenericHistogramBase(const RunQueue& queue);
+
+ protected:
+
+  RunQueue m_queue;
+  GenericDeviceStorage m_algo_storage;
+};
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*!
+ * \internal
+ * \brief Classe pour effectuer le calcul d'un histogramme à pas constant.
+ *
+ * Les valeurs de \a input_iter en dehors de l'intervalle `[lower,upper[` ne sont
+ * pas comptabilisées.
+ */
+class GenericHistogramImpl
+{
+ public:
+
+  template <typename InputIterator, typename SampleType>
+  void apply(GenericHistogramBase& s, Int32 nb_item, InputIterator input_iter,
+             SmallSpan<Int32> histogram, SampleType lower, SampleType upper,
+             const TraceInfo& trace_info)
+  {
+    RunQueue& queue = s.m_queue;
+    eExecutionPolicy exec_policy = queue.executionPolicy();
+    const Int32 nb_bin = histogram.size();
+    [[maybe_unused]] Int32* histogram_data = histogram.data();
+    // Le nombre de niveaux est égal au nombre d'intervalles plus 1.
+    [[maybe_unused]] const int nb_level = nb_bin + 1;
+    switch (exec_policy) {
+#if defined(ARCANE_COMPILING_CUDA)
+    case eExecutionPolicy::CUDA: {
+      RunCommand command = makeCommand(queue);
+      command << trace_info;
+      impl::RunCommandLaunchInfo launch_info(command, nb_item);
+      launch_info.beginExecute();
+      size_t temp_storage_size = 0;
+      cudaStream_t stream = impl::CudaUtils::toNativeStream(&queue);
+      // Premier appel pour connaitre la taille pour l'allocation
+      ARCANE_CHECK_CUDA(::cub::DeviceHistogram::HistogramEven(nullptr, temp_storage_size, input_iter, histogram_data,
+                                                              nb_level, lower, upper, nb_item, stream));
+      void* temp_storage = s.m_algo_storage.allocate(temp_storage_size);
+      ARCANE_CHECK_CUDA(::cub::DeviceHistogram::HistogramEven(temp_storage, temp_storage_size, input_iter, histogram_data,
+                                                              nb_level, lower, upper, nb_item, stream));
+      launch_info.endExecute();
+    } break;
+#endif
+#if defined(ARCANE_COMPILING_HIP)
+    case eExecutionPolicy::HIP: {
+      RunCommand command = makeCommand(queue);
+      command << trace_info;
+      impl::RunCommandLaunchInfo launch_info(command, nb_item);
+      launch_info.beginExecute();
+      size_t temp_storage_size = 0;
+      // Premier appel pour connaitre la taille pour l'allocation
+      hipStream_t stream = impl::HipUtils::toNativeStream(&queue);
+      ARCANE_CHECK_HIP(rocprim::histogram_even(nullptr, temp_storage_size, input_iter, nb_item,
+                                               histogram_data, nb_level, lower, upper, stream));
+      void* temp_storage = s.m_algo_storage.allocate(temp_storage_size);
+      ARCANE_CHECK_HIP(rocprim::histogram_even(temp_storage, temp_storage_size, input_iter, nb_item,
+                                               histogram_data, nb_level, lower, upper, stream));
+      launch_info.endExecute();
+    } break;
+#endif
+    case eExecutionPolicy::SYCL:
+    case eExecutionPolicy::Thread: {
+      // Les compteurs sont des entiers donc le résultat ne dépend pas de
+      // l'ordre des opérations atomiques.
+      HistogramEvenBinComputer<SampleType> bin_computer(lower, upper, nb_bin);
+      {
+        auto command = makeCommand(queue);
+        command << trace_info;
+        command << Arcane::ArrayBounds<MDDim1>(nb_bin) << [=] ARCCORE_HOST_DEVICE(Arcane::MDIndex<1> iter) {
+          histogram[iter()[0]] = 0;
+        };
+      }
+      {
+        auto command = makeCommand(queue);
+        command << trace_info;
+        command << Arcane::ArrayBounds<MDDim1>(nb_item) << [=] ARCCORE_HOST_DEVICE(Arcane::MDIndex<1> iter) {
+          Int32 bin = bin_computer(input_iter[iter()[0]]);
+          if (bin >= 0)
+            ::Arcane::Accelerator::doAtomic<eAtomicOperation::Add>(histogram.ptrAt(bin), 1);
+        };
+      }
+    } break;
+    case eExecutionPolicy::Sequential: {
+      RunCommand command = makeCommand(queue);
+      command << trace_info;
+      impl::RunCommandLaunchInfo launch_info(command, nb_item);
+      launch_info.beginExecute();
+      HistogramEvenBinComputer<SampleType> bin_computer(lower, upper, nb_bin);
+      histogram.fill(0);
+      for (Int32 i = 0; i < nb_item; ++i) {
+        Int32 bin = bin_computer(input_iter[i]);
+        if (bin >= 0)
+          ++histogram[bin];
+      }
+      launch_info.endExecute();
+    } break;
+    default:
+      ARCANE_FATAL(getBadPolicyMessage(exec_policy));
+    }
+  }
+};
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+} // namespace Arcane::Accelerator::impl
+
+namespace Arcane::Accelerator
+{
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*!
+ * \brief Algorithme générique de calcul d'histogramme sur accélérateur.
+ *
+ * Le nombre d'intervalles de l'histogramme est égal à la taille du tableau
+ * \a histogram passé en argument. Les valeurs de l'histogramme sont remises
+ * à zéro avant le calcul.
+ *
+ * Par exemple, pour compter le nombre de particules par maille, en connaissant
+ * la maille de chaque particule:
+ *
+ * \code
+ * Arcane::Accelerator::RunQueue queue = ...;
+ * SmallSpan<const Int32> particle_cell = ...; // Numéro local de la maille de chaque particule
+ * SmallSpan<Int32> nb_particle_per_cell = ...; // Taille nb_cell
+ * Arcane::Accelerator::GenericHistogram histogram(queue);
+ * auto getter = [=] ARCCORE_HOST_DEVICE(Int32 index) -> Int32 { return particle_cell[index]; };
+ * histogram.applyWithBinIndex(particle_cell.size(), getter, nb_particle_per_cell);
+ * \endcode
+ *
+ * Le résultat ne dépend pas de l'ordre d'exécution.
+ */
+class GenericHistogram
+: private impl::GenericHistogramBase
+{
+ public:
+
+  explicit GenericHistogram(const RunQueue& queue)
+  : impl::GenericHistogramBase(queue)
+  {}
+
+ public:
+
+  /*!
+   * \brief Calcule un histogramme à pas constant.
+   *
+   * L'intervalle `[lower,upper[` est découpé en `histogram.size()` intervalles
+   * de même taille et `histogram[i]` contient le nombre de valeurs de \a input
+   * dans l'intervalle \a i. Les valeurs en dehors de `[lower,upper[` sont
+   * ignorées.
+   */
+  template <typename SampleType>
+  void applyEven(SmallSpan<const SampleType> input, SmallSpan<Int32> histogram,
+                 SampleType lower, SampleType upper, const TraceInfo& trace_info = TraceInfo())
+  {
+    if (!(lower < upper))
+      ARCANE_FATAL("Invalid range lower={0} upper={1}", lower, upper);
+    if (_checkEmpty(input.size(), histogram))
+      return;
+    impl::GenericHistogramImpl gh;
+    gh.apply(*this, input.size(), input.data(), histogram, lower, upper, trace_info);
+  }
+
+  /*!
+   * \brief Calcule un histogramme à partir de l'indice de l'intervalle de chaque valeur.
+   *
+   * `getter_lambda(i)` retourne l'indice de l'intervalle de la valeur \a i.
+   * Les indices en dehors de `[0,histogram.size()[` sont ignorés.
+   * Le prototype de la lambda est:
+   *
+   * \code
+   * auto getter_lambda = [=] ARCCORE_HOST_DEVICE (Int32 index) -> Int32;
+   * \endcode
+   */
+  template <typename GetterLambda>
+  void applyWithBinIndex(Int32 nb_value, const GetterLambda& getter_lambda, SmallSpan<Int32> histogram,
+                         const TraceInfo& trace_info = TraceInfo())
+  {
+    if (_checkEmpty(nb_value, histogram))
+      return;
+    impl::GetterLambdaIterator<Int32, GetterLambda> input_iter(getter_lambda);
+    impl::GenericHistogramImpl gh;
+    gh.apply(*this, nb_value, input_iter, histogram, 0, histogram.size(), trace_info);
+  }
+
+ private:
+
+  bool _checkEmpty(Int32 nb_value, SmallSpan<Int32> histogram)
+  {
+    if (histogram.size() == 0)
+      return true;
+    if (nb_value == 0) {
+      // Il faut quand même remettre à zéro l'histogramme.
+      auto command = makeCommand(m_queue);
+      command << Arcane::ArrayBounds<MDDim1>(histogram.size()) << [=] ARCCORE_HOST_DEVICE(Arcane::MDIndex<1> iter) {
+        histogram[iter()[0]] = 0;
+      };
+      return true;
+    }
+    return false;
+  }
+};
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+} // namespace Arcane::Accelerator
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+#endif
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
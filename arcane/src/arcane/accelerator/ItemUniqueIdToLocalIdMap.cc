@@ -0,0 +1,181 @@
+﻿// -*- tab-width: 2; indent-tabs-mode: nil; coding: utf-8-with-signature -*-
+//-----------------------------------------------------------------------------
+// Copyright 2000-2024 CEA (www.cea.fr) IFPEN (www.ifpenergiesnouvelles.com)
+// See the top-level COPYRIGHT file for details.
+// SPDX-License-Identifier: Apache-2.0
+//-----------------------------------------------------------------------------
+/*---------------------------------------------------------------------------*/
+/* ItemUniqueIdToLocalIdMap.cc                                 (C) 2000-2024 */
+/*                                                                           */
+/* Table uniqueId vers localId d'une famille utilisable sur accélérateur.    */
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+#include "arcane/accelerator/ItemUniqueIdToLocalIdMap.h"
+
+#include "arcane/utils/FatalErrorException.h"
+#include "arcane/utils/MemoryUtils.h"
+
+#include "arcane/core/IItemFamily.h"
+#include "arcane/core/IMesh.h"
+#include "arcane/core/ItemGroup.h"
+#include "arcane/core/ItemGenericInfoListView.h"
+
+#include "arcane/accelerator/RunCommandLoop.h"
+#include "arcane/accelerator/Reduce.h"
+#include "arcane/accelerator/Sort.h"
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+namespace Arcane::Accelerator
+{
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+ItemUniqueIdToLocalIdMap::
+ItemUniqueIdToLocalIdMap(const RunQueue& queue, IItemFamily* family)
+: m_queue(queue)
+, m_item_family(family)
+, m_sorted_unique_ids(MemoryUtils::getDefaultDataAllocator())
+, m_sorted_local_ids(MemoryUtils::getDefaultDataAllocator())
+, m_work_unique_ids(MemoryUtils::getDefaultDataAllocator())
+, m_work_local_ids(MemoryUtils::getDefaultDataAllocator())
+{
+  if (!family)
+    ARCANE_FATAL("Null family");
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+/*!
+ * \brief Indique si la famille a été modifiée depuis la dernière construction.
+ *
+ * Les familles de particules ou de DoF peuvent être modifiées sans que
+ * IMesh::timestamp() ne change. On utilise donc aussi le temps de
+ * modification du groupe de toutes les entités de la famille, qui change
+ * lors de chaque IItemFamily::endUpdate(), ainsi que le nombre d'entités
+ * et le maximum des localId.
+ */
+bool ItemUniqueIdToLocalIdMap::
+_isFamilyModified() const
+{
+  if (m_mesh_timestamp != m_item_family->mesh()->timestamp())
+    return true;
+  if (m_all_items_timestamp != m_item_family->allItems().timestamp())
+    return true;
+  if (m_nb_item != m_item_family->nbItem())
+    return true;
+  return m_max_local_id != m_item_family->maxLocalId();
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+void ItemUniqueIdToLocalIdMap::
+update()
+{
+  if (_isFamilyModified())
+    rebuild();
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+void ItemUniqueIdToLocalIdMap::
+rebuild()
+{
+  ItemGroup all_items = m_item_family->allItems();
+  m_mesh_timestamp = m_item_family->mesh()->timestamp();
+  m_all_items_timestamp = all_items.timestamp();
+  m_nb_item = m_item_family->nbItem();
+  m_max_local_id = m_item_family->maxLocalId();
+
+  SmallSpan<const Int32> items_local_id = all_items.view().localIds();
+  const Int32 nb_item = items_local_id.size();
+
+  m_work_unique_ids.resize(nb_item);
+  m_work_local_ids.resize(nb_item);
+  m_sorted_unique_ids.resize(nb_item);
+  m_sorted_local_ids.resize(nb_item);
+
+  // Remplit les couples (uniqueId,localId) puis les trie par uniqueId.
+  {
+    ItemGenericInfoListView items_info(m_item_family);
+    SmallSpan<Int64> work_uids(m_work_unique_ids.view());
+    SmallSpan<Int32> work_lids(m_work_local_ids.view());
+    auto command = makeCommand(m_queue);
+    command << RUNCOMMAND_LOOP1(iter, nb_item)
+    {
+      auto [i] = iter();
+      Int32 lid = items_local_id[i];
+      work_uids[i] = items_info.uniqueId(lid);
+      work_lids[i] = lid;
+    };
+  }
+  GenericSorter sorter(m_queue);
+  sorter.applyPairs(m_work_unique_ids.constSmallSpan(), m_sorted_unique_ids.smallSpan(),
+                    m_work_local_ids.constSmallSpan(), m_sorted_local_ids.smallSpan());
+  m_queue.barrier();
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+ItemUniqueIdToLocalIdView ItemUniqueIdToLocalIdMap::
+view()
+{
+  update();
+  return { m_sorted_unique_ids.constSmallSpan(), m_sorted_local_ids.constSmallSpan() };
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+Int32 ItemUniqueIdToLocalIdMap::
+itemsUniqueIdToLocalId(SmallSpan<Int32> local_ids, SmallSpan<const Int64> unique_ids,
+                       eUniqueIdNotFoundPolicy policy)
+{
+  const Int32 nb_item = unique_ids.size();
+  if (local_ids.size() != nb_item)
+    ARCANE_FATAL("Sizes are not equals: local_ids={0} unique_ids={1}", local_ids.size(), nb_item);
+  ItemUniqueIdToLocalIdView uid_view = view();
+  if (nb_item == 0)
+    return 0;
+
+  auto command = makeCommand(m_queue);
+  ReducerSum2<Int32> nb_not_found(command);
+  command << RUNCOMMAND_LOOP1(iter, nb_item, nb_not_found)
+  {
+    auto [i] = iter();
+    Int32 lid = uid_view.localId(unique_ids[i]);
+    local_ids[i] = lid;
+    if (lid == NULL_ITEM_LOCAL_ID)
+      nb_not_found.combine(1);
+  };
+  Int32 nb_error = nb_not_found.reducedValue();
+  if (nb_error != 0 && policy == eUniqueIdNotFoundPolicy::Fatal) {
+    // Sur l'hôte, recherche le premier uniqueId non trouvé pour le message d'erreur.
+    Int64 first_uid = NULL_ITEM_UNIQUE_ID;
+    if (!m_queue.isAcceleratorPolicy()) {
+      for (Int32 i = 0; i < nb_item; ++i)
+        if (local_ids[i] == NULL_ITEM_LOCAL_ID) {
+          first_uid = unique_ids[i];
+          break;
+        }
+    }
+    ARCANE_FATAL("Can not find {0} items with given uniqueId in family '{1}' (first_unique_id={2})",
+                 nb_error, m_item_family->name(), first_uid);
+  }
+  return nb_error;
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+} // namespace Arcane::Accelerator
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
@@ -0,0 +1,199 @@
+﻿// -*- tab-width: 2; indent-tabs-mode: nil; coding: utf-8-with-signature -*-
+//-----------------------------------------------------------------------------
+// Copyright 2000-2024 CEA (www.cea.fr) IFPEN (www.ifpenergiesnouvelles.com)
+// See the top-level COPYRIGHT file for details.
+// SPDX-License-Identifier: Apache-2.0
+//-----------------------------------------------------------------------------
+/*---------------------------------------------------------------------------*/
+/* ItemUniqueIdToLocalIdMap.h                                  (C) 2000-2024 */
+/*                                                                           */
+/* Table uniqueId vers localId d'une famille utilisable sur accélérateur.    */
+/*---------------------------------------------------------------------------*/
+#ifndef ARCANE_ACCELERATOR_ITEMUNIQUEIDTOLOCALIDMAP_H
+#define ARCANE_ACCELERATOR_ITEMUNIQUEIDTOLOCALIDMAP_H
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+#include "arcane/utils/Array.h"
+
+#include "arcane/core/ArcaneTypes.h"
+
+#include "arcane/accelerator/core/RunQueue.h"
+
+#include "arcane/accelerator/AcceleratorGlobal.h"
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+namespace Arcane::Accelerator
+{
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*!
+ * \brief Comportement lorsqu'un uniqueId n'est pas trouvé.
+ */
+enum class eUniqueIdNotFoundPolicy
+{
+  //! Le localId correspondant vaut NULL_ITEM_LOCAL_ID
+  SetNullLocalId,
+  //! Lève une exception (après avoir traité toutes les valeurs)
+  Fatal
+};
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*!
+ * \brief Vue constante sur la table uniqueId vers localId d'une famille.
+ *
+ * Cette vue est utilisable sur l'hôte et sur accélérateur. Elle contient
+ * les uniqueId de la famille triés par ordre croissant et les localId
+ * associés. La recherche se fait par dichotomie.
+ *
+ * Une vue n'est valide que tant que l'instance de ItemUniqueIdToLocalIdMap
+ * qui l'a créée n'est pas mise à jour.
+ */
+class ItemUniqueIdToLocalIdView
+{
+  friend class ItemUniqueIdToLocalIdMap;
+
+ public:
+
+  ItemUniqueIdToLocalIdView() = default;
+
+ private:
+
+  ItemUniqueIdToLocalIdView(SmallSpan<const Int64> unique_ids, SmallSpan<const Int32> local_ids)
+  : m_unique_ids(unique_ids)
+  , m_local_ids(local_ids)
+  {}
+
+ public:
+
+  //! Nombre d'entités dans la table
+  constexpr ARCCORE_HOST_DEVICE Int32 size() const { return m_unique_ids.size(); }
+
+  /*!
+   * \brief localId de l'entité de uniqueId \a unique_id.
+   *
+   * Retourne NULL_ITEM_LOCAL_ID si l'entité n'est pas dans la table.
+   */
+  ARCCORE_HOST_DEVICE Int32 localId(Int64 unique_id) const
+  {
+    Int32 first = 0;
+    Int32 last = m_unique_ids.size();
+    while (first < last) {
+      Int32 middle = first + (last - first) / 2;
+      Int64 v = m_unique_ids[middle];
+      if (v == unique_id)
+        return m_local_ids[middle];
+      if (v < unique_id)
+        first = middle + 1;
+      else
+        last = middle;
+    }
+    return NULL_ITEM_LOCAL_ID;
+  }
+
+ private:
+
+  SmallSpan<const Int64> m_unique_ids;
+  SmallSpan<const Int32> m_local_ids;
+};
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*!
+ * \brief Table uniqueId vers localId d'une famille utilisable sur accélérateur.
+ *
+ * Cette classe conserve une copie, accessible sur accélérateur, de la
+ * correspondance entre uniqueId et localId des entités d'une famille.
+ * Cette copie est un tableau trié par uniqueId construit avec un tri
+ * par base sur la file \a queue. Elle est reconstruite automatiquement
+ * lors de l'appel à update(), view() ou itemsUniqueIdToLocalId() si la
+ * famille a été modifiée, c'est-à-dire après un IItemFamily::endUpdate()
+ * (par exemple après l'ajout ou la suppression de particules) ou après
+ * un compactage du maillage.
+ *
+ * \code
+ * RunQueue queue = ...;
+ * Accelerator::ItemUniqueIdToLocalIdMap uid_map(queue, mesh->cellFamily());
+ * SmallSpan<const Int64> uids = ...;
+ * SmallSpan<Int32> lids = ...;
+ * uid_map.itemsUniqueIdToLocalId(lids, uids);
+ *
+ * // Utilisation directe dans un noyau
+ * auto uid_view = uid_map.view();
+ * command << RUNCOMMAND_LOOP1(iter, n)
+ * {
+ *   Int32 lid = uid_view.localId(uids[iter()]);
+ *   ...
+ * };
+ * \endcode
+ */
+class ARCANE_ACCELERATOR_EXPORT ItemUniqueIdToLocalIdMap
+{
+ public:
+
+  ItemUniqueIdToLocalIdMap(const RunQueue& queue, IItemFamily* family);
+
+ public:
+
+  //! Famille associée
+  IItemFamily* itemFamily() const { return m_item_family; }
+
+  //! Reconstruit la table si la famille a été modifiée depuis la dernière construction.
+  void update();
+
+  //! Force la reconstruction de la table
+  void rebuild();
+
+  //! Vue sur la table (après mise à jour si nécessaire)
+  ItemUniqueIdToLocalIdView view();
+
+  /*!
+   * \brief Convertit des uniqueId en localId.
+   *
+   * Pour chaque indice \a i, range dans \a local_ids[i] le localId de
+   * l'entité de uniqueId \a unique_ids[i]. Le calcul se fait sur la file
+   * associée et les deux tableaux doivent donc être accessibles sur
+   * cette file.
+   *
+   * Si une entité n'est pas trouvée, le localId vaut NULL_ITEM_LOCAL_ID.
+   * Si \a policy vaut eUniqueIdNotFoundPolicy::Fatal, une exception est
+   * levée à la fin du calcul s'il y a au moins une entité non trouvée.
+   *
+   * Retourne le nombre d'entités non trouvées.
+   *
+   * Cette méthode est bloquante.
+   */
+  Int32 itemsUniqueIdToLocalId(SmallSpan<Int32> local_ids, SmallSpan<const Int64> unique_ids,
+                               eUniqueIdNotFoundPolicy policy = eUniqueIdNotFoundPolicy::Fatal);
+
+ private:
+
+  RunQueue m_queue;
+  IItemFamily* m_item_family = nullptr;
+  Int64 m_mesh_timestamp = -1;
+  Int64 m_all_items_timestamp = -1;
+  Int32 m_nb_item = -1;
+  Int32 m_max_local_id = -1;
+  UniqueArray<Int64> m_sorted_unique_ids;
+  UniqueArray<Int32> m_sorted_local_ids;
+  UniqueArray<Int64> m_work_unique_ids;
+  UniqueArray<Int32> m_work_local_ids;
+
+ private:
+
+  bool _isFamilyModified() const;
+};
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+} // namespace Arcane::Accelerator
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+#endif
@@ -19,6 +19,7 @@
 #include "arcane/core/materials/IMeshMaterialVariable.h"
 #include "arcane/core/materials/MeshMaterialVariableRef.h"
 #include "arcane/core/materials/MeshEnvironmentVariableRef.h"
+#include "arcane/core/materials/CellMaterialVariableSoAArrayRef.h"
 #include "arcane/core/materials/MatItem.h"
 
 /*---------------------------------------------------------------------------*/
@@ -177,6 +178,100 @@ class MatItemVariableScalarOutViewT
   ArrayView<DataType>* m_value;
 };
 
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*!
+ * \brief Vue en lecture sur une variable matériau tableau rangée par composante.
+ *
+ * \sa CellMaterialVariableSoAArrayRef.
+ */
+template<typename ItemType,typename DataType>
+class MatItemVariableSoAArrayInViewT
+: public MatVariableViewBase
+{
+ private:
+
+  using ItemIndexType = typename ItemTraitsT<ItemType>::LocalIdType;
+
+ public:
+
+  MatItemVariableSoAArrayInViewT(RunCommand& cmd, IMeshMaterialVariable* var, SmallSpan<ArrayView<DataType>* const> v)
+  : MatVariableViewBase(cmd, var), m_values(v){}
+
+  //! Nombre de composantes
+  ARCCORE_HOST_DEVICE Int32 nbComponent() const { return m_values.size(); }
+
+  //! Valeur de la composante \a k pour l'entité \a lid
+  ARCCORE_HOST_DEVICE const DataType& operator()(ComponentItemLocalId lid, Int32 k) const
+  {
+    return m_values[k][lid.localId().arrayIndex()][lid.localId().valueIndex()];
+  }
+
+  //! Valeur de la composante \a k pour l'entité \a pmvi
+  ARCCORE_HOST_DEVICE const DataType& operator()(PureMatVarIndex pmvi, Int32 k) const
+  {
+    return m_values[k][0][pmvi.valueIndex()];
+  }
+
+  //! Valeur globale de la composante \a k pour l'entité \a item
+  ARCCORE_HOST_DEVICE const DataType& operator()(ItemIndexType item, Int32 k) const
+  {
+    return m_values[k][0][item.localId()];
+  }
+
+ private:
+
+  SmallSpan<ArrayView<DataType>* const> m_values;
+};
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*!
+ * \brief Vue en écriture sur une variable matériau tableau rangée par composante.
+ *
+ * \sa CellMaterialVariableSoAArrayRef.
+ */
+template<typename ItemType,typename Accessor>
+class MatItemVariableSoAArrayOutViewT
+: public MatVariableViewBase
+{
+ private:
+
+  using DataType = typename Accessor::ValueType;
+  using ItemIndexType = typename ItemTraitsT<ItemType>::LocalIdType;
+
+ public:
+
+  MatItemVariableSoAArrayOutViewT(RunCommand& cmd, IMeshMaterialVariable* var, SmallSpan<ArrayView<DataType>* const> v)
+  : MatVariableViewBase(cmd, var), m_values(v){}
+
+  //! Nombre de composantes
+  ARCCORE_HOST_DEVICE Int32 nbComponent() const { return m_values.size(); }
+
+  //! Valeur de la composante \a k pour l'entité \a lid
+  ARCCORE_HOST_DEVICE Accessor operator()(ComponentItemLocalId lid, Int32 k) const
+  {
+    return Accessor(m_values[k][lid.localId().arrayIndex()].data() + lid.localId().valueIndex());
+  }
+
+  //! Valeur de la composante \a k pour l'entité \a pmvi
+  ARCCORE_HOST_DEVICE Accessor operator()(PureMatVarIndex pmvi, Int32 k) const
+  {
+    return Accessor(m_values[k][0].data() + pmvi.valueIndex());
+  }
+
+  //! Valeur globale de la composante \a k pour l'entité \a item
+  ARCCORE_HOST_DEVICE Accessor operator()(ItemIndexType item, Int32 k) const
+  {
+    ARCANE_CHECK_AT(item.localId(), m_values[k][0].size());
+    return Accessor(m_values[k][0].data() + item.localId());
+  }
+
+ private:
+
+  SmallSpan<ArrayView<DataType>* const> m_values;
+};
+
 /*---------------------------------------------------------------------------*/
 /*---------------------------------------------------------------------------*/
 /*!
@@ -249,6 +344,41 @@ viewIn(RunCommand& cmd,const CellEnvironmentVariableScalarRef<DataType>& var)
   return MatItemVariableScalarInViewT<Cell,DataType>(cmd, var.materialVariable(),var._internalValue());
 }
 
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*!
+ * \brief Vue en lecture pour les variables matériaux tableau rangées par composante.
+ */
+template<typename DataType> auto
+viewIn(RunCommand& cmd,const CellMaterialVariableSoAArrayRef<DataType>& var)
+{
+  return MatItemVariableSoAArrayInViewT<Cell,DataType>(cmd, var._firstMaterialVariable(), var._internalComponentValues());
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*!
+ * \brief Vue en écriture pour les variables matériaux tableau rangées par composante.
+ */
+template<typename DataType> auto
+viewOut(RunCommand& cmd, CellMaterialVariableSoAArrayRef<DataType>& var)
+{
+  using Accessor = DataViewSetter<DataType>;
+  return MatItemVariableSoAArrayOutViewT<Cell,Accessor>(cmd, var._firstMaterialVariable(), var._internalComponentValues());
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*!
+ * \brief Vue en lecture/écriture pour les variables matériaux tableau rangées par composante.
+ */
+template<typename DataType> auto
+viewInOut(RunCommand& cmd, CellMaterialVariableSoAArrayRef<DataType>& var)
+{
+  using Accessor = DataViewGetterSetter<DataType>;
+  return MatItemVariableSoAArrayOutViewT<Cell,Accessor>(cmd, var._firstMaterialVariable(), var._internalComponentValues());
+}
+
 /*---------------------------------------------------------------------------*/
 /*---------------------------------------------------------------------------*/
 
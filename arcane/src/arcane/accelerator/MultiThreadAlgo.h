@@ -0,0 +1,339 @@
+﻿// -*- tab-width: 2; indent-tabs-mode: nil; coding: utf-8-with-signature -*-
+//-----------------------------------------------------------------------------
+// Copyright 2000-2024 CEA (www.cea.fr) IFPEN (www.ifpenergiesnouvelles.com)
+// See the top-level COPYRIGHT file for details.
+// SPDX-License-Identifier: Apache-2.0
+//-----------------------------------------------------------------------------
+/*---------------------------------------------------------------------------*/
+/* MultiThreadAlgo.h                                           (C) 2000-2024 */
+/*                                                                           */
+/* Implémentation multi-thread des algorithmes de scan/filtrage/partition.   */
+/*---------------------------------------------------------------------------*/
+#ifndef ARCANE_ACCELERATOR_MULTITHREADALGO_H
+#define ARCANE_ACCELERATOR_MULTITHREADALGO_H
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+#include "arcane/utils/Array.h"
+#include "arcane/utils/ConcurrencyUtils.h"
+#include "arcane/utils/RangeFunctor.h"
+
+#include "arcane/accelerator/AcceleratorGlobal.h"
+#include "arcane/accelerator/CommonUtils.h"
+
+#include <iterator>
+#include <type_traits>
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+namespace Arcane::Accelerator::impl
+{
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*!
+ * \internal
+ * \brief Algorithmes de scan, filtrage et partitionnement en multi-thread.
+ *
+ * Ces algorithmes sont utilisés pour la politique d'exécution
+ * eExecutionPolicy::Thread. Ils découpent les valeurs en blocs contigus
+ * et fonctionnent en deux passes:
+ *
+ * - la première passe calcule en parallèle une valeur par bloc (la réduction
+ *   du bloc pour le scan, le nombre d'éléments sélectionnés pour le filtrage
+ *   et le partitionnement),
+ * - un scan séquentiel sur les blocs donne la position ou la valeur initiale
+ *   de chaque bloc,
+ * - la seconde passe remplit en parallèle la sortie de chaque bloc.
+ *
+ * Le résultat est identique à celui de l'implémentation séquentielle et ne
+ * dépend pas du nombre de threads. Pour le scan, cela suppose que l'opérateur
+ * est associatif pour le type de donnée, ce qui n'est pas le cas de
+ * l'addition des flottants. isExactScan() indique si l'algorithme peut être
+ * utilisé.
+ *
+ * Pour le filtrage et le partitionnement, toutes les lectures de l'entrée
+ * sont effectuées avant les écritures dans la sortie. L'entrée et la sortie
+ * peuvent donc se chevaucher comme avec l'implémentation séquentielle.
+ */
+class MultiThreadAlgo
+{
+ public:
+
+  explicit MultiThreadAlgo(const ParallelLoopOptions& loop_options)
+  : m_loop_options(loop_options)
+  {}
+
+ public:
+
+  /*!
+   * \brief Indique si le scan multi-thread donne le même résultat
+   * que le scan séquentiel.
+   *
+   * C'est le cas pour les types entiers ou pour les opérateurs de minimum
+   * et de maximum.
+   */
+  template <typename DataType, typename Operator>
+  static constexpr bool isExactScan()
+  {
+    return std::is_integral_v<DataType> ||
+    std::is_same_v<Operator, MinOperator<DataType>> ||
+    std::is_same_v<Operator, MaxOperator<DataType>>;
+  }
+
+  //! Scan inclusif ou exclusif
+  template <bool IsExclusive, typename InputIterator, typename OutputIterator,
+            typename Operator, typename DataType>
+  void doScan(Int32 nb_value, InputIterator input, OutputIterator output,
+              const DataType& init_value, const Operator& op)
+  {
+    if (nb_value <= 0)
+      return;
+    _computeBlocks(nb_value);
+    const Int32 nb_block = m_nb_block;
+    UniqueArray<DataType> block_values(nb_block);
+
+    // Passe 1: calcule la réduction de chaque bloc.
+    auto func1 = [&](Int32 block_index) {
+      const Int32 begin = _blockBegin(block_index);
+      const Int32 end = _blockEnd(block_index);
+      DataType sum = input[begin];
+      for (Int32 i = begin + 1; i < end; ++i) {
+        DataType v = input[i];
+        sum = op(v, sum);
+      }
+      block_values[block_index] = sum;
+    };
+    _executeBlocks(func1);
+
+    // Calcule la valeur initiale de chaque bloc en conservant
+    // l'ordre d'application de l'opérateur du scan séquentiel.
+    DataType sum = init_value;
+    for (Int32 b = 0; b < nb_block; ++b) {
+      DataType v = block_values[b];
+      block_values[b] = sum;
+      sum = op(v, sum);
+    }
+
+    // Passe 2: calcule le scan dans chaque bloc.
+    auto func2 = [&](Int32 block_index) {
+      const Int32 begin = _blockBegin(block_index);
+      const Int32 end = _blockEnd(block_index);
+      DataType sum = block_values[block_index];
+      for (Int32 i = begin; i < end; ++i) {
+        DataType v = input[i];
+        if constexpr (IsExclusive) {
+          output[i] = sum;
+          sum = op(v, sum);
+        }
+        else {
+          sum = op(v, sum);
+          output[i] = sum;
+        }
+      }
+    };
+    _executeBlocks(func2);
+  }
+
+  /*!
+   * \brief Filtrage.
+   *
+   * Recopie dans \a output les valeurs `input[i]` pour lesquelles
+   * `select_lambda(i)` est vrai et retourne le nombre de valeurs recopiées.
+   */
+  template <typename InputIterator, typename OutputIterator, typename SelectLambda>
+  Int32 doFilter(Int32 nb_value, InputIterator input, OutputIterator output,
+                 const SelectLambda& select_lambda)
+  {
+    if (nb_value <= 0)
+      return 0;
+    using ValueType = typename std::iterator_traits<InputIterator>::value_type;
+    _computeBlocks(nb_value);
+    const Int32 nb_block = m_nb_block;
+    // Valeurs sélectionnées. Celles du bloc \a b sont rangées de manière
+    // contigüe à partir de _blockBegin(b).
+    UniqueArray<ValueType> selected_values(nb_value);
+    UniqueArray<Int32> block_offsets(nb_block);
+
+    // Passe 1: conserve les valeurs sélectionnées de chaque bloc.
+    auto func1 = [&](Int32 block_index) {
+      const Int32 begin = _blockBegin(block_index);
+      const Int32 end = _blockEnd(block_index);
+      Int32 index = begin;
+      for (Int32 i = begin; i < end; ++i) {
+        if (select_lambda(i)) {
+          selected_values[index] = input[i];
+          ++index;
+        }
+      }
+      block_offsets[block_index] = index - begin;
+    };
+    _executeBlocks(func1);
+
+    const Int32 nb_output = _exclusiveScan(block_offsets);
+
+    // Passe 2: recopie les valeurs sélectionnées à leur position finale.
+    auto func2 = [&](Int32 block_index) {
+      const Int32 begin = _blockBegin(block_index);
+      const Int32 offset = block_offsets[block_index];
+      const Int32 n = _blockSize(block_offsets, block_index, nb_output);
+      for (Int32 i = 0; i < n; ++i)
+        output[offset + i] = selected_values[begin + i];
+    };
+    _executeBlocks(func2);
+    return nb_output;
+  }
+
+  /*!
+   * \brief Partitionnement en deux listes.
+   *
+   * Les valeurs `input[i]` pour lesquelles `select_lambda(i)` est vrai
+   * sont rangées dans l'ordre au début de \a output et les autres sont
+   * rangées en ordre inverse à partir de la fin de \a output. Retourne le
+   * nombre de valeurs de la première liste.
+   */
+  template <typename InputIterator, typename OutputIterator, typename SelectLambda>
+  Int32 doPartition(Int32 nb_value, InputIterator input, OutputIterator output,
+                    const SelectLambda& select_lambda)
+  {
+    if (nb_value <= 0)
+      return 0;
+    using ValueType = typename std::iterator_traits<InputIterator>::value_type;
+    _computeBlocks(nb_value);
+    const Int32 nb_block = m_nb_block;
+    // Pour le bloc \a b, les valeurs de la première liste sont rangées
+    // à partir de _blockBegin(b) et celles de la seconde à partir de
+    // _blockEnd(b)-1 en allant vers le début.
+    UniqueArray<ValueType> partitioned_values(nb_value);
+    UniqueArray<Int32> block_offsets(nb_block);
+
+    // Passe 1: conserve les valeurs de chaque liste pour chaque bloc.
+    auto func1 = [&](Int32 block_index) {
+      const Int32 begin = _blockBegin(block_index);
+      const Int32 end = _blockEnd(block_index);
+      Int32 index1 = begin;
+      Int32 index2 = end;
+      for (Int32 i = begin; i < end; ++i) {
+        if (select_lambda(i)) {
+          partitioned_values[index1] = input[i];
+          ++index1;
+        }
+        else {
+          --index2;
+          partitioned_values[index2] = input[i];
+        }
+      }
+      block_offsets[block_index] = index1 - begin;
+    };
+    _executeBlocks(func1);
+
+    const Int32 nb_list1 = _exclusiveScan(block_offsets);
+
+    // Passe 2: recopie les valeurs à leur position finale. Le nombre
+    // d'éléments de la seconde liste avant le bloc se déduit du nombre
+    // d'éléments de la première liste.
+    auto func2 = [&](Int32 block_index) {
+      const Int32 begin = _blockBegin(block_index);
+      const Int32 end = _blockEnd(block_index);
+      const Int32 offset1 = block_offsets[block_index];
+      const Int32 n1 = _blockSize(block_offsets, block_index, nb_list1);
+      for (Int32 i = 0; i < n1; ++i)
+        output[offset1 + i] = partitioned_values[begin + i];
+      const Int32 offset2 = nb_value - 1 - (begin - offset1);
+      const Int32 n2 = (end - begin) - n1;
+      for (Int32 i = 0; i < n2; ++i)
+        output[offset2 - i] = partitioned_values[end - 1 - i];
+    };
+    _executeBlocks(func2);
+    return nb_list1;
+  }
+
+ private:
+
+  ParallelLoopOptions m_loop_options;
+  Int32 m_nb_block = 0;
+  Int32 m_block_size = 0;
+  Int32 m_nb_value = 0;
+
+  //! Nombre minimum de valeurs par bloc
+  static constexpr Int32 MIN_BLOCK_SIZE = 2048;
+
+ private:
+
+  void _computeBlocks(Int32 nb_value)
+  {
+    Int32 nb_thread = m_loop_options.maxThread();
+    if (nb_thread <= 0)
+      nb_thread = TaskFactory::nbAllowedThread();
+    if (nb_thread <= 0)
+      nb_thread = 1;
+    // Utilise plusieurs blocs par thread pour équilibrer la charge.
+    Int64 nb_block = static_cast<Int64>(nb_thread) * 4;
+    const Int64 max_nb_block = (static_cast<Int64>(nb_value) + MIN_BLOCK_SIZE - 1) / MIN_BLOCK_SIZE;
+    if (nb_block > max_nb_block)
+      nb_block = max_nb_block;
+    if (nb_block <= 0)
+      nb_block = 1;
+    const Int64 block_size = (nb_value + nb_block - 1) / nb_block;
+    m_block_size = static_cast<Int32>(block_size);
+    m_nb_block = static_cast<Int32>((nb_value + block_size - 1) / block_size);
+    m_nb_value = nb_value;
+  }
+
+  Int32 _blockBegin(Int32 block_index) const { return block_index * m_block_size; }
+  Int32 _blockEnd(Int32 block_index) const
+  {
+    return (block_index + 1 == m_nb_block) ? m_nb_value : (block_index + 1) * m_block_size;
+  }
+
+  //! Nombre d'éléments du bloc \a block_index à partir des positions des blocs.
+  Int32 _blockSize(const UniqueArray<Int32>& offsets, Int32 block_index, Int32 total) const
+  {
+    const Int32 next = (block_index + 1 == m_nb_block) ? total : offsets[block_index + 1];
+    return next - offsets[block_index];
+  }
+
+  //! Scan exclusif en place de \a values. Retourne la somme des valeurs.
+  static Int32 _exclusiveScan(UniqueArray<Int32>& values)
+  {
+    Int32 sum = 0;
+    for (Int32& v : values) {
+      Int32 x = v;
+      v = sum;
+      sum += x;
+    }
+    return sum;
+  }
+
+  //! Exécute \a func pour chaque bloc
+  template <typename Lambda>
+  void _executeBlocks(const Lambda& func)
+  {
+    if (m_nb_block == 1) {
+      func(0);
+      return;
+    }
+    auto range_func = [&](Int32 begin, Int32 size) {
+      for (Int32 i = begin, end = begin + size; i < end; ++i)
+        func(i);
+    };
+    ParallelLoopOptions loop_options(m_loop_options);
+    loop_options.setGrainSize(1);
+    LambdaRangeFunctorT<decltype(range_func)> functor(range_func);
+    TaskFactory::executeParallelFor(0, m_nb_block, loop_options, &functor);
+  }
+};
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+} // namespace Arcane::Accelerator::impl
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+#endif
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
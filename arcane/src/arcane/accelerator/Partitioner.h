@@ -21,6 +21,8 @@
 #include "arcane/accelerator/AcceleratorGlobal.h"
 #include "arcane/accelerator/core/RunQueue.h"
 #include "arcane/accelerator/CommonUtils.h"
+#include "arcane/accelerator/RunCommandLaunchInfo.h"
+#include "arcane/accelerator/MultiThreadAlgo.h"
 
 /*---------------------------------------------------------------------------*/
 /*---------------------------------------------------------------------------*/
@@ -121,9 +123,15 @@ class GenericPartitionerIf
       s.m_device_nb_list1_storage.copyToAsync(s.m_host_nb_list1_storage, queue);
     } break;
 #endif
-    case eExecutionPolicy::Thread:
-      // Pas encore implémenté en multi-thread
-      [[fallthrough]];
+    case eExecutionPolicy::Thread: {
+      RunCommand command = makeCommand(*queue);
+      impl::RunCommandLaunchInfo launch_info(command, nb_item);
+      launch_info.beginExecute();
+      MultiThreadAlgo algo(launch_info.computeParallelLoopOptions());
+      auto filter_lambda = [&](Int32 input_index) -> bool { return select_lambda(input_iter[input_index]); };
+      s.m_host_nb_list1_storage[0] = algo.doPartition(nb_item, input_iter, output_iter, filter_lambda);
+      launch_info.endExecute();
+    } break;
     case eExecutionPolicy::Sequential: {
       UniqueArray<bool> filter_index(nb_item);
       auto saved_output_iter = output_iter;
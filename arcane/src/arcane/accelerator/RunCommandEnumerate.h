@@ -283,14 +283,19 @@ _applyItems(RunCommand& command, typename TraitsType::ContainerType items,
     _applyKernelSYCL(launch_info, ARCANE_KERNEL_SYCL_FUNC(impl::DoIndirectSYCLLambda) < TraitsType, Lambda, ReducerArgs... > {}, func, ids, reducer_args...);
     break;
   case eExecutionPolicy::Sequential:
-    impl::_doItemsLambda<TraitsType>(0, items.paddedView(), func, reducer_args...);
-    break;
-  case eExecutionPolicy::Thread:
-    arcaneParallelForeach(items.paddedView(), launch_info.loopRunInfo(),
-                          [&](ItemVectorViewT<ItemType> sub_items, Int32 base_index) {
-                            impl::_doItemsLambda<TraitsType>(base_index, sub_items, func, reducer_args...);
-                          });
+    launch_info.executeOnHost([=]() {
+      impl::_doItemsLambda<TraitsType>(0, items.paddedView(), func, reducer_args...);
+    });
     break;
+  case eExecutionPolicy::Thread: {
+    ForLoopRunInfo run_info = launch_info.loopRunInfo();
+    launch_info.executeOnHost([=]() {
+      arcaneParallelForeach(items.paddedView(), run_info,
+                            [&](ItemVectorViewT<ItemType> sub_items, Int32 base_index) {
+                              impl::_doItemsLambda<TraitsType>(base_index, sub_items, func, reducer_args...);
+                            });
+    });
+  } break;
   default:
     ARCANE_FATAL("Invalid execution policy '{0}'", exec_policy);
   }
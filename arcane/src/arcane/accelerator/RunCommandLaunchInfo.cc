@@ -58,6 +58,7 @@ _begin()
   m_exec_policy = queue.executionPolicy();
   m_queue_stream = queue._internalStream();
   m_runtime = queue._internalRuntime();
+  m_is_capturing = queue.isCapturing();
   m_command._allocateReduceMemory(m_thread_block_info.nb_block_per_grid);
 }
 
@@ -71,6 +72,9 @@ beginExecute()
     ARCANE_FATAL("beginExecute() has already been called");
   m_has_exec_begun = true;
   m_command._internalNotifyBeginLaunchKernel();
+  ForLoopOneExecStat* exec_stat = m_command._internalCommandExecStat();
+  if (exec_stat)
+    exec_stat->setNbElement(m_total_loop_size);
 }
 
 /*---------------------------------------------------------------------------*/
@@ -86,6 +90,10 @@ endExecute()
 {
   if (!m_has_exec_begun)
     ARCANE_FATAL("beginExecute() has to be called before endExecute()");
+  // Sur l'hôte, une commande capturée doit passer par executeOnHost().
+  // Si ce n'est pas le cas, c'est qu'elle a déjà été exécutée.
+  if (m_is_capturing && !m_has_captured_host_command && !isAcceleratorPolicy(m_exec_policy))
+    ARCANE_FATAL("This command can not be captured (trace={0})", m_command.traceInfo());
   _doEndKernelLaunch();
 }
 
@@ -101,13 +109,24 @@ _doEndKernelLaunch()
   m_command._internalNotifyEndLaunchKernel();
 
   const RunQueue& q = m_command._internalQueue();
-  if (!q.isAsync())
+  if (!q.isAsync() && !m_is_capturing)
     q.barrier();
 }
 
 /*---------------------------------------------------------------------------*/
 /*---------------------------------------------------------------------------*/
 
+void RunCommandLaunchInfo::
+_addCapturedHostCommand(const std::function<void()>& func)
+{
+  if (!m_queue_stream->_addCapturedHostCommand(func))
+    ARCANE_FATAL("Can not add host command to the capture");
+  m_has_captured_host_command = true;
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
 void* RunCommandLaunchInfo::
 _internalStreamImpl()
 {
@@ -20,6 +20,8 @@
 
 #include "arcane/accelerator/AcceleratorGlobal.h"
 
+#include <functional>
+
 /*---------------------------------------------------------------------------*/
 /*---------------------------------------------------------------------------*/
 
@@ -89,6 +91,24 @@ class ARCANE_ACCELERATOR_EXPORT RunCommandLaunchInfo
   //! Taille totale de la boucle
   Int64 totalLoopSize() const { return m_total_loop_size; }
 
+  //! Indique si la file associée à la commande est en cours de capture
+  bool isCapturing() const { return m_is_capturing; }
+
+  /*!
+   * \brief Exécute la fonction \a func sur l'hôte.
+   *
+   * Si la file associée est en cours de capture, \a func n'est pas exécutée
+   * mais est ajoutée à la liste des commandes capturées. Dans ce cas, \a func
+   * doit conserver par valeur tous les arguments dont elle a besoin.
+   */
+  template <typename HostLambda> void executeOnHost(const HostLambda& func)
+  {
+    if (m_is_capturing)
+      _addCapturedHostCommand(std::function<void()>(func));
+    else
+      func();
+  }
+
  public:
 
   void* _internalStreamImpl();
@@ -104,12 +124,15 @@ class ARCANE_ACCELERATOR_EXPORT RunCommandLaunchInfo
   ThreadBlockInfo m_thread_block_info;
   ForLoopRunInfo m_loop_run_info;
   Int64 m_total_loop_size = 0;
+  bool m_is_capturing = false;
+  bool m_has_captured_host_command = false;
 
  private:
 
   void _begin();
   void _doEndKernelLaunch();
   ThreadBlockInfo _computeThreadBlockInfo() const;
+  void _addCapturedHostCommand(const std::function<void()>& func);
 
  private:
 
@@ -55,11 +55,12 @@ _applyGenericLoop(RunCommand& command, LoopBoundType<N, Int32> bounds,
     _applyKernelSYCL(launch_info, ARCANE_KERNEL_SYCL_FUNC(impl::DoDirectSYCLLambdaArrayBounds) < LoopBoundType<N, Int32>, Lambda, RemainingArgs... > {}, func, bounds, other_args...);
     break;
   case eExecutionPolicy::Sequential:
-    arcaneSequentialFor(bounds, func, other_args...);
-    break;
-  case eExecutionPolicy::Thread:
-    arcaneParallelFor(bounds, launch_info.computeParallelLoopOptions(), func, other_args...);
+    launch_info.executeOnHost([=]() { arcaneSequentialFor(bounds, func, other_args...); });
     break;
+  case eExecutionPolicy::Thread: {
+    ParallelLoopOptions loop_options = launch_info.computeParallelLoopOptions();
+    launch_info.executeOnHost([=]() { arcaneParallelFor(bounds, loop_options, func, other_args...); });
+  } break;
   default:
     ARCANE_FATAL("Invalid execution policy '{0}'", exec_policy);
   }
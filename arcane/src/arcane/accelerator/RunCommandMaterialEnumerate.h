@@ -15,11 +15,14 @@
 /*---------------------------------------------------------------------------*/
 
 #include "arcane/utils/ArcaneCxx20.h"
+#include "arcane/utils/PlatformUtils.h"
 
 #include "arcane/core/Concurrency.h"
 #include "arcane/core/materials/ComponentItemVectorView.h"
+#include "arcane/core/materials/ComponentPartItemVectorView.h"
 #include "arcane/core/materials/MaterialsCoreGlobal.h"
 #include "arcane/core/materials/MatItem.h"
+#include "arcane/core/materials/MatItemEnumerator.h"
 #include "arcane/accelerator/RunQueueInternal.h"
 #include "arcane/accelerator/RunCommand.h"
 #include "arcane/accelerator/RunCommandLaunchInfo.h"
@@ -454,6 +457,150 @@ class MatAndGlobalCellRunCommand
   Container m_items;
 };
 
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*!
+ * \brief Commande pour itérer sur la partie pure ou la partie impure
+ * d'un constituant.
+ *
+ * Toutes les entités de la partie ont le même MatVarIndex::arrayIndex(). Pour
+ * la partie pure, il s'agit de l'indice des valeurs globales et
+ * MatVarIndex::valueIndex() est le localId() de la maille. L'accès aux valeurs
+ * ne nécessite donc qu'une indirection sur le tableau des valueIndex() et
+ * sur l'hôte la boucle peut être vectorisée par le compilateur.
+ */
+class ComponentPartCellRunCommand
+{
+ public:
+
+  using ComponentPartItemVectorView = Arcane::Materials::ComponentPartItemVectorView;
+  using ComponentItemLocalId = Arcane::Materials::ComponentItemLocalId;
+  using MatVarIndex = Arcane::Materials::MatVarIndex;
+
+ public:
+
+  /*!
+   * \brief Conteneur contenant les informations nécessaires pour la commande.
+   */
+  class Container
+  {
+    friend ComponentPartCellRunCommand;
+
+   public:
+
+    explicit Container(const ComponentPartItemVectorView& view)
+    : m_value_indexes(view.valueIndexes())
+    , m_component_part_index(view.componentPartIndex())
+    {
+    }
+
+   public:
+
+    ComponentPartCellRunCommand createCommand(RunCommand& run_command) const
+    {
+      return ComponentPartCellRunCommand(run_command, *this);
+    }
+
+   public:
+
+    constexpr ARCCORE_HOST_DEVICE Int32 size() const { return m_value_indexes.size(); }
+
+    //! Accesseur pour le i-ème élément de la liste
+    constexpr ARCCORE_HOST_DEVICE ComponentItemLocalId operator[](Int32 i) const
+    {
+      return { ComponentItemLocalId(MatVarIndex(m_component_part_index, m_value_indexes[i])) };
+    }
+
+    //! Indice du tableau des valeurs de la partie
+    constexpr ARCCORE_HOST_DEVICE Int32 componentPartIndex() const { return m_component_part_index; }
+
+    //! Liste des valueIndex() de la partie
+    constexpr ARCCORE_HOST_DEVICE SmallSpan<const Int32> valueIndexes() const { return m_value_indexes; }
+
+   private:
+
+    SmallSpan<const Int32> m_value_indexes;
+    Int32 m_component_part_index = -1;
+  };
+
+ private:
+
+  // Uniquement appelable depuis 'Container'
+  explicit ComponentPartCellRunCommand(RunCommand& command, const Container& items)
+  : m_command(command)
+  , m_items(items)
+  {
+  }
+
+ public:
+
+  RunCommand& m_command;
+  Container m_items;
+};
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+//! Spécialisation pour une vue sur une partie d'un milieu
+template <>
+class RunCommandMatItemEnumeratorTraitsT<Arcane::Materials::EnvPartCell>
+{
+ public:
+
+  using EnumeratorType = Arcane::Materials::ComponentItemLocalId;
+  using ContainerType = ComponentPartCellRunCommand::Container;
+  using MatCommandType = ComponentPartCellRunCommand;
+
+ public:
+
+  static ContainerType createContainer(const Arcane::Materials::EnvPartItemVectorView& items)
+  {
+    return ContainerType{ items };
+  }
+};
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+//! Spécialisation pour une vue sur une partie d'un matériau
+template <>
+class RunCommandMatItemEnumeratorTraitsT<Arcane::Materials::MatPartCell>
+{
+ public:
+
+  using EnumeratorType = Arcane::Materials::ComponentItemLocalId;
+  using ContainerType = ComponentPartCellRunCommand::Container;
+  using MatCommandType = ComponentPartCellRunCommand;
+
+ public:
+
+  static ContainerType createContainer(const Arcane::Materials::MatPartItemVectorView& items)
+  {
+    return ContainerType{ items };
+  }
+};
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+//! Spécialisation pour une vue sur une partie d'un constituant
+template <>
+class RunCommandMatItemEnumeratorTraitsT<Arcane::Materials::ComponentPartCell>
+{
+ public:
+
+  using EnumeratorType = Arcane::Materials::ComponentItemLocalId;
+  using ContainerType = ComponentPartCellRunCommand::Container;
+  using MatCommandType = ComponentPartCellRunCommand;
+
+ public:
+
+  static ContainerType createContainer(const Arcane::Materials::ComponentPartItemVectorView& items)
+  {
+    return ContainerType{ items };
+  }
+};
+
 /*---------------------------------------------------------------------------*/
 /*---------------------------------------------------------------------------*/
 
@@ -627,6 +774,41 @@ void _doMatItemsLambda(Int32 base_index, Int32 size, ContainerType items, const
   ::Arcane::impl::HostReducerHelper::applyReducerArgs(reducer_args...);
 }
 
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*!
+ * \brief Spécialisation pour l'itération sur une partie d'un constituant.
+ *
+ * L'indice du tableau des valeurs est le même pour toutes les itérations.
+ * S'il n'y a pas de réduction, les itérations sont indépendantes et on
+ * l'indique au compilateur pour qu'il puisse vectoriser la boucle avec
+ * la largeur SIMD de la cible de compilation (SSE, AVX ou AVX512).
+ */
+template <typename Lambda, typename... ReducerArgs>
+void _doMatItemsLambda(Int32 base_index, Int32 size, ComponentPartCellRunCommand::Container items,
+                       const Lambda& func, ReducerArgs... reducer_args)
+{
+  using namespace Arcane::Materials;
+  auto privatizer = privatize(func);
+  auto& body = privatizer.privateCopy();
+
+  const Int32 part_index = items.componentPartIndex();
+  const Int32* value_indexes = items.valueIndexes().data();
+  Int32 last_value = base_index + size;
+  if constexpr (sizeof...(ReducerArgs) == 0) {
+    ARCANE_PRAGMA_IVDEP
+    for (Int32 i = base_index; i < last_value; ++i) {
+      body(ComponentItemLocalId(MatVarIndex(part_index, value_indexes[i])));
+    }
+  }
+  else {
+    for (Int32 i = base_index; i < last_value; ++i) {
+      body(ComponentItemLocalId(MatVarIndex(part_index, value_indexes[i])), reducer_args...);
+    }
+    ::Arcane::impl::HostReducerHelper::applyReducerArgs(reducer_args...);
+  }
+}
+
 /*---------------------------------------------------------------------------*/
 /*---------------------------------------------------------------------------*/
 
@@ -687,6 +869,7 @@ class GenericMatCommand
  * - EnvCellRunCommand
  * - MatAndGlobalCellRunCommand
  * - MatCellRunCommand
+ * - ComponentPartCellRunCommand
  */
 template <typename ContainerType, typename Lambda, typename... ReducerArgs> void
 _applyEnvCells(RunCommand& command, ContainerType items, const Lambda& func, const ReducerArgs&... reducer_args)
@@ -712,14 +895,19 @@ _applyEnvCells(RunCommand& command, ContainerType items, const Lambda& func, con
     _applyKernelSYCL(launch_info, ARCANE_KERNEL_SYCL_FUNC(impl::DoMatContainerSYCLLambda) < ContainerType, Lambda, ReducerArgs... > {}, func, items, reducer_args...);
     break;
   case eExecutionPolicy::Sequential:
-    _doMatItemsLambda(0, vsize, items, func, reducer_args...);
-    break;
-  case eExecutionPolicy::Thread:
-    arcaneParallelFor(0, vsize, launch_info.loopRunInfo(),
-                      [&](Int32 begin, Int32 size) {
-                        _doMatItemsLambda(begin, size, items, func, reducer_args...);
-                      });
+    launch_info.executeOnHost([=]() {
+      _doMatItemsLambda(0, vsize, items, func, reducer_args...);
+    });
     break;
+  case eExecutionPolicy::Thread: {
+    ForLoopRunInfo run_info = launch_info.loopRunInfo();
+    launch_info.executeOnHost([=]() {
+      arcaneParallelFor(0, vsize, run_info,
+                        [&](Int32 begin, Int32 size) {
+                          _doMatItemsLambda(begin, size, items, func, reducer_args...);
+                        });
+    });
+  } break;
   default:
     ARCANE_FATAL("Invalid execution policy '{0}'", exec_policy);
   }
@@ -804,12 +992,36 @@ operator<<(RunCommand& command, const impl::MatCellRunCommand::Container& view)
 /*---------------------------------------------------------------------------*/
 /*---------------------------------------------------------------------------*/
 
+inline auto
+operator<<(RunCommand& command, const impl::ComponentPartCellRunCommand::Container& view)
+{
+  return impl::GenericMatCommand<impl::ComponentPartCellRunCommand>(view.createCommand(command));
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
 } // End namespace Arcane::Accelerator
 
 /*---------------------------------------------------------------------------*/
 /*---------------------------------------------------------------------------*/
 
-//! Macro pour itérer sur un matériau ou un milieu
+/*!
+ * \brief Macro pour itérer sur un matériau ou un milieu.
+ *
+ * \a MatItemNameType peut valoir \a EnvCell, \a MatCell, \a EnvAndGlobalCell,
+ * \a MatAndGlobalCell pour itérer sur toutes les mailles d'un constituant
+ * ou \a EnvPartCell, \a MatPartCell et \a ComponentPartCell pour itérer
+ * uniquement sur la partie pure ou impure d'un constituant. Dans ce dernier cas,
+ * la partie pure ne fait accès qu'aux valeurs globales et la partie impure
+ * qu'aux valeurs partielles du constituant:
+ *
+ * \code
+ * IMeshEnvironment* env = ...;
+ * command << RUNCOMMAND_MAT_ENUMERATE(EnvPartCell, iter, env->pureEnvItems()) { ... };
+ * command << RUNCOMMAND_MAT_ENUMERATE(EnvPartCell, iter, env->impureEnvItems()) { ... };
+ * \endcode
+ */
 #define RUNCOMMAND_MAT_ENUMERATE(MatItemNameType, iter_name, env_or_mat_vector, ...) \
   A_FUNCINFO << ::Arcane::Accelerator::impl::makeExtendedMatItemEnumeratorLoop<MatItemNameType>(env_or_mat_vector __VA_OPT__(, __VA_ARGS__)) \
              << [=] ARCCORE_HOST_DEVICE(::Arcane::Accelerator::impl::RunCommandMatItemEnumeratorTraitsT<MatItemNameType>::EnumeratorType iter_name \
@@ -23,6 +23,7 @@
 
 #include "arcane/accelerator/AcceleratorGlobal.h"
 #include "arcane/accelerator/CommonUtils.h"
+#include "arcane/accelerator/MultiThreadAlgo.h"
 #include "arcane/accelerator/RunCommandLaunchInfo.h"
 #include "arcane/accelerator/RunCommandLoop.h"
 #include "arcane/accelerator/ScanImpl.h"
@@ -141,7 +142,15 @@ class ScannerImpl
     } break;
 #endif
     case eExecutionPolicy::Thread:
-      // Pas encore implémenté en multi-thread
+      // Le scan multi-thread regroupe les opérations par bloc. Il ne donne
+      // le même résultat que la version séquentielle que si l'opérateur est
+      // associatif. Sinon (par exemple pour la somme de réels), on utilise
+      // l'implémentation séquentielle.
+      if constexpr (MultiThreadAlgo::isExactScan<DataType, Operator>()) {
+        MultiThreadAlgo algo(launch_info.computeParallelLoopOptions());
+        algo.doScan<IsExclusive>(nb_item, input_data, output_data, init_value, op);
+        break;
+      }
       [[fallthrough]];
     case eExecutionPolicy::Sequential: {
       DataType sum = init_value;
@@ -0,0 +1,275 @@
+﻿// -*- tab-width: 2; indent-tabs-mode: nil; coding: utf-8-with-signature -*-
+//-----------------------------------------------------------------------------
+// Copyright 2000-2024 CEA (www.cea.fr) IFPEN (www.ifpenergiesnouvelles.com)
+// See the top-level COPYRIGHT file for details.
+// SPDX-License-Identifier: Apache-2.0
+//-----------------------------------------------------------------------------
+/*---------------------------------------------------------------------------*/
+/* SegmentedReduce.h                                           (C) 2000-2024 */
+/*                                                                           */
+/* Algorithme de réduction par segment.                                      */
+/*---------------------------------------------------------------------------*/
+#ifndef ARCANE_ACCELERATOR_SEGMENTEDREDUCE_H
+#define ARCANE_ACCELERATOR_SEGMENTEDREDUCE_H
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+#include "arcane/utils/ArrayView.h"
+#include "arcane/utils/FatalErrorException.h"
+#include "arcane/utils/TraceInfo.h"
+
+#include "arcane/accelerator/core/RunQueue.h"
+
+#include "arcane/accelerator/AcceleratorGlobal.h"
+#include "arcane/accelerator/CommonUtils.h"
+#include "arcane/accelerator/RunCommandLaunchInfo.h"
+#include "arcane/accelerator/RunCommandLoop.h"
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+namespace Arcane::Accelerator::impl
+{
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*!
+ * \internal
+ * \brief Classe de base pour effectuer une réduction par segment.
+ *
+ * Conserve la mémoire temporaire nécessaire à l'algorithme pour pouvoir
+ * la réutiliser entre deux appels.
+ */
+class ARCANE_ACCELERATOR_EXPORT GenericSegmentedReducerBase
+{
+  friend class GenericSegmentedReducerImpl;
+
+ public:
+
+  explicit GenericSegmentedReducerBase(const RunQueue& queue);
+
+ protected:
+
+  RunQueue m_queue;
+  GenericDeviceStorage m_algo_storage;
+};
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*!
+ * \internal
+ * \brief Classe pour effectuer une réduction par segment.
+ *
+ * Le segment \a i contient les valeurs d'indices `[offsets[i],offsets[i+1][`.
+ */
+class GenericSegmentedReducerImpl
+{
+ public:
+
+  template <typename InputIterator, typename DataType, typename Operator>
+  void apply(GenericSegmentedReducerBase& s, Int32 nb_segment, InputIterator input_iter,
+             SmallSpan<const Int32> offsets, SmallSpan<DataType> output,
+             const DataType& init_value, const Operator& op, const TraceInfo& trace_info)
+  {
+    RunQueue& queue = s.m_queue;
+    eExecutionPolicy exec_policy = queue.executionPolicy();
+    [[maybe_unused]] const Int32* begin_offsets = offsets.data();
+    [[maybe_unused]] const Int32* end_offsets = offsets.data() + 1;
+    [[maybe_unused]] DataType* output_data = output.data();
+    switch (exec_policy) {
+#if defined(ARCANE_COMPILING_CUDA)
+    case eExecutionPolicy::CUDA: {
+      RunCommand command = makeCommand(queue);
+      command << trace_info;
+      impl::RunCommandLaunchInfo launch_info(command, nb_segment);
+      launch_info.beginExecute();
+      size_t temp_storage_size = 0;
+      cudaStream_t stream = impl::CudaUtils::toNativeStream(&queue);
+      // Premier appel pour connaitre la taille pour l'allocation
+      ARCANE_CHECK_CUDA(::cub::DeviceSegmentedReduce::Reduce(nullptr, temp_storage_size, input_iter, output_data,
+                                                             nb_segment, begin_offsets, end_offsets,
+                                                             op, init_value, stream));
+      void* temp_storage = s.m_algo_storage.allocate(temp_storage_size);
+      ARCANE_CHECK_CUDA(::cub::DeviceSegmentedReduce::Reduce(temp_storage, temp_storage_size, input_iter, output_data,
+                                                             nb_segment, begin_offsets, end_offsets,
+                                                             op, init_value, stream));
+      launch_info.endExecute();
+    } break;
+#endif
+#if defined(ARCANE_COMPILING_HIP)
+    case eExecutionPolicy::HIP: {
+      RunCommand command = makeCommand(queue);
+      command << trace_info;
+      impl::RunCommandLaunchInfo launch_info(command, nb_segment);
+      launch_info.beginExecute();
+      size_t temp_storage_size = 0;
+      // Premier appel pour connaitre la taille pour l'allocation
+      hipStream_t stream = impl::HipUtils::toNativeStream(&queue);
+      ARCANE_CHECK_HIP(rocprim::segmented_reduce(nullptr, temp_storage_size, input_iter, output_data,
+                                                 nb_segment, begin_offsets, end_offsets,
+                                                 op, init_value, stream));
+      void* temp_storage = s.m_algo_storage.allocate(temp_storage_size);
+      ARCANE_CHECK_HIP(rocprim::segmented_reduce(temp_storage, temp_storage_size, input_iter, output_data,
+                                                 nb_segment, begin_offsets, end_offsets,
+                                                 op, init_value, stream));
+      launch_info.endExecute();
+    } break;
+#endif
+    case eExecutionPolicy::SYCL:
+    case eExecutionPolicy::Thread:
+    case eExecutionPolicy::Sequential: {
+      // Chaque segment est réduit par une seule itération, dans l'ordre
+      // croissant des indices. Le résultat ne dépend donc pas du nombre de
+      // threads utilisés.
+      auto command = makeCommand(queue);
+      command << trace_info;
+      command << Arcane::ArrayBounds<MDDim1>(nb_segment) << [=] ARCCORE_HOST_DEVICE(Arcane::MDIndex<1> iter) {
+        auto [i] = iter();
+        DataType v = init_value;
+        const Int32 end = offsets[i + 1];
+        for (Int32 j = offsets[i]; j < end; ++j)
+          v = op(v, input_iter[j]);
+        output[i] = v;
+      };
+    } break;
+    default:
+      ARCANE_FATAL(getBadPolicyMessage(exec_policy));
+    }
+  }
+};
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+} // namespace Arcane::Accelerator::impl
+
+namespace Arcane::Accelerator
+{
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*!
+ * \brief Algorithme générique de réduction par segment sur accélérateur.
+ *
+ * Les segments sont définis par un tableau d'offsets de taille `nb_segment+1`.
+ * Le segment \a i contient les valeurs d'indices `[offsets[i],offsets[i+1][`
+ * et sa réduction est rangée dans `output[i]`. Un segment vide a pour valeur
+ * la valeur initiale de l'opérateur.
+ *
+ * Par exemple, pour calculer pour chaque maille la somme des valeurs de
+ * ses milieux:
+ *
+ * \code
+ * Arcane::Accelerator::RunQueue queue = ...;
+ * SmallSpan<const Real> values = ...;      // Valeurs rangées par maille
+ * SmallSpan<const Int32> offsets = ...;    // Taille nb_cell+1
+ * SmallSpan<Real> cell_sum = ...;          // Taille nb_cell
+ * Arcane::Accelerator::GenericSegmentedReducer reducer(queue);
+ * reducer.applySum(values, offsets, cell_sum);
+ * \endcode
+ *
+ * Contrairement aux réductions utilisant des opérations atomiques, le résultat
+ * est reproductible pour une politique d'exécution donnée. Sur l'hôte, les
+ * valeurs d'un segment sont combinées dans l'ordre croissant des indices.
+ */
+class GenericSegmentedReducer
+: private impl::GenericSegmentedReducerBase
+{
+ public:
+
+  explicit GenericSegmentedReducer(const RunQueue& queue)
+  : impl::GenericSegmentedReducerBase(queue)
+  {}
+
+ public:
+
+  //! Somme par segment
+  template <typename DataType>
+  void applySum(SmallSpan<const DataType> input, SmallSpan<const Int32> offsets, SmallSpan<DataType> output,
+                const TraceInfo& trace_info = TraceInfo())
+  {
+    impl::SumOperator<DataType> op;
+    apply(input, offsets, output, op.defaultValue(), op, trace_info);
+  }
+
+  //! Minimum par segment
+  template <typename DataType>
+  void applyMin(SmallSpan<const DataType> input, SmallSpan<const Int32> offsets, SmallSpan<DataType> output,
+                const TraceInfo& trace_info = TraceInfo())
+  {
+    impl::MinOperator<DataType> op;
+    apply(input, offsets, output, op.defaultValue(), op, trace_info);
+  }
+
+  //! Maximum par segment
+  template <typename DataType>
+  void applyMax(SmallSpan<const DataType> input, SmallSpan<const Int32> offsets, SmallSpan<DataType> output,
+                const TraceInfo& trace_info = TraceInfo())
+  {
+    impl::MaxOperator<DataType> op;
+    apply(input, offsets, output, op.defaultValue(), op, trace_info);
+  }
+
+  /*!
+   * \brief Réduction par segment avec un opérateur quelconque.
+   *
+   * \a op doit avoir un opérateur
+   * `ARCCORE_HOST_DEVICE DataType operator()(const DataType& a,const DataType& b) const`
+   * associatif.
+   */
+  template <typename DataType, typename Operator>
+  void apply(SmallSpan<const DataType> input, SmallSpan<const Int32> offsets, SmallSpan<DataType> output,
+             const DataType& init_value, const Operator& op, const TraceInfo& trace_info = TraceInfo())
+  {
+    const Int32 nb_segment = _checkSizes(offsets, output.size());
+    if (nb_segment == 0)
+      return;
+    impl::GenericSegmentedReducerImpl gr;
+    gr.apply(*this, nb_segment, input.data(), offsets, output, init_value, op, trace_info);
+  }
+
+  /*!
+   * \brief Réduction par segment avec récupération des valeurs via un index.
+   *
+   * Cette méthode est identique à apply() mais la valeur d'indice \a i est
+   * obtenue par l'appel à `getter_lambda(i)`. Le prototype de cette lambda est:
+   *
+   * \code
+   * auto getter_lambda = [=] ARCCORE_HOST_DEVICE (Int32 index) -> DataType;
+   * \endcode
+   */
+  template <typename DataType, typename GetterLambda, typename Operator>
+  void applyWithIndex(SmallSpan<const Int32> offsets, SmallSpan<DataType> output,
+                      const DataType& init_value, const GetterLambda& getter_lambda,
+                      const Operator& op, const TraceInfo& trace_info = TraceInfo())
+  {
+    const Int32 nb_segment = _checkSizes(offsets, output.size());
+    if (nb_segment == 0)
+      return;
+    impl::GetterLambdaIterator<DataType, GetterLambda> input_iter(getter_lambda);
+    impl::GenericSegmentedReducerImpl gr;
+    gr.apply(*this, nb_segment, input_iter, offsets, output, init_value, op, trace_info);
+  }
+
+ private:
+
+  static Int32 _checkSizes(SmallSpan<const Int32> offsets, Int32 output_size)
+  {
+    if (offsets.size() != (output_size + 1))
+      ARCANE_FATAL("Bad size for offsets: offsets={0} expected={1}", offsets.size(), output_size + 1);
+    return output_size;
+  }
+};
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+} // namespace Arcane::Accelerator
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+#endif
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
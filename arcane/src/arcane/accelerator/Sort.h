@@ -0,0 +1,427 @@
+﻿// -*- tab-width: 2; indent-tabs-mode: nil; coding: utf-8-with-signature -*-
+//-----------------------------------------------------------------------------
+// Copyright 2000-2024 CEA (www.cea.fr) IFPEN (www.ifpenergiesnouvelles.com)
+// See the top-level COPYRIGHT file for details.
+// SPDX-License-Identifier: Apache-2.0
+//-----------------------------------------------------------------------------
+/*---------------------------------------------------------------------------*/
+/* Sort.h                                                      (C) 2000-2024 */
+/*                                                                           */
+/* Algorithme de tri par base (radix sort) de clés ou de couples clé/valeur. */
+/*---------------------------------------------------------------------------*/
+#ifndef ARCANE_ACCELERATOR_SORT_H
+#define ARCANE_ACCELERATOR_SORT_H
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+#include "arcane/utils/ArrayView.h"
+#include "arcane/utils/Array.h"
+#include "arcane/utils/FatalErrorException.h"
+#include "arcane/utils/TraceInfo.h"
+
+#include "arcane/accelerator/core/RunQueue.h"
+
+#include "arcane/accelerator/AcceleratorGlobal.h"
+#include "arcane/accelerator/CommonUtils.h"
+#include "arcane/accelerator/RunCommandLaunchInfo.h"
+
+#include <array>
+#include <cstring>
+#include <type_traits>
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+namespace Arcane::Accelerator::impl
+{
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*!
+ * \internal
+ * \brief Conversion d'une clé en un entier non signé respectant l'ordre.
+ *
+ * La conversion est telle que si `a < b` alors `toRadix(a) < toRadix(b)`.
+ * Cela permet de trier par base les types entiers signés et les types flottants.
+ */
+template <typename KeyType, typename Enable = void>
+class RadixSortKeyTraits;
+
+//! Spécialisation pour les types entiers
+template <typename KeyType>
+class RadixSortKeyTraits<KeyType, std::enable_if_t<std::is_integral_v<KeyType> && !std::is_same_v<KeyType, bool>>>
+{
+ public:
+
+  using UnsignedType = std::make_unsigned_t<KeyType>;
+
+ private:
+
+  static constexpr UnsignedType _signBit() { return UnsignedType(UnsignedType(1) << (sizeof(KeyType) * 8 - 1)); }
+
+ public:
+
+  static UnsignedType toRadix(KeyType v)
+  {
+    auto u = static_cast<UnsignedType>(v);
+    if constexpr (std::is_signed_v<KeyType>)
+      u ^= _signBit();
+    return u;
+  }
+  static KeyType fromRadix(UnsignedType u)
+  {
+    if constexpr (std::is_signed_v<KeyType>)
+      u ^= _signBit();
+    return static_cast<KeyType>(u);
+  }
+};
+
+//! Spécialisation pour les types flottants
+template <typename KeyType>
+class RadixSortKeyTraits<KeyType, std::enable_if_t<std::is_floating_point_v<KeyType>>>
+{
+ public:
+
+  using UnsignedType = std::conditional_t<sizeof(KeyType) == 8, std::uint64_t, std::uint32_t>;
+  static_assert(sizeof(UnsignedType) == sizeof(KeyType), "Unsupported floating point type");
+
+ private:
+
+  static constexpr UnsignedType _signBit() { return UnsignedType(UnsignedType(1) << (sizeof(KeyType) * 8 - 1)); }
+
+ public:
+
+  static UnsignedType toRadix(KeyType v)
+  {
+    UnsignedType u = 0;
+    std::memcpy(&u, &v, sizeof(KeyType));
+    // Pour les nombres négatifs, il faut inverser tous les bits. Pour
+    // les positifs, il suffit de positionner le bit de signe.
+    return (u & _signBit()) ? static_cast<UnsignedType>(~u) : static_cast<UnsignedType>(u | _signBit());
+  }
+  static KeyType fromRadix(UnsignedType u)
+  {
+    u = (u & _signBit()) ? static_cast<UnsignedType>(u ^ _signBit()) : static_cast<UnsignedType>(~u);
+    KeyType v;
+    std::memcpy(&v, &u, sizeof(KeyType));
+    return v;
+  }
+};
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*!
+ * \internal
+ * \brief Tri par base (LSD) sur l'hôte.
+ *
+ * Le tri est stable et utilise des chiffres de 8 bits. Les histogrammes de
+ * toutes les passes sont calculés en une seule lecture des clés et les passes
+ * pour lesquelles toutes les clés ont le même chiffre sont ignorées.
+ *
+ * Pour le tri des couples clé/valeur, on trie une permutation et les valeurs
+ * ne sont recopiées qu'une seule fois à la fin.
+ */
+class HostRadixSorter
+{
+ public:
+
+  template <bool HasValues, typename KeyType, typename ValueType>
+  static void apply(Int32 nb_item, const KeyType* keys_in, KeyType* keys_out,
+                    const ValueType* values_in, ValueType* values_out)
+  {
+    using Traits = RadixSortKeyTraits<KeyType>;
+    using UnsignedType = typename Traits::UnsignedType;
+    constexpr Int32 nb_pass = sizeof(UnsignedType);
+    constexpr Int32 nb_bucket = 256;
+
+    if (nb_item <= 0)
+      return;
+
+    UniqueArray<UnsignedType> keys1(nb_item);
+    UniqueArray<UnsignedType> keys2(nb_item);
+    UniqueArray<Int32> indexes1;
+    UniqueArray<Int32> indexes2;
+    if constexpr (HasValues) {
+      indexes1.resize(nb_item);
+      indexes2.resize(nb_item);
+    }
+
+    std::array<std::array<Int32, nb_bucket>, nb_pass> counts = {};
+    for (Int32 i = 0; i < nb_item; ++i) {
+      UnsignedType u = Traits::toRadix(keys_in[i]);
+      keys1[i] = u;
+      if constexpr (HasValues)
+        indexes1[i] = i;
+      for (Int32 p = 0; p < nb_pass; ++p)
+        ++counts[p][(u >> (p * 8)) & 0xFF];
+    }
+
+    UnsignedType* current_keys = keys1.data();
+    UnsignedType* next_keys = keys2.data();
+    Int32* current_indexes = indexes1.data();
+    Int32* next_indexes = indexes2.data();
+    for (Int32 p = 0; p < nb_pass; ++p) {
+      const Int32 shift = p * 8;
+      std::array<Int32, nb_bucket>& pass_counts = counts[p];
+      // Si toutes les clés ont le même chiffre, la passe ne change rien.
+      if (pass_counts[(current_keys[0] >> shift) & 0xFF] == nb_item)
+        continue;
+      Int32 offset = 0;
+      for (Int32 b = 0; b < nb_bucket; ++b) {
+        Int32 n = pass_counts[b];
+        pass_counts[b] = offset;
+        offset += n;
+      }
+      for (Int32 i = 0; i < nb_item; ++i) {
+        UnsignedType u = current_keys[i];
+        Int32 pos = pass_counts[(u >> shift) & 0xFF]++;
+        next_keys[pos] = u;
+        if constexpr (HasValues)
+          next_indexes[pos] = current_indexes[i];
+      }
+      std::swap(current_keys, next_keys);
+      if constexpr (HasValues)
+        std::swap(current_indexes, next_indexes);
+    }
+
+    for (Int32 i = 0; i < nb_item; ++i) {
+      keys_out[i] = Traits::fromRadix(current_keys[i]);
+      if constexpr (HasValues)
+        values_out[i] = values_in[current_indexes[i]];
+    }
+  }
+};
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*!
+ * \internal
+ * \brief Classe de base pour effectuer un tri.
+ *
+ * Conserve la mémoire temporaire nécessaire à l'algorithme pour pouvoir
+ * la réutiliser entre deux appels.
+ */
+class ARCANE_ACCELERATOR_EXPORT GenericSorterBase
+{
+  friend class GenericSorterImpl;
+
+ public:
+
+  explicit GenericSorterBase(const RunQueue& queue);
+
+ protected:
+
+  RunQueue m_queue;
+  GenericDeviceStorage m_algo_storage;
+};
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*!
+ * \internal
+ * \brief Classe pour effectuer un tri par base de clés ou de couples clé/valeur.
+ */
+class GenericSorterImpl
+{
+ public:
+
+  template <bool HasValues, typename KeyType, typename ValueType>
+  void apply(GenericSorterBase& s, Int32 nb_item, const KeyType* keys_in, KeyType* keys_out,
+             const ValueType* values_in, ValueType* values_out, const TraceInfo& trace_info)
+  {
+    RunQueue& queue = s.m_queue;
+    RunCommand command = makeCommand(queue);
+    command << trace_info;
+    impl::RunCommandLaunchInfo launch_info(command, nb_item);
+    launch_info.beginExecute();
+    eExecutionPolicy exec_policy = queue.executionPolicy();
+    [[maybe_unused]] constexpr int end_bit = sizeof(KeyType) * 8;
+    switch (exec_policy) {
+#if defined(ARCANE_COMPILING_CUDA)
+    case eExecutionPolicy::CUDA: {
+      size_t temp_storage_size = 0;
+      cudaStream_t stream = impl::CudaUtils::toNativeStream(&queue);
+      // Premier appel pour connaitre la taille pour l'allocation
+      if constexpr (HasValues)
+        ARCANE_CHECK_CUDA(::cub::DeviceRadixSort::SortPairs(nullptr, temp_storage_size,
+                                                            keys_in, keys_out, values_in, values_out,
+                                                            nb_item, 0, end_bit, stream));
+      else
+        ARCANE_CHECK_CUDA(::cub::DeviceRadixSort::SortKeys(nullptr, temp_storage_size,
+                                                           keys_in, keys_out, nb_item, 0, end_bit, stream));
+      void* temp_storage = s.m_algo_storage.allocate(temp_storage_size);
+      if constexpr (HasValues)
+        ARCANE_CHECK_CUDA(::cub::DeviceRadixSort::SortPairs(temp_storage, temp_storage_size,
+                                                            keys_in, keys_out, values_in, values_out,
+                                                            nb_item, 0, end_bit, stream));
+      else
+        ARCANE_CHECK_CUDA(::cub::DeviceRadixSort::SortKeys(temp_storage, temp_storage_size,
+                                                           keys_in, keys_out, nb_item, 0, end_bit, stream));
+    } break;
+#endif
+#if defined(ARCANE_COMPILING_HIP)
+    case eExecutionPolicy::HIP: {
+      size_t temp_storage_size = 0;
+      // Premier appel pour connaitre la taille pour l'allocation
+      hipStream_t stream = impl::HipUtils::toNativeStream(&queue);
+      if constexpr (HasValues)
+        ARCANE_CHECK_HIP(rocprim::radix_sort_pairs(nullptr, temp_storage_size, keys_in, keys_out,
+                                                   values_in, values_out, nb_item, 0, end_bit, stream));
+      else
+        ARCANE_CHECK_HIP(rocprim::radix_sort_keys(nullptr, temp_storage_size, keys_in, keys_out,
+                                                  nb_item, 0, end_bit, stream));
+      void* temp_storage = s.m_algo_storage.allocate(temp_storage_size);
+      if constexpr (HasValues)
+        ARCANE_CHECK_HIP(rocprim::radix_sort_pairs(temp_storage, temp_storage_size, keys_in, keys_out,
+                                                   values_in, values_out, nb_item, 0, end_bit, stream));
+      else
+        ARCANE_CHECK_HIP(rocprim::radix_sort_keys(temp_storage, temp_storage_size, keys_in, keys_out,
+                                                  nb_item, 0, end_bit, stream));
+    } break;
+#endif
+#if defined(ARCANE_COMPILING_SYCL)
+    case eExecutionPolicy::SYCL: {
+#if defined(ARCANE_USE_SCAN_ONEDPL) && defined(__INTEL_LLVM_COMPILER)
+      sycl::queue true_queue = impl::SyclUtils::toNativeStream(&queue);
+      auto policy = oneapi::dpl::execution::make_device_policy(true_queue);
+      oneapi::dpl::copy(policy, keys_in, keys_in + nb_item, keys_out);
+      if constexpr (HasValues) {
+        oneapi::dpl::copy(policy, values_in, values_in + nb_item, values_out);
+        oneapi::dpl::stable_sort_by_key(policy, keys_out, keys_out + nb_item, values_out);
+      }
+      else
+        oneapi::dpl::stable_sort(policy, keys_out, keys_out + nb_item);
+#else
+      // Pas encore d'implémentation native: on trie sur l'hôte
+      // (la mémoire doit donc être accessible depuis l'hôte).
+      queue.barrier();
+      HostRadixSorter::apply<HasValues>(nb_item, keys_in, keys_out, values_in, values_out);
+#endif
+    } break;
+#endif
+    case eExecutionPolicy::Thread:
+      // Pas encore implémenté en multi-thread
+      [[fallthrough]];
+    case eExecutionPolicy::Sequential: {
+      HostRadixSorter::apply<HasValues>(nb_item, keys_in, keys_out, values_in, values_out);
+    } break;
+    default:
+      ARCANE_FATAL(getBadPolicyMessage(exec_policy));
+    }
+    launch_info.endExecute();
+  }
+};
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+} // namespace Arcane::Accelerator::impl
+
+namespace Arcane::Accelerator
+{
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*!
+ * \brief Algorithme générique de tri par base sur accélérateur.
+ *
+ * Les types de clé supportés sont les types entiers (hors `bool`) et les
+ * types flottants. Le tri est stable et se fait dans l'ordre croissant des clés.
+ *
+ * Les valeurs en entrée et en sortie ne doivent pas se chevaucher.
+ *
+ * Les instances de cette classe conservent la mémoire temporaire utilisée par
+ * l'algorithme. Il est donc préférable de garder une instance si on effectue
+ * plusieurs tris sur la même file.
+ *
+ * \code
+ * Arcane::Accelerator::RunQueue queue = ...;
+ * SmallSpan<const Int64> keys = ...;
+ * SmallSpan<const Int32> values = ...;
+ * SmallSpan<Int64> sorted_keys = ...;
+ * SmallSpan<Int32> sorted_values = ...;
+ * Arcane::Accelerator::GenericSorter sorter(queue);
+ * sorter.applyPairs(keys, sorted_keys, values, sorted_values);
+ * \endcode
+ *
+ * Comme pour les autres algorithmes, l'appel peut être asynchrone si la file
+ * associée l'est.
+ */
+class GenericSorter
+: private impl::GenericSorterBase
+{
+ public:
+
+  explicit GenericSorter(const RunQueue& queue)
+  : impl::GenericSorterBase(queue)
+  {}
+
+ public:
+
+  /*!
+   * \brief Trie les clés de \a input_keys et range le résultat dans \a output_keys.
+   *
+   * \a input_keys et \a output_keys doivent avoir la même taille.
+   */
+  template <typename KeyType>
+  void applyKeys(SmallSpan<const KeyType> input_keys, SmallSpan<KeyType> output_keys,
+                 const TraceInfo& trace_info = TraceInfo())
+  {
+    _checkKeyType<KeyType>();
+    const Int32 nb_item = input_keys.size();
+    if (output_keys.size() != nb_item)
+      ARCANE_FATAL("Sizes are not equals: input_keys={0} output_keys={1}", nb_item, output_keys.size());
+    if (nb_item == 0)
+      return;
+    impl::GenericSorterImpl gs;
+    gs.apply<false>(*this, nb_item, input_keys.data(), output_keys.data(),
+                    static_cast<const KeyType*>(nullptr), static_cast<KeyType*>(nullptr), trace_info);
+  }
+
+  /*!
+   * \brief Trie les couples (clé,valeur) suivant la valeur de la clé.
+   *
+   * Les clés triées sont rangées dans \a output_keys et les valeurs associées
+   * dans \a output_values. Tous les tableaux doivent avoir la même taille.
+   */
+  template <typename KeyType, typename ValueType>
+  void applyPairs(SmallSpan<const KeyType> input_keys, SmallSpan<KeyType> output_keys,
+                  SmallSpan<const ValueType> input_values, SmallSpan<ValueType> output_values,
+                  const TraceInfo& trace_info = TraceInfo())
+  {
+    _checkKeyType<KeyType>();
+    const Int32 nb_item = input_keys.size();
+    if (output_keys.size() != nb_item)
+      ARCANE_FATAL("Sizes are not equals: input_keys={0} output_keys={1}", nb_item, output_keys.size());
+    if (input_values.size() != nb_item)
+      ARCANE_FATAL("Sizes are not equals: input_keys={0} input_values={1}", nb_item, input_values.size());
+    if (output_values.size() != nb_item)
+      ARCANE_FATAL("Sizes are not equals: input_keys={0} output_values={1}", nb_item, output_values.size());
+    if (nb_item == 0)
+      return;
+    impl::GenericSorterImpl gs;
+    gs.apply<true>(*this, nb_item, input_keys.data(), output_keys.data(),
+                   input_values.data(), output_values.data(), trace_info);
+  }
+
+ private:
+
+  template <typename KeyType> static constexpr void _checkKeyType()
+  {
+    static_assert((std::is_integral_v<KeyType> && !std::is_same_v<KeyType, bool>) || std::is_floating_point_v<KeyType>,
+                  "Only integral or floating point types are supported as keys");
+  }
+};
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+} // namespace Arcane::Accelerator
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+#endif
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
@@ -13,10 +13,17 @@
 
 #include "arcane/accelerator/VariableViews.h"
 
+#include "arcane/utils/Profiling.h"
+#include "arcane/utils/MemoryView.h"
+
+#include "arcane/accelerator/core/ViewBuildInfo.h"
 #include "arcane/accelerator/core/RunCommand.h"
 #include "arcane/accelerator/core/RunQueue.h"
 
 #include "arcane/core/VariableUtils.h"
+#include "arcane/core/IData.h"
+#include "arcane/core/IVariable.h"
+#include "arcane/core/internal/IDataInternal.h"
 
 /*---------------------------------------------------------------------------*/
 /*---------------------------------------------------------------------------*/
@@ -41,6 +48,13 @@ VariableViewBase(const ViewBuildInfo& vbi, IVariable* var)
   const RunQueue& q = vbi.queue();
   if (q._isAutoPrefetchCommand())
     VariableUtils::prefetchVariableAsync(var, &q);
+  // Pour le profiling, conserve le nombre d'octets de la variable pour
+  // pouvoir estimer la bande passante mémoire de la commande.
+  if (ProfilingRegistry::hasProfiling() && var->isUsed()) {
+    INumericDataInternal* nd = var->data()->_commonInternal()->numericData();
+    if (nd)
+      vbi._internalAddNbByte(nd->memoryView().bytes().size());
+  }
 }
 
 /*---------------------------------------------------------------------------*/
@@ -15,6 +15,7 @@
 
 #include "arcane/accelerator/core/internal/AcceleratorCoreGlobalInternal.h"
 #include "arcane/accelerator/core/internal/IRunnerRuntime.h"
+#include "arcane/accelerator/core/internal/RunCommandImpl.h"
 
 #include "arcane/accelerator/core/DeviceInfoList.h"
 #include "arcane/accelerator/core/PointerAttribute.h"
@@ -313,12 +314,23 @@ operator<<(std::ostream& o, const PointerAttribute& a)
 ViewBuildInfo::
 ViewBuildInfo(RunCommand& command)
 : m_queue(command._internalQueue())
+, m_command(&command)
 {
 }
 
 /*---------------------------------------------------------------------------*/
 /*---------------------------------------------------------------------------*/
 
+void ViewBuildInfo::
+_internalAddNbByte(Int64 nb_byte) const
+{
+  if (m_command)
+    m_command->m_p->addNbByte(nb_byte);
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
 } // namespace Arcane::Accelerator
 
 /*---------------------------------------------------------------------------*/
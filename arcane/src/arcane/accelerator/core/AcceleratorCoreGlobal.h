@@ -48,6 +48,7 @@ class RunQueue;
 class RunQueuePool;
 class RunCommand;
 class RunQueueEvent;
+class RunQueueGraph;
 class AcceleratorRuntimeInitialisationInfo;
 class RunQueueBuildInfo;
 class MemoryCopyArgs;
@@ -72,6 +73,7 @@ namespace impl
   class ReduceMemoryImpl;
   class RunQueueImpl;
   class IRunQueueEventImpl;
+  class IRunQueueGraphImpl;
   class RunCommandLaunchInfo;
   class RunnerImpl;
   class RunQueueImplStack;
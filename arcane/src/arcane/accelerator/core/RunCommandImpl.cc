@@ -120,6 +120,10 @@ notifyBeginLaunchKernel()
 {
   IRunQueueStream* stream = internalStream();
   stream->notifyBeginLaunchKernel(*this);
+  // Lors d'une capture, la commande n'est pas exécutée. Il n'est donc pas
+  // possible de mesurer son temps d'exécution.
+  if (m_queue->_isCapturing())
+    return;
   // TODO: utiliser la bonne stream en séquentiel
   m_start_event->recordQueue(stream);
   m_has_been_launched = true;
@@ -127,6 +131,7 @@ notifyBeginLaunchKernel()
     m_begin_time = platform::getRealTimeNS();
     m_loop_one_exec_stat_ptr = &m_loop_one_exec_stat;
     m_loop_one_exec_stat.setBeginTime(m_begin_time);
+    m_loop_one_exec_stat.setNbByte(m_nb_byte);
   }
 }
 
@@ -142,7 +147,8 @@ notifyEndLaunchKernel()
 {
   IRunQueueStream* stream = internalStream();
   // TODO: utiliser la bonne stream en séquentiel
-  m_stop_event->recordQueue(stream);
+  if (!m_queue->_isCapturing())
+    m_stop_event->recordQueue(stream);
   stream->notifyEndLaunchKernel(*this);
 }
 
@@ -179,8 +185,10 @@ void RunCommandImpl::
 notifyEndExecuteKernel()
 {
   // Ne fait rien si la commande n'a pas été lancée.
-  if (!m_has_been_launched)
+  if (!m_has_been_launched) {
+    m_nb_byte = 0;
     return;
+  }
 
   Int64 diff_time_ns = m_stop_event->elapsedTime(m_start_event);
 
@@ -208,6 +216,7 @@ _reset()
   m_nb_thread_per_block = 0;
   m_parallel_loop_options = TaskFactory::defaultParallelLoopOptions();
   m_begin_time = 0;
+  m_nb_byte = 0;
   m_loop_one_exec_stat.reset();
   m_loop_one_exec_stat_ptr = nullptr;
   m_has_been_launched = false;
@@ -219,6 +228,10 @@ _reset()
 IReduceMemoryImpl* RunCommandImpl::
 getOrCreateReduceMemoryImpl()
 {
+  // Les réductions nécessitent de récupérer la valeur sur l'hôte à la fin
+  // de la commande, ce qui n'est pas possible si la commande est capturée.
+  if (m_queue->_isCapturing())
+    ARCANE_FATAL("Reductions are not allowed in commands of a RunQueue during capture");
   ReduceMemoryImpl* p = _getOrCreateReduceMemoryImpl();
   if (p) {
     m_active_reduce_memory_list.insert(p);
@@ -21,6 +21,8 @@
 #include "arcane/accelerator/core/internal/IRunQueueStream.h"
 #include "arcane/accelerator/core/RunQueueEvent.h"
 #include "arcane/accelerator/core/internal/IRunQueueEventImpl.h"
+#include "arcane/accelerator/core/RunQueueGraph.h"
+#include "arcane/accelerator/core/internal/IRunQueueGraphImpl.h"
 #include "arcane/accelerator/core/Memory.h"
 #include "arcane/accelerator/core/internal/RunQueueImpl.h"
 #include "arcane/accelerator/core/internal/RunnerImpl.h"
@@ -123,8 +125,11 @@ _checkNotNull() const
 void RunQueue::
 barrier() const
 {
-  if (m_p)
+  if (m_p) {
+    if (m_p->_isCapturing())
+      ARCANE_FATAL("barrier() is not allowed during capture");
     m_p->_internalBarrier();
+  }
 }
 
 /*---------------------------------------------------------------------------*/
@@ -265,6 +270,75 @@ isAsync() const
 /*---------------------------------------------------------------------------*/
 /*---------------------------------------------------------------------------*/
 
+void RunQueue::
+beginCapture()
+{
+  _checkNotNull();
+  if (m_p->_isCapturing())
+    ARCANE_FATAL("beginCapture() has already been called");
+  // Attend la fin des commandes en cours pour qu'elles ne fassent
+  // pas partie de la capture.
+  m_p->_internalBarrier();
+  _internalStream()->beginCapture();
+  m_p->m_is_capturing = true;
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+Ref<RunQueueGraph> RunQueue::
+endCapture()
+{
+  _checkNotNull();
+  if (!m_p->_isCapturing())
+    ARCANE_FATAL("endCapture() called without beginCapture()");
+  m_p->m_is_capturing = false;
+  impl::IRunQueueGraphImpl* graph_impl = _internalStream()->endCapture();
+  // Les commandes capturées n'ont pas été exécutées. On peut donc les
+  // recycler directement.
+  m_p->_internalFreeRunningCommands();
+  return makeRef(new RunQueueGraph(graph_impl));
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+bool RunQueue::
+isCapturing() const
+{
+  if (m_p)
+    return m_p->_isCapturing();
+  return false;
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+void RunQueue::
+launchGraph(RunQueueGraph& graph)
+{
+  _checkNotNull();
+  if (m_p->_isCapturing())
+    ARCANE_FATAL("Can not launch a graph during capture");
+  graph._internalImpl()->launch(_internalStream());
+  ++graph.m_nb_launch;
+  if (!isAsync())
+    barrier();
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+void RunQueue::
+launchGraph(Ref<RunQueueGraph>& graph)
+{
+  _checkNotNull();
+  launchGraph(*graph.get());
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
 bool RunQueue::
 _isAutoPrefetchCommand() const
 {
@@ -174,6 +174,45 @@ class ARCANE_ACCELERATOR_CORE_EXPORT RunQueue
   eMemoryRessource memoryRessource() const;
   //!@}
 
+  /*!
+   * \name Capture des commandes
+   *
+   * Ces méthodes permettent d'enregistrer une suite de commandes pour
+   * pouvoir la rejouer plusieurs fois à moindre coût:
+   *
+   * \code
+   * RunQueue queue = ...;
+   * queue.beginCapture();
+   * {
+   *   auto command = makeCommand(queue);
+   *   command << RUNCOMMAND_ENUMERATE(Cell, vi, allCells()) { ... };
+   * }
+   * // ... autres commandes
+   * Ref<RunQueueGraph> graph = queue.endCapture();
+   * for (Int32 i = 0; i < nb_iteration; ++i)
+   *   queue.launchGraph(graph);
+   * queue.barrier();
+   * \endcode
+   *
+   * Pendant la capture, les commandes ne sont pas exécutées et il n'est pas
+   * possible d'appeler barrier() ni d'utiliser des réductions.
+   *
+   * \warning API en cours de définition.
+   * \pre !isNull()
+   */
+  //!@{
+  //! Débute la capture des commandes de la file.
+  void beginCapture();
+  //! Termine la capture et retourne le graphe des commandes capturées.
+  Ref<RunQueueGraph> endCapture();
+  //! Indique si la file est en cours de capture.
+  bool isCapturing() const;
+  //! Lance l'exécution des commandes du graphe \a graph sur cette file.
+  void launchGraph(RunQueueGraph& graph);
+  //! Lance l'exécution des commandes du graphe \a graph sur cette file.
+  void launchGraph(Ref<RunQueueGraph>& graph);
+  //!@}
+
  public:
 
   /*!
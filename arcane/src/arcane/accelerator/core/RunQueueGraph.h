@@ -0,0 +1,88 @@
+﻿// -*- tab-width: 2; indent-tabs-mode: nil; coding: utf-8-with-signature -*-
+//-----------------------------------------------------------------------------
+// Copyright 2000-2024 CEA (www.cea.fr) IFPEN (www.ifpenergiesnouvelles.com)
+// See the top-level COPYRIGHT file for details.
+// SPDX-License-Identifier: Apache-2.0
+//-----------------------------------------------------------------------------
+/*---------------------------------------------------------------------------*/
+/* RunQueueGraph.h                                             (C) 2000-2024 */
+/*                                                                           */
+/* Graphe de commandes d'une file d'exécution.                               */
+/*---------------------------------------------------------------------------*/
+#ifndef ARCANE_ACCELERATOR_CORE_RUNQUEUEGRAPH_H
+#define ARCANE_ACCELERATOR_CORE_RUNQUEUEGRAPH_H
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+#include "arcane/utils/Ref.h"
+
+#include "arcane/accelerator/core/AcceleratorCoreGlobal.h"
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+namespace Arcane::Accelerator
+{
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*!
+ * \brief Graphe de commandes capturées sur une file d'exécution.
+ * \warning API en cours de définition.
+ *
+ * Une instance de cette classe est retournée par RunQueue::endCapture() et
+ * contient la liste des commandes lancées sur la file entre les appels à
+ * RunQueue::beginCapture() et RunQueue::endCapture(). Le graphe peut ensuite
+ * être rejoué autant de fois que nécessaire via RunQueue::launchGraph().
+ *
+ * Avec CUDA ou HIP, le graphe correspond à un graphe natif (cudaGraphExec_t
+ * ou hipGraphExec_t). Pour les politiques d'exécution sur l'hôte, il s'agit
+ * de la liste des commandes dont les paramètres d'exécution ont déjà été
+ * calculés lors de la capture.
+ *
+ * Les arguments des commandes (les vues et les valeurs capturées par les
+ * lambdas) sont figés lors de la capture. Il faut donc que les zones mémoire
+ * référencées restent valides et que les groupes d'entités utilisés dans les
+ * commandes ne soient pas modifiés tant que le graphe est utilisé.
+ */
+class ARCANE_ACCELERATOR_CORE_EXPORT RunQueueGraph
+{
+  friend class RunQueue;
+
+ private:
+
+  explicit RunQueueGraph(impl::IRunQueueGraphImpl* p);
+
+ public:
+
+  ~RunQueueGraph();
+  RunQueueGraph(const RunQueueGraph&) = delete;
+  RunQueueGraph& operator=(const RunQueueGraph&) = delete;
+
+ public:
+
+  //! Nombre de commandes (ou de noeuds pour les accélérateurs) du graphe
+  Int32 nbCommand() const;
+
+  //! Nombre de fois où le graphe a été lancé
+  Int64 nbLaunch() const { return m_nb_launch; }
+
+ private:
+
+  impl::IRunQueueGraphImpl* _internalImpl() const { return m_p; }
+
+ private:
+
+  impl::IRunQueueGraphImpl* m_p = nullptr;
+  Int64 m_nb_launch = 0;
+};
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+} // End namespace Arcane::Accelerator
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+#endif
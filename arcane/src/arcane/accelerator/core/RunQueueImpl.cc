@@ -20,6 +20,7 @@
 #include "arcane/accelerator/core/RunQueueBuildInfo.h"
 #include "arcane/accelerator/core/internal/IRunnerRuntime.h"
 #include "arcane/accelerator/core/internal/IRunQueueStream.h"
+#include "arcane/accelerator/core/internal/IRunQueueGraphImpl.h"
 #include "arcane/accelerator/core/DeviceId.h"
 #include "arcane/accelerator/core/internal/RunCommandImpl.h"
 #include "arcane/accelerator/core/internal/RunnerImpl.h"
@@ -70,6 +71,12 @@ _release()
   // les commandes ne seront pas désallouées.
   // TODO: Regarder s'il ne faudrait pas plutôt indiquer cela à l'utilisateur
   // ou faire une erreur fatale.
+  // Si une capture est en cours, on la termine et on détruit le graphe associé.
+  if (m_is_capturing) {
+    m_is_capturing = false;
+    delete m_queue_stream->endCapture();
+    _internalFreeRunningCommands();
+  }
   if (!m_active_run_command_list.empty()) {
     if (!_internalStream()->_barrierNoException()) {
       _internalFreeRunningCommands();
@@ -189,6 +196,7 @@ RunQueueImpl* RunQueueImpl::
 _reset(RunQueueImpl* p)
 {
   p->m_is_async = false;
+  p->m_is_capturing = false;
   p->_setDefaultMemoryRessource();
   return p;
 }
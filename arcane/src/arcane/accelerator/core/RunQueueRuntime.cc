@@ -14,6 +14,7 @@
 #include "arcane/accelerator/core/internal/IRunnerRuntime.h"
 #include "arcane/accelerator/core/internal/IRunQueueStream.h"
 #include "arcane/accelerator/core/internal/IRunQueueEventImpl.h"
+#include "arcane/accelerator/core/internal/IRunQueueGraphImpl.h"
 #include "arcane/accelerator/core/Memory.h"
 #include "arcane/accelerator/core/DeviceInfoList.h"
 
@@ -21,6 +22,7 @@
 #include "arcane/utils/MemoryView.h"
 #include "arcane/utils/PlatformUtils.h"
 #include "arcane/utils/FatalErrorException.h"
+#include "arcane/utils/Array.h"
 
 #include <cstring>
 
@@ -33,6 +35,37 @@ namespace Arcane::Accelerator::impl
 /*---------------------------------------------------------------------------*/
 /*---------------------------------------------------------------------------*/
 
+/*!
+ * \brief Graphe de commandes pour les politiques d'exécution sur l'hôte.
+ *
+ * Le graphe est la liste des fonctions enregistrées lors de la capture.
+ * Les paramètres des boucles (bornes, options de parallélisation) ont
+ * déjà été calculés et il suffit donc d'appeler ces fonctions dans l'ordre.
+ */
+class HostRunQueueGraph
+: public IRunQueueGraphImpl
+{
+ public:
+
+  void launch(IRunQueueStream*) override
+  {
+    for (const auto& f : m_commands)
+      f();
+  }
+  Int32 nbCommand() const override { return m_commands.size(); }
+
+ public:
+
+  void addCommand(const std::function<void()>& f) { m_commands.add(f); }
+
+ private:
+
+  UniqueArray<std::function<void()>> m_commands;
+};
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
 class ARCANE_ACCELERATOR_CORE_EXPORT HostRunQueueStream
 : public IRunQueueStream
 {
@@ -41,6 +74,10 @@ class ARCANE_ACCELERATOR_CORE_EXPORT HostRunQueueStream
   HostRunQueueStream(IRunnerRuntime* runtime)
   : m_runtime(runtime)
   {}
+  ~HostRunQueueStream() override
+  {
+    delete m_capture_graph;
+  }
 
  public:
 
@@ -49,15 +86,43 @@ class ARCANE_ACCELERATOR_CORE_EXPORT HostRunQueueStream
   void barrier() override { return m_runtime->barrier(); }
   void copyMemory(const MemoryCopyArgs& args) override
   {
+    if (m_capture_graph) {
+      MutableMemoryView destination = args.destination();
+      ConstMemoryView source = args.source();
+      m_capture_graph->addCommand([=]() { destination.copyHost(source); });
+      return;
+    }
     args.destination().copyHost(args.source());
   }
   void prefetchMemory(const MemoryPrefetchArgs&) override {}
+  void beginCapture() override
+  {
+    if (m_capture_graph)
+      ARCANE_FATAL("Capture has already begun");
+    m_capture_graph = new HostRunQueueGraph();
+  }
+  IRunQueueGraphImpl* endCapture() override
+  {
+    if (!m_capture_graph)
+      ARCANE_FATAL("No capture in progress");
+    IRunQueueGraphImpl* g = m_capture_graph;
+    m_capture_graph = nullptr;
+    return g;
+  }
   void* _internalImpl() override { return nullptr; }
   bool _barrierNoException() override { return false; }
+  bool _addCapturedHostCommand(const std::function<void()>& func) override
+  {
+    if (!m_capture_graph)
+      return false;
+    m_capture_graph->addCommand(func);
+    return true;
+  }
 
  private:
 
   IRunnerRuntime* m_runtime;
+  HostRunQueueGraph* m_capture_graph = nullptr;
 };
 
 /*---------------------------------------------------------------------------*/
@@ -50,9 +50,21 @@ class ARCANE_ACCELERATOR_CORE_EXPORT ViewBuildInfo
 
   const RunQueue& queue() const { return m_queue; }
 
+ public:
+
+  /*!
+   * \internal
+   * \brief Ajoute \a nb_byte au nombre d'octets accédés par la commande.
+   *
+   * Ne fait rien si l'instance n'est pas associée à une commande.
+   * Cette information est utilisée uniquement pour le profiling.
+   */
+  void _internalAddNbByte(Int64 nb_byte) const;
+
  private:
 
   const RunQueue& m_queue;
+  RunCommand* m_command = nullptr;
 };
 
 /*---------------------------------------------------------------------------*/
@@ -0,0 +1,57 @@
+﻿// -*- tab-width: 2; indent-tabs-mode: nil; coding: utf-8-with-signature -*-
+//-----------------------------------------------------------------------------
+// Copyright 2000-2024 CEA (www.cea.fr) IFPEN (www.ifpenergiesnouvelles.com)
+// See the top-level COPYRIGHT file for details.
+// SPDX-License-Identifier: Apache-2.0
+//-----------------------------------------------------------------------------
+/*---------------------------------------------------------------------------*/
+/* IRunQueueGraphImpl.h                                        (C) 2000-2024 */
+/*                                                                           */
+/* Interface de l'implémentation d'un graphe de commandes.                   */
+/*---------------------------------------------------------------------------*/
+#ifndef ARCANE_ACCELERATOR_IRUNQUEUEGRAPHIMPL_H
+#define ARCANE_ACCELERATOR_IRUNQUEUEGRAPHIMPL_H
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+#include "arcane/accelerator/core/AcceleratorCoreGlobal.h"
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+namespace Arcane::Accelerator::impl
+{
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*!
+ * \internal
+ * \brief Interface de l'implémentation d'un graphe de commandes.
+ *
+ * Les instances de cette interface sont créées par
+ * IRunQueueStream::endCapture().
+ */
+class ARCANE_ACCELERATOR_CORE_EXPORT IRunQueueGraphImpl
+{
+ public:
+
+  virtual ~IRunQueueGraphImpl() = default;
+
+ public:
+
+  //! Lance l'exécution des commandes du graphe sur le flux \a stream.
+  virtual void launch(IRunQueueStream* stream) = 0;
+
+  //! Nombre de commandes (ou de noeuds) du graphe
+  virtual Int32 nbCommand() const = 0;
+};
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+} // namespace Arcane::Accelerator::impl
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+#endif
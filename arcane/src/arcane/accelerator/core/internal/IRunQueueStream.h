@@ -16,6 +16,8 @@
 
 #include "arcane/accelerator/core/AcceleratorCoreGlobal.h"
 
+#include <functional>
+
 /*---------------------------------------------------------------------------*/
 /*---------------------------------------------------------------------------*/
 
@@ -61,6 +63,22 @@ class ARCANE_ACCELERATOR_CORE_EXPORT IRunQueueStream
   //! Effectue un pré-chargement d'une zone mémoire
   virtual void prefetchMemory(const MemoryPrefetchArgs& args) = 0;
 
+  /*!
+   * \brief Débute la capture des commandes.
+   *
+   * Jusqu'à l'appel à endCapture(), les commandes et les copies mémoire
+   * ne sont pas exécutées mais enregistrées.
+   */
+  virtual void beginCapture() = 0;
+
+  /*!
+   * \brief Termine la capture des commandes.
+   *
+   * Retourne le graphe contenant les commandes enregistrées depuis
+   * l'appel à beginCapture(). L'appelant devient propriétaire de l'instance.
+   */
+  virtual IRunQueueGraphImpl* endCapture() = 0;
+
  public:
 
   //! Pointeur sur la structure interne dépendante de l'implémentation
@@ -71,6 +89,13 @@ class ARCANE_ACCELERATOR_CORE_EXPORT IRunQueueStream
 
   //! Pour SYCL, positionne l'évènement associé à la dernière commande exécutée.
   virtual void _setSyclLastCommandEvent([[maybe_unused]] void* sycl_event_ptr) {}
+  /*!
+   * \brief Ajoute la fonction \a func à la capture en cours.
+   *
+   * Cette méthode n'est utilisée que pour les politiques d'exécution sur l'hôte.
+   * Retourne \a false si le flux ne supporte pas cette opération.
+   */
+  virtual bool _addCapturedHostCommand([[maybe_unused]] const std::function<void()>& func) { return false; }
 };
 
 /*---------------------------------------------------------------------------*/
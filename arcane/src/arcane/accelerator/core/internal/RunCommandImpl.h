@@ -62,6 +62,9 @@ class RunCommandImpl
   void notifyEndExecuteKernel();
   impl::IReduceMemoryImpl* getOrCreateReduceMemoryImpl();
 
+  //! Ajoute \a nb_byte au nombre d'octets accédés par la commande
+  void addNbByte(Int64 nb_byte) { m_nb_byte += nb_byte; }
+
   void releaseReduceMemoryImpl(ReduceMemoryImpl* p);
   IRunQueueStream* internalStream() const;
   RunnerImpl* runner() const;
@@ -104,6 +107,9 @@ class RunCommandImpl
   //! Temps au lancement de la commande
   Int64 m_begin_time = 0;
 
+  //! Nombre d'octets des vues créées pour la commande
+  Int64 m_nb_byte = 0;
+
   ForLoopOneExecStat m_loop_one_exec_stat;
   ForLoopOneExecStat* m_loop_one_exec_stat_ptr = nullptr;
 
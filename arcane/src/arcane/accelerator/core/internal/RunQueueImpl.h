@@ -89,6 +89,7 @@ class ARCANE_ACCELERATOR_CORE_EXPORT RunQueueImpl
   void _internalFreeRunningCommands();
   void _internalBarrier();
   bool _isInPool() const { return m_is_in_pool; }
+  bool _isCapturing() const { return m_is_capturing; }
   void _release();
   void _setDefaultMemoryRessource();
   static RunQueueImpl* _reset(RunQueueImpl* p);
@@ -111,6 +112,8 @@ class ARCANE_ACCELERATOR_CORE_EXPORT RunQueueImpl
   std::atomic<Int32> m_nb_ref = 0;
   //! Indique si la file est asynchrone
   bool m_is_async = false;
+  //! Indique si la file est en cours de capture
+  bool m_is_capturing = false;
   //! Ressource mémoire par défaut
   eMemoryRessource m_memory_ressource = eMemoryRessource::Unknown;
 };
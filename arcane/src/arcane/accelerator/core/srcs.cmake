@@ -26,6 +26,8 @@ set( ARCANE_SOURCES
   RunQueueBuildInfo.h
   RunQueueEvent.h
   RunQueueEvent.cc
+  RunQueueGraph.h
+  RunQueueGraph.cc
   RunQueueImpl.h
   RunQueueImpl.cc
   RunQueuePool.h
@@ -36,6 +38,7 @@ set( ARCANE_SOURCES
   internal/AcceleratorCoreGlobalInternal.h
   internal/IRunQueueStream.h
   internal/IRunQueueEventImpl.h
+  internal/IRunQueueGraphImpl.h
   internal/MemoryTracer.h
   internal/RunCommandImpl.h
   internal/RunQueueImpl.h
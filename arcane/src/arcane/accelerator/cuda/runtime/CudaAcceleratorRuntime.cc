@@ -34,6 +34,7 @@
 #include "arcane/accelerator/core/internal/RunCommandImpl.h"
 #include "arcane/accelerator/core/internal/IRunQueueStream.h"
 #include "arcane/accelerator/core/internal/IRunQueueEventImpl.h"
+#include "arcane/accelerator/core/internal/IRunQueueGraphImpl.h"
 #include "arcane/accelerator/core/PointerAttribute.h"
 #include "arcane/accelerator/core/RunQueue.h"
 #include "arcane/accelerator/cuda/runtime/internal/Cupti.h"
@@ -92,6 +93,49 @@ void _printUUID(std::ostream& o, char bytes[16])
   }
 }
 
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*!
+ * \brief Graphe de commandes CUDA.
+ *
+ * Le graphe est instancié lors de la construction pour que les appels
+ * à launch() soient le moins coûteux possible.
+ */
+class CudaRunQueueGraph
+: public impl::IRunQueueGraphImpl
+{
+ public:
+
+  explicit CudaRunQueueGraph(cudaGraph_t graph)
+  : m_graph(graph)
+  {
+    ARCANE_CHECK_CUDA(cudaGraphInstantiateWithFlags(&m_graph_exec, m_graph, 0));
+    size_t nb_node = 0;
+    ARCANE_CHECK_CUDA(cudaGraphGetNodes(m_graph, nullptr, &nb_node));
+    m_nb_node = static_cast<Int32>(nb_node);
+  }
+  ~CudaRunQueueGraph() override
+  {
+    ARCANE_CHECK_CUDA_NOTHROW(cudaGraphExecDestroy(m_graph_exec));
+    ARCANE_CHECK_CUDA_NOTHROW(cudaGraphDestroy(m_graph));
+  }
+
+ public:
+
+  void launch(impl::IRunQueueStream* stream) override
+  {
+    cudaStream_t s = *(static_cast<cudaStream_t*>(stream->_internalImpl()));
+    ARCANE_CHECK_CUDA(cudaGraphLaunch(m_graph_exec, s));
+  }
+  Int32 nbCommand() const override { return m_nb_node; }
+
+ private:
+
+  cudaGraph_t m_graph;
+  cudaGraphExec_t m_graph_exec;
+  Int32 m_nb_node = 0;
+};
+
 /*---------------------------------------------------------------------------*/
 /*---------------------------------------------------------------------------*/
 
@@ -151,7 +195,7 @@ class CudaRunQueueStream
     auto r = cudaMemcpyAsync(args.destination().data(), source_bytes.data(),
                              source_bytes.size(), cudaMemcpyDefault, m_cuda_stream);
     ARCANE_CHECK_CUDA(r);
-    if (!args.isAsync())
+    if (!args.isAsync() && !m_is_capturing)
       barrier();
   }
   void prefetchMemory(const MemoryPrefetchArgs& args) override
@@ -159,6 +203,10 @@ class CudaRunQueueStream
     auto src = args.source().bytes();
     if (src.size() == 0)
       return;
+    // Le préchargement n'est qu'une indication. Il n'est pas
+    // conservé lors d'une capture.
+    if (m_is_capturing)
+      return;
     DeviceId d = args.deviceId();
     int device = cudaCpuDeviceId;
     if (!d.isHost())
@@ -169,6 +217,18 @@ class CudaRunQueueStream
     if (!args.isAsync())
       barrier();
   }
+  void beginCapture() override
+  {
+    ARCANE_CHECK_CUDA(cudaStreamBeginCapture(m_cuda_stream, cudaStreamCaptureModeThreadLocal));
+    m_is_capturing = true;
+  }
+  impl::IRunQueueGraphImpl* endCapture() override
+  {
+    m_is_capturing = false;
+    cudaGraph_t graph = nullptr;
+    ARCANE_CHECK_CUDA(cudaStreamEndCapture(m_cuda_stream, &graph));
+    return new CudaRunQueueGraph(graph);
+  }
   void* _internalImpl() override
   {
     return &m_cuda_stream;
@@ -185,6 +245,7 @@ class CudaRunQueueStream
 
   impl::IRunnerRuntime* m_runtime;
   cudaStream_t m_cuda_stream;
+  bool m_is_capturing = false;
 };
 
 /*---------------------------------------------------------------------------*/
@@ -28,6 +28,7 @@
 #include "arcane/accelerator/core/internal/AcceleratorCoreGlobalInternal.h"
 #include "arcane/accelerator/core/internal/IRunQueueStream.h"
 #include "arcane/accelerator/core/internal/IRunQueueEventImpl.h"
+#include "arcane/accelerator/core/internal/IRunQueueGraphImpl.h"
 #include "arcane/accelerator/core/DeviceInfoList.h"
 #include "arcane/accelerator/core/RunQueue.h"
 #include "arcane/accelerator/core/internal/RunCommandImpl.h"
@@ -43,6 +44,49 @@ using namespace Arccore;
 namespace Arcane::Accelerator::Hip
 {
 
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*!
+ * \brief Graphe de commandes HIP.
+ *
+ * Le graphe est instancié lors de la construction pour que les appels
+ * à launch() soient le moins coûteux possible.
+ */
+class HipRunQueueGraph
+: public impl::IRunQueueGraphImpl
+{
+ public:
+
+  explicit HipRunQueueGraph(hipGraph_t graph)
+  : m_graph(graph)
+  {
+    ARCANE_CHECK_HIP(hipGraphInstantiate(&m_graph_exec, m_graph, nullptr, nullptr, 0));
+    size_t nb_node = 0;
+    ARCANE_CHECK_HIP(hipGraphGetNodes(m_graph, nullptr, &nb_node));
+    m_nb_node = static_cast<Int32>(nb_node);
+  }
+  ~HipRunQueueGraph() override
+  {
+    ARCANE_CHECK_HIP_NOTHROW(hipGraphExecDestroy(m_graph_exec));
+    ARCANE_CHECK_HIP_NOTHROW(hipGraphDestroy(m_graph));
+  }
+
+ public:
+
+  void launch(impl::IRunQueueStream* stream) override
+  {
+    hipStream_t s = *(static_cast<hipStream_t*>(stream->_internalImpl()));
+    ARCANE_CHECK_HIP(hipGraphLaunch(m_graph_exec, s));
+  }
+  Int32 nbCommand() const override { return m_nb_node; }
+
+ private:
+
+  hipGraph_t m_graph;
+  hipGraphExec_t m_graph_exec;
+  Int32 m_nb_node = 0;
+};
+
 /*---------------------------------------------------------------------------*/
 /*---------------------------------------------------------------------------*/
 
@@ -99,7 +143,7 @@ class HipRunQueueStream
     auto r = hipMemcpyAsync(args.destination().data(), args.source().data(),
                             args.source().bytes().size(), hipMemcpyDefault, m_hip_stream);
     ARCANE_CHECK_HIP(r);
-    if (!args.isAsync())
+    if (!args.isAsync() && !m_is_capturing)
       barrier();
   }
   void prefetchMemory(const MemoryPrefetchArgs& args) override
@@ -107,6 +151,10 @@ class HipRunQueueStream
     auto src = args.source().bytes();
     if (src.size()==0)
       return;
+    // Le préchargement n'est qu'une indication. Il n'est pas
+    // conservé lors d'une capture.
+    if (m_is_capturing)
+      return;
     DeviceId d = args.deviceId();
     int device = hipCpuDeviceId;
     if (!d.isHost())
@@ -116,6 +164,18 @@ class HipRunQueueStream
     if (!args.isAsync())
       barrier();
   }
+  void beginCapture() override
+  {
+    ARCANE_CHECK_HIP(hipStreamBeginCapture(m_hip_stream, hipStreamCaptureModeThreadLocal));
+    m_is_capturing = true;
+  }
+  impl::IRunQueueGraphImpl* endCapture() override
+  {
+    m_is_capturing = false;
+    hipGraph_t graph = nullptr;
+    ARCANE_CHECK_HIP(hipStreamEndCapture(m_hip_stream, &graph));
+    return new HipRunQueueGraph(graph);
+  }
   void* _internalImpl() override
   {
     return &m_hip_stream;
@@ -132,6 +192,7 @@ class HipRunQueueStream
 
   impl::IRunnerRuntime* m_runtime;
   hipStream_t m_hip_stream;
+  bool m_is_capturing = false;
 };
 
 /*---------------------------------------------------------------------------*/
@@ -11,6 +11,7 @@ set( ARCANE_SOURCES
   IReduceMemoryImpl.h
   MaterialVariableViews.h
   MemoryCopier.cc
+  MultiThreadAlgo.h
   NumArray.h
   NumArrayViews.h
   NumArrayViews.cc
@@ -34,6 +35,14 @@ set( ARCANE_SOURCES
   Partitioner.h
   Partitioner.cc
   Scan.cc
+  Sort.h
+  Sorter.cc
+  SegmentedReduce.h
+  SegmentedReducer.cc
+  Histogram.h
+  Histogram.cc
+  ItemUniqueIdToLocalIdMap.h
+  ItemUniqueIdToLocalIdMap.cc
   SpanViews.h
   VariableViews.h
   VariableViews.cc
@@ -91,6 +91,15 @@ class SyclRunQueueStream
     if (!args.isAsync())
       this->barrier();
   }
+  // TODO: utiliser l'extension 'sycl_ext_oneapi_graph' lorsqu'elle sera disponible.
+  void beginCapture() override
+  {
+    ARCANE_FATAL("Capture of commands is not supported with SYCL");
+  }
+  impl::IRunQueueGraphImpl* endCapture() override
+  {
+    ARCANE_FATAL("Capture of commands is not supported with SYCL");
+  }
   void* _internalImpl() override
   {
     return m_sycl_stream.get();
@@ -0,0 +1,127 @@
+﻿// -*- tab-width: 2; indent-tabs-mode: nil; coding: utf-8-with-signature -*-
+//-----------------------------------------------------------------------------
+// Copyright 2000-2024 CEA (www.cea.fr) IFPEN (www.ifpenergiesnouvelles.com)
+// See the top-level COPYRIGHT file for details.
+// SPDX-License-Identifier: Apache-2.0
+//-----------------------------------------------------------------------------
+
+#include <gtest/gtest.h>
+
+#include "arcane/utils/NumArray.h"
+#include "arcane/utils/ValueConvert.h"
+
+#include "arcane/accelerator/core/Runner.h"
+#include "arcane/accelerator/core/RunQueue.h"
+#include "arcane/accelerator/Sort.h"
+
+#include <algorithm>
+#include <chrono>
+#include <random>
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+extern "C++" void arcaneRegisterDefaultAcceleratorRuntime();
+extern "C++" Arcane::Accelerator::eExecutionPolicy arcaneGetDefaultExecutionPolicy();
+
+using namespace Arcane;
+using namespace Arcane::Accelerator;
+
+namespace
+{
+void _doInit()
+{
+  arcaneRegisterDefaultAcceleratorRuntime();
+}
+Arcane::Accelerator::eExecutionPolicy _defaultExecutionPolicy()
+{
+  return arcaneGetDefaultExecutionPolicy();
+}
+double _getTime()
+{
+  auto x = std::chrono::steady_clock::now().time_since_epoch();
+  return std::chrono::duration<double>(x).count();
+}
+} // namespace
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*
+ * Compare le temps de GenericSorter avec celui d'un tri sur l'hôte
+ * (recopie puis std::sort()). La taille maximale des tableaux est
+ * 1M par défaut et peut être augmentée (jusqu'à 100M) via la variable
+ * d'environnement ARCANE_TEST_SORT_MAX_SIZE.
+ */
+template <typename KeyType> void
+_doSortBenchmark(RunQueue& queue, Int32 nb_item)
+{
+  NumArray<KeyType, MDDim1> keys(nb_item);
+  NumArray<Int32, MDDim1> values(nb_item);
+  NumArray<KeyType, MDDim1> sorted_keys(nb_item);
+  NumArray<Int32, MDDim1> sorted_values(nb_item);
+
+  std::mt19937_64 randomizer(42);
+  std::uniform_int_distribution<Int64> rng_distrib(-(Int64(1) << 40), Int64(1) << 40);
+  for (Int32 i = 0; i < nb_item; ++i) {
+    keys[i] = static_cast<KeyType>(rng_distrib(randomizer));
+    values[i] = i;
+  }
+
+  GenericSorter sorter(queue);
+  // Premier appel pour que les allocations ne soient pas prises en compte
+  sorter.applyKeys(SmallSpan<const KeyType>(keys.to1DSmallSpan()), sorted_keys.to1DSmallSpan());
+  queue.barrier();
+
+  double t0 = _getTime();
+  sorter.applyKeys(SmallSpan<const KeyType>(keys.to1DSmallSpan()), sorted_keys.to1DSmallSpan());
+  queue.barrier();
+  double t1 = _getTime();
+  sorter.applyPairs(SmallSpan<const KeyType>(keys.to1DSmallSpan()), sorted_keys.to1DSmallSpan(),
+                    SmallSpan<const Int32>(values.to1DSmallSpan()), sorted_values.to1DSmallSpan());
+  queue.barrier();
+  double t2 = _getTime();
+
+  // Version hôte: recopie puis tri avec std::sort (ou std::stable_sort
+  // sur une permutation pour les couples clé/valeur).
+  UniqueArray<KeyType> host_keys(nb_item);
+  for (Int32 i = 0; i < nb_item; ++i)
+    host_keys[i] = keys[i];
+  std::sort(host_keys.begin(), host_keys.end());
+  double t3 = _getTime();
+  UniqueArray<Int32> host_permutation(nb_item);
+  for (Int32 i = 0; i < nb_item; ++i)
+    host_permutation[i] = i;
+  std::stable_sort(host_permutation.begin(), host_permutation.end(),
+                   [&](Int32 a, Int32 b) { return keys[a] < keys[b]; });
+  double t4 = _getTime();
+
+  std::cout << "SORT_BENCH size=" << nb_item << " key_size=" << sizeof(KeyType)
+            << " device_keys=" << (t1 - t0) << " device_pairs=" << (t2 - t1)
+            << " host_keys=" << (t3 - t2) << " host_pairs=" << (t4 - t3)
+            << "\n";
+
+  for (Int32 i = 0; i < nb_item; ++i) {
+    ASSERT_EQ(sorted_keys[i], host_keys[i]);
+    ASSERT_EQ(sorted_values[i], host_permutation[i]);
+  }
+}
+
+TEST(ArcaneAccelerator, SortBenchmark)
+{
+  _doInit();
+
+  Runner runner(_defaultExecutionPolicy());
+  RunQueue queue(makeQueue(runner));
+
+  Int32 max_size = 1000000;
+  if (auto v = Convert::Type<Int32>::tryParseFromEnvironment("ARCANE_TEST_SORT_MAX_SIZE", true))
+    max_size = v.value();
+  for (Int32 nb_item = 1000000; nb_item <= max_size; nb_item *= 10) {
+    _doSortBenchmark<Int64>(queue, nb_item);
+    _doSortBenchmark<Int32>(queue, nb_item);
+    _doSortBenchmark<double>(queue, nb_item);
+  }
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
@@ -1,11 +1,11 @@
 ﻿// -*- tab-width: 2; indent-tabs-mode: nil; coding: utf-8-with-signature -*-
 //-----------------------------------------------------------------------------
-// Copyright 2000-2022 CEA (www.cea.fr) IFPEN (www.ifpenergiesnouvelles.com)
+// Copyright 2000-2024 CEA (www.cea.fr) IFPEN (www.ifpenergiesnouvelles.com)
 // See the top-level COPYRIGHT file for details.
 // SPDX-License-Identifier: Apache-2.0
 //-----------------------------------------------------------------------------
 /*---------------------------------------------------------------------------*/
-/* IMeshUniqueIdMng.h                                          (C) 2000-2022 */
+/* IMeshUniqueIdMng.h                                          (C) 2000-2024 */
 /*                                                                           */
 /* Interface du gestionnaire de numérotation des uniqueId() d'un maillage.   */
 /*---------------------------------------------------------------------------*/
@@ -45,10 +45,15 @@ class ARCANE_CORE_EXPORT IMeshUniqueIdMng
   /*!
    * \brief Positionne la version de la numérotation des faces.
    *
-   * Les valeurs valides sont 0, 1, 2 et 3. La valeur par défaut est 1.
+   * Les valeurs valides sont comprises entre 0 et 6. La valeur par défaut est 1.
    * Si la version vaut 0 alors il n'y a pas de renumérotation. En parallèle,
    * il faut alors que les uniqueId() des faces soient cohérents entre
    * les sous-domaines.
+   *
+   * Les versions 3 et 6 calculent la même numérotation à partir d'un tri
+   * parallèle des faces. La version 3 utilise un tri bitonique et la
+   * version 6 un tri par échantillonnage, qui passe mieux à l'échelle
+   * lorsque le nombre de sous-domaines est important.
    */  
   virtual void setFaceBuilderVersion(Integer n) =0;
 
@@ -1,11 +1,11 @@
 ﻿// -*- tab-width: 2; indent-tabs-mode: nil; coding: utf-8-with-signature -*-
 //-----------------------------------------------------------------------------
-// Copyright 2000-2022 CEA (www.cea.fr) IFPEN (www.ifpenergiesnouvelles.com)
+// Copyright 2000-2024 CEA (www.cea.fr) IFPEN (www.ifpenergiesnouvelles.com)
 // See the top-level COPYRIGHT file for details.
 // SPDX-License-Identifier: Apache-2.0
 //-----------------------------------------------------------------------------
 /*---------------------------------------------------------------------------*/
-/* IMeshUtilities.h                                            (C) 2000-2021 */
+/* IMeshUtilities.h                                            (C) 2000-2024 */
 /*                                                                           */
 /* Interface d'une classe proposant des fonctions utilitaires sur maillage.  */
 /*---------------------------------------------------------------------------*/
@@ -26,6 +26,28 @@
 namespace Arcane
 {
 
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*!
+ * \brief Algorithme de renumérotation des numéros locaux des entités.
+ *
+ * \sa IMeshUtilities::renumberItemsLocalId().
+ */
+enum class eItemsLocalIdRenumbering
+{
+  //! Ordre le long d'une courbe de Morton (Z-order) des centres des entités
+  MortonCurve,
+  //! Ordre le long d'une courbe de Hilbert des centres des entités
+  HilbertCurve,
+  /*!
+   * \brief Ordre de Cuthill-McKee inverse du graphe maille-face-maille.
+   *
+   * Les entités des autres familles sont rangées suivant la plus petite
+   * position des mailles auxquelles elles sont connectées.
+   */
+  ReverseCuthillMcKee
+};
+
 /*---------------------------------------------------------------------------*/
 /*---------------------------------------------------------------------------*/
 /*!
@@ -189,6 +211,30 @@ class ARCANE_CORE_EXPORT IMeshUtilities
    */
   virtual void mergeNodes(Int32ConstArrayView nodes_local_id,
                           Int32ConstArrayView nodes_to_merge_local_id) =0;
+
+  /*!
+   * \brief Renumérote les numéros locaux des entités pour améliorer la localité.
+   *
+   * Les entités des familles de noeuds, arêtes, faces et mailles sont
+   * renumérotées suivant l'algorithme \a algo via un compactage trié
+   * du maillage (IMeshCompacter::setSorted()). Les variables et les groupes
+   * sont mis à jour en une seule passe lors de ce compactage.
+   *
+   * La fonction de tri utilisée (IItemFamily::itemSortFunction()) reste
+   * positionnée après l'appel pour que les compactages triés ultérieurs
+   * conservent cet ordre. Il est possible de revenir à l'ordre par défaut
+   * (suivant les uniqueId()) en appelant IItemFamily::setItemSortFunction()
+   * avec un pointeur nul.
+   *
+   * Cette méthode affiche les statistiques de distance d'accès
+   * maille/noeud et maille/maille ainsi que le temps d'un calcul de type
+   * gradient aux mailles à partir de valeurs aux noeuds, avant et après
+   * la renumérotation.
+   *
+   * Cette opération est locale au sous-domaine. Elle n'est disponible que
+   * pour les maillages non structurés classiques (sans AMR).
+   */
+  virtual void renumberItemsLocalId(eItemsLocalIdRenumbering algo) =0;
 };
 
 /*---------------------------------------------------------------------------*/
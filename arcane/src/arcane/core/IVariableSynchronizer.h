@@ -37,6 +37,25 @@ namespace Arcane
  * à un groupe d'entité. Il faut appeller la fonction compute()
  * pour calculer les infos de synchronisation. Si les entités sont
  * compactées, il faut appeler changeLocalIds().
+ *
+ * Il est possible de compresser les messages d'une variable en lui ajoutant
+ * le tag 'SyncCompressionThreshold' dont la valeur est la taille minimale
+ * (en octet) des messages à compresser. Par exemple:
+ *
+ * \code
+ * VariableCellArrayReal var = ...;
+ * var.addTag("SyncCompressionThreshold", "65536");
+ * \endcode
+ *
+ * Il est aussi possible de spécifier un seuil pour les variables n'ayant
+ * pas ce tag via la variable d'environnement
+ * ARCANE_SYNCHRONIZE_COMPRESSION_THRESHOLD.
+ *
+ * Cette valeur doit être la même sur tous les rangs. La compression n'est
+ * effectuée que si l'implémentation de la synchronisation le supporte et
+ * si les buffers de synchronisation sont alloués sur l'hôte. Le service
+ * de compression utilisé est 'LZ4DataCompressor' et peut être changé
+ * via la variable d'environnement ARCANE_SYNCHRONIZE_COMPRESSOR.
  */
 class ARCANE_CORE_EXPORT IVariableSynchronizer
 {
@@ -104,7 +123,48 @@ class ARCANE_CORE_EXPORT IVariableSynchronizer
    * dans cette liste pour tout autre sous-domaine qui possède cette entité.
    */
   virtual void synchronize(VariableCollection vars, Int32ConstArrayView local_ids);
-  
+
+  /*!
+   * \brief Commence la synchronisation de la variable \a var en mode non bloquant.
+   *
+   * Cette méthode effectue la recopie des valeurs des entités partagées
+   * dans les buffers d'envoi et lance les messages. Il faut ensuite appeler
+   * endSynchronize() pour attendre la fin des messages et recopier les valeurs
+   * des entités fantômes. Entre ces deux appels, il est possible d'effectuer
+   * des calculs qui ne modifient pas les valeurs des entités partagées et
+   * n'utilisent pas les valeurs des entités fantômes de \a var.
+   *
+   * Si \a queue n'est pas nul, les recopies entre la variable et les buffers
+   * sont effectuées sur cette file. Sinon, on utilise la file par défaut
+   * du gestionnaire de parallélisme. Si \a queue est associée à un
+   * accélérateur mais que les buffers de synchronisation ne sont pas alloués
+   * sur l'accélérateur (pas de support accélérateur dans MPI), \a queue est
+   * ignorée et un avertissement est affiché lors de la première utilisation.
+   *
+   * Il ne peut y avoir qu'une seule synchronisation en cours par instance.
+   *
+   * L'implémentation par défaut effectue une synchronisation bloquante.
+   */
+  virtual void beginSynchronize(IVariable* var, RunQueue* queue);
+
+  /*!
+   * \brief Commence la synchronisation des variables \a vars en mode non bloquant.
+   *
+   * Toutes les variables doivent être issues de la même famille
+   * et de ce groupe d'entité.
+   *
+   * \sa beginSynchronize(IVariable* var,RunQueue* queue)
+   */
+  virtual void beginSynchronize(VariableCollection vars, RunQueue* queue);
+
+  /*!
+   * \brief Termine la synchronisation commencée par beginSynchronize().
+   *
+   * Cette méthode est bloquante jusqu'à ce que les valeurs des entités
+   * fantômes aient été mises à jour.
+   */
+  virtual void endSynchronize();
+
   /*!
    * \brief Rangs des sous-domaines avec lesquels on communique.
    */
@@ -281,6 +281,23 @@ synchronize(VariableCollection, Int32ConstArrayView)
   ARCANE_THROW(NotImplementedException,"synchronize() with specific local ids");
 }
 
+void IVariableSynchronizer::
+beginSynchronize(IVariable* var, RunQueue*)
+{
+  synchronize(var);
+}
+
+void IVariableSynchronizer::
+beginSynchronize(VariableCollection vars, RunQueue*)
+{
+  synchronize(vars);
+}
+
+void IVariableSynchronizer::
+endSynchronize()
+{
+}
+
 /*---------------------------------------------------------------------------*/
 /*---------------------------------------------------------------------------*/
 
@@ -1,11 +1,11 @@
 ﻿// -*- tab-width: 2; indent-tabs-mode: nil; coding: utf-8-with-signature -*-
 //-----------------------------------------------------------------------------
-// Copyright 2000-2023 CEA (www.cea.fr) IFPEN (www.ifpenergiesnouvelles.com)
+// Copyright 2000-2024 CEA (www.cea.fr) IFPEN (www.ifpenergiesnouvelles.com)
 // See the top-level COPYRIGHT file for details.
 // SPDX-License-Identifier: Apache-2.0
 //-----------------------------------------------------------------------------
 /*---------------------------------------------------------------------------*/
-/* VariableSynchronizerEventArgs.cc                            (C) 2000-2023 */
+/* VariableSynchronizerEventArgs.cc                            (C) 2000-2024 */
 /*                                                                           */
 /* Arguments des évènements générés par IVariableSynchronizer.               */
 /*---------------------------------------------------------------------------*/
@@ -110,6 +110,9 @@ _reset()
 {
   m_elapsed_time = 0.0;
   m_state = State::BeginSynchronize;
+  m_nb_message = 0;
+  m_total_message_size = 0;
+  m_nb_saved_message = 0;
   m_variables.clear();
   m_compare_status_list.clear();
 }
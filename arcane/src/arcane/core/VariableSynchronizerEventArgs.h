@@ -1,11 +1,11 @@
 ﻿// -*- tab-width: 2; indent-tabs-mode: nil; coding: utf-8-with-signature -*-
 //-----------------------------------------------------------------------------
-// Copyright 2000-2023 CEA (www.cea.fr) IFPEN (www.ifpenergiesnouvelles.com)
+// Copyright 2000-2024 CEA (www.cea.fr) IFPEN (www.ifpenergiesnouvelles.com)
 // See the top-level COPYRIGHT file for details.
 // SPDX-License-Identifier: Apache-2.0
 //-----------------------------------------------------------------------------
 /*---------------------------------------------------------------------------*/
-/* VariableSynchronizerEventArgs.h                             (C) 2000-2023 */
+/* VariableSynchronizerEventArgs.h                             (C) 2000-2024 */
 /*                                                                           */
 /* Arguments des évènements générés par IVariableSynchronizer.               */
 /*---------------------------------------------------------------------------*/
@@ -110,6 +110,34 @@ class ARCANE_CORE_EXPORT VariableSynchronizerEventArgs
   State state() const { return m_state; }
   void setState(State v) { m_state = v; }
 
+  /*!
+   * \brief Nombre de messages envoyés par ce rang pour la synchronisation.
+   *
+   * Cette valeur n'est valide que pour les évènements de fin de synchronisation
+   * (state()==State::EndSynchronize).
+   */
+  Int32 nbMessage() const { return m_nb_message; }
+
+  //! Taille totale (en octet) des messages envoyés par ce rang.
+  Int64 totalMessageSize() const { return m_total_message_size; }
+
+  /*!
+   * \brief Nombre de messages économisés par rapport à une synchronisation
+   * variable par variable.
+   *
+   * Cette valeur est non nulle uniquement lorsque plusieurs variables sont
+   * synchronisées en une seule fois.
+   */
+  Int32 nbSavedMessage() const { return m_nb_saved_message; }
+
+  //! Positionne les informations sur les messages envoyés
+  void setMessageInfo(Int32 nb_message, Int64 total_message_size, Int32 nb_saved_message)
+  {
+    m_nb_message = nb_message;
+    m_total_message_size = total_message_size;
+    m_nb_saved_message = nb_saved_message;
+  }
+
  private:
 
   IVariableSynchronizer* m_var_syncer = nullptr;
@@ -117,6 +145,9 @@ class ARCANE_CORE_EXPORT VariableSynchronizerEventArgs
   UniqueArray<CompareStatus> m_compare_status_list;
   Real m_elapsed_time = 0.0;
   State m_state = State::BeginSynchronize;
+  Int32 m_nb_message = 0;
+  Int64 m_total_message_size = 0;
+  Int32 m_nb_saved_message = 0;
 
  private:
 
@@ -1,11 +1,11 @@
 ﻿// -*- tab-width: 2; indent-tabs-mode: nil; coding: utf-8-with-signature -*-
 //-----------------------------------------------------------------------------
-// Copyright 2000-2023 CEA (www.cea.fr) IFPEN (www.ifpenergiesnouvelles.com)
+// Copyright 2000-2024 CEA (www.cea.fr) IFPEN (www.ifpenergiesnouvelles.com)
 // See the top-level COPYRIGHT file for details.
 // SPDX-License-Identifier: Apache-2.0
 //-----------------------------------------------------------------------------
 /*---------------------------------------------------------------------------*/
-/* IMeshModifierInternal.h                                     (C) 2000-2023 */
+/* IMeshModifierInternal.h                                     (C) 2000-2024 */
 /*                                                                           */
 /* Partie interne à Arcane de IMeshModifier.                                 */
 /*---------------------------------------------------------------------------*/
@@ -33,6 +33,17 @@ class ARCANE_CORE_EXPORT IMeshModifierInternal
  public:
 
   virtual ~IMeshModifierInternal() = default;
+
+ public:
+
+  /*!
+   * \brief Compacte et trie les entités de toutes les familles.
+   *
+   * Le tri utilise pour chaque famille la fonction
+   * IItemFamily::itemSortFunction(). Les variables et les groupes
+   * sont compactés.
+   */
+  virtual void sortAndCompactItems() = 0;
 };
 
 /*---------------------------------------------------------------------------*/
@@ -0,0 +1,171 @@
+﻿// -*- tab-width: 2; indent-tabs-mode: nil; coding: utf-8-with-signature -*-
+//-----------------------------------------------------------------------------
+// Copyright 2000-2024 CEA (www.cea.fr) IFPEN (www.ifpenergiesnouvelles.com)
+// See the top-level COPYRIGHT file for details.
+// SPDX-License-Identifier: Apache-2.0
+//-----------------------------------------------------------------------------
+/*---------------------------------------------------------------------------*/
+/* CellMaterialVariableSoAArrayRef.h                           (C) 2000-2024 */
+/*                                                                           */
+/* Variable tableau matériau rangée par composante.                          */
+/*---------------------------------------------------------------------------*/
+#ifndef ARCANE_CORE_MATERIALS_CELLMATERIALVARIABLESOAARRAYREF_H
+#define ARCANE_CORE_MATERIALS_CELLMATERIALVARIABLESOAARRAYREF_H
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+#include "arcane/utils/Array.h"
+#include "arcane/utils/MemoryUtils.h"
+#include "arcane/utils/FatalErrorException.h"
+#include "arcane/utils/String.h"
+
+#include "arcane/core/materials/MeshMaterialVariableRef.h"
+#include "arcane/core/materials/MaterialVariableBuildInfo.h"
+
+#include <memory>
+#include <vector>
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+namespace Arcane::Materials
+{
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*!
+ * \ingroup ArcaneMaterials
+ * \brief Variable tableau sur les mailles matériaux rangée par composante.
+ *
+ * Cette classe est une alternative à CellMaterialVariableArrayRef pour
+ * laquelle les valeurs sont rangées par composante (Structure of Arrays)
+ * et non pas par maille (Array of Structures). Chaque composante est une
+ * variable scalaire matériau (CellMaterialVariableScalarRef) qui possède
+ * donc ses propres tableaux contigus pour les valeurs globales et
+ * partielles. Les boucles qui ne traitent qu'une composante accèdent donc
+ * à la mémoire de manière contigue, ce qui permet la vectorisation sur
+ * CPU et les accès coalescents sur accélérateur.
+ *
+ * La composante \a k est une variable de nom `name()_k`. Comme il s'agit
+ * de variables matériaux classiques, elles sont mises à jour lors des
+ * modifications des matériaux, synchronisées et sauvegardées comme
+ * les autres variables.
+ *
+ * Il est possible d'accéder à chaque composante via component(). Pour les
+ * accélérateurs, il existe des vues spécifiques (voir MaterialVariableViews.h)
+ * qui permettent d'accéder à toutes les composantes dans un même noyau.
+ */
+template <typename DataType>
+class CellMaterialVariableSoAArrayRef
+{
+ public:
+
+  using ComponentVariableRefType = CellMaterialVariableScalarRef<DataType>;
+
+ public:
+
+  explicit CellMaterialVariableSoAArrayRef(const MaterialVariableBuildInfo& vb, Int32 nb_component = 0)
+  : m_material_mng(vb.materialMng())
+  , m_name(vb.name())
+  , m_property(vb.property())
+  , m_component_values(MemoryUtils::getDefaultDataAllocator())
+  {
+    resize(nb_component);
+  }
+
+  CellMaterialVariableSoAArrayRef(const CellMaterialVariableSoAArrayRef<DataType>& rhs) = delete;
+  CellMaterialVariableSoAArrayRef<DataType>& operator=(const CellMaterialVariableSoAArrayRef<DataType>& rhs) = delete;
+
+ public:
+
+  //! Nom de la variable
+  const String& name() const { return m_name; }
+
+  //! Nombre de composantes
+  Int32 nbComponent() const { return static_cast<Int32>(m_components.size()); }
+
+  /*!
+   * \brief Positionne le nombre de composantes.
+   *
+   * Les valeurs des composantes existantes sont conservées.
+   */
+  void resize(Int32 nb_component)
+  {
+    if (nb_component < 0)
+      ARCANE_FATAL("Invalid negative number of component '{0}'", nb_component);
+    Int32 old_nb_component = nbComponent();
+    m_components.resize(nb_component);
+    for (Int32 k = old_nb_component; k < nb_component; ++k) {
+      String var_name = m_name + "_" + String::fromNumber(k);
+      MaterialVariableBuildInfo vbi(m_material_mng, var_name, m_property);
+      m_components[k] = std::make_unique<ComponentVariableRefType>(vbi);
+    }
+  }
+
+  //! Variable associée à la composante \a k
+  ComponentVariableRefType& component(Int32 k) { return *m_components[k]; }
+
+  //! Variable associée à la composante \a k
+  const ComponentVariableRefType& component(Int32 k) const { return *m_components[k]; }
+
+  //! Valeur partielle de la composante \a k pour la maille matériau \a mc
+  const DataType& operator()(ComponentItemLocalId mc, Int32 k) const { return (*m_components[k])[mc]; }
+
+  //! Valeur partielle de la composante \a k pour la maille matériau \a mc
+  DataType& operator()(ComponentItemLocalId mc, Int32 k) { return (*m_components[k])[mc]; }
+
+  //! Valeur globale de la composante \a k pour la maille \a c
+  const DataType& operator()(CellLocalId c, Int32 k) const { return (*m_components[k])[c]; }
+
+  //! Valeur globale de la composante \a k pour la maille \a c
+  DataType& operator()(CellLocalId c, Int32 k) { return (*m_components[k])[c]; }
+
+ public:
+
+  /*!
+   * \internal
+   * \brief Liste des conteneurs de valeurs de chaque composante.
+   *
+   * Cette liste est accessible depuis les accélérateurs. Elle est mise à
+   * jour lors de chaque appel car les conteneurs des composantes peuvent
+   * changer lors de l'ajout de matériaux ou de milieux.
+   */
+  SmallSpan<ArrayView<DataType>* const> _internalComponentValues() const
+  {
+    const Int32 n = nbComponent();
+    m_component_values.resize(n);
+    for (Int32 k = 0; k < n; ++k)
+      m_component_values[k] = m_components[k]->_internalValue();
+    return m_component_values.constSmallSpan();
+  }
+
+  //! \internal Variable matériau de la première composante (ou nullptr)
+  IMeshMaterialVariable* _firstMaterialVariable() const
+  {
+    return (m_components.empty()) ? nullptr : m_components[0]->materialVariable();
+  }
+
+ private:
+
+  IMeshMaterialMng* m_material_mng = nullptr;
+  String m_name;
+  int m_property = 0;
+  std::vector<std::unique_ptr<ComponentVariableRefType>> m_components;
+  mutable UniqueArray<ArrayView<DataType>*> m_component_values;
+};
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+//! %Variable matériau tableau rangée par composante de type \a #Real
+typedef CellMaterialVariableSoAArrayRef<Real> MaterialVariableCellSoAArrayReal;
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+} // End namespace Arcane::Materials
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+#endif
@@ -1,11 +1,11 @@
 ﻿// -*- tab-width: 2; indent-tabs-mode: nil; coding: utf-8-with-signature -*-
 //-----------------------------------------------------------------------------
-// Copyright 2000-2023 CEA (www.cea.fr) IFPEN (www.ifpenergiesnouvelles.com)
+// Copyright 2000-2024 CEA (www.cea.fr) IFPEN (www.ifpenergiesnouvelles.com)
 // See the top-level COPYRIGHT file for details.
 // SPDX-License-Identifier: Apache-2.0
 //-----------------------------------------------------------------------------
 /*---------------------------------------------------------------------------*/
-/* IMeshMaterialMng.h                                          (C) 2000-2023 */
+/* IMeshMaterialMng.h                                          (C) 2000-2024 */
 /*                                                                           */
 /* Interface du gestionnaire des matériaux d'un maillage.                    */
 /*---------------------------------------------------------------------------*/
@@ -339,6 +339,18 @@ class ARCANE_CORE_EXPORT IMeshMaterialMng
    */
   virtual void forceRecompute() =0;
 
+  /*!
+   * \brief Compacte les valeurs partielles des variables matériaux.
+   *
+   * Après des modifications incrémentales des constituants, les tableaux
+   * contenant les valeurs partielles peuvent contenir des emplacements
+   * inutilisés. Cette méthode renumérote les valeurs partielles de chaque
+   * constituant pour qu'elles soient contigües et libère la mémoire
+   * non utilisée. Les valeurs sont conservées mais les MatVarIndex des
+   * mailles partielles sont modifiés.
+   */
+  virtual void compactPartialValues() =0;
+
   //! Verrou utilisé pour le multi-threading
   virtual Mutex* variableLock() =0;
 
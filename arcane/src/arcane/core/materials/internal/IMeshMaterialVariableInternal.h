@@ -157,6 +157,18 @@ class ARCANE_CORE_EXPORT IMeshMaterialVariableInternal
 
   //! Redimensionne la valeur partielle associée à l'indexer \a index
   virtual void resizeForIndexer(Int32 index, RunQueue& queue) = 0;
+
+  /*!
+   * \brief Compacte les valeurs partielles associées à l'indexer \a index.
+   *
+   * La valeur d'indice \a old_indexes[i] est recopiée à l'indice \a new_indexes[i].
+   * Le tableau des valeurs partielles est ensuite redimensionné à la taille
+   * donnée par l'indexer et la mémoire non utilisée est libérée.
+   * \a buffer est un tableau de travail qui doit être accessible depuis \a queue.
+   */
+  virtual void compactPartialValues(Int32 index, SmallSpan<const MatVarIndex> old_indexes,
+                                    SmallSpan<const MatVarIndex> new_indexes,
+                                    Array<std::byte>& buffer, RunQueue& queue) = 0;
 };
 
 /*---------------------------------------------------------------------------*/
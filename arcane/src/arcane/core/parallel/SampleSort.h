@@ -0,0 +1,139 @@
+﻿// -*- tab-width: 2; indent-tabs-mode: nil; coding: utf-8-with-signature -*-
+//-----------------------------------------------------------------------------
+// Copyright 2000-2024 CEA (www.cea.fr) IFPEN (www.ifpenergiesnouvelles.com)
+// See the top-level COPYRIGHT file for details.
+// SPDX-License-Identifier: Apache-2.0
+//-----------------------------------------------------------------------------
+/*---------------------------------------------------------------------------*/
+/* SampleSort.h                                                (C) 2000-2024 */
+/*                                                                           */
+/* Algorithme de tri parallèle par échantillonnage                           */
+/*---------------------------------------------------------------------------*/
+#ifndef ARCANE_CORE_PARALLEL_SAMPLESORT_H
+#define ARCANE_CORE_PARALLEL_SAMPLESORT_H
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+#include "arcane/utils/TraceAccessor.h"
+#include "arcane/utils/Array.h"
+
+#include "arcane/core/IParallelSort.h"
+#include "arcane/core/IParallelMng.h"
+#include "arcane/core/parallel/BitonicSort.h"
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+namespace Arcane::Parallel
+{
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*!
+ * \brief Algorithme de tri parallèle par échantillonnage (sample sort).
+ *
+ * Cette classe fournit les mêmes fonctionnalités que BitonicSort et utilise
+ * les mêmes caractéristiques \a KeyTypeTraits (seule la méthode
+ * `compareLess()` est utilisée). Le type \a KeyType doit pouvoir être copié
+ * octet par octet.
+ *
+ * L'algorithme est le suivant:
+ * - chaque rang trie localement ses clés,
+ * - chaque rang choisit un échantillon régulier de ses clés triées. Le nombre
+ *   d'éléments de l'échantillon est proportionnel au nombre de clés du rang,
+ * - les échantillons sont rassemblés sur tous les rangs et triés, ce qui
+ *   permet de déterminer \a nb_rank-1 séparateurs,
+ * - chaque rang envoie à chaque autre rang les clés comprises entre
+ *   deux séparateurs via un seul appel à IParallelMng::allToAllVariable(),
+ * - chaque rang fusionne les listes triées qu'il a reçues.
+ *
+ * Contrairement à BitonicSort, qui nécessite de l'ordre de log2(N)^2 phases
+ * d'échanges entre paires de processeurs, cet algorithme n'effectue qu'un
+ * nombre constant d'opérations collectives. Il est donc préférable lorsque
+ * le nombre de rangs est important.
+ *
+ * Comme pour BitonicSort, après le tri les éléments sont répartis par ordre
+ * croissant en commençant par le rang 0. Le nombre d'éléments par rang n'est
+ * pas forcément le même. Les clés égales sont rangées par ordre croissant
+ * de leur rang puis de leur indice d'origine.
+ */
+template <typename KeyType, typename KeyTypeTraits = BitonicSortDefaultTraits<KeyType>>
+class SampleSort
+: public TraceAccessor
+, public IParallelSort<KeyType>
+{
+ public:
+
+  explicit SampleSort(IParallelMng* parallel_mng);
+
+ public:
+
+  /*!
+   * \brief Trie en parallèle les éléments de \a keys sur tous les rangs.
+   *
+   * Cette opération est collective.
+   */
+  void sort(ConstArrayView<KeyType> keys) override;
+
+  //! Après un tri, retourne la liste des éléments de ce rang.
+  ConstArrayView<KeyType> keys() const override { return m_keys; }
+
+  //! Après un tri, retourne le tableau des rangs d'origine des éléments de keys().
+  Int32ConstArrayView keyRanks() const override { return m_key_ranks; }
+
+  //! Après un tri, retourne le tableau des indices dans la liste d'origine des éléments de keys().
+  Int32ConstArrayView keyIndexes() const override { return m_key_indexes; }
+
+ public:
+
+  void setNeedIndexAndRank(bool want_index_and_rank)
+  {
+    m_want_index_and_rank = want_index_and_rank;
+  }
+
+  /*!
+   * \brief Positionne le nombre moyen d'échantillons par rang.
+   *
+   * Plus ce nombre est grand, meilleur est l'équilibrage du nombre
+   * d'éléments par rang après le tri mais plus le volume des échantillons
+   * (qui sont rassemblés sur tous les rangs) est important.
+   */
+  void setNbSamplePerRank(Int32 v)
+  {
+    m_nb_sample_per_rank = (v > 0) ? v : 1;
+  }
+
+ private:
+
+  //! Variable contenant la cle du tri
+  UniqueArray<KeyType> m_keys;
+  //! Tableau contenant le rang du processeur où se trouve la clé
+  UniqueArray<Int32> m_key_ranks;
+  //! Tableau contenant l'indice de la clé dans le processeur
+  UniqueArray<Int32> m_key_indexes;
+  //! Gestionnaire du parallèlisme
+  IParallelMng* m_parallel_mng = nullptr;
+  //! Indique si on souhaite les infos sur les rangs et index
+  bool m_want_index_and_rank = true;
+  //! Nombre moyen d'échantillons par rang
+  Int32 m_nb_sample_per_rank = 64;
+
+ private:
+
+  void _localSort(ConstArrayView<KeyType> keys, Array<KeyType>& sorted_keys,
+                  Array<Int32>& sorted_indexes);
+  void _computeSplitters(ConstArrayView<KeyType> sorted_keys, Int64 total_nb_key,
+                         Array<KeyType>& splitters);
+  void _mergeReceivedKeys(ConstArrayView<KeyType> recv_keys, ConstArrayView<Int32> recv_indexes,
+                          Int32ConstArrayView recv_counts);
+};
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+} // namespace Arcane::Parallel
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+#endif
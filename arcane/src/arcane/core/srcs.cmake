@@ -43,6 +43,7 @@ set(ARCANE_MATERIALS_SOURCES
   materials/MaterialVariableTypeInfo.h
   materials/MeshMaterialVariableRef.cc
   materials/MeshMaterialVariableRef.h
+  materials/CellMaterialVariableSoAArrayRef.h
   materials/MeshEnvironmentVariableRef.cc
   materials/MeshEnvironmentVariableRef.h
   materials/MeshMaterialVariableComputeFunction.h
@@ -740,6 +741,8 @@ set(ARCANE_ORIGINAL_SOURCES
 
   parallel/BitonicSort.h
   parallel/BitonicSortT.H
+  parallel/SampleSort.h
+  parallel/SampleSortT.H
   parallel/GhostItemsVariableParallelOperation.cc
   parallel/GhostItemsVariableParallelOperation.h
   parallel/IMultiReduce.h
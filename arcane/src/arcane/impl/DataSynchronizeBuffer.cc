@@ -1,11 +1,11 @@
 ﻿// -*- tab-width: 2; indent-tabs-mode: nil; coding: utf-8-with-signature -*-
 //-----------------------------------------------------------------------------
-// Copyright 2000-2023 CEA (www.cea.fr) IFPEN (www.ifpenergiesnouvelles.com)
+// Copyright 2000-2024 CEA (www.cea.fr) IFPEN (www.ifpenergiesnouvelles.com)
 // See the top-level COPYRIGHT file for details.
 // SPDX-License-Identifier: Apache-2.0
 //-----------------------------------------------------------------------------
 /*---------------------------------------------------------------------------*/
-/* DataSynchronizeBuffer.cc                                    (C) 2000-2023 */
+/* DataSynchronizeBuffer.cc                                    (C) 2000-2024 */
 /*                                                                           */
 /* Implémentation d'un buffer générique pour la synchronisation de donnéess. */
 /*---------------------------------------------------------------------------*/
@@ -14,6 +14,8 @@
 #include "arcane/impl/internal/DataSynchronizeBuffer.h"
 
 #include "arcane/utils/FatalErrorException.h"
+#include "arcane/utils/PlatformUtils.h"
+#include "arcane/utils/IDataCompressor.h"
 #include "arcane/utils/internal/MemoryBuffer.h"
 
 #include "arcane/impl/DataSynchronizeInfo.h"
@@ -21,12 +23,101 @@
 
 #include "arcane/accelerator/core/Runner.h"
 
+#include <algorithm>
+#include <cstring>
+
 /*---------------------------------------------------------------------------*/
 /*---------------------------------------------------------------------------*/
 
 namespace Arcane
 {
 
+namespace
+{
+  /*!
+   * \brief Taille de l'en-tête d'un message compressé.
+   *
+   * L'en-tête contient la taille des données compressées, ou 0 si les
+   * données ne sont pas compressées.
+   */
+  constexpr Int64 COMPRESSED_HEADER_SIZE = sizeof(Int64);
+
+  /*!
+   * \brief Taille (en octet) de l'élément de base d'un type de taille \a datatype_size.
+   *
+   * Les types de base ont une taille de 1, 2, 4 ou 8 octets et les types
+   * composés (Real3, Real2x2, tableaux 2D, ...) sont formés d'un nombre
+   * entier de ces types de base. On prend donc la plus grande puissance
+   * de 2, limitée à 8, qui divise \a datatype_size.
+   */
+  Int32 _shuffleElementSize(Int32 datatype_size)
+  {
+    Int32 element_size = 1;
+    while (element_size < 8 && (datatype_size % (element_size * 2)) == 0)
+      element_size *= 2;
+    return element_size;
+  }
+
+  /*!
+   * \brief Regroupe les octets de même poids des éléments de \a input.
+   *
+   * Pour les types flottants, cela permet de regrouper les signes et
+   * les exposants qui varient peu et améliore fortement le taux de compression.
+   */
+  void _shuffleSegment(Span<const std::byte> input, Span<std::byte> output, Int32 element_size)
+  {
+    const Int64 nb_element = input.size() / element_size;
+    for (Int64 i = 0; i < nb_element; ++i)
+      for (Int32 b = 0; b < element_size; ++b)
+        output[b * nb_element + i] = input[i * element_size + b];
+  }
+
+  //! Opération inverse de _shuffleSegment()
+  void _unshuffleSegment(Span<const std::byte> input, Span<std::byte> output, Int32 element_size)
+  {
+    const Int64 nb_element = input.size() / element_size;
+    for (Int64 i = 0; i < nb_element; ++i)
+      for (Int32 b = 0; b < element_size; ++b)
+        output[i * element_size + b] = input[b * nb_element + i];
+  }
+
+  /*!
+   * \brief Regroupe les octets de même poids du message \a input.
+   *
+   * Le message contient les valeurs de plusieurs données rangées les unes
+   * après les autres. \a datatype_sizes contient la taille du type de
+   * chaque donnée dans l'ordre de rangement. Les octets sont regroupés
+   * donnée par donnée en fonction de la taille de l'élément de base de
+   * chaque type et pas de la somme des tailles des types.
+   */
+  void _shuffleBytes(Span<const std::byte> input, Span<std::byte> output,
+                     ConstArrayView<Int32> datatype_sizes, Int32 full_datatype_size)
+  {
+    const Int64 nb_item = input.size() / full_datatype_size;
+    Int64 offset = 0;
+    for (Int32 datatype_size : datatype_sizes) {
+      const Int64 size = nb_item * datatype_size;
+      _shuffleSegment(input.subSpan(offset, size), output.subSpan(offset, size),
+                      _shuffleElementSize(datatype_size));
+      offset += size;
+    }
+  }
+
+  //! Opération inverse de _shuffleBytes()
+  void _unshuffleBytes(Span<const std::byte> input, Span<std::byte> output,
+                       ConstArrayView<Int32> datatype_sizes, Int32 full_datatype_size)
+  {
+    const Int64 nb_item = input.size() / full_datatype_size;
+    Int64 offset = 0;
+    for (Int32 datatype_size : datatype_sizes) {
+      const Int64 size = nb_item * datatype_size;
+      _unshuffleSegment(input.subSpan(offset, size), output.subSpan(offset, size),
+                        _shuffleElementSize(datatype_size));
+      offset += size;
+    }
+  }
+} // namespace
+
 /*---------------------------------------------------------------------------*/
 /*---------------------------------------------------------------------------*/
 
@@ -70,7 +161,7 @@ barrier()
 Int64 DataSynchronizeBufferBase::BufferInfo::
 displacement(Int32 index) const
 {
-  return m_buffer_info->bufferDisplacement(index) * m_datatype_size;
+  return m_displacements[index];
 }
 
 /*---------------------------------------------------------------------------*/
@@ -79,9 +170,36 @@ displacement(Int32 index) const
 MutableMemoryView DataSynchronizeBufferBase::BufferInfo::
 localBuffer(Int32 index)
 {
-  Int64 displacement = m_buffer_info->bufferDisplacement(index);
   Int32 local_size = m_buffer_info->nbItem(index);
-  return m_memory_view.subView(displacement, local_size);
+  std::byte* local_data = m_memory_view.data() + m_displacements[index];
+  return makeMutableMemoryView(local_data, m_datatype_size, local_size);
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*!
+ * \brief Calcule le déplacement en octet du buffer de chaque rang.
+ *
+ * Si \a alignment n'est pas nul, le début du buffer de chaque rang est
+ * aligné sur cette valeur.
+ *
+ * Retourne la taille totale en octet nécessaire.
+ */
+Int64 DataSynchronizeBufferBase::BufferInfo::
+_computeDisplacements(Int32 nb_rank, Int32 alignment)
+{
+  m_displacements.resize(nb_rank);
+  Int64 total_size = 0;
+  for (Int32 i = 0; i < nb_rank; ++i) {
+    m_displacements[i] = total_size;
+    total_size += m_buffer_info->nbItem(i) * static_cast<Int64>(m_datatype_size);
+    if (alignment > 0) {
+      Int64 modulo = total_size % alignment;
+      if (modulo != 0)
+        total_size += alignment - modulo;
+    }
+  }
+  return total_size;
 }
 
 /*---------------------------------------------------------------------------*/
@@ -124,6 +242,179 @@ barrier()
   m_buffer_copier->barrier();
 }
 
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+MutableMemoryView DataSynchronizeBufferBase::
+receiveBuffer(Int32 index)
+{
+  MutableMemoryView buf = m_ghost_buffer_info.localBuffer(index);
+  if (!_isCompressedMessage(buf.bytes().size()))
+    return buf;
+  const CompressedMessageInfo& info = m_compressed_receive_infos[index];
+  return MutableMemoryView(m_compressed_receive_buffer.span().subSpan(info.m_offset, info.m_size));
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*!
+ * \brief Buffer d'envoi pour le \a index-ème rang.
+ *
+ * Si la compression est active, le buffer retourné n'est valide qu'après
+ * l'appel à copyAllSend().
+ */
+MutableMemoryView DataSynchronizeBufferBase::
+sendBuffer(Int32 index)
+{
+  MutableMemoryView buf = m_share_buffer_info.localBuffer(index);
+  if (!_isCompressedMessage(buf.bytes().size()))
+    return buf;
+  const CompressedMessageInfo& info = m_compressed_send_infos[index];
+  return MutableMemoryView(m_compressed_send_buffer.span().subSpan(info.m_offset, info.m_size));
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+void DataSynchronizeBufferBase::
+copyAllSend()
+{
+  IDataSynchronizeBuffer::copyAllSend();
+  if (m_is_compression_active)
+    _compressSendBuffers();
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+void DataSynchronizeBufferBase::
+setCompression(IDataCompressor* compressor, Int64 threshold)
+{
+  m_compressor = compressor;
+  m_compression_threshold = threshold;
+  // Le compresseur peut ne pas être efficace pour les petits messages.
+  if (compressor && threshold >= 0)
+    m_compression_threshold = std::max(threshold, compressor->minCompressSize());
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*!
+ * \brief Calcule les informations pour la compression des messages.
+ *
+ * La taille d'un message compressé n'est connue qu'après sa réception.
+ * Le buffer de réception de chaque message compressé a donc la taille
+ * non compressée plus celle de l'en-tête.
+ */
+void DataSynchronizeBufferBase::
+_computeCompressionInfos()
+{
+  m_compression_stats = {};
+  m_is_compression_active = (m_compressor && m_compression_threshold >= 0);
+  if (!m_is_compression_active)
+    return;
+
+  m_compressed_send_infos.resize(m_nb_rank);
+  m_compressed_receive_infos.resize(m_nb_rank);
+  Int64 receive_offset = 0;
+  for (Int32 i = 0; i < m_nb_rank; ++i) {
+    m_compressed_send_infos[i] = {};
+    CompressedMessageInfo& info = m_compressed_receive_infos[i];
+    Int64 raw_size = m_ghost_buffer_info.localBuffer(i).bytes().size();
+    info.m_offset = receive_offset;
+    info.m_size = 0;
+    if (_isCompressedMessage(raw_size)) {
+      info.m_size = raw_size + COMPRESSED_HEADER_SIZE;
+      receive_offset += info.m_size;
+    }
+  }
+  m_compressed_receive_buffer.resize(receive_offset);
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*!
+ * \brief Compresse les buffers d'envoi.
+ *
+ * Les octets des valeurs de chaque donnée sont d'abord regroupés par
+ * poids avant d'être compressés. Si la compression ne permet pas de réduire la taille du
+ * message, les valeurs sont envoyées telles quelles.
+ */
+void DataSynchronizeBufferBase::
+_compressSendBuffers()
+{
+  Real begin_time = platform::getRealTime();
+  const Int32 datatype_size = m_share_buffer_info.m_datatype_size;
+
+  m_compressed_send_buffer.clear();
+  m_compressed_send_buffer.reserve(totalSendSize() + m_nb_rank * COMPRESSED_HEADER_SIZE);
+  for (Int32 i = 0; i < m_nb_rank; ++i) {
+    Span<const std::byte> raw_bytes = m_share_buffer_info.localBuffer(i).bytes();
+    const Int64 raw_size = raw_bytes.size();
+    CompressedMessageInfo& info = m_compressed_send_infos[i];
+    info.m_offset = m_compressed_send_buffer.size();
+    info.m_size = 0;
+    if (!_isCompressedMessage(raw_size))
+      continue;
+
+    m_compression_shuffle_buffer.resize(raw_size);
+    _shuffleBytes(raw_bytes, m_compression_shuffle_buffer.span(), m_data_datatype_sizes, datatype_size);
+    m_compressor->compress(m_compression_shuffle_buffer.span(), m_compression_work_buffer);
+
+    Int64 compressed_size = m_compression_work_buffer.size();
+    const bool is_compressed = (compressed_size < raw_size);
+    Span<const std::byte> payload = raw_bytes;
+    if (is_compressed)
+      payload = m_compression_work_buffer.span();
+    else
+      compressed_size = 0;
+
+    info.m_size = COMPRESSED_HEADER_SIZE + payload.size();
+    m_compressed_send_buffer.resize(info.m_offset + info.m_size);
+    std::byte* dest = m_compressed_send_buffer.data() + info.m_offset;
+    std::memcpy(dest, &compressed_size, COMPRESSED_HEADER_SIZE);
+    std::memcpy(dest + COMPRESSED_HEADER_SIZE, payload.data(), payload.size());
+
+    m_compression_stats.m_nb_raw_byte += raw_size;
+    m_compression_stats.m_nb_compressed_byte += info.m_size;
+  }
+  m_compression_stats.m_compress_time += platform::getRealTime() - begin_time;
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+void DataSynchronizeBufferBase::
+_decompressReceiveBuffer(Int32 index)
+{
+  if (!m_is_compression_active)
+    return;
+  Span<std::byte> raw_bytes = m_ghost_buffer_info.localBuffer(index).bytes();
+  const Int64 raw_size = raw_bytes.size();
+  if (!_isCompressedMessage(raw_size))
+    return;
+
+  Real begin_time = platform::getRealTime();
+  const CompressedMessageInfo& info = m_compressed_receive_infos[index];
+  const std::byte* source = m_compressed_receive_buffer.data() + info.m_offset;
+  Int64 compressed_size = 0;
+  std::memcpy(&compressed_size, source, COMPRESSED_HEADER_SIZE);
+  source += COMPRESSED_HEADER_SIZE;
+  if (compressed_size == 0)
+    std::memcpy(raw_bytes.data(), source, raw_size);
+  else {
+    if (compressed_size < 0 || compressed_size >= raw_size)
+      ARCANE_FATAL("Bad compressed message size rank={0} size={1} raw_size={2}",
+                   targetRank(index), compressed_size, raw_size);
+    m_compression_shuffle_buffer.resize(raw_size);
+    m_compressor->decompress(Span<const std::byte>(source, compressed_size), m_compression_shuffle_buffer.span());
+    _unshuffleBytes(m_compression_shuffle_buffer.span(), raw_bytes, m_data_datatype_sizes,
+                    m_ghost_buffer_info.m_datatype_size);
+  }
+  m_compression_stats.m_nb_decompressed_byte += raw_size;
+  m_compression_stats.m_decompress_time += platform::getRealTime() - begin_time;
+}
+
 /*---------------------------------------------------------------------------*/
 /*---------------------------------------------------------------------------*/
 /*!
@@ -143,6 +434,7 @@ _compute(Int32 datatype_size)
   m_compare_sync_buffer_info.m_buffer_info = &m_sync_info->receiveInfo();
 
   _allocateBuffers(datatype_size);
+  _computeCompressionInfos();
 }
 
 /*---------------------------------------------------------------------------*/
@@ -157,26 +449,34 @@ _compute(Int32 datatype_size)
 void DataSynchronizeBufferBase::
 _allocateBuffers(Int32 datatype_size)
 {
-  Int64 total_ghost_buffer = m_sync_info->receiveInfo().totalNbItem();
-  Int64 total_share_buffer = m_sync_info->sendInfo().totalNbItem();
-
-  Int32 full_dim2_size = datatype_size;
-  Int64 total_size = total_ghost_buffer + total_share_buffer;
+  const Int32 alignment = m_rank_buffer_alignment;
+  Int64 ghost_size = m_ghost_buffer_info._computeDisplacements(m_nb_rank, alignment);
+  Int64 share_size = m_share_buffer_info._computeDisplacements(m_nb_rank, alignment);
+  Int64 compare_size = 0;
   if (m_is_compare_sync_values)
-    total_size += total_ghost_buffer;
-  m_memory->resize(total_size * full_dim2_size);
+    compare_size = m_compare_sync_buffer_info._computeDisplacements(m_nb_rank, alignment);
 
-  Int64 share_offset = total_ghost_buffer * full_dim2_size;
-  Int64 check_sync_offset = share_offset + total_share_buffer * full_dim2_size;
+  m_memory->resize(ghost_size + share_size + compare_size);
+
+  Int64 share_offset = ghost_size;
+  Int64 check_sync_offset = share_offset + share_size;
+
+  // S'il n'y a pas d'alignement, les buffers de chaque rang sont contigus
+  // et on peut conserver le type de la donnée dans la vue globale.
+  auto make_view = [&](Span<std::byte> bytes, Int64 nb_item) -> MutableMemoryView {
+    if (alignment == 0)
+      return makeMutableMemoryView(bytes.data(), datatype_size, nb_item);
+    return MutableMemoryView(bytes);
+  };
 
   Span<std::byte> buffer_span = m_memory->bytes();
-  auto s1 = buffer_span.subspan(0, share_offset);
-  m_ghost_buffer_info.m_memory_view = makeMutableMemoryView(s1.data(), full_dim2_size, total_ghost_buffer);
-  auto s2 = buffer_span.subspan(share_offset, total_share_buffer * full_dim2_size);
-  m_share_buffer_info.m_memory_view = makeMutableMemoryView(s2.data(), full_dim2_size, total_share_buffer);
+  auto s1 = buffer_span.subspan(0, ghost_size);
+  m_ghost_buffer_info.m_memory_view = make_view(s1, m_sync_info->receiveInfo().totalNbItem());
+  auto s2 = buffer_span.subspan(share_offset, share_size);
+  m_share_buffer_info.m_memory_view = make_view(s2, m_sync_info->sendInfo().totalNbItem());
   if (m_is_compare_sync_values) {
-    auto s3 = buffer_span.subspan(check_sync_offset, total_ghost_buffer * full_dim2_size);
-    m_compare_sync_buffer_info.m_memory_view = makeMutableMemoryView(s3.data(), full_dim2_size, total_ghost_buffer);
+    auto s3 = buffer_span.subspan(check_sync_offset, compare_size);
+    m_compare_sync_buffer_info.m_memory_view = make_view(s3, m_sync_info->receiveInfo().totalNbItem());
   }
 }
 
@@ -190,6 +490,7 @@ void SingleDataSynchronizeBuffer::
 copyReceiveAsync(Int32 index)
 {
   m_ghost_buffer_info.checkValid();
+  _decompressReceiveBuffer(index);
 
   MutableMemoryView var_values = dataView();
   ConstArrayView<Int32> indexes = m_ghost_buffer_info.localIds(index);
@@ -219,6 +520,8 @@ void SingleDataSynchronizeBuffer::
 prepareSynchronize(Int32 datatype_size, bool is_compare_sync)
 {
   m_is_compare_sync_values = is_compare_sync;
+  m_data_datatype_sizes.resize(1);
+  m_data_datatype_sizes[0] = datatype_size;
   _compute(datatype_size);
   if (!is_compare_sync)
     return;
@@ -275,9 +578,45 @@ finalizeSynchronize()
 void MultiDataSynchronizeBuffer::
 prepareSynchronize(Int32 datatype_size, [[maybe_unused]] bool is_compare_sync)
 {
+  _computeDataOrder();
+  m_data_datatype_sizes.clear();
+  for (Int32 data_index : m_data_order)
+    m_data_datatype_sizes.add(m_data_views[data_index].datatypeSize());
   _compute(datatype_size);
 }
 
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*!
+ * \brief Calcule l'ordre de rangement des données dans le buffer d'un rang.
+ *
+ * Les données sont rangées par alignement décroissant. L'alignement d'une
+ * donnée est la plus grande puissance de 2 (limitée à RANK_BUFFER_ALIGNMENT)
+ * qui divise la taille de son type. Comme le début du buffer de chaque
+ * rang est aligné sur RANK_BUFFER_ALIGNMENT, les valeurs de chaque donnée
+ * sont alors correctement alignées.
+ *
+ * L'ordre ne dépend que des types des données et est donc le même sur
+ * tous les rangs.
+ */
+void MultiDataSynchronizeBuffer::
+_computeDataOrder()
+{
+  auto get_alignment = [](Int32 datatype_size) -> Int32 {
+    Int32 alignment = 1;
+    while (alignment < RANK_BUFFER_ALIGNMENT && (datatype_size % (alignment * 2)) == 0)
+      alignment *= 2;
+    return alignment;
+  };
+  const Int32 nb_data = m_data_views.size();
+  m_data_order.resize(nb_data);
+  for (Int32 i = 0; i < nb_data; ++i)
+    m_data_order[i] = i;
+  std::stable_sort(m_data_order.begin(), m_data_order.end(), [&](Int32 a, Int32 b) {
+    return get_alignment(m_data_views[a].datatypeSize()) > get_alignment(m_data_views[b].datatypeSize());
+  });
+}
+
 /*---------------------------------------------------------------------------*/
 /*---------------------------------------------------------------------------*/
 
@@ -286,12 +625,14 @@ copyReceiveAsync(Int32 index)
 {
   IBufferCopier* copier = m_buffer_copier.get();
   m_ghost_buffer_info.checkValid();
+  _decompressReceiveBuffer(index);
 
   Int64 data_offset = 0;
   Span<const std::byte> local_buffer_bytes = m_ghost_buffer_info.localBuffer(index).bytes();
   Int32ConstArrayView indexes = m_ghost_buffer_info.localIds(index);
   const Int64 nb_element = indexes.size();
-  for (MutableMemoryView var_values : m_data_views) {
+  for (Int32 data_index : m_data_order) {
+    MutableMemoryView var_values = m_data_views[data_index];
     Int32 datatype_size = var_values.datatypeSize();
     Int64 current_size_in_bytes = nb_element * datatype_size;
     Span<const std::byte> sub_local_buffer_bytes = local_buffer_bytes.subSpan(data_offset, current_size_in_bytes);
@@ -315,7 +656,8 @@ copySendAsync(Int32 index)
   Span<std::byte> local_buffer_bytes = m_share_buffer_info.localBuffer(index).bytes();
   Int32ConstArrayView indexes = m_share_buffer_info.localIds(index);
   const Int64 nb_element = indexes.size();
-  for (ConstMemoryView var_values : m_data_views) {
+  for (Int32 data_index : m_data_order) {
+    ConstMemoryView var_values = m_data_views[data_index];
     Int32 datatype_size = var_values.datatypeSize();
     Int64 current_size_in_bytes = nb_element * datatype_size;
     Span<std::byte> sub_local_buffer_bytes = local_buffer_bytes.subSpan(data_offset, current_size_in_bytes);
@@ -1,11 +1,11 @@
 ﻿// -*- tab-width: 2; indent-tabs-mode: nil; coding: utf-8-with-signature -*-
 //-----------------------------------------------------------------------------
-// Copyright 2000-2023 CEA (www.cea.fr) IFPEN (www.ifpenergiesnouvelles.com)
+// Copyright 2000-2024 CEA (www.cea.fr) IFPEN (www.ifpenergiesnouvelles.com)
 // See the top-level COPYRIGHT file for details.
 // SPDX-License-Identifier: Apache-2.0
 //-----------------------------------------------------------------------------
 /*---------------------------------------------------------------------------*/
-/* DataSynchronizeDispatcher.cc                                (C) 2000-2023 */
+/* DataSynchronizeDispatcher.cc                                (C) 2000-2024 */
 /*                                                                           */
 /* Gestion de la synchronisation d'une instance de 'IData'.                  */
 /*---------------------------------------------------------------------------*/
@@ -26,6 +26,7 @@
 #include "arcane/core/ISerializer.h"
 #include "arcane/core/IParallelMng.h"
 #include "arcane/core/IData.h"
+#include "arcane/core/parallel/IStat.h"
 #include "arcane/core/internal/IDataInternal.h"
 
 #include "arcane/impl/DataSynchronizeInfo.h"
@@ -73,6 +74,8 @@ class DataSynchronizeDispatcherBase
  protected:
 
   void _compute();
+  void _setCompression(DataSynchronizeBufferBase& buffer, IDataCompressor* compressor, Int64 threshold);
+  void _addCompressionStats(const DataSynchronizeBufferBase& buffer);
 };
 
 /*---------------------------------------------------------------------------*/
@@ -109,6 +112,40 @@ _compute()
 /*---------------------------------------------------------------------------*/
 /*---------------------------------------------------------------------------*/
 
+void DataSynchronizeDispatcherBase::
+_setCompression(DataSynchronizeBufferBase& buffer, IDataCompressor* compressor, Int64 threshold)
+{
+  // Les messages compressés ont une taille variable.
+  if (!m_synchronize_implementation->isVariableSizeMessageSupported())
+    compressor = nullptr;
+  buffer.setCompression(compressor, threshold);
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*!
+ * \brief Ajoute aux statistiques de synchronisation celles de la compression.
+ *
+ * Le rapport entre la taille de 'SyncCompressedSize' et celle de
+ * 'SyncCompress' donne le taux de compression.
+ */
+void DataSynchronizeDispatcherBase::
+_addCompressionStats(const DataSynchronizeBufferBase& buffer)
+{
+  if (!buffer.isCompressionActive())
+    return;
+  Parallel::IStat* s = m_parallel_mng->stat();
+  if (!s)
+    return;
+  const DataSynchronizeCompressionStats& stats = buffer.compressionStats();
+  s->add("SyncCompress", stats.m_compress_time, stats.m_nb_raw_byte);
+  s->add("SyncCompressedSize", 0.0, stats.m_nb_compressed_byte);
+  s->add("SyncDecompress", stats.m_decompress_time, stats.m_nb_decompressed_byte);
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
 /*---------------------------------------------------------------------------*/
 /*---------------------------------------------------------------------------*/
 /*!
@@ -133,6 +170,10 @@ class ARCANE_IMPL_EXPORT DataSynchronizeDispatcher
 
   void compute() override { _compute(); }
   void setSynchronizeBuffer(Ref<MemoryBuffer> buffer) override { m_sync_buffer.setSynchronizeBuffer(buffer); }
+  void setCompression(IDataCompressor* compressor, Int64 threshold) override
+  {
+    _setCompression(m_sync_buffer, compressor, threshold);
+  }
   void beginSynchronize(INumericDataInternal* data, bool is_compare_sync) override;
   DataSynchronizeResult endSynchronize() override;
 
@@ -182,6 +223,7 @@ endSynchronize()
   if (!m_is_empty_sync) {
     m_synchronize_implementation->endSynchronize(&m_sync_buffer);
     result = m_sync_buffer.finalizeSynchronize();
+    _addCompressionStats(m_sync_buffer);
   }
   m_is_in_sync = false;
   return result;
@@ -220,7 +262,13 @@ class ARCANE_IMPL_EXPORT DataSynchronizeMultiDispatcher
 
   void compute() override {}
   void setSynchronizeBuffer(Ref<MemoryBuffer>) override {}
+  // Les messages sont gérés par un IParallelExchanger et ne sont pas compressés.
+  void setCompression(IDataCompressor*, Int64) override {}
   void synchronize(ConstArrayView<IVariable*> vars) override;
+  // Cette implémentation ne supporte pas le mode non bloquant. La
+  // synchronisation est donc complètement effectuée dans beginSynchronize().
+  void beginSynchronize(ConstArrayView<IVariable*> vars) override { synchronize(vars); }
+  void endSynchronize() override {}
 
  private:
 
@@ -294,11 +342,18 @@ class ARCANE_IMPL_EXPORT DataSynchronizeMultiDispatcherV2
 
   void compute() override { _compute(); }
   void setSynchronizeBuffer(Ref<MemoryBuffer> buffer) override { m_sync_buffer.setSynchronizeBuffer(buffer); }
+  void setCompression(IDataCompressor* compressor, Int64 threshold) override
+  {
+    _setCompression(m_sync_buffer, compressor, threshold);
+  }
   void synchronize(ConstArrayView<IVariable*> vars) override;
+  void beginSynchronize(ConstArrayView<IVariable*> vars) override;
+  void endSynchronize() override;
 
  private:
 
   MultiDataSynchronizeBuffer m_sync_buffer;
+  bool m_is_in_sync = false;
 };
 
 /*---------------------------------------------------------------------------*/
@@ -307,6 +362,20 @@ class ARCANE_IMPL_EXPORT DataSynchronizeMultiDispatcherV2
 void DataSynchronizeMultiDispatcherV2::
 synchronize(ConstArrayView<IVariable*> vars)
 {
+  beginSynchronize(vars);
+  endSynchronize();
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+void DataSynchronizeMultiDispatcherV2::
+beginSynchronize(ConstArrayView<IVariable*> vars)
+{
+  if (m_is_in_sync)
+    ARCANE_FATAL("beginSynchronize() has already been called");
+  m_is_in_sync = true;
+
   const Int32 nb_var = vars.size();
   m_sync_buffer.setNbData(nb_var);
 
@@ -330,7 +399,19 @@ synchronize(ConstArrayView<IVariable*> vars)
   m_sync_buffer.prepareSynchronize(all_datatype_size, is_compare_sync);
 
   m_synchronize_implementation->beginSynchronize(&m_sync_buffer);
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+void DataSynchronizeMultiDispatcherV2::
+endSynchronize()
+{
+  if (!m_is_in_sync)
+    ARCANE_FATAL("No pending synchronize(). You need to call beginSynchronize() before");
   m_synchronize_implementation->endSynchronize(&m_sync_buffer);
+  _addCompressionStats(m_sync_buffer);
+  m_is_in_sync = false;
 }
 
 /*---------------------------------------------------------------------------*/
@@ -38,6 +38,8 @@
 #include <iostream>
 #include <iomanip>
 #include <fstream>
+#include <algorithm>
+#include <vector>
 
 /*---------------------------------------------------------------------------*/
 /*---------------------------------------------------------------------------*/
@@ -48,6 +50,27 @@ namespace Arcane
 /*---------------------------------------------------------------------------*/
 /*---------------------------------------------------------------------------*/
 
+namespace
+{
+  using LoopStatInfo = std::pair<String, impl::ForLoopProfilingStat>;
+
+  //! Liste des statistiques de \a stat_list triée par temps d'exécution décroissant
+  std::vector<LoopStatInfo>
+  _sortedLoopStat(const impl::ForLoopStatInfoList& stat_list)
+  {
+    const auto& stat_map = stat_list._internalImpl()->m_stat_map;
+    std::vector<LoopStatInfo> sorted_list(stat_map.begin(), stat_map.end());
+    auto sort_func = [](const LoopStatInfo& a, const LoopStatInfo& b) {
+      return a.second.execTime() > b.second.execTime();
+    };
+    std::stable_sort(sorted_list.begin(), sorted_list.end(), sort_func);
+    return sorted_list;
+  }
+} // namespace
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
 void ExecutionStatsDumper::
 _dumpProfilingJSON(JSONWriter& json_writer)
 {
@@ -56,13 +79,17 @@ _dumpProfilingJSON(JSONWriter& json_writer)
     JSONWriter::Object jo(json_writer);
     json_writer.writeKey("Loops");
     json_writer.beginArray();
-    for (const auto& x : stat_list._internalImpl()->m_stat_map) {
+    for (const auto& x : _sortedLoopStat(stat_list)) {
       JSONWriter::Object jo2(json_writer);
       const auto& s = x.second;
       json_writer.write("Name", x.first);
       json_writer.write("TotalTime", s.execTime());
       json_writer.write("NbLoop", s.nbCall());
       json_writer.write("NbChunk", s.nbChunk());
+      json_writer.write("MeanTime", s.meanTime());
+      json_writer.write("NbElement", s.nbElement());
+      json_writer.write("NbByte", s.nbByte());
+      json_writer.write("Bandwidth", s.bandwidth());
     }
     json_writer.endArray();
   };
@@ -101,10 +128,14 @@ _dumpProfilingTable(ISimpleTableOutput* table)
   table->addColumn("TotalTime");
   table->addColumn("NbLoop");
   table->addColumn("NbChunk");
+  table->addColumn("MeanTime");
+  table->addColumn("NbElement");
+  table->addColumn("NbByte");
+  table->addColumn("Bandwidth");
 
   Integer list_index = 0;
   auto f = [&](const impl::ForLoopStatInfoList& stat_list) {
-    for (const auto& x : stat_list._internalImpl()->m_stat_map) {
+    for (const auto& x : _sortedLoopStat(stat_list)) {
       const auto& s = x.second;
       String row_name = x.first;
       if (list_index > 0)
@@ -113,6 +144,10 @@ _dumpProfilingTable(ISimpleTableOutput* table)
       table->addElementInRow(row, static_cast<Real>(s.execTime()));
       table->addElementInRow(row, static_cast<Real>(s.nbCall()));
       table->addElementInRow(row, static_cast<Real>(s.nbChunk()));
+      table->addElementInRow(row, static_cast<Real>(s.meanTime()));
+      table->addElementInRow(row, static_cast<Real>(s.nbElement()));
+      table->addElementInRow(row, static_cast<Real>(s.nbByte()));
+      table->addElementInRow(row, s.bandwidth());
     }
     ++list_index;
   };
@@ -150,35 +185,23 @@ _dumpProfiling(std::ostream& o)
 void ExecutionStatsDumper::
 _dumpOneLoopListStat(std::ostream& o, const impl::ForLoopStatInfoList& stat_list)
 {
-  struct SortedStatInfo
-  {
-    bool operator<(const SortedStatInfo& rhs) const
-    {
-      return m_stat.execTime() > rhs.m_stat.execTime();
-    }
-    String m_name;
-    impl::ForLoopProfilingStat m_stat;
-  };
-
   // Met 1 pour éviter de diviser par zéro.
   Int64 cumulative_total = 1;
 
   // Tri les fonctions par temps d'exécution décroissant
-  std::set<SortedStatInfo> sorted_set;
-  for (const auto& x : stat_list._internalImpl()->m_stat_map) {
-    const auto& s = x.second;
-    sorted_set.insert({ x.first, s });
-    cumulative_total += s.execTime();
-  }
+  auto sorted_list = _sortedLoopStat(stat_list);
+  for (const auto& x : sorted_list)
+    cumulative_total += x.second.execTime();
 
   o << "ProfilingStat\n";
   o << std::setw(10) << "Ncall" << std::setw(10) << "Nchunk"
     << std::setw(11) << " T (ms)" << std::setw(10) << "Tck (ns)"
-    << "     %  name\n";
+    << "     %      GB/s  name\n";
 
   char old_filler = o.fill();
-  for (const auto& x : sorted_set) {
-    const impl::ForLoopProfilingStat& s = x.m_stat;
+  std::streamsize old_precision = o.precision();
+  for (const auto& x : sorted_list) {
+    const impl::ForLoopProfilingStat& s = x.second;
     Int64 nb_loop = s.nbCall();
     Int64 nb_chunk = s.nbChunk();
     Int64 total_time_ns = s.execTime();
@@ -194,7 +217,9 @@ _dumpOneLoopListStat(std::ostream& o, const impl::ForLoopStatInfoList& stat_list
       << std::setw(7) << total_time_ms << ".";
     o << std::setfill('0') << std::setw(3) << total_time_remaining_us << std::setfill(old_filler);
     o << std::setw(10) << time_per_chunk
-      << std::setw(4) << percent << "." << percent_digit << "  " << x.m_name << "\n";
+      << std::setw(4) << percent << "." << percent_digit
+      << std::setw(10) << std::fixed << std::setprecision(2) << s.bandwidth()
+      << std::defaultfloat << std::setprecision(old_precision) << "  " << x.first << "\n";
   }
   o << "TOTAL=" << cumulative_total / 1000000 << "\n";
 }
@@ -1,11 +1,11 @@
 ﻿// -*- tab-width: 2; indent-tabs-mode: nil; coding: utf-8-with-signature -*-
 //-----------------------------------------------------------------------------
-// Copyright 2000-2023 CEA (www.cea.fr) IFPEN (www.ifpenergiesnouvelles.com)
+// Copyright 2000-2024 CEA (www.cea.fr) IFPEN (www.ifpenergiesnouvelles.com)
 // See the top-level COPYRIGHT file for details.
 // SPDX-License-Identifier: Apache-2.0
 //-----------------------------------------------------------------------------
 /*---------------------------------------------------------------------------*/
-/* IDataSynchronizeBuffer.h                                    (C) 2000-2023 */
+/* IDataSynchronizeBuffer.h                                    (C) 2000-2024 */
 /*                                                                           */
 /* Interface d'un buffer générique pour la synchronisation de donnéess.      */
 /*---------------------------------------------------------------------------*/
@@ -48,6 +48,8 @@ namespace Arcane
  * pour l'envoi et globalReceiveBuffer() pour la réception. Il est aussi
  * possible dans ce de récupérer le déplacement de chaque sous-partie via
  * les méthodes sendDisplacement() ou receiveDisplacement().
+ * Les buffers de chaque partie ne sont pas forcément contigus dans le
+ * buffer global.
  */
 class ARCANE_IMPL_EXPORT IDataSynchronizeBuffer
 {
@@ -66,6 +68,15 @@ class ARCANE_IMPL_EXPORT IDataSynchronizeBuffer
   //! Indique si les buffers sont globaux.
   virtual bool hasGlobalBuffer() const = 0;
 
+  /*!
+   * \brief Taille (en octet) du type de la donnée pour une entité.
+   *
+   * Pour une synchronisation de plusieurs données, il s'agit de la somme
+   * des tailles des types de chaque donnée. Cette valeur est la même sur
+   * tous les rangs.
+   */
+  virtual Int32 datatypeSize() const = 0;
+
   //! Buffer d'envoi
   virtual MutableMemoryView globalSendBuffer() = 0;
 
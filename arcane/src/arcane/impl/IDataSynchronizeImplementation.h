@@ -1,11 +1,11 @@
 ﻿// -*- tab-width: 2; indent-tabs-mode: nil; coding: utf-8-with-signature -*-
 //-----------------------------------------------------------------------------
-// Copyright 2000-2023 CEA (www.cea.fr) IFPEN (www.ifpenergiesnouvelles.com)
+// Copyright 2000-2024 CEA (www.cea.fr) IFPEN (www.ifpenergiesnouvelles.com)
 // See the top-level COPYRIGHT file for details.
 // SPDX-License-Identifier: Apache-2.0
 //-----------------------------------------------------------------------------
 /*---------------------------------------------------------------------------*/
-/* IDataSynchronizeImplementation.h                            (C) 2000-2023 */
+/* IDataSynchronizeImplementation.h                            (C) 2000-2024 */
 /*                                                                           */
 /* Interface pour l'implémentation d'une synchronisation de variables.       */
 /*---------------------------------------------------------------------------*/
@@ -62,6 +62,15 @@ class ARCANE_IMPL_EXPORT IDataSynchronizeImplementation
   virtual void compute() = 0;
   virtual void beginSynchronize(IDataSynchronizeBuffer* buf) = 0;
   virtual void endSynchronize(IDataSynchronizeBuffer* buf) = 0;
+
+  /*!
+   * \brief Indique si l'implémentation supporte les messages de taille variable.
+   *
+   * Si vrai, un message envoyé peut être plus petit que le buffer de réception
+   * associé et IDataSynchronizeBuffer::hasGlobalBuffer() peut être faux.
+   * Cela est nécessaire pour pouvoir compresser les messages.
+   */
+  virtual bool isVariableSizeMessageSupported() const { return false; }
 };
 
 /*---------------------------------------------------------------------------*/
@@ -1,6 +1,6 @@
 ﻿// -*- tab-width: 2; indent-tabs-mode: nil; coding: utf-8-with-signature -*-
 //-----------------------------------------------------------------------------
-// Copyright 2000-2023 CEA (www.cea.fr) IFPEN (www.ifpenergiesnouvelles.com)
+// Copyright 2000-2024 CEA (www.cea.fr) IFPEN (www.ifpenergiesnouvelles.com)
 // See the top-level COPYRIGHT file for details.
 // SPDX-License-Identifier: Apache-2.0
 //-----------------------------------------------------------------------------
@@ -19,6 +19,7 @@
 #include "arcane/utils/ITraceMng.h"
 #include "arcane/utils/IMemoryRessourceMng.h"
 #include "arcane/utils/ValueConvert.h"
+#include "arcane/utils/IDataCompressor.h"
 #include "arcane/utils/internal/MemoryBuffer.h"
 
 #include "arcane/core/VariableSynchronizerEventArgs.h"
@@ -32,6 +33,7 @@
 #include "arcane/core/IMesh.h"
 #include "arcane/core/IVariableMng.h"
 #include "arcane/core/IVariableSynchronizerMng.h"
+#include "arcane/core/ServiceBuilder.h"
 #include "arcane/core/parallel/IStat.h"
 #include "arcane/core/internal/IDataInternal.h"
 #include "arcane/core/internal/IParallelMngInternal.h"
@@ -44,6 +46,7 @@
 #include "arcane/impl/internal/IBufferCopier.h"
 
 #include <algorithm>
+#include <memory>
 
 /*---------------------------------------------------------------------------*/
 /*---------------------------------------------------------------------------*/
@@ -92,13 +95,16 @@ class VariableSynchronizer::SyncMessage
  public:
 
   SyncMessage(const DataSynchronizeDispatcherBuildInfo& bi, VariableSynchronizer* var_syncer,
-              IMemoryAllocator* allocator)
+              IMemoryAllocator* allocator, RunQueue* default_queue)
   : m_variable_synchronizer(var_syncer)
   , m_variable_synchronizer_mng(var_syncer->synchronizeMng())
   , m_dispatcher(IDataSynchronizeDispatcher::create(bi))
   , m_multi_dispatcher(IDataSynchronizeMultiDispatcher::create(bi))
   , m_event_args(var_syncer)
+  , m_sync_info(bi.synchronizeInfo())
   , m_allocator(allocator)
+  , m_buffer_copier(bi.bufferCopier())
+  , m_default_queue(default_queue)
   {
     if (!m_dispatcher)
       ARCANE_FATAL("No synchronizer created");
@@ -138,27 +144,64 @@ class VariableSynchronizer::SyncMessage
 
   //! Effectue la synchronisation
   void synchronize()
+  {
+    beginSynchronize(nullptr);
+    endSynchronize();
+  }
+
+  /*!
+   * \brief Commence la synchronisation.
+   *
+   * Si \a queue n'est pas nul, elle est utilisée pour les recopies entre
+   * les variables et les buffers.
+   */
+  void beginSynchronize(RunQueue* queue)
   {
     Int32 nb_var = m_variables.size();
     if (nb_var == 0)
       return;
+    _setCopyQueue(queue);
+    // Le buffer doit être conservé jusqu'à la fin de la synchronisation.
+    m_pending_buffer = std::make_unique<ScopedBuffer>(m_variable_synchronizer_mng->_internalApi(), m_allocator);
+    Int64 compression_threshold = _compressionThreshold();
+    IDataCompressor* compressor = nullptr;
+    if (compression_threshold >= 0)
+      compressor = m_variable_synchronizer->_compressor();
     if (nb_var == 1) {
       bool is_compare_sync = m_variable_synchronizer_mng->isSynchronizationComparisonEnabled();
-      m_synchronize_result = synchronizeData(m_data_list[0], is_compare_sync);
+      m_dispatcher->setSynchronizeBuffer(m_pending_buffer->m_buffer);
+      m_dispatcher->setCompression(compressor, compression_threshold);
+      m_dispatcher->beginSynchronize(m_data_list[0], is_compare_sync);
     }
-    if (nb_var >= 2) {
-      ScopedBuffer tmp_buf(m_variable_synchronizer_mng->_internalApi(), m_allocator);
-      m_multi_dispatcher->setSynchronizeBuffer(tmp_buf.m_buffer);
-      m_multi_dispatcher->synchronize(m_variables);
+    else {
+      m_multi_dispatcher->setSynchronizeBuffer(m_pending_buffer->m_buffer);
+      m_multi_dispatcher->setCompression(compressor, compression_threshold);
+      m_multi_dispatcher->beginSynchronize(m_variables);
     }
+  }
+
+  //! Termine la synchronisation commencée par beginSynchronize()
+  void endSynchronize()
+  {
+    Int32 nb_var = m_variables.size();
+    if (nb_var == 0)
+      return;
+    if (nb_var == 1)
+      m_synchronize_result = m_dispatcher->endSynchronize();
+    else
+      m_multi_dispatcher->endSynchronize();
+    m_pending_buffer.reset();
+    m_buffer_copier->setRunQueue(m_default_queue);
     for (IVariable* var : m_variables)
       var->setIsSynchronized();
+    _computeMessageInfo();
   }
 
   DataSynchronizeResult synchronizeData(INumericDataInternal* data, bool is_compare_sync)
   {
     ScopedBuffer tmp_buf(m_variable_synchronizer_mng->_internalApi(), m_allocator);
     m_dispatcher->setSynchronizeBuffer(tmp_buf.m_buffer);
+    m_dispatcher->setCompression(nullptr, -1);
     m_dispatcher->beginSynchronize(data, is_compare_sync);
     return m_dispatcher->endSynchronize();
   }
@@ -167,18 +210,96 @@ class VariableSynchronizer::SyncMessage
 
  private:
 
-  IVariableSynchronizer* m_variable_synchronizer = nullptr;
+  VariableSynchronizer* m_variable_synchronizer = nullptr;
   IVariableSynchronizerMng* m_variable_synchronizer_mng = nullptr;
   Ref<IDataSynchronizeDispatcher> m_dispatcher;
   IDataSynchronizeMultiDispatcher* m_multi_dispatcher = nullptr;
   VariableSynchronizerEventArgs m_event_args;
+  Ref<DataSynchronizeInfo> m_sync_info;
   UniqueArray<IVariable*> m_variables;
   UniqueArray<INumericDataInternal*> m_data_list;
   DataSynchronizeResult m_synchronize_result;
   IMemoryAllocator* m_allocator = nullptr;
+  Ref<IBufferCopier> m_buffer_copier;
+  //! File utilisée par défaut pour les recopies
+  RunQueue* m_default_queue = nullptr;
+  //! Buffer utilisé pour la synchronisation en cours
+  std::unique_ptr<ScopedBuffer> m_pending_buffer;
+  //! Indique si on a déjà signalé que la file de recopie est ignorée
+  bool m_has_warned_ignored_queue = false;
 
  private:
 
+  /*!
+   * \brief Calcule les informations sur les messages envoyés.
+   *
+   * Les valeurs de toutes les variables à destination d'un même rang
+   * sont envoyées dans un seul message. Les tailles sont celles des
+   * données non compressées.
+   */
+  void _computeMessageInfo()
+  {
+    Int64 total_datatype_size = 0;
+    for (INumericDataInternal* data : m_data_list)
+      total_datatype_size += data->memoryView().datatypeSize();
+    const DataSynchronizeBufferInfoList& send_info = m_sync_info->sendInfo();
+    Int32 nb_message = 0;
+    for (Int32 i = 0, n = send_info.nbRank(); i < n; ++i)
+      if (send_info.nbItem(i) != 0)
+        ++nb_message;
+    Int64 total_size = send_info.totalNbItem() * total_datatype_size;
+    Int32 nb_saved_message = (m_data_list.size() - 1) * nb_message;
+    m_event_args.setMessageInfo(nb_message, total_size, nb_saved_message);
+  }
+
+  void _setCopyQueue(RunQueue* queue)
+  {
+    if (!queue)
+      return;
+    // Si les buffers ne sont pas alloués sur l'accélérateur, ils ne sont pas
+    // forcément accessibles depuis une file accélérateur. Dans ce cas on
+    // conserve la file par défaut.
+    if (!m_allocator && queue->isAcceleratorPolicy()) {
+      if (!m_has_warned_ignored_queue) {
+        m_has_warned_ignored_queue = true;
+        m_variable_synchronizer->pwarning() << "beginSynchronize(): the accelerator queue is ignored"
+                                            << " because the synchronization buffers are not"
+                                            << " allocated on the accelerator";
+      }
+      return;
+    }
+    m_buffer_copier->setRunQueue(queue);
+  }
+
+  /*!
+   * \brief Seuil de compression des messages pour les variables à synchroniser.
+   *
+   * Le seuil est donné par le tag 'SyncCompressionThreshold' des variables
+   * ou à défaut par la variable d'environnement
+   * ARCANE_SYNCHRONIZE_COMPRESSION_THRESHOLD. Pour que la compression soit
+   * active, toutes les variables doivent avoir un seuil et dans ce cas on
+   * prend le plus petit. La compression n'est
+   * possible que si les buffers sont alloués sur l'hôte.
+   *
+   * Retourne -1 si la compression n'est pas active.
+   */
+  Int64 _compressionThreshold() const
+  {
+    if (m_allocator)
+      return -1;
+    Int64 threshold = -1;
+    for (IVariable* var : m_variables) {
+      String tag_value = var->tagValue("SyncCompressionThreshold");
+      Int64 var_threshold = m_variable_synchronizer->_defaultCompressionThreshold();
+      if (!tag_value.null() && builtInGetValue(var_threshold, tag_value))
+        return -1;
+      if (var_threshold < 0)
+        return -1;
+      threshold = (threshold < 0) ? var_threshold : std::min(threshold, var_threshold);
+    }
+    return threshold;
+  }
+
   void _reset()
   {
     m_variables.clear();
@@ -229,6 +350,11 @@ VariableSynchronizer(IParallelMng* pm, const ItemGroup& group,
   if (auto v = Convert::Type<Int32>::tryParseFromEnvironment("ARCANE_CHECK_SYNCHRONIZE_COHERENCE",true))
     m_is_check_coherence = (v.value()!=0);
 
+  // Seuil de compression des messages pour les variables sans tag
+  // 'SyncCompressionThreshold'. Cette valeur doit être la même sur tous les rangs.
+  if (auto v = Convert::Type<Int64>::tryParseFromEnvironment("ARCANE_SYNCHRONIZE_COMPRESSION_THRESHOLD",true))
+    m_default_compression_threshold = v.value();
+
   m_default_message = _buildMessage();
   m_partial_message = makeRef<SyncMessage>(_buildMessage(m_partial_sync_info));
 }
@@ -243,6 +369,32 @@ VariableSynchronizer::
   delete m_default_message;
 }
 
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*!
+ * \brief Compresseur utilisé pour les messages de synchronisation.
+ *
+ * Le compresseur est créé lors du premier appel. Le nom du service peut
+ * être spécifié via la variable d'environnement ARCANE_SYNCHRONIZE_COMPRESSOR.
+ * Retourne nul si le service n'est pas disponible.
+ */
+IDataCompressor* VariableSynchronizer::
+_compressor()
+{
+  if (!m_is_compressor_initialized) {
+    m_is_compressor_initialized = true;
+    String service_name = platform::getEnvironmentVariable("ARCANE_SYNCHRONIZE_COMPRESSOR");
+    if (service_name.null())
+      service_name = "LZ4DataCompressor";
+    ServiceBuilder<IDataCompressor> sb(m_item_group.mesh()->handle().application());
+    m_compressor = sb.createReference(service_name, SB_AllowNull);
+    if (!m_compressor.get())
+      pwarning() << "Can not create compressor service '" << service_name
+                 << "' for synchronizations. Compression is disabled.";
+  }
+  return m_compressor.get();
+}
+
 /*---------------------------------------------------------------------------*/
 /*---------------------------------------------------------------------------*/
 
@@ -279,11 +431,13 @@ _buildMessage(Ref<DataSynchronizeInfo>& sync_info)
   auto* internal_pm = m_parallel_mng->_internalApi();
 
   IMemoryAllocator* allocator = nullptr;
+  RunQueue* default_queue = nullptr;
   // Si le IParallelMng gère la mémoire des accélérateurs alors on alloue le
   // buffer sur le device. On pourrait utiliser la mémoire managée mais certaines
   // implémentations MPI (i.e: BXI) ne le supportent pas.
   if (m_runner) {
-    buffer_copier->setRunQueue(internal_pm->defaultQueue());
+    default_queue = internal_pm->defaultQueue();
+    buffer_copier->setRunQueue(default_queue);
     allocator = platform::getDataMemoryRessourceMng()->getAllocator(eMemoryRessource::Device);
   }
 
@@ -292,7 +446,7 @@ _buildMessage(Ref<DataSynchronizeInfo>& sync_info)
   sync_impl->setDataSynchronizeInfo(sync_info.get());
 
   DataSynchronizeDispatcherBuildInfo bi(m_parallel_mng, sync_impl, sync_info, buffer_copier);
-  return new SyncMessage(bi, this, allocator);
+  return new SyncMessage(bi, this, allocator, default_queue);
 }
 
 /*---------------------------------------------------------------------------*/
@@ -303,6 +457,7 @@ _buildMessage(Ref<DataSynchronizeInfo>& sync_info)
 void VariableSynchronizer::
 compute()
 {
+  _checkNoPendingSynchronize();
   VariableSynchronizerComputeList computer(this);
   computer.compute();
 
@@ -333,6 +488,16 @@ _doSynchronize(SyncMessage* message)
     message->synchronize();
   }
 
+  _finalizeSynchronize(message, m_sync_timer->lastActivationTime());
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+void VariableSynchronizer::
+_finalizeSynchronize(SyncMessage* message, Real elapsed_time)
+{
+  VariableSynchronizerEventArgs& event_args = message->eventArgs();
   Int32 nb_var = message->nbVariable();
   // Si une seule variable, affiche le résutat de la comparaison de
   // la synchronisation
@@ -347,7 +512,38 @@ _doSynchronize(SyncMessage* message)
   }
 
   // Fin de la synchro
-  _sendEndEvent(event_args);
+  _sendEndEvent(event_args, elapsed_time);
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+void VariableSynchronizer::
+_beginSynchronize(SyncMessage* message, RunQueue* queue)
+{
+  Timer::Phase tphase(m_parallel_mng->timeStats(), TP_Communication);
+
+  _setCurrentDevice();
+
+  VariableSynchronizerEventArgs& event_args = message->eventArgs();
+  _sendBeginEvent(event_args);
+
+  {
+    Timer::Sentry ts2(m_sync_timer);
+    message->beginSynchronize(queue);
+  }
+  m_pending_message = message;
+  m_pending_elapsed_time = m_sync_timer->lastActivationTime();
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+void VariableSynchronizer::
+_checkNoPendingSynchronize()
+{
+  if (m_pending_message)
+    ARCANE_FATAL("A synchronization is in progress. You need to call endSynchronize() before");
 }
 
 /*---------------------------------------------------------------------------*/
@@ -426,6 +622,7 @@ _rebuildMessage(Int32ConstArrayView local_ids)
 void VariableSynchronizer::
 _synchronize(IVariable* var, SyncMessage* message)
 {
+  _checkNoPendingSynchronize();
   message->initialize(var);
 
   IParallelMng* pm = m_parallel_mng;
@@ -504,9 +701,67 @@ synchronize(VariableCollection vars, Int32ConstArrayView local_ids)
 /*---------------------------------------------------------------------------*/
 /*---------------------------------------------------------------------------*/
 
+void VariableSynchronizer::
+beginSynchronize(IVariable* var, RunQueue* queue)
+{
+  _checkNoPendingSynchronize();
+  SyncMessage* message = m_default_message;
+  message->initialize(var);
+  debug(Trace::High) << " Proc " << m_parallel_mng->commRank() << " BeginSync variable " << var->fullName();
+  _beginSynchronize(message, queue);
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+void VariableSynchronizer::
+beginSynchronize(VariableCollection vars, RunQueue* queue)
+{
+  _checkNoPendingSynchronize();
+  if (vars.empty())
+    return;
+  // Si on ne peut pas synchroniser les variables en une seule fois, il n'est
+  // pas possible de faire une synchronisation non bloquante. Dans ce cas on
+  // synchronise directement les variables.
+  if (!m_allow_multi_sync || !_canSynchronizeMulti(vars)) {
+    synchronize(vars);
+    return;
+  }
+  SyncMessage* message = m_default_message;
+  message->initialize(vars);
+  debug(Trace::High) << " Proc " << m_parallel_mng->commRank() << " BeginMultiSync variable";
+  _beginSynchronize(message, queue);
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+void VariableSynchronizer::
+endSynchronize()
+{
+  SyncMessage* message = m_pending_message;
+  // Ne fait rien si la synchronisation a été effectuée dans beginSynchronize().
+  if (!message)
+    return;
+  m_pending_message = nullptr;
+
+  Timer::Phase tphase(m_parallel_mng->timeStats(), TP_Communication);
+  _setCurrentDevice();
+  {
+    Timer::Sentry ts2(m_sync_timer);
+    message->endSynchronize();
+  }
+  Real elapsed_time = m_pending_elapsed_time + m_sync_timer->lastActivationTime();
+  _finalizeSynchronize(message, elapsed_time);
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
 DataSynchronizeResult VariableSynchronizer::
 _synchronize(INumericDataInternal* data, bool is_compare_sync)
 {
+  _checkNoPendingSynchronize();
   return m_default_message->synchronizeData(data, is_compare_sync);
 }
 
@@ -573,6 +828,7 @@ _canSynchronizeMulti(const VariableCollection& vars)
 void VariableSynchronizer::
 _synchronizeMulti(const VariableCollection& vars, SyncMessage* message)
 {
+  _checkNoPendingSynchronize();
   message->initialize(vars);
 
   IParallelMng* pm = m_parallel_mng;
@@ -627,10 +883,8 @@ _sendBeginEvent(VariableSynchronizerEventArgs& args)
 /*---------------------------------------------------------------------------*/
 
 void VariableSynchronizer::
-_sendEndEvent(VariableSynchronizerEventArgs& args)
+_sendEndEvent(VariableSynchronizerEventArgs& args, Real elapsed_time)
 {
-  ARCANE_CHECK_POINTER(m_sync_timer);
-  Real elapsed_time = m_sync_timer->lastActivationTime();
   m_parallel_mng->stat()->add("Synchronize", elapsed_time, 1);
   args.setState(VariableSynchronizerEventArgs::State::EndSynchronize);
   args.setElapsedTime(elapsed_time);
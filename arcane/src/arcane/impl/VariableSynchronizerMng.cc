@@ -1,11 +1,11 @@
 ﻿// -*- tab-width: 2; indent-tabs-mode: nil; coding: utf-8-with-signature -*-
 //-----------------------------------------------------------------------------
-// Copyright 2000-2023 CEA (www.cea.fr) IFPEN (www.ifpenergiesnouvelles.com)
+// Copyright 2000-2024 CEA (www.cea.fr) IFPEN (www.ifpenergiesnouvelles.com)
 // See the top-level COPYRIGHT file for details.
 // SPDX-License-Identifier: Apache-2.0
 //-----------------------------------------------------------------------------
 /*---------------------------------------------------------------------------*/
-/* VariableSynchronizerMng.cc                                  (C) 2000-2023 */
+/* VariableSynchronizerMng.cc                                  (C) 2000-2024 */
 /*                                                                           */
 /* Gestionnaire des synchroniseurs de variables.                             */
 /*---------------------------------------------------------------------------*/
@@ -142,6 +142,16 @@ class VariableSynchronizerStats
          << "   "
          << "TOTAL"
          << "\n\n";
+    if (m_nb_synchronize > 0) {
+      Int64 bytes_per_message = (m_nb_message > 0) ? (m_total_message_size / m_nb_message) : 0;
+      ostr << "Synchronization Messages (local rank)\n"
+           << "  nb_synchronize=" << m_nb_synchronize
+           << " nb_message=" << m_nb_message
+           << " total_size=" << m_total_message_size
+           << " bytes_per_message=" << bytes_per_message
+           << " nb_saved_message=" << m_nb_saved_message
+           << "\n\n";
+    }
     ostr.precision(old_precision);
     return total_stat.m_count;
   }
@@ -154,6 +164,11 @@ class VariableSynchronizerStats
   bool m_is_event_registered = false;
   UniqueArray<String> m_pending_variable_name_list;
   UniqueArray<unsigned char> m_pending_compare_status_list;
+  // Statistiques sur les messages envoyés par ce rang
+  Int64 m_nb_synchronize = 0;
+  Int64 m_nb_message = 0;
+  Int64 m_total_message_size = 0;
+  Int64 m_nb_saved_message = 0;
 
  private:
 
@@ -171,6 +186,10 @@ _handleEvent(const VariableSynchronizerEventArgs& args)
   Int32 level = m_variable_synchronizer_mng->synchronizationCompareLevel();
   IParallelMng* pm = m_variable_synchronizer_mng->parallelMng();
   auto compare_status_list = args.compareStatusList();
+  ++m_nb_synchronize;
+  m_nb_message += args.nbMessage();
+  m_total_message_size += args.totalMessageSize();
+  m_nb_saved_message += args.nbSavedMessage();
   {
     Int32 index = 0;
     for (IVariable* var : args.variables()) {
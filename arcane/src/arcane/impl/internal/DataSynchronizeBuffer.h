@@ -1,11 +1,11 @@
 ﻿// -*- tab-width: 2; indent-tabs-mode: nil; coding: utf-8-with-signature -*-
 //-----------------------------------------------------------------------------
-// Copyright 2000-2023 CEA (www.cea.fr) IFPEN (www.ifpenergiesnouvelles.com)
+// Copyright 2000-2024 CEA (www.cea.fr) IFPEN (www.ifpenergiesnouvelles.com)
 // See the top-level COPYRIGHT file for details.
 // SPDX-License-Identifier: Apache-2.0
 //-----------------------------------------------------------------------------
 /*---------------------------------------------------------------------------*/
-/* DataSynchronizeBuffer.h                                     (C) 2000-2023 */
+/* DataSynchronizeBuffer.h                                     (C) 2000-2024 */
 /*                                                                           */
 /* Implémentation d'un buffer générique pour la synchronisation de donnéess. */
 /*---------------------------------------------------------------------------*/
@@ -31,12 +31,44 @@ class DataSynchronizeResult;
 class DataSynchronizeInfo;
 class DataSynchronizeBufferInfoList;
 class MemoryBuffer;
+class IDataCompressor;
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*!
+ * \internal
+ * \brief Statistiques sur la compression des buffers de synchronisation.
+ */
+class DataSynchronizeCompressionStats
+{
+ public:
+
+  //! Nombre d'octets envoyés avant compression
+  Int64 m_nb_raw_byte = 0;
+  //! Nombre d'octets envoyés après compression (en-têtes compris)
+  Int64 m_nb_compressed_byte = 0;
+  //! Nombre d'octets reçus après décompression
+  Int64 m_nb_decompressed_byte = 0;
+  //! Temps passé dans la compression (en secondes)
+  Real m_compress_time = 0.0;
+  //! Temps passé dans la décompression (en secondes)
+  Real m_decompress_time = 0.0;
+};
 
 /*---------------------------------------------------------------------------*/
 /*---------------------------------------------------------------------------*/
 /*!
  * \internal
  * \brief Classe de base de l'implémentation de IDataSynchronizeBuffer.
+ *
+ * Si la compression est active (voir setCompression()), les messages dont
+ * la taille est supérieure ou égale au seuil de compression sont compressés
+ * après l'appel à copyAllSend() et décompressés lors de l'appel à
+ * copyReceiveAsync(). Dans ce cas, sendBuffer() et receiveBuffer() ne
+ * retournent plus des vues sur le buffer global et hasGlobalBuffer() est faux.
+ * La taille du message envoyé peut alors être inférieure à celle de
+ * receiveBuffer() et l'implémentation de la synchronisation doit le supporter
+ * (voir IDataSynchronizeImplementation::isVariableSizeMessageSupported()).
  */
 class ARCANE_IMPL_EXPORT DataSynchronizeBufferBase
 : public IDataSynchronizeBuffer
@@ -72,16 +104,23 @@ class ARCANE_IMPL_EXPORT DataSynchronizeBufferBase
     MutableMemoryView m_memory_view;
     Int32 m_datatype_size = 0;
     const DataSynchronizeBufferInfoList* m_buffer_info = nullptr;
+    //! Déplacement (en octet) du buffer de chaque rang
+    UniqueArray<Int64> m_displacements;
+
+   private:
+
+    Int64 _computeDisplacements(Int32 nb_rank, Int32 alignment);
   };
 
  public:
 
   Int32 nbRank() const final { return m_nb_rank; }
   Int32 targetRank(Int32 index) const final;
-  bool hasGlobalBuffer() const final { return true; }
+  bool hasGlobalBuffer() const final { return !m_is_compression_active; }
+  Int32 datatypeSize() const final { return m_share_buffer_info.m_datatype_size; }
 
-  MutableMemoryView receiveBuffer(Int32 index) final { return m_ghost_buffer_info.localBuffer(index); }
-  MutableMemoryView sendBuffer(Int32 index) final { return m_share_buffer_info.localBuffer(index); }
+  MutableMemoryView receiveBuffer(Int32 index) final;
+  MutableMemoryView sendBuffer(Int32 index) final;
 
   Int64 receiveDisplacement(Int32 index) const final { return m_ghost_buffer_info.displacement(index); }
   Int64 sendDisplacement(Int32 index) const final { return m_share_buffer_info.displacement(index); }
@@ -93,6 +132,7 @@ class ARCANE_IMPL_EXPORT DataSynchronizeBufferBase
   Int64 totalSendSize() const final { return m_share_buffer_info.totalSize(); }
 
   void barrier() final;
+  void copyAllSend() override;
 
  public:
 
@@ -108,6 +148,26 @@ class ARCANE_IMPL_EXPORT DataSynchronizeBufferBase
     m_memory = v;
   }
 
+  /*!
+   * \brief Positionne le compresseur à utiliser pour les messages.
+   *
+   * Les messages dont la taille est au moins \a threshold octets sont
+   * compressés avec \a compressor. Si \a compressor est nul ou si
+   * \a threshold est négatif, la compression est désactivée.
+   *
+   * La compression n'est possible que si les buffers sont accessibles
+   * depuis l'hôte. Le seuil doit être le même sur tous les rangs.
+   * La prise en compte de ces paramètres a lieu lors de l'appel à
+   * prepareSynchronize().
+   */
+  void setCompression(IDataCompressor* compressor, Int64 threshold);
+
+  //! Indique si la compression est active pour la synchronisation en cours
+  bool isCompressionActive() const { return m_is_compression_active; }
+
+  //! Statistiques de compression de la synchronisation en cours
+  const DataSynchronizeCompressionStats& compressionStats() const { return m_compression_stats; }
+
   /*!
    * \brief Prépare la synchronisation.
    *
@@ -126,6 +186,8 @@ class ARCANE_IMPL_EXPORT DataSynchronizeBufferBase
   void _allocateBuffers(Int32 datatype_size);
   //! Calcule les informations pour la synchronisation
   void _compute(Int32 datatype_size);
+  //! Décompresse si besoin le message reçu du \a index-ème rang dans le buffer de réception.
+  void _decompressReceiveBuffer(Int32 index);
 
  protected:
 
@@ -145,7 +207,53 @@ class ARCANE_IMPL_EXPORT DataSynchronizeBufferBase
   //! Buffer contenant les données concaténées en envoi et réception
   Ref<MemoryBuffer> m_memory;
 
+  /*!
+   * \brief Alignement (en octet) du début du buffer de chaque rang.
+   *
+   * Si nul, les buffers de chaque rang sont contigus.
+   */
+  Int32 m_rank_buffer_alignment = 0;
+
   Ref<IBufferCopier> m_buffer_copier;
+
+  /*!
+   * \brief Taille (en octet) du type de chaque donnée dans l'ordre de
+   * rangement dans le buffer d'un rang.
+   *
+   * Doit être positionné par les classes dérivées avant l'appel à _compute().
+   * Sert à regrouper les octets des valeurs de chaque donnée lors de la
+   * compression.
+   */
+  SmallArray<Int32> m_data_datatype_sizes;
+
+ private:
+
+  //! Informations sur le message compressé pour un rang
+  struct CompressedMessageInfo
+  {
+    Int64 m_offset = 0;
+    Int64 m_size = 0;
+  };
+
+  IDataCompressor* m_compressor = nullptr;
+  Int64 m_compression_threshold = -1;
+  bool m_is_compression_active = false;
+  DataSynchronizeCompressionStats m_compression_stats;
+  UniqueArray<std::byte> m_compressed_send_buffer;
+  UniqueArray<std::byte> m_compressed_receive_buffer;
+  UniqueArray<CompressedMessageInfo> m_compressed_send_infos;
+  UniqueArray<CompressedMessageInfo> m_compressed_receive_infos;
+  UniqueArray<std::byte> m_compression_work_buffer;
+  UniqueArray<std::byte> m_compression_shuffle_buffer;
+
+ private:
+
+  bool _isCompressedMessage(Int64 raw_size) const
+  {
+    return m_is_compression_active && raw_size >= m_compression_threshold && raw_size > 0;
+  }
+  void _computeCompressionInfos();
+  void _compressSendBuffers();
 };
 
 /*---------------------------------------------------------------------------*/
@@ -189,19 +297,34 @@ class ARCANE_IMPL_EXPORT SingleDataSynchronizeBuffer
 /*---------------------------------------------------------------------------*/
 /*!
  * \brief Implémentation de IDataSynchronizeBuffer pour plusieurs données.
+ *
+ * Les valeurs de toutes les données pour un rang sont rangées dans un seul
+ * buffer, donnée par donnée, ce qui permet de n'avoir qu'un seul message
+ * par rang quels que soient le type et la dimension des données.
+ *
+ * Pour que les valeurs de chaque donnée soient correctement alignées dans
+ * le buffer, les données sont rangées par alignement décroissant et
+ * le début du buffer de chaque rang est aligné sur RANK_BUFFER_ALIGNMENT.
  */
 class ARCANE_IMPL_EXPORT MultiDataSynchronizeBuffer
 : public TraceAccessor
 , public DataSynchronizeBufferBase
 {
 
+ public:
+
+  //! Alignement du début du buffer de chaque rang
+  static constexpr Int32 RANK_BUFFER_ALIGNMENT = 16;
+
  public:
 
   MultiDataSynchronizeBuffer(ITraceMng* tm, DataSynchronizeInfo* sync_info,
                              Ref<IBufferCopier> copier)
   : TraceAccessor(tm)
   , DataSynchronizeBufferBase(sync_info, copier)
-  {}
+  {
+    m_rank_buffer_alignment = RANK_BUFFER_ALIGNMENT;
+  }
 
  public:
 
@@ -222,6 +345,12 @@ class ARCANE_IMPL_EXPORT MultiDataSynchronizeBuffer
 
   //! Vue sur les données de la variable
   SmallArray<MutableMemoryView> m_data_views;
+  //! Ordre de rangement des données dans les buffers
+  SmallArray<Int32> m_data_order;
+
+ private:
+
+  void _computeDataOrder();
 };
 
 /*---------------------------------------------------------------------------*/
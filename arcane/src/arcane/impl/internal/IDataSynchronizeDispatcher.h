@@ -1,6 +1,6 @@
 ﻿// -*- tab-width: 2; indent-tabs-mode: nil; coding: utf-8-with-signature -*-
 //-----------------------------------------------------------------------------
-// Copyright 2000-2023 CEA (www.cea.fr) IFPEN (www.ifpenergiesnouvelles.com)
+// Copyright 2000-2024 CEA (www.cea.fr) IFPEN (www.ifpenergiesnouvelles.com)
 // See the top-level COPYRIGHT file for details.
 // SPDX-License-Identifier: Apache-2.0
 //-----------------------------------------------------------------------------
@@ -39,6 +39,7 @@ class DataSynchronizeResult;
 class IVariableSynchronizerDispatcher;
 class INumericDataInternal;
 class IBufferCopier;
+class IDataCompressor;
 
 /*---------------------------------------------------------------------------*/
 /*---------------------------------------------------------------------------*/
@@ -110,6 +111,16 @@ class ARCANE_IMPL_EXPORT IDataSynchronizeDispatcher
    */
   virtual void setSynchronizeBuffer(Ref<MemoryBuffer> buffer) =0;
 
+  /*!
+   * \brief Positionne le compresseur et le seuil (en octet) de compression des messages.
+   *
+   * Il faut appeler cette méthode avant beginSynchronize(). La compression
+   * n'est utilisée que si l'implémentation de la synchronisation le supporte.
+   * Si \a compressor est nul ou si \a threshold est négatif, la compression
+   * est désactivée.
+   */
+  virtual void setCompression(IDataCompressor* compressor, Int64 threshold) = 0;
+
   /*!
    * \brief Commence l'exécution pour la synchronisation pour la donnée \a data.
    */
@@ -153,8 +164,32 @@ class ARCANE_IMPL_EXPORT IDataSynchronizeMultiDispatcher
    * Il faut appeler cette méthode avant synchronize().
    */
   virtual void setSynchronizeBuffer(Ref<MemoryBuffer> buffer) =0;
+
+  /*!
+   * \brief Positionne le compresseur et le seuil (en octet) de compression des messages.
+   *
+   * \sa IDataSynchronizeDispatcher::setCompression().
+   */
+  virtual void setCompression(IDataCompressor* compressor, Int64 threshold) = 0;
+
+  //! Synchronise les variables \a vars en mode bloquant.
   virtual void synchronize(ConstArrayView<IVariable*> vars) = 0;
 
+  /*!
+   * \brief Commence la synchronisation des variables \a vars.
+   *
+   * Le buffer positionné par setSynchronizeBuffer() ne doit pas être
+   * modifié avant l'appel à endSynchronize().
+   */
+  virtual void beginSynchronize(ConstArrayView<IVariable*> vars) = 0;
+
+  /*!
+   * \brief Termine la synchronisation.
+   *
+   * Il faut avoir appelé beginSynchronize() avant.
+   */
+  virtual void endSynchronize() = 0;
+
  public:
 
   static IDataSynchronizeMultiDispatcher* create(const DataSynchronizeDispatcherBuildInfo& bi);
@@ -34,6 +34,7 @@
 namespace Arcane
 {
 class Timer;
+class IDataCompressor;
 class INumericDataInternal;
 class DataSynchronizeResult;
 
@@ -81,6 +82,12 @@ class ARCANE_IMPL_EXPORT VariableSynchronizer
 
   void synchronize(VariableCollection vars, Int32ConstArrayView local_ids) override;
 
+  void beginSynchronize(IVariable* var, RunQueue* queue) override;
+
+  void beginSynchronize(VariableCollection vars, RunQueue* queue) override;
+
+  void endSynchronize() override;
+
   Int32ConstArrayView communicatingRanks() override;
 
   Int32ConstArrayView sharedItems(Int32 index) override;
@@ -117,6 +124,15 @@ class ARCANE_IMPL_EXPORT VariableSynchronizer
   Ref<SyncMessage> m_partial_message;
   UniqueArray<Int32> m_partial_local_ids;
   bool m_is_check_coherence = false;
+  //! Message de la synchronisation non bloquante en cours
+  SyncMessage* m_pending_message = nullptr;
+  //! Temps passé dans beginSynchronize() pour la synchronisation en cours
+  Real m_pending_elapsed_time = 0.0;
+  //! Compresseur pour les messages (créé à la demande)
+  Ref<IDataCompressor> m_compressor;
+  bool m_is_compressor_initialized = false;
+  //! Seuil de compression pour les variables sans tag 'SyncCompressionThreshold'
+  Int64 m_default_compression_threshold = -1;
 
  private:
 
@@ -128,11 +144,16 @@ class ARCANE_IMPL_EXPORT VariableSynchronizer
   SyncMessage* _buildMessage(Ref<DataSynchronizeInfo>& sync_info);
   void _rebuildMessage(Int32ConstArrayView local_ids);
   void _sendBeginEvent(VariableSynchronizerEventArgs& args);
-  void _sendEndEvent(VariableSynchronizerEventArgs& args);
+  void _sendEndEvent(VariableSynchronizerEventArgs& args, Real elapsed_time);
   void _sendEvent(VariableSynchronizerEventArgs& args);
   void _checkCreateTimer();
   void _doSynchronize(SyncMessage* message);
+  void _beginSynchronize(SyncMessage* message, RunQueue* queue);
+  void _finalizeSynchronize(SyncMessage* message, Real elapsed_time);
+  void _checkNoPendingSynchronize();
   void _setCurrentDevice();
+  IDataCompressor* _compressor();
+  Int64 _defaultCompressionThreshold() const { return m_default_compression_threshold; }
 };
 
 /*---------------------------------------------------------------------------*/
@@ -19,6 +19,7 @@
 #include "arcane/utils/MemoryUtils.h"
 #include "arcane/utils/ValueConvert.h"
 #include "arcane/utils/ArraySimdPadder.h"
+#include "arcane/utils/PlatformUtils.h"
 
 #include "arcane/core/IMesh.h"
 #include "arcane/core/IItemFamily.h"
@@ -204,35 +205,37 @@ _rebuildMaterialsAndEnvironmentsFromGroups()
 {
   ConstArrayView<MeshEnvironment*> true_environments(m_material_mng->trueEnvironments());
   const bool is_full_verbose = _isFullVerbose();
-  ConstArrayView<Int16> cells_nb_env = m_component_connectivity_list->cellsNbEnvironment();
+  RunQueue& queue(m_material_mng->runQueue());
+  SmallSpan<const Int16> cells_nb_env = m_component_connectivity_list->cellsNbEnvironment();
+  UniqueArray<bool> cells_is_partial(queue.allocationOptions());
   for (const MeshEnvironment* env : true_environments) {
     MeshMaterialVariableIndexer* var_indexer = env->variableIndexer();
-    ComponentItemListBuilderOld list_builder(var_indexer, 0);
     CellGroup cells = var_indexer->cells();
-    Integer var_nb_cell = cells.size();
+    SmallSpan<const Int32> local_ids = cells.view().localIds();
+    Integer var_nb_cell = local_ids.size();
     info(4) << "ENV_INDEXER (V2) i=" << var_indexer->index() << " NB_CELL=" << var_nb_cell << " name=" << cells.name()
             << " index=" << var_indexer->index();
     if (is_full_verbose)
       info(5) << "ENV_INDEXER (V2) name=" << cells.name() << " cells=" << cells.view().localIds();
 
-    ENUMERATE_CELL (icell, cells) {
-      if (cells_nb_env[icell.itemLocalId()] > 1)
-        list_builder.addPartialItem(icell.itemLocalId());
-      else
-        // Je suis le seul milieu de la maille donc je prends l'indice global
-        list_builder.addPureItem(icell.itemLocalId());
-    }
+    // Si je suis le seul milieu de la maille, je prends l'indice global
+    cells_is_partial.resize(var_nb_cell);
+    SmallSpan<bool> cells_is_partial_view = cells_is_partial.view();
+    auto command = makeCommand(queue);
+    command << RUNCOMMAND_LOOP1(iter, var_nb_cell)
+    {
+      auto [i] = iter();
+      cells_is_partial_view[i] = (cells_nb_env[local_ids[i]] > 1);
+    };
+    var_indexer->endUpdate(local_ids, cells_is_partial_view, queue);
     if (is_full_verbose)
       info() << "MAT_NB_MULTIPLE_CELL (V2) mat=" << var_indexer->name()
-             << " nb_in_global=" << list_builder.pureMatVarIndexes().size()
-             << " (ids=" << list_builder.pureMatVarIndexes() << ")"
-             << " nb_in_multiple=" << list_builder.partialMatVarIndexes().size()
-             << " (ids=" << list_builder.partialLocalIds() << ")";
-    var_indexer->endUpdate(list_builder);
+             << " max_index_in_multiple=" << var_indexer->maxIndexInMultipleArray()
+             << " (ids=" << var_indexer->matvarIndexes() << ")";
   }
 
   for (MeshEnvironment* env : true_environments)
-    env->computeItemListForMaterials(*m_component_connectivity_list);
+    env->computeItemListForMaterials(*m_component_connectivity_list, queue);
 }
 
 /*---------------------------------------------------------------------------*/
@@ -255,23 +258,26 @@ _computeInfosForAllEnvCells1(RecomputeConstituentCellInfos& work_info)
 
   work_info.env_cell_indexes.resize(cells_nb_env.size());
 
-  bool do_old = (max_local_id != nb_cell);
-  if (do_old) {
-    Integer env_cell_index = 0;
-    ENUMERATE_CELL (icell, all_cells) {
-      Int32 lid = icell.itemLocalId();
-      Int32 nb_env = cells_nb_env[lid];
-      work_info.env_cell_indexes[lid] = env_cell_index;
-      env_cell_index += nb_env;
-    }
+  Accelerator::GenericScanner scanner(work_info.m_queue);
+  SmallSpan<Int32> env_cell_indexes_view(work_info.env_cell_indexes);
+  Accelerator::ScannerSumOperator<Int32> op;
+  const bool is_compact = (max_local_id == nb_cell);
+  if (is_compact) {
+    // Si all_cells est compacté, on a local_id[i] <=> i et on peut
+    // directement faire le scan sur le nombre de milieux par maille.
+    scanner.applyExclusive(0, cells_nb_env, env_cell_indexes_view, op, A_FUNCINFO);
   }
   else {
-    // TODO: Cela ne fonctionne que si all_cells est compacté et
-    // local_id[i] <=> i.
-    Accelerator::GenericScanner scanner(work_info.m_queue);
-    SmallSpan<Int32> env_cell_indexes_view(work_info.env_cell_indexes);
-    Accelerator::ScannerSumOperator<Int32> op;
-    scanner.applyExclusive(0, cells_nb_env, env_cell_indexes_view, op, A_FUNCINFO);
+    // Sinon, le scan se fait dans l'ordre de all_cells et le résultat
+    // est rangé à l'indice du localId() de la maille.
+    SmallSpan<const Int32> all_local_ids = all_cells.view().localIds();
+    auto getter = [=] ARCCORE_HOST_DEVICE(Int32 index) -> Int32 {
+      return cells_nb_env[all_local_ids[index]];
+    };
+    auto setter = [=] ARCCORE_HOST_DEVICE(Int32 index, Int32 value) {
+      env_cell_indexes_view[all_local_ids[index]] = value;
+    };
+    scanner.applyWithIndexExclusive(nb_cell, 0, getter, setter, op, A_FUNCINFO);
   }
 }
 
@@ -429,6 +435,7 @@ _checkLocalIdsCoherency() const
 void AllEnvData::
 forceRecompute(bool compute_all)
 {
+  const Real begin_time = platform::getRealTime();
   m_material_mng->incrementTimestamp();
 
   ConstArrayView<MeshMaterialVariableIndexer*> vars_idx = m_material_mng->_internalApi()->variablesIndexer();
@@ -527,6 +534,10 @@ forceRecompute(bool compute_all)
     else
       m_material_mng->_internalApi()->createAllCellToAllEnvCell(platform::getDefaultDataAllocator());
   }
+
+  const Real end_time = platform::getRealTime();
+  info(4) << "ForceRecompute compute_all?=" << compute_all << " time=" << (end_time - begin_time)
+          << " policy=" << queue.executionPolicy();
 }
 
 /*---------------------------------------------------------------------------*/
@@ -0,0 +1,46 @@
+﻿// -*- tab-width: 2; indent-tabs-mode: nil; coding: utf-8-with-signature -*-
+//-----------------------------------------------------------------------------
+// Copyright 2000-2024 CEA (www.cea.fr) IFPEN (www.ifpenergiesnouvelles.com)
+// See the top-level COPYRIGHT file for details.
+// SPDX-License-Identifier: Apache-2.0
+//-----------------------------------------------------------------------------
+/*---------------------------------------------------------------------------*/
+/* CellMaterialPresenceView.cc                                 (C) 2000-2024 */
+/*                                                                           */
+/* Vue sur la présence des matériaux dans les mailles.                       */
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+#include "arcane/materials/CellMaterialPresenceView.h"
+
+#include "arcane/utils/FatalErrorException.h"
+
+#include "arcane/materials/internal/MeshMaterialMng.h"
+#include "arcane/materials/internal/AllEnvData.h"
+#include "arcane/materials/internal/ConstituentConnectivityList.h"
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+namespace Arcane::Materials
+{
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+CellMaterialPresenceView::
+CellMaterialPresenceView(IMeshMaterialMng* mm)
+{
+  auto* true_mm = dynamic_cast<MeshMaterialMng*>(mm);
+  if (!true_mm)
+    ARCANE_FATAL("Material manager is not an instance of 'MeshMaterialMng'");
+  *this = true_mm->allEnvData()->componentConnectivityList()->materialPresenceView();
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+} // namespace Arcane::Materials
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
@@ -0,0 +1,119 @@
+﻿// -*- tab-width: 2; indent-tabs-mode: nil; coding: utf-8-with-signature -*-
+//-----------------------------------------------------------------------------
+// Copyright 2000-2024 CEA (www.cea.fr) IFPEN (www.ifpenergiesnouvelles.com)
+// See the top-level COPYRIGHT file for details.
+// SPDX-License-Identifier: Apache-2.0
+//-----------------------------------------------------------------------------
+/*---------------------------------------------------------------------------*/
+/* CellMaterialPresenceView.h                                  (C) 2000-2024 */
+/*                                                                           */
+/* Vue sur la présence des matériaux dans les mailles.                       */
+/*---------------------------------------------------------------------------*/
+#ifndef ARCANE_MATERIALS_CELLMATERIALPRESENCEVIEW_H
+#define ARCANE_MATERIALS_CELLMATERIALPRESENCEVIEW_H
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+#include "arcane/utils/ArrayView.h"
+
+#include "arcane/core/ItemLocalId.h"
+
+#include "arcane/materials/MaterialsGlobal.h"
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+namespace Arcane::Materials
+{
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*!
+ * \ingroup ArcaneMaterials
+ * \brief Vue sur la présence des matériaux dans les mailles.
+ *
+ * Pour chaque maille, la présence des matériaux est conservée sous forme
+ * d'un ensemble de bits: le bit \a i est positionné si le matériau
+ * d'indice \a i (IMeshMaterial::id()) est présent dans la maille.
+ * Chaque maille utilise nbWordPerCell() mots de 64 bits. S'il y a au plus
+ * 64 matériaux, une maille n'utilise donc qu'un seul mot.
+ *
+ * Cette vue est utilisable sur accélérateur. Elle est construite à partir
+ * des connectivités incrémentales des constituants et n'est valide que
+ * tant que les matériaux ou le maillage ne sont pas modifiés.
+ *
+ * \code
+ * CellMaterialPresenceView presence(material_mng);
+ * command << RUNCOMMAND_ENUMERATE(Cell, cell_id, all_cells)
+ * {
+ *   if (presence.hasMaterial(cell_id, mat_id))
+ *     ...
+ * };
+ * \endcode
+ */
+class ARCANE_MATERIALS_EXPORT CellMaterialPresenceView
+{
+ public:
+
+  CellMaterialPresenceView() = default;
+  //! Construit une vue pour les matériaux de \a mm
+  explicit CellMaterialPresenceView(IMeshMaterialMng* mm);
+  CellMaterialPresenceView(SmallSpan<const UInt64> words, Int32 nb_word_per_cell)
+  : m_words(words)
+  , m_nb_word_per_cell(nb_word_per_cell)
+  {}
+
+ public:
+
+  //! Indique si le matériau d'indice \a mat_id est présent dans la maille \a cell_id
+  ARCCORE_HOST_DEVICE bool hasMaterial(CellLocalId cell_id, Int32 mat_id) const
+  {
+    UInt64 w = m_words[cell_id.localId() * m_nb_word_per_cell + (mat_id / 64)];
+    return (w >> (mat_id % 64)) & 1;
+  }
+
+  /*!
+   * \brief Indique si la maille \a cell_id contient au moins un des matériaux de \a mask.
+   *
+   * \a mask doit avoir nbWordPerCell() éléments.
+   */
+  ARCCORE_HOST_DEVICE bool hasAnyMaterial(CellLocalId cell_id, SmallSpan<const UInt64> mask) const
+  {
+    const UInt64* w = _cellWords(cell_id);
+    for (Int32 i = 0; i < m_nb_word_per_cell; ++i)
+      if ((w[i] & mask[i]) != 0)
+        return true;
+    return false;
+  }
+
+  //! Mots contenant les bits de présence de la maille \a cell_id
+  ARCCORE_HOST_DEVICE SmallSpan<const UInt64> cellWords(CellLocalId cell_id) const
+  {
+    return { _cellWords(cell_id), m_nb_word_per_cell };
+  }
+
+  //! Nombre de mots de 64 bits par maille
+  ARCCORE_HOST_DEVICE Int32 nbWordPerCell() const { return m_nb_word_per_cell; }
+
+ private:
+
+  SmallSpan<const UInt64> m_words;
+  Int32 m_nb_word_per_cell = 0;
+
+ private:
+
+  ARCCORE_HOST_DEVICE const UInt64* _cellWords(CellLocalId cell_id) const
+  {
+    return m_words.data() + cell_id.localId() * m_nb_word_per_cell;
+  }
+};
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+} // namespace Arcane::Materials
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+#endif
@@ -13,6 +13,8 @@
 
 #include "arcane/materials/internal/ConstituentConnectivityList.h"
 
+#include "arcane/utils/MemoryUtils.h"
+
 #include "arcane/core/IItemFamily.h"
 #include "arcane/core/MeshUtils.h"
 #include "arcane/core/internal/IDataInternal.h"
@@ -280,6 +282,7 @@ ConstituentConnectivityList(MeshMaterialMng* mm)
 : TraceAccessor(mm->traceMng())
 , m_material_mng(mm)
 , m_container(new Container(mm->meshHandle(), String("ComponentEnviroment") + mm->name()))
+, m_material_presence(MemoryUtils::getDefaultDataAllocator())
 {
 }
 
@@ -332,7 +335,12 @@ endCreate(bool is_continue)
     auto local_view = environment_for_materials.view();
     for (Int32 i = 0; i < nb_mat; ++i)
       local_view[i] = materials[i]->trueEnvironment()->componentId();
+    m_nb_presence_word = (nb_mat + 63) / 64;
+    if (m_nb_presence_word == 0)
+      m_nb_presence_word = 1;
   }
+
+  _rebuildMaterialPresence();
 }
 
 /*---------------------------------------------------------------------------*/
@@ -464,6 +472,7 @@ void ConstituentConnectivityList::
 addCellsToMaterial(Int16 mat_id, SmallSpan<const Int32> cell_ids, RunQueue& queue)
 {
   _addCells(mat_id, cell_ids, m_container->m_material, queue);
+  _updateMaterialPresence(mat_id, cell_ids, true, queue);
 }
 
 /*---------------------------------------------------------------------------*/
@@ -473,6 +482,76 @@ void ConstituentConnectivityList::
 removeCellsToMaterial(Int16 mat_id, SmallSpan<const Int32> cell_ids, RunQueue& queue)
 {
   _removeCells(mat_id, cell_ids, m_container->m_material, queue);
+  _updateMaterialPresence(mat_id, cell_ids, false, queue);
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*!
+ * \brief Positionne ou supprime le bit de présence du matériau \a mat_id.
+ *
+ * Une maille n'apparait qu'une fois dans \a cell_ids donc il n'y a pas
+ * de conflit d'écriture entre les itérations.
+ */
+void ConstituentConnectivityList::
+_updateMaterialPresence(Int16 mat_id, SmallSpan<const Int32> cell_ids, bool is_add, RunQueue& queue)
+{
+  const Int32 n = cell_ids.size();
+  if (n == 0)
+    return;
+  SmallSpan<UInt64> presence = m_material_presence.smallSpan();
+  const Int32 nb_word = m_nb_presence_word;
+  const Int32 word_index = mat_id / 64;
+  const UInt64 mask = UInt64(1) << (mat_id % 64);
+  auto command = makeCommand(queue);
+  command << RUNCOMMAND_LOOP1(iter, n)
+  {
+    auto [i] = iter();
+    UInt64& w = presence[cell_ids[i] * nb_word + word_index];
+    if (is_add)
+      w |= mask;
+    else
+      w &= ~mask;
+  };
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*!
+ * \brief Recalcule les bits de présence à partir des listes de matériaux.
+ */
+void ConstituentConnectivityList::
+_rebuildMaterialPresence()
+{
+  if (!m_cell_family)
+    return;
+  const Int32 nb_cell = m_cell_family->maxLocalId();
+  const Int32 nb_word = m_nb_presence_word;
+  m_material_presence.resize(nb_cell * nb_word);
+  m_material_presence.fill(0);
+  ConstituentContainer& materials = m_container->m_material;
+  const Int32 nb_item = materials.m_nb_component_as_array.size();
+  for (Int32 i = 0; i < nb_cell && i < nb_item; ++i) {
+    for (Int16 mat_id : materials.components(CellLocalId(i)))
+      m_material_presence[i * nb_word + (mat_id / 64)] |= UInt64(1) << (mat_id % 64);
+  }
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+void ConstituentConnectivityList::
+_changeLocalIdsForMaterialPresence(Int32ConstArrayView new_to_old_ids)
+{
+  const Int32 nb_word = m_nb_presence_word;
+  const Int32 nb_new = new_to_old_ids.size();
+  UniqueArray<UInt64> new_presence(m_material_presence.allocator(), nb_new * nb_word);
+  for (Int32 i = 0; i < nb_new; ++i) {
+    const Int32 old_index = new_to_old_ids[i] * nb_word;
+    for (Int32 k = 0; k < nb_word; ++k)
+      new_presence[i * nb_word + k] = m_material_presence[old_index + k];
+  }
+  m_material_presence.swap(new_presence);
 }
 
 /*---------------------------------------------------------------------------*/
@@ -613,6 +692,7 @@ void ConstituentConnectivityList::
 notifySourceFamilyLocalIdChanged([[maybe_unused]] Int32ConstArrayView new_to_old_ids)
 {
   m_container->changeLocalIds(new_to_old_ids);
+  _changeLocalIdsForMaterialPresence(new_to_old_ids);
 }
 
 /*---------------------------------------------------------------------------*/
@@ -629,6 +709,13 @@ notifySourceItemAdded(ItemLocalId item)
 
   m_container->m_material.m_nb_component_as_array[lid] = 0;
   m_container->m_material.m_component_index_as_array[lid] = 0;
+
+  const Int32 nb_word = m_nb_presence_word;
+  const Int64 wanted_size = (lid + 1) * nb_word;
+  if (m_material_presence.size() < wanted_size)
+    m_material_presence.resize(wanted_size);
+  for (Int32 k = 0; k < nb_word; ++k)
+    m_material_presence[lid * nb_word + k] = 0;
 }
 
 /*---------------------------------------------------------------------------*/
@@ -639,6 +726,7 @@ reserveMemoryForNbSourceItems(Int32 n, [[maybe_unused]] bool pre_alloc_connectiv
 {
   info() << "Constituent: reserve=" << n;
   m_container->reserve(n);
+  m_material_presence.reserve(n * m_nb_presence_word);
 }
 
 /*---------------------------------------------------------------------------*/
@@ -647,6 +735,7 @@ reserveMemoryForNbSourceItems(Int32 n, [[maybe_unused]] bool pre_alloc_connectiv
 void ConstituentConnectivityList::
 notifyReadFromDump()
 {
+  _rebuildMaterialPresence();
 }
 
 /*---------------------------------------------------------------------------*/
@@ -666,6 +755,7 @@ removeAllConnectivities()
 {
   m_container->m_environment.removeAllConnectivities();
   m_container->m_material.removeAllConnectivities();
+  m_material_presence.fill(0);
 }
 
 /*---------------------------------------------------------------------------*/
@@ -1,11 +1,11 @@
 ﻿// -*- tab-width: 2; indent-tabs-mode: nil; coding: utf-8-with-signature -*-
 //-----------------------------------------------------------------------------
-// Copyright 2000-2023 CEA (www.cea.fr) IFPEN (www.ifpenergiesnouvelles.com)
+// Copyright 2000-2024 CEA (www.cea.fr) IFPEN (www.ifpenergiesnouvelles.com)
 // See the top-level COPYRIGHT file for details.
 // SPDX-License-Identifier: Apache-2.0
 //-----------------------------------------------------------------------------
 /*---------------------------------------------------------------------------*/
-/* IMeshMaterialVariableSynchronizer.h                         (C) 2000-2023 */
+/* IMeshMaterialVariableSynchronizer.h                         (C) 2000-2024 */
 /*                                                                           */
 /* Interface du synchroniseur de variables matériaux.                        */
 /*---------------------------------------------------------------------------*/
@@ -69,6 +69,14 @@ class ARCANE_MATERIALS_EXPORT IMeshMaterialVariableSynchronizer
 
   //! Ressource mémoire à utiliser pour les buffers de communication
   virtual eMemoryRessource bufferMemoryRessource() const =0;
+
+  /*!
+   * \brief File à utiliser pour les recopies entre les variables et les buffers.
+   *
+   * Si nul, la file par défaut du IParallelMng est utilisée. L'implémentation
+   * par défaut retourne nul.
+   */
+  virtual RunQueue* copyQueue() const { return nullptr; }
 };
 
 /*---------------------------------------------------------------------------*/
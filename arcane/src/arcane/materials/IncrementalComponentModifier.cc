@@ -468,6 +468,95 @@ _addItemsToEnvironment(MeshEnvironment* env, MeshMaterial* mat,
   }
 }
 
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*!
+ * \brief Supprime du milieu \a env les mailles détruites lors d'un échange.
+ *
+ * \a env_ids contient les mailles détruites du milieu et \a mats_ids[i]
+ * celles du i-ème matériau du milieu. Ces mailles ont déjà été supprimées
+ * des groupes et n'appartiennent plus à aucun constituant. Il n'y a donc pas
+ * de transformation entre mailles pures et partielles à faire pour les mailles
+ * restantes. La liste de connectivité des constituants n'est pas modifiée car
+ * elle est réinitialisée si le localId est réutilisé par une nouvelle maille.
+ */
+void IncrementalComponentModifier::
+removeDestroyedCells(MeshEnvironment* env, SmallSpan<const Int32> env_ids,
+                     ConstArrayView<SmallSpan<const Int32>> mats_ids)
+{
+  ConstArrayView<MeshMaterial*> mats = env->trueMaterials();
+  const Int32 nb_mat = mats.size();
+  const bool update_env_indexer = (nb_mat != 1);
+
+  // Toutes les mailles supprimées d'un matériau le sont aussi du milieu.
+  // Il suffit donc de marquer les mailles du milieu.
+  flagRemovedCells(env_ids, true);
+  for (Int32 i = 0; i < nb_mat; ++i)
+    _removeItemsFromEnvironment(env, mats[i], mats_ids[i], false);
+  if (update_env_indexer)
+    env->variableIndexer()->endUpdateRemove(m_work_info, env_ids.size(), m_queue);
+  flagRemovedCells(env_ids, false);
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*!
+ * \brief Ajoute à la liste de connectivité les mailles reçues lors d'un échange.
+ *
+ * Cette méthode doit être appelée pour tous les milieux avant
+ * addReceivedCells() car le caractère pur ou partiel d'une maille
+ * dépend du nombre total de milieux et de matériaux de la maille.
+ */
+void IncrementalComponentModifier::
+addReceivedCellsConnectivity(MeshEnvironment* env, SmallSpan<const Int32> env_ids,
+                             ConstArrayView<SmallSpan<const Int32>> mats_ids)
+{
+  ConstituentConnectivityList* connectivity = m_all_env_data->componentConnectivityList();
+  ConstArrayView<MeshMaterial*> mats = env->trueMaterials();
+  connectivity->addCellsToEnvironment(env->componentId(), env_ids, m_queue);
+  for (Int32 i = 0, n = mats.size(); i < n; ++i)
+    connectivity->addCellsToMaterial(mats[i]->componentId(), mats_ids[i], m_queue);
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*!
+ * \brief Ajoute au milieu \a env les mailles reçues lors d'un échange.
+ *
+ * Les mailles reçues sont de nouvelles mailles : aucune maille existante
+ * ne change de statut entre pure et partielle. Les valeurs des nouvelles
+ * mailles sont ensuite positionnées lors de la désérialisation.
+ */
+void IncrementalComponentModifier::
+addReceivedCells(MeshEnvironment* env, SmallSpan<const Int32> env_ids,
+                 ConstArrayView<SmallSpan<const Int32>> mats_ids)
+{
+  ConstArrayView<MeshMaterial*> mats = env->trueMaterials();
+  const Int32 nb_mat = mats.size();
+  for (Int32 i = 0; i < nb_mat; ++i)
+    _addItemsToEnvironment(env, mats[i], mats_ids[i], false);
+
+  if (nb_mat == 1)
+    return;
+
+  // Pour l'indexeur du milieu, une maille est partielle si elle
+  // contient plusieurs milieux.
+  ConstituentConnectivityList* connectivity = m_all_env_data->componentConnectivityList();
+  SmallSpan<const Int16> cells_nb_env = connectivity->cellsNbEnvironment();
+  const Int32 nb_id = env_ids.size();
+  m_work_info.m_cells_is_partial.resize(nb_id);
+  SmallSpan<bool> cells_is_partial = m_work_info.m_cells_is_partial.to1DSmallSpan();
+  {
+    auto command = makeCommand(m_queue);
+    command << RUNCOMMAND_LOOP1(iter, nb_id)
+    {
+      auto [i] = iter();
+      cells_is_partial[i] = (cells_nb_env[env_ids[i]] > 1);
+    };
+  }
+  _addItemsToIndexer(env->variableIndexer(), env_ids);
+}
+
 /*---------------------------------------------------------------------------*/
 /*---------------------------------------------------------------------------*/
 
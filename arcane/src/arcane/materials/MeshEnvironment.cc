@@ -73,7 +73,7 @@ class MeshEnvironmentObserver
     if (info1) {
       //info(4) << "EXTEND_ENV " << m_environment->name() << " ids=" << (*info1);
       if (m_environment->materialMng()->isInMeshMaterialExchange())
-        info() << "EXTEND_ENV_IN_LOADBALANCE " << m_environment->name()
+        info(4) << "EXTEND_ENV_IN_LOADBALANCE " << m_environment->name()
                << " ids=" << (*info1);
     }
   }
@@ -82,7 +82,7 @@ class MeshEnvironmentObserver
     if (info1) {
       //info(4) << "REDUCE_ENV " << m_environment->name() << " ids=" << (*info1);
       if (m_environment->materialMng()->isInMeshMaterialExchange())
-        info() << "REDUCE_ENV_IN_LOADBALANCE " << m_environment->name()
+        info(4) << "REDUCE_ENV_IN_LOADBALANCE " << m_environment->name()
                << " ids=" << (*info1);
     }
   }
@@ -389,38 +389,44 @@ _computeMaterialIndexesMonoMat(ComponentItemInternalData* item_internal_data, Ru
  * dans le tableau d'indexation des variables.
  */
 void MeshEnvironment::
-computeItemListForMaterials(const ConstituentConnectivityList& connectivity_list)
+computeItemListForMaterials(ConstituentConnectivityList& connectivity_list, RunQueue& queue)
 {
   info(4) << "ComputeItemListForMaterials (V2)";
-  ConstArrayView<Int16> nb_env_per_cell = connectivity_list.cellsNbEnvironment();
+  SmallSpan<const Int16> nb_env_per_cell = connectivity_list.cellsNbEnvironment();
   const Int16 env_id = componentId();
+  UniqueArray<Int16> cells_nb_mat(queue.allocationOptions());
+  UniqueArray<bool> cells_is_partial(queue.allocationOptions());
   // Calcul pour chaque matériau le nombre de mailles mixtes
   // TODO: a faire dans MeshMaterialVariableIndexer
   for (MeshMaterial* mat : m_true_materials) {
     MeshMaterialVariableIndexer* var_indexer = mat->variableIndexer();
     CellGroup cells = var_indexer->cells();
-    Integer var_nb_cell = cells.size();
-
-    ComponentItemListBuilderOld list_builder(var_indexer, 0);
-
-    info(4) << "MAT_INDEXER mat=" << mat->name() << " NB_CELL=" << var_nb_cell << " name=" << cells.name();
-    ENUMERATE_CELL (icell, cells) {
-      Int32 lid = icell.itemLocalId();
-      // On ne prend l'indice global que si on est le seul matériau et le seul
-      // milieu de la maille. Sinon, on prend un indice multiple
-      if (nb_env_per_cell[lid] > 1 || connectivity_list.cellNbMaterial(icell, env_id) > 1)
-        list_builder.addPartialItem(lid);
-      else
-        list_builder.addPureItem(lid);
-    }
+    SmallSpan<const Int32> local_ids = cells.view().localIds();
+    const Int32 nb_cell = local_ids.size();
+
+    info(4) << "MAT_INDEXER mat=" << mat->name() << " NB_CELL=" << nb_cell << " name=" << cells.name();
+
+    cells_nb_mat.resize(nb_cell);
+    cells_is_partial.resize(nb_cell);
+    SmallSpan<const Int16> cells_nb_mat_view = cells_nb_mat.view();
+    SmallSpan<bool> cells_is_partial_view = cells_is_partial.view();
+    connectivity_list.fillCellsNbMaterial(local_ids, env_id, cells_nb_mat.view(), queue);
+
+    // On ne prend l'indice global que si on est le seul matériau et le seul
+    // milieu de la maille. Sinon, on prend un indice multiple
+    auto command = makeCommand(queue);
+    command << RUNCOMMAND_LOOP1(iter, nb_cell)
+    {
+      auto [i] = iter();
+      Int32 lid = local_ids[i];
+      cells_is_partial_view[i] = (nb_env_per_cell[lid] > 1 || cells_nb_mat_view[i] > 1);
+    };
+    var_indexer->endUpdate(local_ids, cells_is_partial_view, queue);
 
     if (traceMng()->verbosityLevel() >= 5)
       info() << "MAT_NB_MULTIPLE_CELL (V2) mat=" << var_indexer->name()
-             << " nb_in_global=" << list_builder.pureMatVarIndexes().size()
-             << " (ids=" << list_builder.pureMatVarIndexes() << ")"
-             << " nb_in_multiple=" << list_builder.partialMatVarIndexes().size()
-             << " (ids=" << list_builder.partialLocalIds() << ")";
-    var_indexer->endUpdate(list_builder);
+             << " max_index_in_multiple=" << var_indexer->maxIndexInMultipleArray()
+             << " (ids=" << var_indexer->matvarIndexes() << ")";
   }
 }
 
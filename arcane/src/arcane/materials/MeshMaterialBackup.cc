@@ -1,11 +1,11 @@
 ﻿// -*- tab-width: 2; indent-tabs-mode: nil; coding: utf-8-with-signature -*-
 //-----------------------------------------------------------------------------
-// Copyright 2000-2023 CEA (www.cea.fr) IFPEN (www.ifpenergiesnouvelles.com)
+// Copyright 2000-2024 CEA (www.cea.fr) IFPEN (www.ifpenergiesnouvelles.com)
 // See the top-level COPYRIGHT file for details.
 // SPDX-License-Identifier: Apache-2.0
 //-----------------------------------------------------------------------------
 /*---------------------------------------------------------------------------*/
-/* MeshMaterialBackup.cc                                       (C) 2000-2023 */
+/* MeshMaterialBackup.cc                                       (C) 2000-2024 */
 /*                                                                           */
 /* Sauvegarde/restauration des valeurs des matériaux et milieux.             */
 /*---------------------------------------------------------------------------*/
@@ -14,6 +14,7 @@
 #include "arcane/materials/MeshMaterialBackup.h"
 
 #include "arcane/utils/IDataCompressor.h"
+#include "arcane/utils/MemoryView.h"
 
 #include "arcane/core/IVariable.h"
 #include "arcane/core/IData.h"
@@ -30,12 +31,35 @@
 #include "arcane/materials/internal/MeshMaterialMng.h"
 #include "arcane/materials/internal/MeshMaterialVariableIndexer.h"
 
+#include <cstring>
+
 /*---------------------------------------------------------------------------*/
 /*---------------------------------------------------------------------------*/
 
 namespace Arcane::Materials
 {
 
+namespace
+{
+  //! Somme de contrôle (FNV-1a sur des mots de 64 bits) de \a bytes.
+  UInt64 _computeChecksum(Span<const std::byte> bytes)
+  {
+    const UInt64 prime = 0x100000001b3ULL;
+    UInt64 checksum = 0xcbf29ce484222325ULL;
+    const Int64 size = bytes.size();
+    const Int64 nb_word = size / 8;
+    const std::byte* ptr = bytes.data();
+    for (Int64 i = 0; i < nb_word; ++i) {
+      UInt64 word = 0;
+      std::memcpy(&word, ptr + i * 8, 8);
+      checksum = (checksum ^ word) * prime;
+    }
+    for (Int64 i = nb_word * 8; i < size; ++i)
+      checksum = (checksum ^ static_cast<UInt64>(ptr[i])) * prime;
+    return checksum;
+  }
+} // namespace
+
 struct MeshMaterialBackup::VarData
 {
  public:
@@ -49,6 +73,12 @@ struct MeshMaterialBackup::VarData
   Integer data_index = 0;
   DataCompressionBuffer m_data_buffer;
   Ref<IDataCompressor> m_compressor;
+  //! Somme de contrôle des valeurs non compressées (mode incrémental)
+  UInt64 m_checksum = 0;
+  //! Taille mémoire (en octet) des valeurs non compressées
+  Int64 m_raw_size = 0;
+  //! Taille mémoire utilisée pour conserver les valeurs
+  Int64 m_stored_size = 0;
 };
 
 /*---------------------------------------------------------------------------*/
@@ -124,6 +154,9 @@ _save()
 {
   if (!m_compressor_service_name.null())
     m_use_v2 = true;
+  // Le mode incrémental sauvegarde les valeurs variable par variable.
+  if (m_is_incremental)
+    m_use_v2 = true;
 
   ConstArrayView<MeshMaterialVariableIndexer*> indexers = m_material_mng->_internalApi()->variablesIndexer();
 
@@ -140,12 +173,17 @@ _save()
 
   // Stocke dans \a vars la liste des variables pour accès plus simple qu'avec la map
   Integer max_nb_var = arcaneCheckArraySize(mm->m_full_name_variable_map.size());
+  m_vars.clear();
   m_vars.reserve(max_nb_var);
   for( const auto& i : mm->m_full_name_variable_map){
     IMeshMaterialVariable* mv = i.second;
     if (mv->keepOnChange() && mv->globalVariable()->isUsed())
       m_vars.add(mv);
   }
+  if (m_is_incremental){
+    _saveIncremental(nb_value);
+    return;
+  }
   for( IMeshMaterialVariable* mv : m_vars ){
     info(4) << "SAVE MVAR=" << mv->name() << " is_used?=" << mv->globalVariable()->isUsed();
     VarData* vd = new VarData(mv->_internalApi()->internalCreateSaveDataRef(nb_value));
@@ -177,14 +215,24 @@ _saveV1()
 /*---------------------------------------------------------------------------*/
 /*---------------------------------------------------------------------------*/
 
-void MeshMaterialBackup::
-_saveV2()
+Ref<IDataCompressor> MeshMaterialBackup::
+_createCompressor()
 {
   IMesh* mesh = m_material_mng->mesh();
   ServiceBuilder<IDataCompressor> sb(mesh->handle().application());
   Ref<IDataCompressor> compressor_ref;
   if (!m_compressor_service_name.empty())
     compressor_ref = sb.createReference(m_compressor_service_name);
+  return compressor_ref;
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+void MeshMaterialBackup::
+_saveV2()
+{
+  Ref<IDataCompressor> compressor_ref = _createCompressor();
   IDataCompressor* compressor = compressor_ref.get();
   auto components = m_material_mng->components();
 
@@ -213,6 +261,125 @@ _saveV2()
   }
 }
 
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*!
+ * \brief Sauvegarde incrémentale.
+ *
+ * Les valeurs de chaque variable sont rassemblées puis comparées à celles
+ * de la sauvegarde précédente. Si elles sont identiques, la sauvegarde
+ * précédente (éventuellement compressée) est conservée et les nouvelles
+ * valeurs ne sont ni conservées ni compressées. Si les constituants ont été
+ * modifiés, toutes les variables sont considérées comme modifiées.
+ */
+void MeshMaterialBackup::
+_saveIncremental(Integer nb_value)
+{
+  Ref<IDataCompressor> compressor_ref = _createCompressor();
+  IDataCompressor* compressor = compressor_ref.get();
+  auto components = m_material_mng->components();
+
+  // Les identifiants des mailles des constituants ne changent que si
+  // le timestamp du gestionnaire des matériaux a changé.
+  const Int64 timestamp = m_material_mng->timestamp();
+  const bool is_same_components = (timestamp==m_saved_timestamp);
+  m_saved_timestamp = timestamp;
+  if (!is_same_components){
+    m_ids_array.clear();
+    m_unique_ids_array.clear();
+    ENUMERATE_COMPONENT(ic,components){
+      IMeshComponent* c = *ic;
+      _saveIds(c);
+    }
+  }
+
+  // Supprime les valeurs des variables qui ne sont plus sauvegardées.
+  for( auto iter = m_saved_data.begin(); iter!=m_saved_data.end(); ){
+    if (!m_vars.contains(iter->first)){
+      delete iter->second;
+      iter = m_saved_data.erase(iter);
+    }
+    else
+      ++iter;
+  }
+
+  Int32 nb_unchanged = 0;
+  m_stored_memory_size = 0;
+  m_saved_memory_size = 0;
+
+  for( IMeshMaterialVariable* var : m_vars ){
+    VarData*& var_data = m_saved_data[var];
+    Ref<IData> new_data = var->_internalApi()->internalCreateSaveDataRef(nb_value);
+    ENUMERATE_COMPONENT(ic,components){
+      IMeshComponent* c = *ic;
+      if (_isValidComponent(var,c))
+        var->_internalApi()->saveData(c,new_data.get());
+    }
+    IDataInternal* d = new_data->_commonInternal();
+    INumericDataInternal* numeric_data = d->numericData();
+    Span<const std::byte> new_bytes;
+    if (numeric_data)
+      new_bytes = numeric_data->memoryView().bytes();
+    const Int64 raw_size = new_bytes.size();
+    const UInt64 checksum = _computeChecksum(new_bytes);
+
+    if (var_data && is_same_components && numeric_data && _isSameValues(var_data,new_bytes,checksum)){
+      // Variable non modifiée: conserve la sauvegarde précédente.
+      ++nb_unchanged;
+      m_saved_memory_size += var_data->m_raw_size;
+      m_stored_memory_size += var_data->m_stored_size;
+      continue;
+    }
+
+    if (!var_data)
+      var_data = new VarData();
+    var_data->data = new_data;
+    var_data->m_checksum = checksum;
+    var_data->m_data_buffer = DataCompressionBuffer();
+    var_data->m_compressor.reset();
+    var_data->m_raw_size = raw_size;
+    var_data->m_stored_size = raw_size;
+    if (compressor){
+      var_data->m_compressor = compressor_ref;
+      var_data->m_data_buffer.m_compressor = compressor;
+      if (d->compressAndClear(var_data->m_data_buffer)){
+        var_data->m_stored_size = var_data->m_data_buffer.m_buffer.size();
+        m_saved_memory_size += raw_size - var_data->m_stored_size;
+      }
+    }
+    m_stored_memory_size += var_data->m_stored_size;
+  }
+
+  info(4) << "MeshMaterialBackup: incremental save nb_var=" << m_vars.size()
+          << " nb_unchanged=" << nb_unchanged << " is_same_components=" << is_same_components
+          << " stored_size=" << m_stored_memory_size << " saved_size=" << m_saved_memory_size;
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*!
+ * \brief Indique si \a new_bytes sont identiques aux valeurs sauvegardées
+ * dans \a var_data.
+ *
+ * Si les valeurs sauvegardées sont compressées, seule la somme de contrôle
+ * \a checksum est comparée. Sinon, les valeurs sont comparées octet par octet.
+ */
+bool MeshMaterialBackup::
+_isSameValues(VarData* var_data,Span<const std::byte> new_bytes,UInt64 checksum)
+{
+  if (var_data->m_raw_size!=new_bytes.size() || var_data->m_checksum!=checksum)
+    return false;
+  if (var_data->m_data_buffer.m_compressor)
+    return true;
+  INumericDataInternal* saved_numeric_data = var_data->data->_commonInternal()->numericData();
+  if (!saved_numeric_data)
+    return false;
+  Span<const std::byte> saved_bytes = saved_numeric_data->memoryView().bytes();
+  if (saved_bytes.size()!=new_bytes.size())
+    return false;
+  return std::memcmp(saved_bytes.data(),new_bytes.data(),new_bytes.size())==0;
+}
+
 /*---------------------------------------------------------------------------*/
 /*---------------------------------------------------------------------------*/
 
@@ -304,6 +471,8 @@ _restoreV2()
 
   for( IMeshMaterialVariable* var : m_vars ){
     VarData* vd = m_saved_data[var];
+    // En mode incrémental, il est possible de faire plusieurs restaurations.
+    vd->data_index = 0;
     // Décompresse les données si nécessaire
     IDataCompressor* compressor = vd->m_data_buffer.m_compressor;
     if (compressor){
@@ -320,6 +489,10 @@ _restoreV2()
         vd->data_index += ids.size();
       }
     }
+    // En mode incrémental, libère les valeurs décompressées. Elles seront
+    // de nouveau décompressées lors de la prochaine restauration.
+    if (compressor && m_is_incremental)
+      vd->data = var->_internalApi()->internalCreateSaveDataRef(0);
   }
 }
 
@@ -1,11 +1,11 @@
 ﻿// -*- tab-width: 2; indent-tabs-mode: nil; coding: utf-8-with-signature -*-
 //-----------------------------------------------------------------------------
-// Copyright 2000-2023 CEA (www.cea.fr) IFPEN (www.ifpenergiesnouvelles.com)
+// Copyright 2000-2024 CEA (www.cea.fr) IFPEN (www.ifpenergiesnouvelles.com)
 // See the top-level COPYRIGHT file for details.
 // SPDX-License-Identifier: Apache-2.0
 //-----------------------------------------------------------------------------
 /*---------------------------------------------------------------------------*/
-/* MeshMaterialBackup.h                                        (C) 2000-2023 */
+/* MeshMaterialBackup.h                                        (C) 2000-2024 */
 /*                                                                           */
 /* Sauvegarde/restauration des valeurs des matériaux et milieux.             */
 /*---------------------------------------------------------------------------*/
@@ -29,6 +29,11 @@
 /*---------------------------------------------------------------------------*/
 /*---------------------------------------------------------------------------*/
 
+namespace Arcane
+{
+class IDataCompressor;
+}
+
 namespace Arcane::Materials
 {
 
@@ -45,6 +50,18 @@ namespace Arcane::Materials
  * pour les données avant les sauvegardes via la méthode setCompressorServiceName().
  * Si cette méthode n'est pas appelée, la valeur par défaut est celle de
  * IMeshMaterialMng::dataCompressorServiceName().
+ *
+ * En mode incrémental (setIncremental()), une même instance peut être
+ * utilisée pour plusieurs sauvegardes successives et restaurations.
+ * Chaque appel à saveValues() remplace la sauvegarde précédente mais
+ * ne conserve les nouvelles valeurs d'une variable que si elles ont changé
+ * depuis la dernière sauvegarde. Pour le détecter, les valeurs sont
+ * rassemblées puis comparées à celles de la sauvegarde précédente
+ * (via une somme de contrôle si elles sont compressées). Il n'est donc pas
+ * nécessaire d'indiquer les modifications des variables. Si les constituants
+ * ont été modifiés (IMeshMaterialMng::timestamp() a changé), toutes les
+ * variables sont considérées comme modifiées. Les valeurs inchangées ne sont
+ * donc ni conservées une seconde fois ni compressées à nouveau.
  */
 class ARCANE_MATERIALS_EXPORT MeshMaterialBackup
 : public TraceAccessor
@@ -62,6 +79,25 @@ class ARCANE_MATERIALS_EXPORT MeshMaterialBackup
   void setCompressorServiceName(const String& name);
   const String& compressorServiceName() const { return m_compressor_service_name; }
 
+  /*!
+   * \brief Indique si on utilise le mode incrémental.
+   *
+   * Cette méthode doit être appelée avant le premier appel à saveValues().
+   */
+  void setIncremental(bool v) { m_is_incremental = v; }
+  bool isIncremental() const { return m_is_incremental; }
+
+  //! Taille mémoire (en octet) utilisée pour conserver les valeurs sauvegardées
+  Int64 storedMemorySize() const { return m_stored_memory_size; }
+
+  /*!
+   * \brief Taille mémoire (en octet) économisée lors de la dernière sauvegarde.
+   *
+   * Il s'agit de la taille des valeurs qui n'ont pas eu besoin d'être
+   * conservées car elles étaient inchangées ou de la taille gagnée par la compression.
+   */
+  Int64 savedMemorySize() const { return m_saved_memory_size; }
+
  public:
 
   void saveValues();
@@ -77,6 +113,11 @@ class ARCANE_MATERIALS_EXPORT MeshMaterialBackup
   UniqueArray<IMeshMaterialVariable*> m_vars;
   bool m_use_v2 = false;
   String m_compressor_service_name;
+  bool m_is_incremental = false;
+  Int64 m_stored_memory_size = 0;
+  Int64 m_saved_memory_size = 0;
+  //! Valeur de IMeshMaterialMng::timestamp() lors de la dernière sauvegarde incrémentale
+  Int64 m_saved_timestamp = -1;
 
  private:
 
@@ -86,6 +127,9 @@ class ARCANE_MATERIALS_EXPORT MeshMaterialBackup
   bool _isValidComponent(IMeshMaterialVariable* var, IMeshComponent* component);
   void _saveV1();
   void _saveV2();
+  void _saveIncremental(Integer nb_value);
+  bool _isSameValues(VarData* var_data, Span<const std::byte> new_bytes, UInt64 checksum);
+  Ref<IDataCompressor> _createCompressor();
   void _restoreV1();
   void _restoreV2();
 };
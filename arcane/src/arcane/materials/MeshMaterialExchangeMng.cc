@@ -1,17 +1,19 @@
 ﻿// -*- tab-width: 2; indent-tabs-mode: nil; coding: utf-8-with-signature -*-
 //-----------------------------------------------------------------------------
-// Copyright 2000-2023 CEA (www.cea.fr) IFPEN (www.ifpenergiesnouvelles.com)
+// Copyright 2000-2024 CEA (www.cea.fr) IFPEN (www.ifpenergiesnouvelles.com)
 // See the top-level COPYRIGHT file for details.
 // SPDX-License-Identifier: Apache-2.0
 //-----------------------------------------------------------------------------
 /*---------------------------------------------------------------------------*/
-/* MeshMaterialExchangeMng.cc                                  (C) 2000-2023 */
+/* MeshMaterialExchangeMng.cc                                  (C) 2000-2024 */
 /*                                                                           */
 /* Gestion de l'échange des matériaux entre sous-domaines.                   */
 /*---------------------------------------------------------------------------*/
 /*---------------------------------------------------------------------------*/
 
 #include "arcane/utils/FunctorUtils.h"
+#include "arcane/utils/ValueConvert.h"
+#include "arcane/utils/MemoryUtils.h"
 
 #include "arcane/IItemFamilySerializeStep.h"
 #include "arcane/IMesh.h"
@@ -19,12 +21,17 @@
 #include "arcane/IItemFamilyPolicyMng.h"
 #include "arcane/ItemFamilySerializeArgs.h"
 #include "arcane/ISerializer.h"
+#include "arcane/core/ItemGroupObserver.h"
 
 #include "arcane/materials/MeshMaterialExchangeMng.h"
 #include "arcane/materials/MeshMaterialIndirectModifier.h"
 #include "arcane/materials/IMeshMaterialVariable.h"
 
 #include "arcane/materials/internal/MeshMaterialMng.h"
+#include "arcane/materials/internal/AllEnvData.h"
+#include "arcane/materials/internal/MeshEnvironment.h"
+#include "arcane/materials/internal/MeshMaterial.h"
+#include "arcane/materials/internal/IncrementalComponentModifier.h"
 
 /*---------------------------------------------------------------------------*/
 /*---------------------------------------------------------------------------*/
@@ -32,6 +39,65 @@
 namespace Arcane::Materials
 {
 
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*!
+ * \brief Observe le groupe des mailles d'un constituant pendant un échange.
+ *
+ * Conserve la liste des mailles supprimées du groupe (les mailles détruites)
+ * et celle des mailles ajoutées (les mailles reçues). L'instance appartient
+ * au groupe et est détruite lors de l'appel à detach().
+ */
+class ExchangeComponentCellsObserver
+: public IItemGroupObserver
+{
+ public:
+
+  explicit ExchangeComponentCellsObserver(const CellGroup& cells)
+  : m_cells(cells)
+  , m_removed_ids(MemoryUtils::getDefaultDataAllocator())
+  , m_added_ids(MemoryUtils::getDefaultDataAllocator())
+  {
+    m_cells.internal()->attachObserver(this, this);
+  }
+
+ public:
+
+  void executeExtend(const Int32ConstArrayView* info1) override
+  {
+    if (info1)
+      m_added_ids.addRange(*info1);
+    else
+      m_is_valid = false;
+  }
+  void executeReduce(const Int32ConstArrayView* info1) override
+  {
+    if (info1)
+      m_removed_ids.addRange(*info1);
+    else
+      m_is_valid = false;
+  }
+  void executeCompact(const Int32ConstArrayView*) override { m_is_valid = false; }
+  void executeInvalidate() override { m_is_valid = false; }
+  bool needInfo() const override { return true; }
+
+ public:
+
+  //! Détache l'observateur du groupe. L'instance est détruite.
+  void detach() { m_cells.internal()->detachObserver(this); }
+  bool isValid() const { return m_is_valid; }
+  const CellGroup& cells() const { return m_cells; }
+  SmallSpan<const Int32> removedIds() const { return m_removed_ids.view(); }
+  SmallSpan<const Int32> addedIds() const { return m_added_ids.view(); }
+
+ private:
+
+  CellGroup m_cells;
+  UniqueArray<Int32> m_removed_ids;
+  UniqueArray<Int32> m_added_ids;
+  bool m_is_valid = true;
+};
+
 /*---------------------------------------------------------------------------*/
 /*---------------------------------------------------------------------------*/
 
@@ -56,7 +122,14 @@ class MeshMaterialExchangeMng::ExchangeCellStep
   {
     if (m_exchange_mng->m_is_in_mesh_material_exchange)
       ARCANE_FATAL("Already in an exchange");
-    m_exchange_mng->m_is_in_mesh_material_exchange = false;
+    m_exchange_mng->m_is_in_mesh_material_exchange = true;
+    if (m_exchange_mng->isUseFastPath()) {
+      // Observe les groupes des constituants pour connaitre les mailles
+      // détruites et reçues lors de l'échange. Elles seront appliquées
+      // de manière incrémentale au début de la réception.
+      _attachObservers();
+      return;
+    }
     // Création du modificateur indirect permettant de remettre à jour les
     // matériaux après la mise à jour des groupes suite à la suppression
     // des entités lors de l'échange.
@@ -77,17 +150,28 @@ class MeshMaterialExchangeMng::ExchangeCellStep
       // les mailles qui viennent d'être ajoutées. Cela se fait dans
       // la désérialisation.
       info() << "NOTIFY_ACTION BEGIN_RECEIVE";
-      m_indirect_modifier->endUpdate();
-      delete m_indirect_modifier;
-      m_indirect_modifier = nullptr;
+      if (m_indirect_modifier) {
+        m_indirect_modifier->endUpdate();
+        delete m_indirect_modifier;
+        m_indirect_modifier = nullptr;
+      }
+      else
+        _applyExchangedCells();
     }
     if (args.action()==eAction::AC_EndReceive){
       info() << "NOTIFY_ACTION END_RECEIVE";
-      // Maintenant que les valeurs sont bonnes pour les variables, on doit
-      // les sauvegarder car une fois les réceptions terminées il va y avoir
-      // un compactage et pour l'instant cela peut poser des problèmes
-      // car la mise à jour des groupes via les observers n'est pas traitée.
-      // Du coup on remettra tout à jour lors du finalize();
+      // Une fois les réceptions terminées, il va y avoir un compactage.
+      // Si les milieux sont notifiés des modifications du maillage, le
+      // compactage met à jour directement les indexeurs des variables et
+      // les valeurs restent valides. Il n'est alors pas nécessaire de
+      // sauvegarder les valeurs (voir finalize()).
+      // Sinon, la mise à jour des groupes lors du compactage n'est pas
+      // répercutée sur les matériaux. Il faut donc sauvegarder maintenant
+      // les valeurs des variables et tout remettre à jour lors du finalize().
+      if (m_exchange_mng->isUseFastPath()) {
+        info(4) << "NOTIFY_ACTION END_RECEIVE: use fast path";
+        return;
+      }
       m_indirect_modifier = new MeshMaterialIndirectModifier(m_material_mng);
       m_indirect_modifier->beginUpdate();
     }
@@ -107,11 +191,20 @@ class MeshMaterialExchangeMng::ExchangeCellStep
   }
   void finalize() override
   {
-    // Reconstruit toutes les informations sur les groupes avec les bonnes valeurs
-    // des variables.
-    m_indirect_modifier->endUpdate();
-    delete m_indirect_modifier;
-    m_indirect_modifier = nullptr;
+    _detachObservers();
+    if (m_indirect_modifier) {
+      // Reconstruit toutes les informations sur les groupes avec les bonnes valeurs
+      // des variables.
+      m_indirect_modifier->endUpdate();
+      delete m_indirect_modifier;
+      m_indirect_modifier = nullptr;
+    }
+    else {
+      // Les listes de mailles des constituants et les valeurs partielles
+      // sont déjà à jour. Il suffit de recalculer les informations
+      // de connectivité sans reconstruire les constituants à partir des groupes.
+      m_material_mng->allEnvData()->recomputeIncremental();
+    }
     m_exchange_mng->m_is_in_mesh_material_exchange = false;
   }
   ePhase phase() const override { return IItemFamilySerializeStep::PH_Variable; }
@@ -121,6 +214,97 @@ class MeshMaterialExchangeMng::ExchangeCellStep
   MeshMaterialMng* m_material_mng;
   IItemFamily* m_family;
   MeshMaterialIndirectModifier* m_indirect_modifier;
+  //! Observateurs des groupes des milieux
+  UniqueArray<ExchangeComponentCellsObserver*> m_env_observers;
+  //! Observateurs des groupes des matériaux (dans l'ordre des milieux)
+  UniqueArray<ExchangeComponentCellsObserver*> m_mat_observers;
+
+ private:
+
+  void _attachObservers()
+  {
+    for (MeshEnvironment* env : m_material_mng->trueEnvironments()) {
+      m_env_observers.add(new ExchangeComponentCellsObserver(env->cells()));
+      for (MeshMaterial* mat : env->trueMaterials())
+        m_mat_observers.add(new ExchangeComponentCellsObserver(mat->cells()));
+    }
+  }
+  void _detachObservers()
+  {
+    for (ExchangeComponentCellsObserver* o : m_env_observers)
+      o->detach();
+    for (ExchangeComponentCellsObserver* o : m_mat_observers)
+      o->detach();
+    m_env_observers.clear();
+    m_mat_observers.clear();
+  }
+  /*!
+   * \brief Met à jour les constituants avec les mailles détruites et reçues.
+   *
+   * Les groupes des constituants sont déjà à jour. Il reste à supprimer
+   * des indexeurs les mailles détruites et à y ajouter les mailles reçues.
+   * Les valeurs des autres mailles ne sont ni sauvegardées ni recopiées.
+   */
+  void _applyExchangedCells()
+  {
+    for (ExchangeComponentCellsObserver* o : m_env_observers)
+      if (!o->isValid())
+        ARCANE_FATAL("Group '{0}' has been invalidated or compacted during the exchange."
+                     " Set ARCANE_MATERIAL_EXCHANGE_USE_FASTPATH=0 to disable the fast path",
+                     o->cells().name());
+    for (ExchangeComponentCellsObserver* o : m_mat_observers)
+      if (!o->isValid())
+        ARCANE_FATAL("Group '{0}' has been invalidated or compacted during the exchange."
+                     " Set ARCANE_MATERIAL_EXCHANGE_USE_FASTPATH=0 to disable the fast path",
+                     o->cells().name());
+
+    AllEnvData* all_env_data = m_material_mng->allEnvData();
+    IncrementalComponentModifier modifier(all_env_data, m_material_mng->runQueue());
+    modifier.initialize();
+
+    ConstArrayView<MeshEnvironment*> envs = m_material_mng->trueEnvironments();
+    const Int32 nb_env = envs.size();
+    UniqueArray<SmallSpan<const Int32>> mats_ids;
+
+    // Il faut d'abord supprimer les mailles détruites car leur localId
+    // a pu être réutilisé par une maille reçue.
+    for (Int32 i = 0, mat_index = 0; i < nb_env; ++i) {
+      Int32 nb_mat = envs[i]->trueMaterials().size();
+      mats_ids.clear();
+      for (Int32 k = 0; k < nb_mat; ++k)
+        mats_ids.add(m_mat_observers[mat_index + k]->removedIds());
+      info(4) << "Exchange: remove cells env=" << envs[i]->name()
+              << " n=" << m_env_observers[i]->removedIds().size();
+      modifier.removeDestroyedCells(envs[i], m_env_observers[i]->removedIds(), mats_ids);
+      mat_index += nb_mat;
+    }
+
+    // Met à jour la connectivité de tous les milieux avant de remplir
+    // les indexeurs car l'état pur ou partiel d'une maille en dépend.
+    for (Int32 pass = 0; pass < 2; ++pass) {
+      for (Int32 i = 0, mat_index = 0; i < nb_env; ++i) {
+        Int32 nb_mat = envs[i]->trueMaterials().size();
+        mats_ids.clear();
+        for (Int32 k = 0; k < nb_mat; ++k)
+          mats_ids.add(m_mat_observers[mat_index + k]->addedIds());
+        SmallSpan<const Int32> env_ids = m_env_observers[i]->addedIds();
+        if (pass == 0)
+          modifier.addReceivedCellsConnectivity(envs[i], env_ids, mats_ids);
+        else {
+          info(4) << "Exchange: add cells env=" << envs[i]->name() << " n=" << env_ids.size();
+          modifier.addReceivedCells(envs[i], env_ids, mats_ids);
+        }
+        mat_index += nb_mat;
+      }
+    }
+
+    modifier.finalize();
+    _detachObservers();
+
+    // La suppression laisse des trous dans les valeurs partielles.
+    m_material_mng->checkCompactPartialValues();
+    all_env_data->recomputeIncremental();
+  }
 };
 
 /*---------------------------------------------------------------------------*/
@@ -157,6 +341,8 @@ MeshMaterialExchangeMng(MeshMaterialMng* material_mng)
 , m_serialize_cells_factory(nullptr)
 , m_is_in_mesh_material_exchange(false)
 {
+  if (auto v = Convert::Type<Int32>::tryParseFromEnvironment("ARCANE_MATERIAL_EXCHANGE_USE_FASTPATH", true))
+    m_is_use_fast_path = (v.value() != 0);
 }
 
 /*---------------------------------------------------------------------------*/
@@ -174,6 +360,21 @@ MeshMaterialExchangeMng::
 
 /*---------------------------------------------------------------------------*/
 /*---------------------------------------------------------------------------*/
+/*!
+ * \brief Indique si on met à jour les constituants de manière incrémentale.
+ *
+ * Dans ce cas, les mailles détruites et reçues lors de l'échange sont
+ * appliquées via IncrementalComponentModifier au début de la réception et
+ * les valeurs des mailles conservées ne sont ni sauvegardées ni recopiées.
+ * Ce n'est possible que si les milieux sont notifiés des compactages du
+ * maillage (IMeshMaterialMng::isMeshModificationNotified()) car dans ce cas
+ * les indexeurs des variables sont mis à jour directement lors du compactage.
+ */
+bool MeshMaterialExchangeMng::
+isUseFastPath() const
+{
+  return m_is_use_fast_path && m_material_mng->isMeshModificationNotified();
+}
 
 /*---------------------------------------------------------------------------*/
 /*---------------------------------------------------------------------------*/
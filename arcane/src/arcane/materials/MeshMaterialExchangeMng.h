@@ -1,11 +1,11 @@
 ﻿// -*- tab-width: 2; indent-tabs-mode: nil; coding: utf-8-with-signature -*-
 //-----------------------------------------------------------------------------
-// Copyright 2000-2022 CEA (www.cea.fr) IFPEN (www.ifpenergiesnouvelles.com)
+// Copyright 2000-2024 CEA (www.cea.fr) IFPEN (www.ifpenergiesnouvelles.com)
 // See the top-level COPYRIGHT file for details.
 // SPDX-License-Identifier: Apache-2.0
 //-----------------------------------------------------------------------------
 /*---------------------------------------------------------------------------*/
-/* MeshMaterialExchangeMng.h                                   (C) 2000-2016 */
+/* MeshMaterialExchangeMng.h                                   (C) 2000-2024 */
 /*                                                                           */
 /* Gestion de l'échange des matériaux entre sous-domaines.                   */
 /*---------------------------------------------------------------------------*/
@@ -55,12 +55,14 @@ class MeshMaterialExchangeMng
   {
     return m_is_in_mesh_material_exchange;
   }
+  bool isUseFastPath() const;
 
  public:
 
   MeshMaterialMng* m_material_mng;
   IItemFamilySerializeStepFactory* m_serialize_cells_factory;
   bool m_is_in_mesh_material_exchange;
+  bool m_is_use_fast_path = true;
 };
 
 /*---------------------------------------------------------------------------*/
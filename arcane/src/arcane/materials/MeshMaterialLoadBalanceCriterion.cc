@@ -0,0 +1,155 @@
+﻿// -*- tab-width: 2; indent-tabs-mode: nil; coding: utf-8-with-signature -*-
+//-----------------------------------------------------------------------------
+// Copyright 2000-2024 CEA (www.cea.fr) IFPEN (www.ifpenergiesnouvelles.com)
+// See the top-level COPYRIGHT file for details.
+// SPDX-License-Identifier: Apache-2.0
+//-----------------------------------------------------------------------------
+/*---------------------------------------------------------------------------*/
+/* MeshMaterialLoadBalanceCriterion.cc                         (C) 2000-2024 */
+/*                                                                           */
+/* Critère d'équilibrage de charge pour les matériaux.                       */
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+#include "arcane/materials/MeshMaterialLoadBalanceCriterion.h"
+
+#include "arcane/utils/PlatformUtils.h"
+#include "arcane/utils/FatalErrorException.h"
+
+#include "arcane/core/IMesh.h"
+#include "arcane/core/IParallelMng.h"
+#include "arcane/core/VariableBuildInfo.h"
+#include "arcane/core/ICriteriaLoadBalanceMng.h"
+#include "arcane/core/materials/IMeshMaterialMng.h"
+#include "arcane/core/materials/IMeshEnvironment.h"
+#include "arcane/core/materials/MatItemEnumerator.h"
+#include "arcane/core/materials/ComponentPartItemVectorView.h"
+#include "arcane/core/materials/MeshMaterialVariableRef.h"
+#include "arcane/core/materials/MaterialVariableBuildInfo.h"
+
+#include "arcane/materials/CellToAllEnvCellConverter.h"
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+namespace Arcane::Materials
+{
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+MeshMaterialLoadBalanceCriterion::
+MeshMaterialLoadBalanceCriterion(IMeshMaterialMng* mm)
+: TraceAccessor(mm->traceMng())
+, m_material_mng(mm)
+, m_costs(VariableBuildInfo(mm->mesh(), "ArcaneMaterialLoadBalanceCost",
+                            IVariable::PNoDump | IVariable::PExecutionDepend))
+{
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+void MeshMaterialLoadBalanceCriterion::
+calibrate(Int32 nb_iteration)
+{
+  if (nb_iteration <= 0)
+    ARCANE_FATAL("Invalid number of iteration '{0}'", nb_iteration);
+
+  MaterialVariableCellReal var_a(MaterialVariableBuildInfo(m_material_mng, "ArcaneLoadBalanceCalibrationA",
+                                                           IVariable::PNoDump | IVariable::PTemporary));
+  MaterialVariableCellReal var_b(MaterialVariableBuildInfo(m_material_mng, "ArcaneLoadBalanceCalibrationB",
+                                                           IVariable::PNoDump | IVariable::PTemporary));
+  var_b.fill(1.0);
+
+  // Temps (en secondes) et nombre de mailles des parties pures et impures.
+  Real times[2] = { 0.0, 0.0 };
+  Real nb_items[2] = { 0.0, 0.0 };
+  for (IMeshEnvironment* env : m_material_mng->environments()) {
+    EnvPurePartItemVectorView pure_items = env->pureEnvItems();
+    EnvImpurePartItemVectorView impure_items = env->impureEnvItems();
+    Real t0 = platform::getRealTime();
+    for (Int32 z = 0; z < nb_iteration; ++z) {
+      ENUMERATE_COMPONENTITEM (EnvPartCell, imc, pure_items) {
+        var_a[imc] += var_b[imc] * 0.5;
+      }
+    }
+    Real t1 = platform::getRealTime();
+    for (Int32 z = 0; z < nb_iteration; ++z) {
+      ENUMERATE_COMPONENTITEM (EnvPartCell, imc, impure_items) {
+        var_a[imc] += var_b[imc] * 0.5;
+      }
+    }
+    Real t2 = platform::getRealTime();
+    times[0] += t1 - t0;
+    times[1] += t2 - t1;
+    nb_items[0] += pure_items.nbItem();
+    nb_items[1] += impure_items.nbItem();
+  }
+
+  // Utilise les valeurs de l'ensemble des rangs pour que le facteur soit
+  // le même partout.
+  IParallelMng* pm = m_material_mng->mesh()->parallelMng();
+  pm->reduce(Parallel::ReduceSum, RealArrayView(2, times));
+  pm->reduce(Parallel::ReduceSum, RealArrayView(2, nb_items));
+
+  if (nb_items[0] == 0.0 || nb_items[1] == 0.0 || times[0] <= 0.0) {
+    info() << "MeshMaterialLoadBalanceCriterion: not enough cells to calibrate."
+           << " Keeping impure_factor=" << m_impure_factor;
+    return;
+  }
+  Real pure_time = times[0] / nb_items[0];
+  Real impure_time = times[1] / nb_items[1];
+  m_impure_factor = math::min(math::max(impure_time / pure_time, 1.0), 100.0);
+  info() << "MeshMaterialLoadBalanceCriterion: calibration time_per_pure_cell=" << pure_time
+         << " time_per_impure_cell=" << impure_time
+         << " impure_factor=" << m_impure_factor;
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+void MeshMaterialLoadBalanceCriterion::
+computeCosts()
+{
+  CellToAllEnvCellConverter all_env_cell_converter(m_material_mng);
+  const Real cell_cost = m_cell_cost;
+  const Real env_cost = m_environment_cost;
+  const Real mat_cost = m_material_cost;
+  const Real impure_factor = m_impure_factor;
+  Int32 nb_mixed = 0;
+  ENUMERATE_ (Cell, icell, m_material_mng->mesh()->allCells()) {
+    AllEnvCell all_env_cell = all_env_cell_converter[icell];
+    Int32 nb_env = all_env_cell.nbEnvironment();
+    Int32 nb_mat = 0;
+    ENUMERATE_CELL_ENVCELL (ienvcell, all_env_cell) {
+      nb_mat += (*ienvcell).nbMaterial();
+    }
+    bool is_mixed = (nb_env > 1 || nb_mat > 1);
+    if (is_mixed)
+      ++nb_mixed;
+    Real factor = (is_mixed) ? impure_factor : 1.0;
+    m_costs[icell] = cell_cost + factor * (env_cost * nb_env + mat_cost * nb_mat);
+  }
+  info(4) << "MeshMaterialLoadBalanceCriterion: nb_mixed_cell=" << nb_mixed
+          << " nb_cell=" << m_material_mng->mesh()->allCells().size();
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+void MeshMaterialLoadBalanceCriterion::
+registerCriterion(ICriteriaLoadBalanceMng& mng)
+{
+  computeCosts();
+  mng.addCriterion(m_costs);
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+} // End namespace Arcane::Materials
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
@@ -0,0 +1,132 @@
+﻿// -*- tab-width: 2; indent-tabs-mode: nil; coding: utf-8-with-signature -*-
+//-----------------------------------------------------------------------------
+// Copyright 2000-2024 CEA (www.cea.fr) IFPEN (www.ifpenergiesnouvelles.com)
+// See the top-level COPYRIGHT file for details.
+// SPDX-License-Identifier: Apache-2.0
+//-----------------------------------------------------------------------------
+/*---------------------------------------------------------------------------*/
+/* MeshMaterialLoadBalanceCriterion.h                          (C) 2000-2024 */
+/*                                                                           */
+/* Critère d'équilibrage de charge pour les matériaux.                       */
+/*---------------------------------------------------------------------------*/
+#ifndef ARCANE_MATERIALS_MESHMATERIALLOADBALANCECRITERION_H
+#define ARCANE_MATERIALS_MESHMATERIALLOADBALANCECRITERION_H
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+#include "arcane/utils/TraceAccessor.h"
+
+#include "arcane/core/VariableTypes.h"
+
+#include "arcane/materials/MaterialsGlobal.h"
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+namespace Arcane
+{
+class ICriteriaLoadBalanceMng;
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+namespace Arcane::Materials
+{
+class IMeshMaterialMng;
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*!
+ * \ingroup ArcaneMaterials
+ * \brief Critère d'équilibrage de charge tenant compte des matériaux.
+ *
+ * Cette classe calcule pour chaque maille un coût estimé à partir du nombre
+ * de milieux et de matériaux de la maille. Ce coût vaut:
+ *
+ * \code
+ * cost = cellCost() + factor * (environmentCost() * nb_env + materialCost() * nb_mat)
+ * \endcode
+ *
+ * avec \a factor qui vaut 1.0 pour les mailles pures et impureFactor() pour
+ * les mailles mixtes (plusieurs milieux ou plusieurs matériaux).
+ *
+ * La valeur de impureFactor() peut être estimée via calibrate() qui mesure
+ * le temps d'itération sur les parties pures et impures des milieux.
+ *
+ * L'appel à registerCriterion() calcule les coûts et les ajoute comme critère
+ * à un ICriteriaLoadBalanceMng (par exemple MeshCriteriaLoadBalanceMng).
+ * Comme les critères sont supprimés après chaque partitionnement, il faut
+ * appeler registerCriterion() avant chaque demande de repartitionnement.
+ *
+ * \code
+ * MeshMaterialLoadBalanceCriterion mat_criterion(material_mng);
+ * MeshCriteriaLoadBalanceMng lb_mng(subDomain(), mesh()->handle());
+ * mat_criterion.registerCriterion(lb_mng);
+ * subDomain()->timeLoopMng()->registerActionMeshPartition(partitioner);
+ * \endcode
+ */
+class ARCANE_MATERIALS_EXPORT MeshMaterialLoadBalanceCriterion
+: public TraceAccessor
+{
+ public:
+
+  explicit MeshMaterialLoadBalanceCriterion(IMeshMaterialMng* mm);
+
+ public:
+
+  //! Coût de base d'une maille
+  Real cellCost() const { return m_cell_cost; }
+  void setCellCost(Real v) { m_cell_cost = v; }
+
+  //! Coût d'un milieu d'une maille
+  Real environmentCost() const { return m_environment_cost; }
+  void setEnvironmentCost(Real v) { m_environment_cost = v; }
+
+  //! Coût d'un matériau d'une maille
+  Real materialCost() const { return m_material_cost; }
+  void setMaterialCost(Real v) { m_material_cost = v; }
+
+  //! Facteur multiplicatif du coût des constituants pour les mailles mixtes
+  Real impureFactor() const { return m_impure_factor; }
+  void setImpureFactor(Real v) { m_impure_factor = v; }
+
+ public:
+
+  /*!
+   * \brief Estime impureFactor() en mesurant le temps des boucles sur les milieux.
+   *
+   * Effectue \a nb_iteration fois une boucle sur la partie pure et sur
+   * la partie impure de chaque milieu et positionne impureFactor() avec
+   * le rapport des temps par maille. Cette méthode est collective.
+   */
+  void calibrate(Int32 nb_iteration = 10);
+
+  //! Calcule le coût de chaque maille.
+  void computeCosts();
+
+  //! Calcule le coût de chaque maille et l'ajoute comme critère à \a mng.
+  void registerCriterion(ICriteriaLoadBalanceMng& mng);
+
+  //! Variable contenant le coût de chaque maille.
+  VariableCellReal& costs() { return m_costs; }
+
+ private:
+
+  IMeshMaterialMng* m_material_mng = nullptr;
+  VariableCellReal m_costs;
+  Real m_cell_cost = 1.0;
+  Real m_environment_cost = 1.0;
+  Real m_material_cost = 1.0;
+  Real m_impure_factor = 2.0;
+};
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+} // End namespace Arcane::Materials
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+#endif
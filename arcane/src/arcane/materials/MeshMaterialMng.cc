@@ -21,6 +21,7 @@
 #include "arcane/utils/PlatformUtils.h"
 #include "arcane/utils/ValueConvert.h"
 #include "arcane/utils/CheckedConvert.h"
+#include "arcane/utils/MemoryUtils.h"
 
 #include "arcane/core/IMesh.h"
 #include "arcane/core/IItemFamily.h"
@@ -130,6 +131,7 @@ MeshMaterialMng(const MeshHandle& mesh_handle,const String& name)
 , m_internal_api(std::make_unique<InternalApi>(this))
 , m_variable_mng(mesh_handle.variableMng())
 , m_name(name)
+, m_compaction_buffer(MemoryUtils::getDefaultDataAllocator())
 {
   m_all_env_data = std::make_unique<AllEnvData>(this);
   m_exchange_mng = std::make_unique<MeshMaterialExchangeMng>(this);
@@ -306,6 +308,16 @@ build()
     }
   }
 
+  // Choix du compactage automatique des valeurs partielles
+  {
+    if (auto v = Convert::Type<Real>::tryParseFromEnvironment("ARCANE_MATERIALMNG_PARTIAL_VALUES_COMPACTION_RATIO", true)){
+      if (v>=0.0){
+        m_partial_values_compaction_ratio = v.value();
+        info() << "Set partial values compaction ratio to " << m_partial_values_compaction_ratio;
+      }
+    }
+  }
+
   m_exchange_mng->build();
   // Si les traces des énumérateurs sur les entités sont actives, active celles
   // sur les matériaux.
@@ -665,6 +677,77 @@ _endUpdate()
   m_all_env_data->forceRecompute(true);
 }
 
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+void MeshMaterialMng::
+compactPartialValues()
+{
+  // Une valeur négative force le compactage de tous les indexeurs, ce qui
+  // permet aussi de libérer la capacité non utilisée.
+  _compactPartialValues(-1.0);
+  m_all_env_data->recomputeIncremental();
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*!
+ * \brief Compacte les valeurs partielles si le compactage automatique est actif.
+ *
+ * Cette méthode est appelée après une modification incrémentale des
+ * constituants et avant la mise à jour des informations des mailles
+ * constituants qui utilisent les MatVarIndex.
+ */
+void MeshMaterialMng::
+checkCompactPartialValues()
+{
+  if (m_partial_values_compaction_ratio > 0.0)
+    _compactPartialValues(m_partial_values_compaction_ratio);
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*!
+ * \brief Compacte les valeurs partielles des indexeurs.
+ *
+ * Seuls les indexeurs dont la proportion d'emplacements inutilisés
+ * dans le tableau des valeurs partielles est supérieure à \a min_hole_ratio
+ * sont compactés. Le tableau de travail servant aux recopies est conservé
+ * pour être réutilisé lors des compactages suivants.
+ *
+ * Retourne le nombre d'indexeurs compactés.
+ */
+Int32 MeshMaterialMng::
+_compactPartialValues(Real min_hole_ratio)
+{
+  UniqueArray<MatVarIndex> old_indexes(MemoryUtils::getDefaultDataAllocator());
+  UniqueArray<MatVarIndex> new_indexes(MemoryUtils::getDefaultDataAllocator());
+  RunQueue& queue = runQueue();
+  Int32 nb_compacted = 0;
+  for (MeshMaterialVariableIndexer* indexer : m_variables_indexer) {
+    const Int32 nb_slot = indexer->maxIndexInMultipleArray();
+    const Int32 nb_hole = nb_slot - indexer->nbPartialValue();
+    if (nb_hole <= (min_hole_ratio * nb_slot))
+      continue;
+    indexer->compactPartialIndexes(old_indexes, new_indexes);
+    for (const auto& i : m_full_name_variable_map) {
+      IMeshMaterialVariable* mv = i.second;
+      mv->_internalApi()->compactPartialValues(indexer->index(), old_indexes, new_indexes,
+                                               m_compaction_buffer, queue);
+    }
+    m_nb_reclaimed_partial_value += nb_hole;
+    ++nb_compacted;
+  }
+  queue.barrier();
+  if (nb_compacted != 0) {
+    ++m_nb_partial_values_compaction;
+    incrementTimestamp();
+  }
+  info(4) << "CompactPartialValues nb_compacted=" << nb_compacted
+          << " total_reclaimed=" << m_nb_reclaimed_partial_value;
+  return nb_compacted;
+}
+
 /*---------------------------------------------------------------------------*/
 /*---------------------------------------------------------------------------*/
 /*!
@@ -887,6 +970,7 @@ dumpInfos(std::ostream& o)
       o << "--       var_idx = " << idx->index() << "\n";
     }
   }
+  _dumpPartialValuesMemoryInfos(o);
 }
 
 /*---------------------------------------------------------------------------*/
@@ -950,6 +1034,52 @@ dumpInfos2(std::ostream& o)
         << "\n";
     }
   }
+  _dumpPartialValuesMemoryInfos(o);
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*!
+ * \brief Affiche les informations sur la mémoire utilisée par les valeurs partielles.
+ *
+ * Pour chaque indexeur, affiche le nombre de valeurs partielles utilisées et
+ * le nombre d'emplacements alloués. La différence correspond aux trous
+ * laissés par les modifications incrémentales qui peuvent être supprimés
+ * via compactPartialValues().
+ */
+void MeshMaterialMng::
+_dumpPartialValuesMemoryInfos(std::ostream& o)
+{
+  Int64 total_nb_partial = 0;
+  Int64 total_nb_slot = 0;
+  o << "-- Partial values memory\n";
+  for (MeshMaterialVariableIndexer* indexer : m_variables_indexer) {
+    const Int32 nb_slot = indexer->maxIndexInMultipleArray();
+    const Int32 nb_partial = indexer->nbPartialValue();
+    total_nb_partial += nb_partial;
+    total_nb_slot += nb_slot;
+    o << "--   Indexer name=" << indexer->name()
+      << " index=" << indexer->index()
+      << " nb_partial=" << nb_partial
+      << " nb_slot=" << nb_slot;
+    if (nb_slot != 0)
+      o << " hole_percent=" << ((nb_slot - nb_partial) * 100) / nb_slot;
+    o << "\n";
+  }
+  Real allocated_memory = 0.0;
+  for (const auto& i : m_full_name_variable_map) {
+    ConstArrayView<VariableRef*> refs = i.second->_internalApi()->variableReferenceList();
+    // L'indice 0 correspond à la variable globale.
+    for (Integer k = 1, n = refs.size(); k < n; ++k)
+      if (refs[k])
+        allocated_memory += refs[k]->variable()->allocatedMemory();
+  }
+  o << "--   Total nb_partial=" << total_nb_partial
+    << " nb_slot=" << total_nb_slot
+    << " allocated_memory=" << allocated_memory
+    << " nb_compaction=" << m_nb_partial_values_compaction
+    << " nb_reclaimed=" << m_nb_reclaimed_partial_value
+    << "\n";
 }
 
 /*---------------------------------------------------------------------------*/
@@ -87,6 +87,17 @@ removeCells(IMeshMaterial* mat, SmallSpan<const Int32> ids)
 /*---------------------------------------------------------------------------*/
 /*---------------------------------------------------------------------------*/
 
+void MeshMaterialModifier::
+modifyCells(SmallSpan<const Int32> material_ids, SmallSpan<const Int32> cell_local_ids,
+            SmallSpan<const bool> is_add)
+{
+  _checkHasUpdate();
+  m_impl->modifyCells(material_ids, cell_local_ids, is_add);
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
 void MeshMaterialModifier::
 endUpdate()
 {
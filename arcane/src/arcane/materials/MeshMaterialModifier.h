@@ -60,6 +60,32 @@ class ARCANE_MATERIALS_EXPORT MeshMaterialModifier
    */
   void removeCells(IMeshMaterial* mat, SmallSpan<const Int32> ids);
 
+  /*!
+   * \brief Ajoute ou supprime en une fois des mailles de plusieurs matériaux.
+   *
+   * Pour chaque indice \a i, la maille de numéro local \a cell_local_ids[i]
+   * est ajoutée au matériau d'identifiant \a material_ids[i] si \a is_add[i]
+   * est vrai et supprimée de ce matériau sinon. L'identifiant d'un matériau
+   * est celui retourné par IMeshMaterial::id().
+   *
+   * Les trois tableaux doivent avoir la même taille et être accessibles
+   * depuis la file de IMeshMaterialMng::runQueue(). Ils ne sont lus que
+   * sur cette file et n'ont donc pas besoin d'être accessibles depuis l'hôte.
+   *
+   * Si un même couple (matériau,maille) apparait plusieurs fois, seule la
+   * dernière occurrence est prise en compte. La liste est triée et regroupée
+   * par matériau de sorte qu'il n'y a au plus qu'une opération de suppression
+   * et une opération d'ajout par matériau. Les suppressions sont effectuées
+   * avant les ajouts. Comme pour addCells() et removeCells(), les modifications
+   * ne sont prises en compte que lors de l'appel à endUpdate() et ne
+   * nécessitent donc qu'un seul recalcul des informations des milieux.
+   *
+   * Cette méthode est à privilégier lorsque de nombreux matériaux sont
+   * modifiés simultanément.
+   */
+  void modifyCells(SmallSpan<const Int32> material_ids, SmallSpan<const Int32> cell_local_ids,
+                   SmallSpan<const bool> is_add);
+
   /*!
    * \brief Met à jour les structures après une modification.
    *
@@ -15,6 +15,7 @@
 #include "arcane/utils/PlatformUtils.h"
 #include "arcane/utils/ITraceMng.h"
 #include "arcane/utils/ValueConvert.h"
+#include "arcane/utils/MemoryUtils.h"
 
 #include "arcane/core/IItemFamily.h"
 #include "arcane/core/IData.h"
@@ -30,6 +31,10 @@
 #include "arcane/materials/internal/IncrementalComponentModifier.h"
 #include "arcane/materials/internal/ConstituentListPrinter.h"
 
+#include "arcane/accelerator/RunCommandLoop.h"
+#include "arcane/accelerator/Filter.h"
+#include "arcane/accelerator/Sort.h"
+
 /*---------------------------------------------------------------------------*/
 /*---------------------------------------------------------------------------*/
 
@@ -146,6 +151,127 @@ removeCells(IMeshMaterial* mat, SmallSpan<const Int32> ids)
   m_operations.add(Operation::createRemove(mat, ids));
 }
 
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*!
+ * \brief Enregistre en une fois des ajouts et suppressions pour plusieurs matériaux.
+ *
+ * Les couples (matériau,maille) sont triés sur la file et on ne conserve
+ * que la dernière occurrence de chaque couple. Les tableaux d'entrée ne sont
+ * lus que sur la file. Les mailles sont ensuite regroupées par matériau pour ne créer au plus qu'une opération d'ajout
+ * et une opération de suppression par matériau.
+ */
+void MeshMaterialModifierImpl::
+modifyCells(SmallSpan<const Int32> material_ids, SmallSpan<const Int32> cell_local_ids,
+            SmallSpan<const bool> is_add)
+{
+  const Int32 n = cell_local_ids.size();
+  if (material_ids.size() != n)
+    ARCANE_FATAL("Bad size for material_ids v={0} expected={1}", material_ids.size(), n);
+  if (is_add.size() != n)
+    ARCANE_FATAL("Bad size for is_add v={0} expected={1}", is_add.size(), n);
+  if (n == 0)
+    return;
+  ++nb_bulk_modification;
+
+  IMemoryAllocator* allocator = MemoryUtils::getDefaultDataAllocator();
+  UniqueArray<Int64> keys(allocator, n);
+  UniqueArray<Int64> sorted_keys(allocator, n);
+  UniqueArray<Int32> indexes(allocator, n);
+  UniqueArray<Int32> sorted_indexes(allocator, n);
+  UniqueArray<Int32> last_positions(allocator, n);
+  UniqueArray<Int64> unique_keys(allocator, n);
+  UniqueArray<bool> unique_is_add(allocator, n);
+
+  // La clé de tri est le couple (matériau,maille). Le tri étant stable,
+  // la dernière occurrence d'un couple est la dernière de sa série.
+  {
+    SmallSpan<Int64> keys_view = keys.view();
+    SmallSpan<Int32> indexes_view = indexes.view();
+    auto command = makeCommand(m_queue);
+    command << RUNCOMMAND_LOOP1(iter, n)
+    {
+      auto [i] = iter();
+      keys_view[i] = (static_cast<Int64>(material_ids[i]) << 32) | static_cast<Int64>(cell_local_ids[i]);
+      indexes_view[i] = i;
+    };
+  }
+  {
+    Accelerator::GenericSorter sorter(m_queue);
+    sorter.applyPairs(keys.constSmallSpan(), sorted_keys.smallSpan(), indexes.constSmallSpan(),
+                      sorted_indexes.smallSpan(), A_FUNCINFO);
+  }
+  Int32 nb_unique = 0;
+  {
+    Accelerator::GenericFilterer filterer(&m_queue);
+    SmallSpan<const Int64> sorted_keys_view = sorted_keys.constView();
+    SmallSpan<Int32> last_positions_view = last_positions.view();
+    auto select_lambda = [=] ARCCORE_HOST_DEVICE(Int32 index) -> bool {
+      return (index + 1) == n || sorted_keys_view[index] != sorted_keys_view[index + 1];
+    };
+    auto setter_lambda = [=] ARCCORE_HOST_DEVICE(Int32 input_index, Int32 output_index) {
+      last_positions_view[output_index] = input_index;
+    };
+    filterer.applyWithIndex(n, select_lambda, setter_lambda, A_FUNCINFO);
+    nb_unique = filterer.nbOutputElement();
+  }
+  // Récupère sur la file la clé et le type d'opération de chaque couple
+  // conservé pour pouvoir ensuite les lire depuis l'hôte.
+  {
+    SmallSpan<const Int64> sorted_keys_view = sorted_keys.constView();
+    SmallSpan<const Int32> sorted_indexes_view = sorted_indexes.constView();
+    SmallSpan<const Int32> last_positions_view = last_positions.constView();
+    SmallSpan<Int64> unique_keys_view = unique_keys.view();
+    SmallSpan<bool> unique_is_add_view = unique_is_add.view();
+    auto command = makeCommand(m_queue);
+    command << RUNCOMMAND_LOOP1(iter, nb_unique)
+    {
+      auto [i] = iter();
+      const Int32 sorted_pos = last_positions_view[i];
+      unique_keys_view[i] = sorted_keys_view[sorted_pos];
+      unique_is_add_view[i] = is_add[sorted_indexes_view[sorted_pos]];
+    };
+    m_queue.barrier();
+  }
+
+  // Regroupe les mailles par matériau. Les opérations de suppression
+  // sont ajoutées avant les opérations d'ajout.
+  ConstArrayView<IMeshMaterial*> materials = m_material_mng->materials();
+  const Int32 nb_material = materials.size();
+  UniqueArray<Operation*> add_operations;
+  UniqueArray<Int32> added_ids;
+  UniqueArray<Int32> removed_ids;
+  Int32 position = 0;
+  while (position < nb_unique) {
+    const Int64 first_key = unique_keys[position];
+    const Int32 mat_id = static_cast<Int32>(first_key >> 32);
+    if (mat_id < 0 || mat_id >= nb_material)
+      ARCANE_FATAL("Bad material id '{0}' (nb_material={1})", mat_id, nb_material);
+    added_ids.clear();
+    removed_ids.clear();
+    for (; position < nb_unique; ++position) {
+      const Int64 key = unique_keys[position];
+      if (static_cast<Int32>(key >> 32) != mat_id)
+        break;
+      const Int32 lid = static_cast<Int32>(key & 0xFFFFFFFF);
+      if (unique_is_add[position])
+        added_ids.add(lid);
+      else
+        removed_ids.add(lid);
+    }
+    IMeshMaterial* mat = materials[mat_id];
+    if (!removed_ids.empty())
+      m_operations.add(Operation::createRemove(mat, removed_ids));
+    if (!added_ids.empty())
+      add_operations.add(Operation::createAdd(mat, added_ids));
+  }
+  for (Operation* o : add_operations)
+    m_operations.add(o);
+
+  info(4) << "MeshMaterialModifier::modifyCells nb_input=" << n << " nb_unique=" << nb_unique
+          << " nb_operation=" << m_operations.values().size();
+}
+
 /*---------------------------------------------------------------------------*/
 /*---------------------------------------------------------------------------*/
 
@@ -309,6 +435,10 @@ _endUpdate()
   }
   else {
     m_incremental_modifier->finalize();
+    // Les modifications incrémentales laissent des trous dans les valeurs
+    // partielles. Il faut éventuellement les compacter avant de mettre à jour
+    // les informations des mailles constituants.
+    m_material_mng->checkCompactPartialValues();
     all_env_data->recomputeIncremental();
   }
 
@@ -427,6 +557,7 @@ dumpStats()
   info() << " Nb save/restore : " << nb_save_restore;
   info() << " Nb optimized add : " << nb_optimize_add;
   info() << " Nb optimized remove : " << nb_optimize_remove;
+  info() << " Nb bulk modifications : " << nb_bulk_modification;
 }
 
 /*---------------------------------------------------------------------------*/
@@ -1,11 +1,11 @@
 ﻿// -*- tab-width: 2; indent-tabs-mode: nil; coding: utf-8-with-signature -*-
 //-----------------------------------------------------------------------------
-// Copyright 2000-2023 CEA (www.cea.fr) IFPEN (www.ifpenergiesnouvelles.com)
+// Copyright 2000-2024 CEA (www.cea.fr) IFPEN (www.ifpenergiesnouvelles.com)
 // See the top-level COPYRIGHT file for details.
 // SPDX-License-Identifier: Apache-2.0
 //-----------------------------------------------------------------------------
 /*---------------------------------------------------------------------------*/
-/* MeshMaterialSynchronizer.cc                                 (C) 2000-2023 */
+/* MeshMaterialSynchronizer.cc                                 (C) 2000-2024 */
 /*                                                                           */
 /* Synchronisation des entités des matériaux.                                */
 /*---------------------------------------------------------------------------*/
@@ -21,6 +21,7 @@
 #include "arcane/materials/CellToAllEnvCellConverter.h"
 #include "arcane/materials/MatItemEnumerator.h"
 #include "arcane/materials/MeshMaterialModifier.h"
+#include "arcane/materials/CellMaterialPresenceView.h"
 
 /*---------------------------------------------------------------------------*/
 /*---------------------------------------------------------------------------*/
@@ -68,16 +69,20 @@ _hasBit(ByteConstArrayView bytes,Integer position)
 /*---------------------------------------------------------------------------*/
 /*---------------------------------------------------------------------------*/
 
+/*!
+ * \brief Remplit \a presence avec les bits de présence des matériaux de la maille.
+ *
+ * Les bits sont directement recopiés depuis \a presence_view. L'octet \a i
+ * de \a presence correspond aux matériaux d'indice \a i*8 à \a i*8+7, ce qui
+ * est le même rangement que celui utilisé par _setBit() et _hasBit().
+ */
 void MeshMaterialSynchronizer::
-_fillPresence(AllEnvCell all_env_cell,ByteArrayView presence)
+_fillPresence(const CellMaterialPresenceView& presence_view,CellLocalId cell_id,ByteArrayView presence)
 {
-  ENUMERATE_CELL_ENVCELL(ienvcell,all_env_cell){
-    ENUMERATE_CELL_MATCELL(imatcell,(*ienvcell)){
-      MatCell mc = *imatcell;
-      Integer mat_index = mc.materialId();
-      _setBit(presence,mat_index);
-    }
-  }
+  SmallSpan<const UInt64> words = presence_view.cellWords(cell_id);
+  const Integer nb_byte = presence.size();
+  for( Integer i=0; i<nb_byte; ++i )
+    presence[i] = static_cast<Byte>(words[i/8] >> ((i%8)*8));
 }
 
 /*---------------------------------------------------------------------------*/
@@ -113,12 +118,10 @@ synchronizeMaterialsInCells()
     ++dim2_size;
   mat_presence.resize(dim2_size);
   info(4) << "Resize presence variable nb_mat=" << nb_mat << " dim2=" << dim2_size;
-  CellToAllEnvCellConverter cell_converter = m_material_mng->cellToAllEnvCellConverter();
+  CellMaterialPresenceView presence_view(m_material_mng);
   ENUMERATE_CELL(icell,mesh->ownCells()){
     ByteArrayView presence = mat_presence[icell];
-    presence.fill(0);
-    AllEnvCell all_env_cell = cell_converter[*icell];
-    _fillPresence(all_env_cell,presence);
+    _fillPresence(presence_view,*icell,presence);
   }
 
   bool has_changed = false;
@@ -134,9 +137,7 @@ synchronizeMaterialsInCells()
       if (cell.isOwn())
         continue;
       Int32 cell_lid = cell.localId();
-      AllEnvCell all_env_cell = cell_converter[cell];
-      before_presence.fill(0);
-      _fillPresence(all_env_cell,before_presence);
+      _fillPresence(presence_view,cell,before_presence);
       ByteConstArrayView after_presence = mat_presence[cell];
       // Ajoute/Supprime cette maille des matériaux si besoin.
       for( Integer imat=0; imat<nb_mat; ++imat ){
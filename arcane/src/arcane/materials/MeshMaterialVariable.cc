@@ -176,6 +176,14 @@ resizeForIndexer(Int32 index, RunQueue& queue)
 /*---------------------------------------------------------------------------*/
 /*---------------------------------------------------------------------------*/
 
+void MeshMaterialVariablePrivate::
+compactPartialValues(Int32 index, SmallSpan<const MatVarIndex> old_indexes,
+                     SmallSpan<const MatVarIndex> new_indexes,
+                     Array<std::byte>& buffer, RunQueue& queue)
+{
+  m_variable->_compactPartialValues(index, old_indexes, new_indexes, buffer, queue);
+}
+
 /*---------------------------------------------------------------------------*/
 /*---------------------------------------------------------------------------*/
 
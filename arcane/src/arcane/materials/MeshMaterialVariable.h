@@ -154,6 +154,9 @@ class ARCANE_MATERIALS_EXPORT MeshMaterialVariable
   virtual void _initializeNewItems(const ComponentItemListBuilder& list_builder, RunQueue& queue) = 0;
   virtual void _syncReferences(bool update_views) = 0;
   virtual void _resizeForIndexer(Int32 index, RunQueue& queue) = 0;
+  virtual void _compactPartialValues(Int32 index, SmallSpan<const MatVarIndex> old_indexes,
+                                     SmallSpan<const MatVarIndex> new_indexes,
+                                     Array<std::byte>& buffer, RunQueue& queue) = 0;
 
  private:
 
@@ -355,6 +358,10 @@ class ItemMaterialVariableBase
   _fillPartialValuesWithSuperValues(MeshComponentList components);
   ARCANE_MATERIALS_EXPORT void _syncReferences(bool check_resize) override;
   ARCANE_MATERIALS_EXPORT void _resizeForIndexer(Int32 index, RunQueue& queue) override;
+  ARCANE_MATERIALS_EXPORT void
+  _compactPartialValues(Int32 index, SmallSpan<const MatVarIndex> old_indexes,
+                        SmallSpan<const MatVarIndex> new_indexes,
+                        Array<std::byte>& buffer, RunQueue& queue) override;
   ARCANE_MATERIALS_EXPORT void _copyHostViewsToViews(RunQueue* queue);
 
  public:
@@ -100,10 +100,67 @@ endUpdate(const ComponentItemListBuilderOld& builder)
     }
     m_max_index_in_multiple_array = max_index_in_multiple;
   }
+  m_nb_partial_value = nb_partial;
 
   info(4) << "END_UPDATE max_index=" << m_max_index_in_multiple_array;
 }
 
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*!
+ * \brief Reconstruit l'indexeur à partir d'une liste de mailles.
+ *
+ * \a local_ids contient la liste des mailles de l'indexeur et
+ * \a cells_is_partial[i] indique si la maille \a local_ids[i] est partielle.
+ * Les mailles pures sont rangées en premier suivies des mailles partielles,
+ * dans l'ordre de \a local_ids. Le calcul est effectué sur la file \a queue.
+ */
+void MeshMaterialVariableIndexer::
+endUpdate(SmallSpan<const Int32> local_ids, SmallSpan<const bool> cells_is_partial, RunQueue& queue)
+{
+  const Int32 n = local_ids.size();
+  ComponentItemListBuilder list_builder;
+  list_builder.setIndexer(this);
+  list_builder.preAllocate(n);
+
+  SmallSpan<MatVarIndex> pure_matvar_indexes = list_builder.pureMatVarIndexes();
+  SmallSpan<MatVarIndex> partial_matvar_indexes = list_builder.partialMatVarIndexes();
+  SmallSpan<Int32> partial_local_ids = list_builder.partialLocalIds();
+  const Int32 component_index = m_index + 1;
+  Int32 nb_pure = 0;
+  Int32 nb_partial = 0;
+
+  Accelerator::GenericFilterer filterer(&queue);
+  {
+    auto select_lambda = [=] ARCCORE_HOST_DEVICE(Int32 index) -> bool {
+      return !cells_is_partial[index];
+    };
+    auto setter_lambda = [=] ARCCORE_HOST_DEVICE(Int32 input_index, Int32 output_index) {
+      pure_matvar_indexes[output_index] = MatVarIndex(0, local_ids[input_index]);
+    };
+    filterer.applyWithIndex(n, select_lambda, setter_lambda, A_FUNCINFO);
+    nb_pure = filterer.nbOutputElement();
+  }
+  {
+    auto select_lambda = [=] ARCCORE_HOST_DEVICE(Int32 index) -> bool {
+      return cells_is_partial[index];
+    };
+    auto setter_lambda = [=] ARCCORE_HOST_DEVICE(Int32 input_index, Int32 output_index) {
+      partial_matvar_indexes[output_index] = MatVarIndex(component_index, output_index);
+      partial_local_ids[output_index] = local_ids[input_index];
+    };
+    filterer.applyWithIndex(n, select_lambda, setter_lambda, A_FUNCINFO);
+    nb_partial = filterer.nbOutputElement();
+  }
+  list_builder.resize(nb_pure, nb_partial);
+
+  m_matvar_indexes.clear();
+  m_local_ids.clear();
+  m_max_index_in_multiple_array = (-1);
+  m_nb_partial_value = 0;
+  endUpdateAdd(list_builder, queue);
+}
+
 /*---------------------------------------------------------------------------*/
 /*---------------------------------------------------------------------------*/
 
@@ -147,6 +204,7 @@ endUpdateAdd(const ComponentItemListBuilder& builder, RunQueue& queue)
     max_index_in_multiple = math::max(max_index_reducer.reducedValue(), m_max_index_in_multiple_array);
   }
   m_max_index_in_multiple_array = max_index_in_multiple;
+  m_nb_partial_value += nb_partial_to_add;
 
   info(4) << "END_UPDATE_ADD max_index=" << m_max_index_in_multiple_array
           << " nb_partial_to_add=" << nb_partial_to_add;
@@ -178,6 +236,7 @@ endUpdateRemoveV2(ConstituentModifierWorkInfo& work_info, Integer nb_remove, Run
   if (nb_remove == nb_item) {
     m_matvar_indexes.clear();
     m_local_ids.clear();
+    m_nb_partial_value = 0;
     return;
   }
 
@@ -195,6 +254,19 @@ endUpdateRemoveV2(ConstituentModifierWorkInfo& work_info, Integer nb_remove, Run
   Span<Int32> local_ids(m_local_ids);
   Span<MatVarIndex> matvar_indexes(m_matvar_indexes);
 
+  // Compte le nombre de valeurs partielles supprimées
+  {
+    auto command = makeCommand(queue);
+    Arcane::Accelerator::ReducerSum2<Int32> nb_partial_reducer(command);
+    command << RUNCOMMAND_LOOP1(iter, orig_nb_item, nb_partial_reducer)
+    {
+      auto [i] = iter();
+      if (removed_cells[local_ids[i]] && matvar_indexes[i].arrayIndex() != 0)
+        nb_partial_reducer.combine(1);
+    };
+    m_nb_partial_value -= nb_partial_reducer.reducedValue();
+  }
+
   // Conserve \a nb_remove valeurs en partant de la fin de la liste
   {
     Int32 last_index = nb_item - 1;
@@ -268,6 +340,7 @@ _changeLocalIdsV2(MeshMaterialVariableIndexer* var_indexer, Int32ConstArrayView
 
   var_indexer->m_local_ids.clear();
   var_indexer->m_matvar_indexes.clear();
+  var_indexer->m_nb_partial_value = 0;
 
   Integer nb = ids_copy.size();
 
@@ -299,6 +372,7 @@ _changeLocalIdsV2(MeshMaterialVariableIndexer* var_indexer, Int32ConstArrayView
         // Valeur partielle: rien ne change dans le MatVarIndex
         var_indexer->m_matvar_indexes.add(mvi);
         var_indexer->m_local_ids.add(new_lid);
+        ++var_indexer->m_nb_partial_value;
       }
     }
   }
@@ -312,6 +386,41 @@ _changeLocalIdsV2(MeshMaterialVariableIndexer* var_indexer, Int32ConstArrayView
 /*---------------------------------------------------------------------------*/
 /*---------------------------------------------------------------------------*/
 
+/*!
+ * \brief Renumérote les valeurs partielles pour qu'elles soient contigües.
+ *
+ * Après appel, les valeurs partielles ont les indices de 0 à nbPartialValue()-1
+ * dans l'ordre de matvarIndexes(). Les tableaux \a old_indexes et \a new_indexes
+ * contiennent les anciens et nouveaux MatVarIndex des valeurs dont l'indice
+ * a changé.
+ */
+void MeshMaterialVariableIndexer::
+compactPartialIndexes(Array<MatVarIndex>& old_indexes, Array<MatVarIndex>& new_indexes)
+{
+  old_indexes.clear();
+  new_indexes.clear();
+  Int32 nb_partial = 0;
+  for (MatVarIndex& mvi : m_matvar_indexes) {
+    if (mvi.arrayIndex() == 0)
+      continue;
+    if (mvi.valueIndex() != nb_partial) {
+      MatVarIndex new_mvi(mvi.arrayIndex(), nb_partial);
+      old_indexes.add(mvi);
+      new_indexes.add(new_mvi);
+      mvi = new_mvi;
+    }
+    ++nb_partial;
+  }
+  info(4) << "CompactPartialIndexes name=" << name() << " nb_partial=" << nb_partial
+          << " old_max_index=" << m_max_index_in_multiple_array
+          << " nb_moved=" << old_indexes.size();
+  m_max_index_in_multiple_array = nb_partial - 1;
+  m_nb_partial_value = nb_partial;
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
 void MeshMaterialVariableIndexer::
 transformCellsV2(ConstituentModifierWorkInfo& work_info, RunQueue& queue)
 {
@@ -391,8 +500,12 @@ _switchBetweenPureAndPartial(ConstituentModifierWorkInfo& work_info,
   pure_local_ids_modifier.resize(nb_out);
   partial_indexes_modifier.resize(nb_out);
 
-  if (is_pure_to_partial)
+  if (is_pure_to_partial) {
     m_max_index_in_multiple_array += nb_out;
+    m_nb_partial_value += nb_out;
+  }
+  else
+    m_nb_partial_value -= nb_out;
 }
 
 /*---------------------------------------------------------------------------*/
@@ -407,6 +520,12 @@ checkValid()
 
   vc.areEqual(nb_item, m_matvar_indexes.size(), "Incoherent size for local ids and matvar indexes");
 
+  Int32 nb_partial = 0;
+  for (MatVarIndex mvi : m_matvar_indexes)
+    if (mvi.arrayIndex() != 0)
+      ++nb_partial;
+  vc.areEqual(nb_partial, m_nb_partial_value, "Incoherent number of partial values");
+
   // TODO: vérifier que les m_local_ids pour les parties pures correspondent
   // au m_matvar_indexes.valueIndex() correspondant.
 }
@@ -303,10 +303,32 @@ void MeshMaterialVariableSynchronizer::
 _initialize()
 {
   IParallelMng* pm = m_variable_synchronizer->parallelMng();
+  RunQueue& material_queue = m_material_mng->_internalApi()->runQueue();
+  // Par défaut, si les matériaux sont sur accélérateur, les recopies entre
+  // les variables et les buffers sont faites sur l'accélérateur.
+  // ARCANE_MATERIALSYNCHRONIZER_DEVICE_COPY=0 permet de revenir au
+  // comportement précédent (buffers en mémoire unifiée).
+  bool use_device_copy = true;
+  if (auto v = Convert::Type<Int32>::tryParseFromEnvironment("ARCANE_MATERIALSYNCHRONIZER_DEVICE_COPY", true))
+    use_device_copy = (v.value() != 0);
+  // File par défaut pour les recopies. Elle n'est pas nulle dès qu'un
+  // runtime accélérateur est utilisé.
+  m_copy_queue = pm->_internalApi()->defaultQueue();
   if (pm->_internalApi()->isAcceleratorAware()) {
     m_buffer_memory_ressource = eMemoryRessource::Device;
     info() << "MeshMaterialVariableSynchronizer: Using device memory for buffer";
   }
+  else if (use_device_copy && material_queue.isAcceleratorPolicy()) {
+    // Les valeurs des variables sont sur l'accélérateur mais l'implémentation
+    // MPI ne sait pas utiliser directement la mémoire de l'accélérateur.
+    // Dans ce cas on utilise des buffers en mémoire hôte punaisée, qui sont
+    // accessibles depuis l'accélérateur. Les recopies entre les variables et
+    // les buffers sont faites sur l'accélérateur et seules les valeurs
+    // échangées transitent entre l'accélérateur et l'hôte.
+    m_buffer_memory_ressource = eMemoryRessource::HostPinned;
+    m_copy_queue = &material_queue;
+    info() << "MeshMaterialVariableSynchronizer: Using host pinned memory for buffer and device copy";
+  }
   m_common_buffer = impl::makeOneBufferMeshMaterialSynchronizeBufferRef(m_buffer_memory_ressource);
 }
 
@@ -1,11 +1,11 @@
 ﻿// -*- tab-width: 2; indent-tabs-mode: nil; coding: utf-8-with-signature -*-
 //-----------------------------------------------------------------------------
-// Copyright 2000-2023 CEA (www.cea.fr) IFPEN (www.ifpenergiesnouvelles.com)
+// Copyright 2000-2024 CEA (www.cea.fr) IFPEN (www.ifpenergiesnouvelles.com)
 // See the top-level COPYRIGHT file for details.
 // SPDX-License-Identifier: Apache-2.0
 //-----------------------------------------------------------------------------
 /*---------------------------------------------------------------------------*/
-/* MeshMaterialVariableSynchronizerList.cc                     (C) 2000-2023 */
+/* MeshMaterialVariableSynchronizerList.cc                     (C) 2000-2024 */
 /*                                                                           */
 /* Synchroniseur de variables matériaux.                                     */
 /*---------------------------------------------------------------------------*/
@@ -304,7 +304,9 @@ _beginSynchronizeMultiple2(SyncInfo& sync_info)
   if (!pm->isParallel())
     return;
   const bool use_new_version = sync_info.use_generic_version;
-  RunQueue* queue = pm->_internalApi()->defaultQueue();
+  RunQueue* queue = mmvs->copyQueue();
+  if (!queue)
+    queue = pm->_internalApi()->defaultQueue();
 
   mmvs->checkRecompute();
 
@@ -388,7 +390,9 @@ _endSynchronizeMultiple2(SyncInfo& sync_info)
   if (!pm->isParallel())
     return;
   const bool use_new_version = sync_info.use_generic_version;
-  RunQueue* queue = pm->_internalApi()->defaultQueue();
+  RunQueue* queue = mmvs->copyQueue();
+  if (!queue)
+    queue = pm->_internalApi()->defaultQueue();
   IMeshMaterialSynchronizeBuffer* buf_list = sync_info.buf_list.get();
 
   Int32ConstArrayView ranks = var_syncer->communicatingRanks();
@@ -23,6 +23,7 @@
 #include "arcane/core/IIncrementalItemConnectivity.h"
 
 #include "arcane/materials/MaterialsGlobal.h"
+#include "arcane/materials/CellMaterialPresenceView.h"
 
 /*---------------------------------------------------------------------------*/
 /*---------------------------------------------------------------------------*/
@@ -107,6 +108,16 @@ class ConstituentConnectivityList
    */
   bool isActive() const { return m_is_active; }
 
+  /*!
+   * \brief Vue sur la présence des matériaux dans les mailles.
+   *
+   * La vue est invalidée par toute modification des matériaux ou du maillage.
+   */
+  CellMaterialPresenceView materialPresenceView() const
+  {
+    return { m_material_presence.constSmallSpan(), m_nb_presence_word };
+  }
+
  public:
 
   // Implémentation de IIncrementalItemSourceConnectivity
@@ -129,12 +140,27 @@ class ConstituentConnectivityList
   DualUniqueArray<Int16> m_environment_for_materials;
   bool m_is_active = false;
 
+  /*!
+   * \brief Bits de présence des matériaux dans les mailles.
+   *
+   * Il y a \a m_nb_presence_word mots par maille (voir CellMaterialPresenceView).
+   */
+  UniqueArray<UInt64> m_material_presence;
+  Int32 m_nb_presence_word = 1;
+
  public:
 
   void _addCells(Int16 env_id, SmallSpan<const Int32> cell_ids,
                  ConstituentContainer& component, RunQueue& queue);
   void _removeCells(Int16 env_id, SmallSpan<const Int32> cell_ids,
                     ConstituentContainer& component, RunQueue& queue);
+  void _updateMaterialPresence(Int16 mat_id, SmallSpan<const Int32> cell_ids,
+                               bool is_add, RunQueue& queue);
+
+ private:
+
+  void _rebuildMaterialPresence();
+  void _changeLocalIdsForMaterialPresence(Int32ConstArrayView new_to_old_ids);
 };
 
 /*---------------------------------------------------------------------------*/
@@ -54,6 +54,18 @@ class ARCANE_MATERIALS_EXPORT IncrementalComponentModifier
   void setDoCopyBetweenPartialAndPure(bool v) { m_do_copy_between_partial_and_pure = v; }
   void setDoInitNewItems(bool v) { m_do_init_new_items = v; }
 
+ public:
+
+  //! \name Mise à jour des constituants lors d'un échange de maillage
+  //@{
+  void removeDestroyedCells(MeshEnvironment* env, SmallSpan<const Int32> env_ids,
+                            ConstArrayView<SmallSpan<const Int32>> mats_ids);
+  void addReceivedCellsConnectivity(MeshEnvironment* env, SmallSpan<const Int32> env_ids,
+                                    ConstArrayView<SmallSpan<const Int32>> mats_ids);
+  void addReceivedCells(MeshEnvironment* env, SmallSpan<const Int32> env_ids,
+                        ConstArrayView<SmallSpan<const Int32>> mats_ids);
+  //@}
+
  private:
 
   AllEnvData* m_all_env_data = nullptr;
@@ -159,7 +159,7 @@ class MeshEnvironment
   //! Recalcule le nombre de mailles par matériau et de mailles totales
   void computeNbMatPerCell();
 
-  void computeItemListForMaterials(const ConstituentConnectivityList& connectivity_list);
+  void computeItemListForMaterials(ConstituentConnectivityList& connectivity_list, RunQueue& queue);
 
   //! Nombre total de mailles pour tous les matériaux
   Integer totalNbCellMat() const { return m_total_nb_cell_mat; }
@@ -216,6 +216,7 @@ class MeshMaterialMng
   void checkValid() override;
 
   void forceRecompute() override;
+  void compactPartialValues() override;
 
   Mutex* variableLock() override
   {
@@ -285,6 +286,7 @@ class MeshMaterialMng
 
   void incrementTimestamp() { ++m_timestamp; }
   void dumpInfos2(std::ostream& o);
+  void checkCompactPartialValues();
 
   const MeshHandle& meshHandle() const { return m_mesh_handle; }
 
@@ -341,6 +343,14 @@ class MeshMaterialMng
   bool m_is_use_material_value_when_removing_partial_value = false;
   int m_modification_flags = 0;
   Real m_additional_capacity_ratio = 0.05;
+  //! Proportion d'emplacements inutilisés à partir de laquelle on compacte (0 si pas de compactage automatique)
+  Real m_partial_values_compaction_ratio = 0.0;
+  //! Nombre de compactages des valeurs partielles effectués
+  Int32 m_nb_partial_values_compaction = 0;
+  //! Nombre total d'emplacements inutilisés récupérés lors des compactages
+  Int64 m_nb_reclaimed_partial_value = 0;
+  //! Tableau de travail conservé entre deux compactages
+  UniqueArray<std::byte> m_compaction_buffer;
 
   Mutex m_variable_lock;
 
@@ -380,6 +390,8 @@ class MeshMaterialMng
  private:
 
   void _endUpdate();
+  Int32 _compactPartialValues(Real min_hole_ratio);
+  void _dumpPartialValuesMemoryInfos(std::ostream& o);
   IMeshMaterialVariable* _findVariableFullyQualified(const String& name);
   MeshMaterialInfo* _findMaterialInfo(const String& name);
   MeshEnvironment* _findEnvironment(const String& name);
@@ -70,6 +70,8 @@ class MeshMaterialModifierImpl
 
   void addCells(IMeshMaterial* mat, SmallSpan<const Int32> ids);
   void removeCells(IMeshMaterial* mat, SmallSpan<const Int32> ids);
+  void modifyCells(SmallSpan<const Int32> material_ids, SmallSpan<const Int32> cell_local_ids,
+                   SmallSpan<const bool> is_add);
 
   void endUpdate();
   void beginUpdate();
@@ -95,6 +97,7 @@ class MeshMaterialModifierImpl
   Int32 nb_save_restore = 0;
   Int32 nb_optimize_add = 0;
   Int32 nb_optimize_remove = 0;
+  Int32 nb_bulk_modification = 0;
   Int32 m_modification_id = 0;
 
   bool m_allow_optimization = false;
@@ -1,11 +1,11 @@
 ﻿// -*- tab-width: 2; indent-tabs-mode: nil; coding: utf-8-with-signature -*-
 //-----------------------------------------------------------------------------
-// Copyright 2000-2023 CEA (www.cea.fr) IFPEN (www.ifpenergiesnouvelles.com)
+// Copyright 2000-2024 CEA (www.cea.fr) IFPEN (www.ifpenergiesnouvelles.com)
 // See the top-level COPYRIGHT file for details.
 // SPDX-License-Identifier: Apache-2.0
 //-----------------------------------------------------------------------------
 /*---------------------------------------------------------------------------*/
-/* MeshMaterialSynchronizer.h                                  (C) 2000-2023 */
+/* MeshMaterialSynchronizer.h                                  (C) 2000-2024 */
 /*                                                                           */
 /* Synchronisation de la liste des matériaux/milieux des entités.            */
 /*---------------------------------------------------------------------------*/
@@ -28,6 +28,7 @@
 namespace Arcane::Materials
 {
 class MeshMaterialModifierImpl;
+class CellMaterialPresenceView;
 
 /*---------------------------------------------------------------------------*/
 /*---------------------------------------------------------------------------*/
@@ -70,7 +71,7 @@ class MeshMaterialSynchronizer
 
   inline static void _setBit(ByteArrayView bytes,Integer position);
   inline static bool _hasBit(ByteConstArrayView bytes,Integer position);
-  void _fillPresence(AllEnvCell all_env_cell,ByteArrayView presence);
+  void _fillPresence(const CellMaterialPresenceView& presence_view,CellLocalId cell_id,ByteArrayView presence);
   void _checkComponents(VariableCellInt32& indexes,
                         ConstArrayView<IMeshComponent*> components,
                         Integer max_print);
@@ -93,6 +93,7 @@ class ARCANE_MATERIALS_EXPORT MeshMaterialVariableIndexer
   //! Fonctions publiques mais réservées aux classes de Arcane.
   //@{
   void endUpdate(const ComponentItemListBuilderOld& builder);
+  void endUpdate(SmallSpan<const Int32> local_ids, SmallSpan<const bool> cells_is_partial, RunQueue& queue);
   Array<MatVarIndex>& matvarIndexesArray() { return m_matvar_indexes; }
   void setCells(const CellGroup& cells) { m_cells = cells; }
   void setIsEnvironment(bool is_environment) { m_is_environment = is_environment; }
@@ -101,6 +102,9 @@ class ARCANE_MATERIALS_EXPORT MeshMaterialVariableIndexer
   ConstArrayView<Int32> localIds() const { return m_local_ids; }
 
   void changeLocalIds(Int32ConstArrayView old_to_new_ids);
+  void compactPartialIndexes(Array<MatVarIndex>& old_indexes, Array<MatVarIndex>& new_indexes);
+  //! Nombre de valeurs partielles utilisées par l'indexeur
+  Int32 nbPartialValue() const { return m_nb_partial_value; }
   void endUpdateRemove(ConstituentModifierWorkInfo& args, Integer nb_remove, RunQueue& queue);
   //@}
 
@@ -116,6 +120,9 @@ class ARCANE_MATERIALS_EXPORT MeshMaterialVariableIndexer
   //! Indice max plus 1 dans le tableau des valeurs multiples
   Integer m_max_index_in_multiple_array = -1;
 
+  //! Nombre de valeurs partielles (mis à jour à chaque modification)
+  Int32 m_nb_partial_value = 0;
+
   //! Nom du matériau ou milieu
   String m_name;
 
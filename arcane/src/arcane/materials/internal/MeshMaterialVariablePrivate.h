@@ -82,6 +82,9 @@ class MeshMaterialVariablePrivate
   }
   void syncReferences(bool check_resize) override;
   void resizeForIndexer(Int32 index, RunQueue& queue) override;
+  void compactPartialValues(Int32 index, SmallSpan<const MatVarIndex> old_indexes,
+                            SmallSpan<const MatVarIndex> new_indexes,
+                            Array<std::byte>& buffer, RunQueue& queue) override;
 
  public:
 
@@ -58,6 +58,7 @@ class ARCANE_MATERIALS_EXPORT MeshMaterialVariableSynchronizer
   void checkRecompute() override;
   Ref<IMeshMaterialSynchronizeBuffer> commonBuffer() override { return m_common_buffer; }
   eMemoryRessource bufferMemoryRessource() const override { return m_buffer_memory_ressource; }
+  RunQueue* copyQueue() const override { return m_copy_queue; }
 
  private:
 
@@ -71,6 +72,8 @@ class ARCANE_MATERIALS_EXPORT MeshMaterialVariableSynchronizer
   eMemoryRessource m_buffer_memory_ressource = eMemoryRessource::UnifiedMemory;
   // Permet de forcer l'utilisation ou non l'implémentation accélérateur
   Int32 m_use_accelerator_mode = -1;
+  //! File pour les recopies entre les variables et les buffers
+  RunQueue* m_copy_queue = nullptr;
 
  public:
 
@@ -2,6 +2,8 @@ set(ARCANE_SOURCES
   AllCellToAllEnvCellConverter.cc
   AllCellToAllEnvCellConverter.h
   AllEnvData.cc
+  CellMaterialPresenceView.cc
+  CellMaterialPresenceView.h
   ComponentItemInternal.h
   ComponentItem.h
   ComponentItemListBuilder.cc
@@ -45,6 +47,8 @@ set(ARCANE_SOURCES
   MeshMaterialBackup.h
   MeshMaterialInfo.cc
   MeshMaterialInfo.h
+  MeshMaterialLoadBalanceCriterion.cc
+  MeshMaterialLoadBalanceCriterion.h
   MeshMaterialSynchronizer.cc
   MeshMaterialIndirectModifier.cc
   MeshMaterialIndirectModifier.h
@@ -87,6 +91,7 @@ set(ARCANE_SOURCES
   MeshEnvironmentBuildInfo.h
   MeshMaterialBackup.h
   MeshMaterialInfo.h
+  MeshMaterialLoadBalanceCriterion.h
   MeshMaterialIndirectModifier.h
   MeshMaterialModifier.h
   MeshMaterialVariable.h
@@ -95,6 +100,7 @@ set(ARCANE_SOURCES
   MeshEnvironmentVariableRef.h
   MeshMaterialVariableSynchronizerList.h
   CellToAllEnvCellConverter.h
+  CellMaterialPresenceView.h
   ComponentItem.h
   MatConcurrency.h
   MatItem.h
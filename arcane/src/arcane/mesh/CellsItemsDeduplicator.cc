@@ -0,0 +1,461 @@
+﻿// -*- tab-width: 2; indent-tabs-mode: nil; coding: utf-8-with-signature -*-
+//-----------------------------------------------------------------------------
+// Copyright 2000-2024 CEA (www.cea.fr) IFPEN (www.ifpenergiesnouvelles.com)
+// See the top-level COPYRIGHT file for details.
+// SPDX-License-Identifier: Apache-2.0
+//-----------------------------------------------------------------------------
+/*---------------------------------------------------------------------------*/
+/* CellsItemsDeduplicator.cc                                   (C) 2000-2024 */
+/*                                                                           */
+/* Calcul multi-thread des entités uniques d'une liste de mailles.           */
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+#include "arcane/mesh/CellsItemsDeduplicator.h"
+
+#include "arcane/utils/FatalErrorException.h"
+#include "arcane/utils/HashFunction.h"
+#include "arcane/utils/ITraceMng.h"
+
+#include "arcane/core/ItemTypeMng.h"
+#include "arcane/core/ItemTypeInfo.h"
+#include "arcane/core/MeshUtils.h"
+#include "arcane/core/Concurrency.h"
+
+#include <algorithm>
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+namespace Arcane::mesh
+{
+
+namespace
+{
+  //! Nombre minimum d'occurrences par bloc
+  constexpr Int32 MIN_BLOCK_SIZE = 2048;
+
+  inline UInt64 _hashCombine(UInt64 hash, Int64 value)
+  {
+    Int64 h = static_cast<Int64>(hash * 31) ^ value;
+    return static_cast<UInt64>(IntegerHashFunctionT<Int64>::hashfunc(h));
+  }
+
+  inline Int32 _checkedSize(Int64 size, const char* name)
+  {
+    if (size > INT32_MAX)
+      ARCANE_FATAL("Too many {0} occurrences ({1}) for bulk allocation", name, size);
+    return static_cast<Int32>(size);
+  }
+} // namespace
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+CellsItemsDeduplicator::
+CellsItemsDeduplicator(ITraceMng* tm, ItemTypeMng* item_type_mng,
+                       Int32 mesh_dimension, bool has_edge)
+: TraceAccessor(tm)
+, m_item_type_mng(item_type_mng)
+, m_mesh_dimension(mesh_dimension)
+, m_has_edge(has_edge)
+{
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+void CellsItemsDeduplicator::
+compute(Int32 nb_cell, Int64ConstArrayView cells_infos)
+{
+  m_nb_cell = nb_cell;
+  _computeCellsOffsets(cells_infos);
+  _computeCells(cells_infos);
+  if (m_has_duplicated_cell)
+    return;
+  _computeNodes(cells_infos);
+  if (m_has_edge)
+    _computeEdges(cells_infos);
+  _computeFaces(cells_infos);
+  info(4) << "CellsItemsDeduplicator: nb_cell=" << m_nb_cell
+          << " nb_node=" << nbUniqueNode() << " nb_edge=" << nbUniqueEdge()
+          << " nb_face=" << nbUniqueFace();
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*!
+ * \brief Calcule les positions des mailles dans \a cells_infos et les
+ * indices de leurs premières occurrences.
+ *
+ * Le format de \a cells_infos impose un parcours séquentiel.
+ */
+void CellsItemsDeduplicator::
+_computeCellsOffsets(Int64ConstArrayView cells_infos)
+{
+  const Int32 nb_cell = m_nb_cell;
+  m_cells_type_info.resize(nb_cell);
+  m_cells_info_index.resize(nb_cell);
+  m_cells_node_offset.resize(nb_cell + 1);
+  m_cells_edge_offset.resize(nb_cell + 1);
+  m_cells_face_offset.resize(nb_cell + 1);
+
+  Int64 nb_node_occurrence = 0;
+  Int64 nb_edge_occurrence = 0;
+  Int64 nb_face_occurrence = 0;
+  Int32 cells_infos_index = 0;
+  for (Int32 i = 0; i < nb_cell; ++i) {
+    ItemTypeId type_id(static_cast<Int16>(cells_infos[cells_infos_index]));
+    ItemTypeInfo* type_info = m_item_type_mng->typeFromId(type_id);
+    m_cells_type_info[i] = type_info;
+    m_cells_info_index[i] = cells_infos_index + 1;
+    m_cells_node_offset[i] = _checkedSize(nb_node_occurrence, "node");
+    m_cells_edge_offset[i] = _checkedSize(nb_edge_occurrence, "edge");
+    m_cells_face_offset[i] = _checkedSize(nb_face_occurrence, "face");
+    const Int32 nb_node = type_info->nbLocalNode();
+    nb_node_occurrence += nb_node;
+    if (m_has_edge)
+      nb_edge_occurrence += type_info->nbLocalEdge();
+    nb_face_occurrence += type_info->nbLocalFace();
+    cells_infos_index += 2 + nb_node;
+  }
+  m_cells_node_offset[nb_cell] = _checkedSize(nb_node_occurrence, "node");
+  m_cells_edge_offset[nb_cell] = _checkedSize(nb_edge_occurrence, "edge");
+  m_cells_face_offset[nb_cell] = _checkedSize(nb_face_occurrence, "face");
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+void CellsItemsDeduplicator::
+_computeCells(Int64ConstArrayView cells_infos)
+{
+  auto hash_func = [&](Int32 i) {
+    return _hashCombine(0, cells_infos[m_cells_info_index[i]]);
+  };
+  auto compare_func = [&](Int32 a, Int32 b) -> int {
+    const Int64 uid_a = cells_infos[m_cells_info_index[a]];
+    const Int64 uid_b = cells_infos[m_cells_info_index[b]];
+    return (uid_a < uid_b) ? -1 : ((uid_a > uid_b) ? 1 : 0);
+  };
+  UniqueArray<Int32> cells_index;
+  UniqueArray<Int32> cells_first_occurrence;
+  _computeUniqueIndexes(m_nb_cell, hash_func, compare_func, cells_index, cells_first_occurrence);
+  m_has_duplicated_cell = (cells_first_occurrence.size() != m_nb_cell);
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+void CellsItemsDeduplicator::
+_computeNodes(Int64ConstArrayView cells_infos)
+{
+  const Int32 nb_occurrence = m_cells_node_offset[m_nb_cell];
+  UniqueArray<Int64> nodes_uid(nb_occurrence);
+  arcaneParallelFor(0, m_nb_cell, [&](Int32 begin, Int32 size) {
+    for (Int32 i = begin, end = begin + size; i < end; ++i) {
+      const Int32 info_index = m_cells_info_index[i] + 1;
+      const Int32 offset = m_cells_node_offset[i];
+      const Int32 nb_node = m_cells_node_offset[i + 1] - offset;
+      for (Int32 k = 0; k < nb_node; ++k)
+        nodes_uid[offset + k] = cells_infos[info_index + k];
+    }
+  });
+
+  auto hash_func = [&](Int32 i) { return _hashCombine(0, nodes_uid[i]); };
+  auto compare_func = [&](Int32 a, Int32 b) -> int {
+    const Int64 uid_a = nodes_uid[a];
+    const Int64 uid_b = nodes_uid[b];
+    return (uid_a < uid_b) ? -1 : ((uid_a > uid_b) ? 1 : 0);
+  };
+  _computeUniqueIndexes(nb_occurrence, hash_func, compare_func, m_nodes_index, m_nodes_first_occurrence);
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*!
+ * \brief Calcule les arêtes uniques.
+ *
+ * Comme dans OneMeshItemAdder, le premier noeud d'une arête est celui
+ * de plus petit uniqueId().
+ */
+void CellsItemsDeduplicator::
+_computeEdges(Int64ConstArrayView cells_infos)
+{
+  const Int32 nb_occurrence = m_cells_edge_offset[m_nb_cell];
+  m_edges_nodes_index.resize(nb_occurrence * 2);
+  arcaneParallelFor(0, m_nb_cell, [&](Int32 begin, Int32 size) {
+    for (Int32 i = begin, end = begin + size; i < end; ++i) {
+      ItemTypeInfo* type_info = m_cells_type_info[i];
+      const Int32 info_index = m_cells_info_index[i] + 1;
+      const Int32 node_offset = m_cells_node_offset[i];
+      const Int32 edge_offset = m_cells_edge_offset[i];
+      const Int32 nb_edge = m_cells_edge_offset[i + 1] - edge_offset;
+      for (Int32 i_edge = 0; i_edge < nb_edge; ++i_edge) {
+        const ItemTypeInfo::LocalEdge le = type_info->localEdge(i_edge);
+        Int32 first_node = le.beginNode();
+        Int32 second_node = le.endNode();
+        if (cells_infos[info_index + first_node] > cells_infos[info_index + second_node])
+          std::swap(first_node, second_node);
+        const Int32 pos = (edge_offset + i_edge) * 2;
+        m_edges_nodes_index[pos] = m_nodes_index[node_offset + first_node];
+        m_edges_nodes_index[pos + 1] = m_nodes_index[node_offset + second_node];
+      }
+    }
+  });
+
+  auto hash_func = [&](Int32 i) {
+    return _hashCombine(_hashCombine(0, m_edges_nodes_index[i * 2]), m_edges_nodes_index[i * 2 + 1]);
+  };
+  auto compare_func = [&](Int32 a, Int32 b) -> int {
+    for (Int32 k = 0; k < 2; ++k) {
+      const Int32 na = m_edges_nodes_index[a * 2 + k];
+      const Int32 nb = m_edges_nodes_index[b * 2 + k];
+      if (na != nb)
+        return (na < nb) ? -1 : 1;
+    }
+    return 0;
+  };
+  _computeUniqueIndexes(nb_occurrence, hash_func, compare_func, m_edges_index, m_edges_first_occurrence);
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*!
+ * \brief Calcule les faces uniques.
+ *
+ * Les noeuds de chaque face sont réorientés de la même manière que dans
+ * OneMeshItemAdder::_isReorder().
+ */
+void CellsItemsDeduplicator::
+_computeFaces(Int64ConstArrayView cells_infos)
+{
+  const Int32 nb_occurrence = m_cells_face_offset[m_nb_cell];
+  m_faces_is_reorder.resize(nb_occurrence);
+  m_faces_node_offset.resize(nb_occurrence + 1);
+  UniqueArray<Int16> faces_type(nb_occurrence);
+
+  // Positions des noeuds des faces. Ce calcul est séquentiel mais ne fait
+  // que parcourir les types.
+  {
+    Int64 nb_face_node = 0;
+    for (Int32 i = 0; i < m_nb_cell; ++i) {
+      ItemTypeInfo* type_info = m_cells_type_info[i];
+      const Int32 face_offset = m_cells_face_offset[i];
+      const Int32 nb_face = m_cells_face_offset[i + 1] - face_offset;
+      for (Int32 i_face = 0; i_face < nb_face; ++i_face) {
+        m_faces_node_offset[face_offset + i_face] = _checkedSize(nb_face_node, "face node");
+        nb_face_node += type_info->localFace(i_face).nbNode();
+      }
+    }
+    m_faces_node_offset[nb_occurrence] = _checkedSize(nb_face_node, "face node");
+    m_faces_nodes_index.resize(m_faces_node_offset[nb_occurrence]);
+  }
+
+  const bool is_1d = (m_mesh_dimension == 1);
+  arcaneParallelFor(0, m_nb_cell, [&](Int32 begin, Int32 size) {
+    UniqueArray<Int64> orig_nodes_uid;
+    UniqueArray<Integer> new_index;
+    for (Int32 i = begin, end = begin + size; i < end; ++i) {
+      ItemTypeInfo* type_info = m_cells_type_info[i];
+      const Int32 info_index = m_cells_info_index[i] + 1;
+      const Int32 node_offset = m_cells_node_offset[i];
+      const Int32 face_offset = m_cells_face_offset[i];
+      const Int32 nb_face = m_cells_face_offset[i + 1] - face_offset;
+      for (Int32 i_face = 0; i_face < nb_face; ++i_face) {
+        const Int32 occurrence = face_offset + i_face;
+        const ItemTypeInfo::LocalFace lf = type_info->localFace(i_face);
+        const Int32 face_nb_node = lf.nbNode();
+        orig_nodes_uid.resize(face_nb_node);
+        new_index.resize(face_nb_node);
+        for (Int32 k = 0; k < face_nb_node; ++k)
+          orig_nodes_uid[k] = cells_infos[info_index + lf.node(k)];
+        bool is_reorder = false;
+        if (is_1d) {
+          // En 1D, les noeuds de la face ne sont pas réordonnés.
+          is_reorder = (i_face == 1);
+          for (Int32 k = 0; k < face_nb_node; ++k)
+            new_index[k] = k;
+        }
+        else
+          is_reorder = mesh_utils::reorderNodesOfFace2(orig_nodes_uid, new_index);
+        m_faces_is_reorder[occurrence] = (is_reorder) ? 1 : 0;
+        faces_type[occurrence] = lf.typeId();
+        const Int32 pos = m_faces_node_offset[occurrence];
+        for (Int32 k = 0; k < face_nb_node; ++k)
+          m_faces_nodes_index[pos + k] = m_nodes_index[node_offset + lf.node(new_index[k])];
+      }
+    }
+  });
+
+  auto hash_func = [&](Int32 i) {
+    UInt64 h = _hashCombine(0, faces_type[i]);
+    for (Int32 node_index : faceNodesIndex(i))
+      h = _hashCombine(h, node_index);
+    return h;
+  };
+  auto compare_func = [&](Int32 a, Int32 b) -> int {
+    if (faces_type[a] != faces_type[b])
+      return (faces_type[a] < faces_type[b]) ? -1 : 1;
+    Int32ConstArrayView nodes_a = faceNodesIndex(a);
+    Int32ConstArrayView nodes_b = faceNodesIndex(b);
+    if (nodes_a.size() != nodes_b.size())
+      return (nodes_a.size() < nodes_b.size()) ? -1 : 1;
+    for (Int32 k = 0, n = nodes_a.size(); k < n; ++k)
+      if (nodes_a[k] != nodes_b[k])
+        return (nodes_a[k] < nodes_b[k]) ? -1 : 1;
+    return 0;
+  };
+  _computeUniqueIndexes(nb_occurrence, hash_func, compare_func, m_faces_index, m_faces_first_occurrence);
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*!
+ * \brief Calcule les entités uniques d'une liste d'occurrences.
+ *
+ * En retour, \a occurrences_index contient pour chaque occurrence l'indice
+ * de l'entité unique associée et \a first_occurrences contient pour chaque
+ * entité unique l'indice de sa première occurrence. Les entités uniques
+ * sont numérotées dans l'ordre de leur première occurrence ce qui rend
+ * le résultat indépendant du nombre de threads.
+ *
+ * L'algorithme est le suivant:
+ * - les occurrences sont découpées en blocs. Pour chaque bloc, on compte
+ *   le nombre d'occurrences de chaque paquet, le paquet étant déterminé
+ *   par le hash de la clé.
+ * - les occurrences sont rangées par paquet, en conservant l'ordre initial
+ *   dans chaque paquet.
+ * - chaque paquet est trié suivant (hash,clé,occurrence) ce qui permet de
+ *   déterminer pour chaque occurrence la première occurrence ayant la même clé.
+ * - un dernier parcours séquentiel numérote les entités uniques.
+ *
+ * \a compare_function(a,b) doit retourner une valeur négative, nulle ou
+ * positive suivant que la clé de l'occurrence \a a est inférieure, égale ou
+ * supérieure à celle de l'occurrence \a b.
+ */
+template <typename HashFunction, typename CompareFunction>
+void CellsItemsDeduplicator::
+_computeUniqueIndexes(Int32 nb_occurrence, const HashFunction& hash_function,
+                      const CompareFunction& compare_function,
+                      Array<Int32>& occurrences_index,
+                      Array<Int32>& first_occurrences)
+{
+  occurrences_index.resize(nb_occurrence);
+  first_occurrences.clear();
+  if (nb_occurrence == 0)
+    return;
+
+  UniqueArray<UInt64> hashes(nb_occurrence);
+  arcaneParallelFor(0, nb_occurrence, [&](Int32 begin, Int32 size) {
+    for (Int32 i = begin, end = begin + size; i < end; ++i)
+      hashes[i] = hash_function(i);
+  });
+
+  // Utilise plusieurs blocs par thread pour équilibrer la charge.
+  // Le nombre de paquets est égal au nombre de blocs.
+  Int64 nb_block_64 = static_cast<Int64>(TaskFactory::nbAllowedThread()) * 4;
+  const Int64 max_nb_block = (static_cast<Int64>(nb_occurrence) + MIN_BLOCK_SIZE - 1) / MIN_BLOCK_SIZE;
+  nb_block_64 = std::clamp(nb_block_64, static_cast<Int64>(1), max_nb_block);
+  const Int32 block_size = static_cast<Int32>((nb_occurrence + nb_block_64 - 1) / nb_block_64);
+  const Int32 nb_block = (nb_occurrence + block_size - 1) / block_size;
+  const Int32 nb_bucket = nb_block;
+  auto block_end = [&](Int32 block) { return std::min(nb_occurrence, (block + 1) * block_size); };
+  auto bucket_of = [&](Int32 i) { return static_cast<Int32>(hashes[i] % static_cast<UInt64>(nb_bucket)); };
+
+  // Nombre d'occurrences de chaque paquet pour chaque bloc.
+  UniqueArray<Int32> positions(static_cast<Int64>(nb_block) * nb_bucket, 0);
+  _executeBlocks(nb_block, [&](Int32 block) {
+    Int32* block_counts = positions.data() + static_cast<Int64>(block) * nb_bucket;
+    for (Int32 i = block * block_size, end = block_end(block); i < end; ++i)
+      ++block_counts[bucket_of(i)];
+  });
+
+  // Transforme les nombres en positions. Les paquets sont contigus et
+  // dans un paquet les blocs sont rangés par ordre croissant.
+  UniqueArray<Int32> buckets_offset(nb_bucket + 1);
+  {
+    Int32 pos = 0;
+    for (Int32 bucket = 0; bucket < nb_bucket; ++bucket) {
+      buckets_offset[bucket] = pos;
+      for (Int32 block = 0; block < nb_block; ++block) {
+        Int32& v = positions[static_cast<Int64>(block) * nb_bucket + bucket];
+        Int32 n = v;
+        v = pos;
+        pos += n;
+      }
+    }
+    buckets_offset[nb_bucket] = pos;
+  }
+
+  UniqueArray<Int32> sorted_occurrences(nb_occurrence);
+  _executeBlocks(nb_block, [&](Int32 block) {
+    Int32* block_positions = positions.data() + static_cast<Int64>(block) * nb_bucket;
+    for (Int32 i = block * block_size, end = block_end(block); i < end; ++i)
+      sorted_occurrences[block_positions[bucket_of(i)]++] = i;
+  });
+
+  // Tri de chaque paquet et calcul de la première occurrence de chaque clé.
+  // Le résultat temporaire est conservé dans \a occurrences_index.
+  _executeBlocks(nb_bucket, [&](Int32 bucket) {
+    Int32* begin = sorted_occurrences.data() + buckets_offset[bucket];
+    Int32* end = sorted_occurrences.data() + buckets_offset[bucket + 1];
+    std::sort(begin, end, [&](Int32 a, Int32 b) {
+      if (hashes[a] != hashes[b])
+        return hashes[a] < hashes[b];
+      int r = compare_function(a, b);
+      if (r != 0)
+        return r < 0;
+      return a < b;
+    });
+    Int32 first = -1;
+    for (Int32* x = begin; x != end; ++x) {
+      const Int32 occurrence = *x;
+      if (first < 0 || hashes[first] != hashes[occurrence] || compare_function(first, occurrence) != 0)
+        first = occurrence;
+      occurrences_index[occurrence] = first;
+    }
+  });
+
+  // Numérotation des entités uniques dans l'ordre de leur première occurrence.
+  // La première occurrence d'une clé ayant toujours un indice inférieur ou égal,
+  // elle a déjà été numérotée.
+  for (Int32 i = 0; i < nb_occurrence; ++i) {
+    const Int32 first = occurrences_index[i];
+    if (first == i) {
+      occurrences_index[i] = first_occurrences.size();
+      first_occurrences.add(i);
+    }
+    else
+      occurrences_index[i] = occurrences_index[first];
+  }
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*!
+ * \brief Exécute \a func(block) pour chaque bloc, éventuellement en parallèle.
+ */
+template <typename Lambda>
+void CellsItemsDeduplicator::
+_executeBlocks(Int32 nb_block, const Lambda& func)
+{
+  if (nb_block == 1) {
+    func(0);
+    return;
+  }
+  ParallelLoopOptions loop_options;
+  loop_options.setGrainSize(1);
+  arcaneParallelFor(0, nb_block, loop_options, [&](Int32 begin, Int32 size) {
+    for (Int32 i = begin, end = begin + size; i < end; ++i)
+      func(i);
+  });
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+} // namespace Arcane::mesh
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
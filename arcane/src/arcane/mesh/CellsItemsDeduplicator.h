@@ -0,0 +1,170 @@
+﻿// -*- tab-width: 2; indent-tabs-mode: nil; coding: utf-8-with-signature -*-
+//-----------------------------------------------------------------------------
+// Copyright 2000-2024 CEA (www.cea.fr) IFPEN (www.ifpenergiesnouvelles.com)
+// See the top-level COPYRIGHT file for details.
+// SPDX-License-Identifier: Apache-2.0
+//-----------------------------------------------------------------------------
+/*---------------------------------------------------------------------------*/
+/* CellsItemsDeduplicator.h                                    (C) 2000-2024 */
+/*                                                                           */
+/* Calcul multi-thread des entités uniques d'une liste de mailles.           */
+/*---------------------------------------------------------------------------*/
+#ifndef ARCANE_MESH_CELLSITEMSDEDUPLICATOR_H
+#define ARCANE_MESH_CELLSITEMSDEDUPLICATOR_H
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+#include "arcane/utils/TraceAccessor.h"
+#include "arcane/utils/Array.h"
+
+#include "arcane/mesh/MeshGlobal.h"
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+namespace Arcane
+{
+class ItemTypeMng;
+class ItemTypeInfo;
+}
+
+namespace Arcane::mesh
+{
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*!
+ * \internal
+ * \brief Calcul des noeuds, arêtes et faces uniques d'une liste de mailles.
+ *
+ * La liste des mailles a le même format que celui de IMesh::allocateCells().
+ * Chaque maille référence ses noeuds, ses arêtes et ses faces. On appelle
+ * \a occurrence une référence d'une maille vers une de ces entités. Les
+ * occurrences sont numérotées dans l'ordre des mailles puis dans l'ordre
+ * local de l'entité dans la maille.
+ *
+ * La méthode compute() associe à chaque occurrence l'indice de l'entité
+ * unique correspondante. Les entités uniques sont numérotées dans l'ordre
+ * de leur première occurrence, ce qui correspond à l'ordre de création
+ * utilisé par OneMeshItemAdder::addOneCell(). Les arêtes sont identifiées
+ * par leurs deux noeuds et les faces par leur type et leurs noeuds après
+ * réorientation via mesh_utils::reorderNodesOfFace2().
+ *
+ * Les calculs n'utilisent pas de table de hachage globale: les occurrences
+ * sont réparties en paquets suivant un hash de leur clé puis chaque paquet
+ * est trié indépendamment. Ces opérations sont effectuées en multi-thread
+ * si le multi-threading est actif.
+ */
+class CellsItemsDeduplicator
+: public TraceAccessor
+{
+ public:
+
+  CellsItemsDeduplicator(ITraceMng* tm, ItemTypeMng* item_type_mng,
+                         Int32 mesh_dimension, bool has_edge);
+
+ public:
+
+  //! Calcule les entités uniques des \a nb_cell mailles décrites par \a cells_infos
+  void compute(Int32 nb_cell, Int64ConstArrayView cells_infos);
+
+ public:
+
+  Int32 nbCell() const { return m_nb_cell; }
+  //! Indique si plusieurs mailles ont le même uniqueId()
+  bool hasDuplicatedCell() const { return m_has_duplicated_cell; }
+  //! Type de la maille \a cell_index
+  ItemTypeInfo* cellTypeInfo(Int32 cell_index) const { return m_cells_type_info[cell_index]; }
+  //! Position dans \a cells_infos du uniqueId() de la maille \a cell_index
+  Int32 cellInfoIndex(Int32 cell_index) const { return m_cells_info_index[cell_index]; }
+
+  Int32 nbUniqueNode() const { return m_nodes_first_occurrence.size(); }
+  Int32 nbUniqueEdge() const { return m_edges_first_occurrence.size(); }
+  Int32 nbUniqueFace() const { return m_faces_first_occurrence.size(); }
+
+  //! Indice de la première occurrence de noeud de la maille \a cell_index
+  Int32 cellNodeOffset(Int32 cell_index) const { return m_cells_node_offset[cell_index]; }
+  //! Indice de la première occurrence d'arête de la maille \a cell_index
+  Int32 cellEdgeOffset(Int32 cell_index) const { return m_cells_edge_offset[cell_index]; }
+  //! Indice de la première occurrence de face de la maille \a cell_index
+  Int32 cellFaceOffset(Int32 cell_index) const { return m_cells_face_offset[cell_index]; }
+
+  //! Indice du noeud unique de l'occurrence \a occurrence
+  Int32 nodeIndex(Int32 occurrence) const { return m_nodes_index[occurrence]; }
+  //! Indice de la première occurrence du noeud unique \a node_index
+  Int32 nodeFirstOccurrence(Int32 node_index) const { return m_nodes_first_occurrence[node_index]; }
+
+  //! Indice de l'arête unique de l'occurrence \a occurrence
+  Int32 edgeIndex(Int32 occurrence) const { return m_edges_index[occurrence]; }
+  //! Indice de la première occurrence de l'arête unique \a edge_index
+  Int32 edgeFirstOccurrence(Int32 edge_index) const { return m_edges_first_occurrence[edge_index]; }
+  //! Indice du noeud unique \a i (0 ou 1) de l'occurrence d'arête \a occurrence
+  Int32 edgeNodeIndex(Int32 occurrence, Int32 i) const { return m_edges_nodes_index[occurrence * 2 + i]; }
+
+  //! Indice de la face unique de l'occurrence \a occurrence
+  Int32 faceIndex(Int32 occurrence) const { return m_faces_index[occurrence]; }
+  //! Indice de la première occurrence de la face unique \a face_index
+  Int32 faceFirstOccurrence(Int32 face_index) const { return m_faces_first_occurrence[face_index]; }
+  //! Indique si la face de l'occurrence \a occurrence est réorientée par rapport à la maille
+  bool isFaceReorder(Int32 occurrence) const { return m_faces_is_reorder[occurrence] != 0; }
+  //! Indices des noeuds uniques (après réorientation) de l'occurrence de face \a occurrence
+  Int32ConstArrayView faceNodesIndex(Int32 occurrence) const
+  {
+    Int32 begin = m_faces_node_offset[occurrence];
+    return m_faces_nodes_index.subConstView(begin, m_faces_node_offset[occurrence + 1] - begin);
+  }
+
+ private:
+
+  ItemTypeMng* m_item_type_mng = nullptr;
+  Int32 m_mesh_dimension = 0;
+  bool m_has_edge = false;
+  Int32 m_nb_cell = 0;
+  bool m_has_duplicated_cell = false;
+
+  UniqueArray<ItemTypeInfo*> m_cells_type_info;
+  UniqueArray<Int32> m_cells_info_index;
+  UniqueArray<Int32> m_cells_node_offset;
+  UniqueArray<Int32> m_cells_edge_offset;
+  UniqueArray<Int32> m_cells_face_offset;
+
+  UniqueArray<Int32> m_nodes_index;
+  UniqueArray<Int32> m_nodes_first_occurrence;
+
+  UniqueArray<Int32> m_edges_index;
+  UniqueArray<Int32> m_edges_first_occurrence;
+  UniqueArray<Int32> m_edges_nodes_index;
+
+  UniqueArray<Int32> m_faces_index;
+  UniqueArray<Int32> m_faces_first_occurrence;
+  UniqueArray<Byte> m_faces_is_reorder;
+  UniqueArray<Int32> m_faces_node_offset;
+  UniqueArray<Int32> m_faces_nodes_index;
+
+ private:
+
+  void _computeCellsOffsets(Int64ConstArrayView cells_infos);
+  void _computeCells(Int64ConstArrayView cells_infos);
+  void _computeNodes(Int64ConstArrayView cells_infos);
+  void _computeEdges(Int64ConstArrayView cells_infos);
+  void _computeFaces(Int64ConstArrayView cells_infos);
+
+  template <typename HashFunction, typename CompareFunction>
+  void _computeUniqueIndexes(Int32 nb_occurrence, const HashFunction& hash_function,
+                             const CompareFunction& compare_function,
+                             Array<Int32>& occurrences_index,
+                             Array<Int32>& first_occurrences);
+
+  template <typename Lambda>
+  static void _executeBlocks(Int32 nb_block, const Lambda& func);
+};
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+} // namespace Arcane::mesh
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+#endif
@@ -152,17 +152,12 @@ void
 DoFFamily::
 _printInfos(Integer nb_added)
 {
-  Integer nb_in_map = 0;
-  for( auto i : itemsMap().buckets() ){
-    for( ItemInternalMap::Data* nbid = i; nbid; nbid = nbid->next() ){
-      ++nb_in_map;
-    }
-  }
+  Integer nb_in_map = itemsMap().count();
 
   info() << "DoFFamily: added=" << nb_added
          << " nb_internal=" << infos().m_internals.size()
          << " nb_free=" << infos().m_free_internals.size()
-         << " map_nb_bucket=" << itemsMap().buckets().size()
+         << " map_nb_bucket=" << itemsMap().nbBucket()
          << " map_size=" << nb_in_map;
 }
 
@@ -174,7 +169,7 @@ DoFFamily::
 preAllocate(Integer nb_item)
 {
   // Copy paste de particle, pas utilise pour l'instant
-  Integer nb_hash = itemsMap().buckets().size();
+  Integer nb_hash = itemsMap().nbBucket();
   Integer wanted_size = 2*(nb_item+infos().nbItem());
   if (nb_hash<wanted_size)
     itemsMap().resize(wanted_size,true);
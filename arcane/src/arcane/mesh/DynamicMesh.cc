@@ -180,6 +180,11 @@ class DynamicMesh::InternalApi
     return m_connectivity_mng.get();
   }
 
+  void sortAndCompactItems() override
+  {
+    m_mesh->_compactItems(true, true);
+  }
+
  private:
 
   DynamicMesh* m_mesh = nullptr;
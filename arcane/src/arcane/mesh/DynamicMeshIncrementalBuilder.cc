@@ -1,11 +1,11 @@
 ﻿// -*- tab-width: 2; indent-tabs-mode: nil; coding: utf-8-with-signature -*-
 //-----------------------------------------------------------------------------
-// Copyright 2000-2022 CEA (www.cea.fr) IFPEN (www.ifpenergiesnouvelles.com)
+// Copyright 2000-2024 CEA (www.cea.fr) IFPEN (www.ifpenergiesnouvelles.com)
 // See the top-level COPYRIGHT file for details.
 // SPDX-License-Identifier: Apache-2.0
 //-----------------------------------------------------------------------------
 /*---------------------------------------------------------------------------*/
-/* DynamicMeshIncrementalBuilder.cc                            (C) 2000-2022 */
+/* DynamicMeshIncrementalBuilder.cc                            (C) 2000-2024 */
 /*                                                                           */
 /* Construction d'un maillage de manière incrémentale.                       */
 /*---------------------------------------------------------------------------*/
@@ -16,6 +16,7 @@
 #include "arcane/utils/OStringStream.h"
 #include "arcane/utils/NotImplementedException.h"
 #include "arcane/utils/NotSupportedException.h"
+#include "arcane/utils/ValueConvert.h"
 
 #include "arcane/ItemTypeMng.h"
 #include "arcane/MeshUtils.h"
@@ -67,6 +68,8 @@ DynamicMeshIncrementalBuilder(DynamicMesh* mesh)
 , m_has_amr(mesh->isAmrActivated())
 , m_one_mesh_item_adder(new OneMeshItemAdder(this))
 {
+  if (auto v = Convert::Type<Int32>::tryParseFromEnvironment("ARCANE_USE_BULK_MESH_ALLOCATION", true))
+    m_use_bulk_cells_allocation = (v.value() != 0);
 }
 
 /*---------------------------------------------------------------------------*/
@@ -134,6 +137,11 @@ addCells(Integer nb_cell,Int64ConstArrayView cells_infos,
   bool add_to_cells = cells.size()!=0;
   if (add_to_cells && nb_cell!=cells.size())
     ARCANE_THROW(ArgumentException,"return array 'cells' has to have same size as number of cells");
+  if (_isBulkCellsAllocationPossible(allow_build_face)){
+    if (m_one_mesh_item_adder->addCellsBulk(nb_cell,cells_infos,sub_domain_id,cells))
+      return;
+    info() << "Duplicated cells in bulk allocation: using incremental allocation";
+  }
   for( Integer i_cell=0; i_cell<nb_cell; ++i_cell ){
     ItemTypeId item_type_id { (Int16)cells_infos[cells_infos_index] };
     ++cells_infos_index;
@@ -153,6 +161,24 @@ addCells(Integer nb_cell,Int64ConstArrayView cells_infos,
   }
 }
 
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*!
+ * \brief Indique si on peut ajouter les mailles via OneMeshItemAdder::addCellsBulk().
+ *
+ * Cette méthode n'est utilisable que si la variable d'environnement
+ * ARCANE_USE_BULK_MESH_ALLOCATION est positionnée, si les faces peuvent
+ * être créées à la volée et si le maillage ne contient encore aucune entité.
+ */
+bool DynamicMeshIncrementalBuilder::
+_isBulkCellsAllocationPossible(bool allow_build_face) const
+{
+  if (!m_use_bulk_cells_allocation || !allow_build_face || m_has_amr)
+    return false;
+  return (m_mesh->nodeFamily()->nbItem()==0 && m_mesh->edgeFamily()->nbItem()==0 &&
+          m_mesh->faceFamily()->nbItem()==0 && m_mesh->cellFamily()->nbItem()==0);
+}
+
 /*---------------------------------------------------------------------------*/
 /*---------------------------------------------------------------------------*/
 /*!
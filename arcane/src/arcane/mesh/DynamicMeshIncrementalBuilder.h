@@ -1,11 +1,11 @@
 ﻿// -*- tab-width: 2; indent-tabs-mode: nil; coding: utf-8-with-signature -*-
 //-----------------------------------------------------------------------------
-// Copyright 2000-2022 CEA (www.cea.fr) IFPEN (www.ifpenergiesnouvelles.com)
+// Copyright 2000-2024 CEA (www.cea.fr) IFPEN (www.ifpenergiesnouvelles.com)
 // See the top-level COPYRIGHT file for details.
 // SPDX-License-Identifier: Apache-2.0
 //-----------------------------------------------------------------------------
 /*---------------------------------------------------------------------------*/
-/* DynamicMeshIncrementalBuilder.h                             (C) 2000-2021 */
+/* DynamicMeshIncrementalBuilder.h                             (C) 2000-2024 */
 /*                                                                           */
 /* Construction d'un maillage de manière incrémentale.                       */
 /*---------------------------------------------------------------------------*/
@@ -254,6 +254,7 @@ class DynamicMeshIncrementalBuilder
   void _addFaceInFaceNodesSet(NodeInFaceSet& face_nodes_set,Integer index,Int64ConstArrayView face_nodes, NodeInFacePtr node, Int64 face_uid);
   NodeInFacePtr& _insertNode(NodeInFaceSet& face_nodes_set, Int64 inserted_node_uid);
   void _addItemsOrRelations(ItemDataList& info_list, IItemFamilyNetwork::eSchedulingOrder family_graph_traversal_order);
+  bool _isBulkCellsAllocationPossible(bool allow_build_face) const;
 
  private:
   
@@ -268,6 +269,9 @@ class DynamicMeshIncrementalBuilder
 
   bool m_verbose = false; //!< Vrai si affiche messages
 
+  //! Vrai si on utilise OneMeshItemAdder::addCellsBulk() quand c'est possible
+  bool m_use_bulk_cells_allocation = false;
+
   //! Outils de construction du maillage
   OneMeshItemAdder* m_one_mesh_item_adder = nullptr;   //!< Outil pour ajouter un élément au maillage
   GhostLayerBuilder* m_ghost_layer_builder = nullptr;  //!< Outil pour construire les éléments fantômes
@@ -1,11 +1,11 @@
 ﻿// -*- tab-width: 2; indent-tabs-mode: nil; coding: utf-8-with-signature -*-
 //-----------------------------------------------------------------------------
-// Copyright 2000-2022 CEA (www.cea.fr) IFPEN (www.ifpenergiesnouvelles.com)
+// Copyright 2000-2024 CEA (www.cea.fr) IFPEN (www.ifpenergiesnouvelles.com)
 // See the top-level COPYRIGHT file for details.
 // SPDX-License-Identifier: Apache-2.0
 //-----------------------------------------------------------------------------
 /*---------------------------------------------------------------------------*/
-/* DynamicMeshKindInfos.cc                                     (C) 2000-2019 */
+/* DynamicMeshKindInfos.cc                                     (C) 2000-2024 */
 /*                                                                           */
 /* Infos de maillage pour un genre d'entité donnée.                          */
 /*---------------------------------------------------------------------------*/
@@ -190,19 +190,15 @@ itemsUniqueIdToLocalId(ArrayView<Int64> ids,bool do_fatal) const
   if (!m_has_unique_id_map)
     _badUniqueIdMap();
   if (!arcaneIsCheck()){
-    if (do_fatal){
-      for( Integer i=0, s=ids.size(); i<s; ++i ){
-        Int64 unique_id = ids[i];
-        ids[i] =m_items_map.lookupValue(unique_id)->localId();
-      }
-    }
-    else{
-      for( Integer i=0, s=ids.size(); i<s; ++i ){
-        Int64 unique_id = ids[i];
-        const ItemInternalMap::Data* data = m_items_map.lookup(unique_id);
-        ids[i] = (data) ? data->value()->localId() : NULL_ITEM_LOCAL_ID;
-      }
-    }
+    // Chaque valeur de \a ids est lue par lookupMany() avant d'être remplacée.
+    m_items_map.lookupMany(ids,[&](Int32 index,const ItemInternalMap::Data* data){
+      if (data)
+        ids[index] = data->value()->localId();
+      else if (do_fatal)
+        m_items_map.lookupValue(ids[index]); // Lance une exception
+      else
+        ids[index] = NULL_ITEM_LOCAL_ID;
+    });
   }
   else{
     Integer nb_error = 0;
@@ -236,17 +232,12 @@ itemsUniqueIdToLocalId(Int32ArrayView local_ids,
   if (!m_has_unique_id_map)
     _badUniqueIdMap();
   if (!arcaneIsCheck()){
-    if (do_fatal){
+    Int32 nb_not_found = m_items_map.findLocalIds(unique_ids,local_ids);
+    if (do_fatal && nb_not_found!=0){
       for( Integer i=0, s=unique_ids.size(); i<s; ++i ){
         Int64 unique_id = unique_ids[i];
-        local_ids[i] = (unique_id==NULL_ITEM_UNIQUE_ID) ? NULL_ITEM_LOCAL_ID : m_items_map.lookupValue(unique_id)->localId();
-      }
-    }
-    else{
-      for( Integer i=0, s=unique_ids.size(); i<s; ++i ){
-        Int64 unique_id = unique_ids[i];
-        const ItemInternalMap::Data* data = m_items_map.lookup(unique_id);
-        local_ids[i] = (data) ? data->value()->localId() : NULL_ITEM_LOCAL_ID;
+        if (local_ids[i]==NULL_ITEM_LOCAL_ID && unique_id!=NULL_ITEM_UNIQUE_ID)
+          m_items_map.lookupValue(unique_id); // Lance une exception
       }
     }
   }
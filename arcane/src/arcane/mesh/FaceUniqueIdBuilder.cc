@@ -46,6 +46,8 @@ _computeFaceUniqueIdVersion3(DynamicMesh* mesh);
 extern "C++" void
 _computeFaceUniqueIdVersion5(DynamicMesh* mesh);
 extern "C++" void
+_computeFaceUniqueIdVersion6(DynamicMesh* mesh);
+extern "C++" void
 arcaneComputeCartesianFaceUniqueId(DynamicMesh* mesh);
 
 /*---------------------------------------------------------------------------*/
@@ -72,10 +74,12 @@ computeFacesUniqueIds()
   info() << "Using version=" << face_version << " to compute faces unique ids"
          << " mesh=" << m_mesh->name() << " is_parallel=" << is_parallel;
 
-  if (face_version > 5 || face_version < 0)
+  if (face_version > 6 || face_version < 0)
     ARCANE_FATAL("Invalid value '{0}' for compute face unique ids versions: v>=0 && v<=6", face_version);
 
-  if (face_version == 5)
+  if (face_version == 6)
+    _computeFaceUniqueIdVersion6(m_mesh);
+  else if (face_version == 5)
     _computeFaceUniqueIdVersion5(m_mesh);
   else if (face_version == 4)
     arcaneComputeCartesianFaceUniqueId(m_mesh);
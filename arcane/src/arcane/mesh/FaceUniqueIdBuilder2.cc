@@ -22,6 +22,7 @@
 #include "arcane/core/Timer.h"
 
 #include "arcane/parallel/BitonicSortT.H"
+#include "arcane/parallel/SampleSortT.H"
 
 /*---------------------------------------------------------------------------*/
 /*---------------------------------------------------------------------------*/
@@ -65,6 +66,12 @@ namespace Arcane::mesh
  * le nombre de messages augmente en log2(N), avec N le nombre de processeurs.
  * Cela évite d'avoir potentiellement un grand nombre de messages, ce qui
  * n'est pas supporté par certaines implémentations MPI (par exemple MPC).
+ *
+ * La version 3 utilise le tri bitonique (Parallel::BitonicSort) et la
+ * version 6 le tri par échantillonnage (Parallel::SampleSort). Ce dernier
+ * n'utilise qu'un nombre constant d'opérations collectives et est donc
+ * préférable lorsque le nombre de processeurs est important. Les deux
+ * versions donnent la même numérotation.
  */
 class FaceUniqueIdBuilder2
 : public TraceAccessor
@@ -97,12 +104,15 @@ class FaceUniqueIdBuilder2
 
   void computeFacesUniqueIdAndOwnerVersion3();
   void computeFacesUniqueIdAndOwnerVersion5();
+  void computeFacesUniqueIdAndOwnerVersion6();
 
  private:
 
   DynamicMesh* m_mesh = nullptr;
   IParallelMng* m_parallel_mng = nullptr;
   bool m_is_verbose = false;
+  //! Indique si on utilise le tri par échantillonnage au lieu du tri bitonique
+  bool m_use_sample_sort = false;
 
  private:
 
@@ -112,6 +122,8 @@ class FaceUniqueIdBuilder2
   void _computeAndSortBoundaryFaces(Array<BoundaryFaceInfo>& boundary_faces_info);
   void _computeParallel();
   void _computeSequential();
+  template <typename KeyType, typename KeyTypeTraits>
+  void _parallelSort(ConstArrayView<KeyType> keys, Array<KeyType>& sorted_keys, const String& name);
 };
 
 /*---------------------------------------------------------------------------*/
@@ -496,6 +508,47 @@ computeFacesUniqueIdAndOwnerVersion3()
     _computeSequential();
 }
 
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*!
+ *\brief Calcul les numéros uniques de chaque face en parallèle avec
+ * le tri par échantillonnage.
+ */
+void FaceUniqueIdBuilder2::
+computeFacesUniqueIdAndOwnerVersion6()
+{
+  m_use_sample_sort = true;
+  computeFacesUniqueIdAndOwnerVersion3();
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*!
+ * \brief Trie en parallèle \a keys et range dans \a sorted_keys
+ * les valeurs triées de ce rang.
+ */
+template <typename KeyType, typename KeyTypeTraits> void FaceUniqueIdBuilder2::
+_parallelSort(ConstArrayView<KeyType> keys, Array<KeyType>& sorted_keys, const String& name)
+{
+  IParallelMng* pm = m_parallel_mng;
+  Real sort_begin_time = platform::getRealTime();
+  sorted_keys.clear();
+  if (m_use_sample_sort) {
+    Parallel::SampleSort<KeyType, KeyTypeTraits> sorter(pm);
+    sorter.setNeedIndexAndRank(false);
+    sorter.sort(keys);
+    sorted_keys.addRange(sorter.keys());
+  }
+  else {
+    Parallel::BitonicSort<KeyType, KeyTypeTraits> sorter(pm);
+    sorter.setNeedIndexAndRank(false);
+    sorter.sort(keys);
+    sorted_keys.addRange(sorter.keys());
+  }
+  Real sort_end_time = platform::getRealTime();
+  info() << "END_" << name << " time=" << (Real)(sort_end_time - sort_begin_time);
+}
+
 /*---------------------------------------------------------------------------*/
 /*---------------------------------------------------------------------------*/
 /*!
@@ -549,7 +602,8 @@ _computeParallel()
 
   ItemInternalMap& cells_map = m_mesh->cellsMap();
 
-  info() << "Compute FacesUniqueId() V3 using parallel sort";
+  info() << "Compute FacesUniqueId() V3 using parallel sort"
+         << " sort=" << ((m_use_sample_sort) ? "sample" : "bitonic");
 
   // Calcule et trie pour les faces frontières
   UniqueArray<BoundaryFaceInfo> boundary_faces_info;
@@ -653,14 +707,10 @@ _computeParallel()
   }
 
   info() << "ALL_FACE_LIST memorysize=" << sizeof(AnyFaceInfo)*all_face_list.size();
-  Parallel::BitonicSort<AnyFaceInfo,AnyFaceBitonicSortTraits> all_face_sorter(pm);
-  all_face_sorter.setNeedIndexAndRank(false);
-  Real sort_begin_time = platform::getRealTime();
-  all_face_sorter.sort(all_face_list);
-  Real sort_end_time = platform::getRealTime();
-  info() << "END_ALL_FACE_SORTER time=" << (Real)(sort_end_time - sort_begin_time);
+  UniqueArray<AnyFaceInfo> sorted_face_list;
+  _parallelSort<AnyFaceInfo, AnyFaceBitonicSortTraits>(all_face_list, sorted_face_list, "ALL_FACE_SORTER");
 
-  _resendCellsAndComputeFacesUniqueId(all_face_sorter.keys());
+  _resendCellsAndComputeFacesUniqueId(sorted_face_list);
 }
 
 /*---------------------------------------------------------------------------*/
@@ -677,9 +727,6 @@ _computeAndSortBoundaryFaces(Array<BoundaryFaceInfo>& boundary_faces_info)
   bool is_verbose = m_is_verbose;
   ItemInternalMap& faces_map = m_mesh->facesMap();
 
-  Parallel::BitonicSort<BoundaryFaceInfo,BoundaryFaceBitonicSortTraits> boundary_face_sorter(pm);
-  boundary_face_sorter.setNeedIndexAndRank(false);
-
   //UniqueArray<BoundaryFaceInfo> boundary_face_list;
   boundary_faces_info.clear();
   ENUMERATE_ITEM_INTERNAL_MAP_DATA(iid,faces_map){
@@ -718,13 +765,12 @@ _computeAndSortBoundaryFaces(Array<BoundaryFaceInfo>& boundary_faces_info)
     }
   }
 
-  Real sort_begin_time = platform::getRealTime();
-  boundary_face_sorter.sort(boundary_faces_info);
-  Real sort_end_time = platform::getRealTime();
-  info() << "END_BOUNDARY_FACE_SORT time=" << (Real)(sort_end_time - sort_begin_time);
+  UniqueArray<BoundaryFaceInfo> sorted_boundary_faces_info;
+  _parallelSort<BoundaryFaceInfo, BoundaryFaceBitonicSortTraits>(boundary_faces_info, sorted_boundary_faces_info,
+                                                                 "BOUNDARY_FACE_SORT");
 
   {
-    ConstArrayView<BoundaryFaceInfo> all_bfi = boundary_face_sorter.keys();
+    ConstArrayView<BoundaryFaceInfo> all_bfi = sorted_boundary_faces_info;
     Integer n = all_bfi.size();
     if (is_verbose){
       for( Integer i=0; i<n; ++i ){
@@ -1109,6 +1155,16 @@ _computeFaceUniqueIdVersion5(DynamicMesh* mesh)
 /*---------------------------------------------------------------------------*/
 /*---------------------------------------------------------------------------*/
 
+extern "C++" void
+_computeFaceUniqueIdVersion6(DynamicMesh* mesh)
+{
+  FaceUniqueIdBuilder2 f(mesh);
+  f.computeFacesUniqueIdAndOwnerVersion6();
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
 } // End namespace Arcane::mesh
 
 /*---------------------------------------------------------------------------*/
@@ -1,11 +1,11 @@
 ﻿// -*- tab-width: 2; indent-tabs-mode: nil; coding: utf-8-with-signature -*-
 //-----------------------------------------------------------------------------
-// Copyright 2000-2022 CEA (www.cea.fr) IFPEN (www.ifpenergiesnouvelles.com)
+// Copyright 2000-2024 CEA (www.cea.fr) IFPEN (www.ifpenergiesnouvelles.com)
 // See the top-level COPYRIGHT file for details.
 // SPDX-License-Identifier: Apache-2.0
 //-----------------------------------------------------------------------------
 /*---------------------------------------------------------------------------*/
-/* ItemInternalMap.cc                                          (C) 2000-2021 */
+/* ItemInternalMap.cc                                          (C) 2000-2024 */
 /*                                                                           */
 /* Tableau associatif de ItemInternal.                                       */
 /*---------------------------------------------------------------------------*/
@@ -32,13 +32,31 @@ namespace Arcane::mesh
 
 ItemInternalMap::
 ItemInternalMap()
-: BaseClass(5000,false)
+: BaseClass(5000)
 {
 }
 
 /*---------------------------------------------------------------------------*/
 /*---------------------------------------------------------------------------*/
 
+Int32 ItemInternalMap::
+findLocalIds(Int64ConstArrayView unique_ids,Int32ArrayView local_ids) const
+{
+  Int32 nb_not_found = 0;
+  lookupMany(unique_ids,[&](Int32 index,const Data* data){
+    if (data)
+      local_ids[index] = data->value()->localId();
+    else{
+      local_ids[index] = NULL_ITEM_LOCAL_ID;
+      ++nb_not_found;
+    }
+  });
+  return nb_not_found;
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
 void ItemInternalMap::
 notifyUniqueIdsChanged()
 {
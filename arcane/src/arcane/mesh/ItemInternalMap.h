@@ -1,11 +1,11 @@
 ﻿// -*- tab-width: 2; indent-tabs-mode: nil; coding: utf-8-with-signature -*-
 //-----------------------------------------------------------------------------
-// Copyright 2000-2023 CEA (www.cea.fr) IFPEN (www.ifpenergiesnouvelles.com)
+// Copyright 2000-2024 CEA (www.cea.fr) IFPEN (www.ifpenergiesnouvelles.com)
 // See the top-level COPYRIGHT file for details.
 // SPDX-License-Identifier: Apache-2.0
 //-----------------------------------------------------------------------------
 /*---------------------------------------------------------------------------*/
-/* ItemInternalMap.h                                           (C) 2000-2023 */
+/* ItemInternalMap.h                                           (C) 2000-2024 */
 /*                                                                           */
 /* Tableau associatif de ItemInternal.                                       */
 /*---------------------------------------------------------------------------*/
@@ -14,7 +14,7 @@
 /*---------------------------------------------------------------------------*/
 /*---------------------------------------------------------------------------*/
 
-#include "arcane/utils/HashTableMap.h"
+#include "arcane/utils/FlatHashTableMap.h"
 
 #include "arcane/mesh/MeshGlobal.h"
 
@@ -40,16 +40,28 @@ namespace Arcane::mesh
  * La clé de ce tableau associatif est le UniqueId des entités.
  * S'il change, il faut appeler notifyUniqueIdsChanged() pour remettre
  * à jour le tableau associatif.
+ *
+ * L'implémentation utilise un adressage ouvert (FlatHashTableMapT). Les
+ * pointeurs retournés par lookup() ne sont donc valides que jusqu'à la
+ * prochaine modification du tableau.
  */
 class ItemInternalMap
-: public HashTableMapT<Int64,ItemInternal*>
+: public FlatHashTableMapT<Int64,ItemInternal*>
 {
  private:
-  typedef HashTableMapT<Int64,ItemInternal*> BaseClass;
+  typedef FlatHashTableMapT<Int64,ItemInternal*> BaseClass;
  public:
   ItemInternalMap();
  public:
   void notifyUniqueIdsChanged();
+  /*!
+   * \brief Numéros locaux des entités de numéros uniques \a unique_ids.
+   *
+   * Remplit \a local_ids avec le numéro local des entités dont le numéro
+   * unique est dans \a unique_ids ou NULL_ITEM_LOCAL_ID si l'entité n'est
+   * pas dans le tableau. Retourne le nombre d'entités non trouvées.
+   */
+  Int32 findLocalIds(Int64ConstArrayView unique_ids,Int32ArrayView local_ids) const;
 };
 
 /*---------------------------------------------------------------------------*/
@@ -57,8 +69,8 @@ class ItemInternalMap
 
 //! Macro pour itérer sur les valeurs d'un ItemInternalMap
 #define ENUMERATE_ITEM_INTERNAL_MAP_DATA(iter,item_list) \
-for( auto __i__##iter : item_list .buckets() ) \
-  for( Arcane::mesh::ItemInternalMap::Data* iter = __i__##iter; iter; iter = iter->next() )
+for( auto& __i__##iter : (item_list).dataView() ) \
+  for( auto* iter = &__i__##iter; iter; iter = nullptr )
 
 /*---------------------------------------------------------------------------*/
 /*---------------------------------------------------------------------------*/
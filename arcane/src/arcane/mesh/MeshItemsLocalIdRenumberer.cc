@@ -0,0 +1,555 @@
+﻿// -*- tab-width: 2; indent-tabs-mode: nil; coding: utf-8-with-signature -*-
+//-----------------------------------------------------------------------------
+// Copyright 2000-2024 CEA (www.cea.fr) IFPEN (www.ifpenergiesnouvelles.com)
+// See the top-level COPYRIGHT file for details.
+// SPDX-License-Identifier: Apache-2.0
+//-----------------------------------------------------------------------------
+/*---------------------------------------------------------------------------*/
+/* MeshItemsLocalIdRenumberer.cc                               (C) 2000-2024 */
+/*                                                                           */
+/* Renumérotation des numéros locaux des entités d'un maillage.              */
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+#include "arcane/mesh/MeshItemsLocalIdRenumberer.h"
+
+#include "arcane/utils/FatalErrorException.h"
+#include "arcane/utils/PlatformUtils.h"
+#include "arcane/utils/Real3.h"
+#include "arcane/utils/String.h"
+
+#include "arcane/core/IMesh.h"
+#include "arcane/core/IMeshModifier.h"
+#include "arcane/core/IItemFamily.h"
+#include "arcane/core/IItemInternalSortFunction.h"
+#include "arcane/core/ItemGroup.h"
+#include "arcane/core/ItemEnumerator.h"
+#include "arcane/core/ItemInfoListView.h"
+#include "arcane/core/ItemInternal.h"
+#include "arcane/core/VariableTypes.h"
+#include "arcane/core/internal/IMeshModifierInternal.h"
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+namespace Arcane::mesh
+{
+
+namespace
+{
+  //! Nombre de bits par dimension pour les clés des courbes
+  constexpr Int32 NB_BIT_PER_DIM = 21;
+
+  const char* _algoName(eItemsLocalIdRenumbering algo)
+  {
+    switch (algo) {
+    case eItemsLocalIdRenumbering::MortonCurve:
+      return "Morton";
+    case eItemsLocalIdRenumbering::HilbertCurve:
+      return "Hilbert";
+    case eItemsLocalIdRenumbering::ReverseCuthillMcKee:
+      return "ReverseCuthillMcKee";
+    }
+    return "Unknown";
+  }
+
+  //! Entrelace les bits des \a dim coordonnées de \a x (bit de poids fort en premier)
+  UInt64 _interleaveBits(const UInt32* x, Int32 dim)
+  {
+    UInt64 key = 0;
+    for (Int32 bit = NB_BIT_PER_DIM - 1; bit >= 0; --bit)
+      for (Int32 d = 0; d < dim; ++d)
+        key = (key << 1) | ((x[d] >> bit) & 1);
+    return key;
+  }
+
+  /*!
+   * \brief Transforme les coordonnées \a x en la forme transposée de
+   * l'index de Hilbert.
+   *
+   * Il s'agit de l'algorithme de J. Skilling, "Programming the Hilbert curve"
+   * (AIP Conf. Proc. 707, 2004). L'index s'obtient ensuite en entrelaçant
+   * les bits via _interleaveBits().
+   */
+  void _axesToHilbertTranspose(UInt32* x, Int32 dim)
+  {
+    const UInt32 m = 1U << (NB_BIT_PER_DIM - 1);
+    for (UInt32 q = m; q > 1; q >>= 1) {
+      const UInt32 p = q - 1;
+      for (Int32 i = 0; i < dim; ++i) {
+        if (x[i] & q)
+          x[0] ^= p;
+        else {
+          const UInt32 t = (x[0] ^ x[i]) & p;
+          x[0] ^= t;
+          x[i] ^= t;
+        }
+      }
+    }
+    for (Int32 i = 1; i < dim; ++i)
+      x[i] ^= x[i - 1];
+    UInt32 t = 0;
+    for (UInt32 q = m; q > 1; q >>= 1)
+      if (x[dim - 1] & q)
+        t ^= q - 1;
+    for (Int32 i = 0; i < dim; ++i)
+      x[i] ^= t;
+  }
+
+  /*!
+   * \brief Calcule l'ordre de Cuthill-McKee inverse des mailles.
+   *
+   * Deux mailles sont voisines si elles partagent une face. En retour,
+   * \a ranks[lid] contient la position de la maille de numéro local \a lid.
+   * Chaque composante connexe démarre par la maille non numérotée de plus
+   * petit degré.
+   */
+  void _computeCellReverseCuthillMcKeeRanks(IMesh* mesh, Array<Int32>& ranks)
+  {
+    IItemFamily* cell_family = mesh->cellFamily();
+    CellInfoListView cells(cell_family);
+    CellGroup all_cells = mesh->allCells();
+    const Int32 max_lid = cell_family->maxLocalId();
+    const Int32 nb_cell = all_cells.size();
+
+    UniqueArray<Int32> degrees(max_lid, 0);
+    ENUMERATE_CELL (icell, all_cells) {
+      Int32 degree = 0;
+      for (Face face : icell->faces())
+        if (face.nbCell() == 2)
+          ++degree;
+      degrees[icell.itemLocalId()] = degree;
+    }
+    auto is_before = [&](Int32 lid1, Int32 lid2) {
+      if (degrees[lid1] != degrees[lid2])
+        return degrees[lid1] < degrees[lid2];
+      return lid1 < lid2;
+    };
+
+    UniqueArray<Int32> start_cells(all_cells.view().localIds());
+    std::sort(start_cells.begin(), start_cells.end(), is_before);
+
+    // Sert aussi de marqueur: une maille déjà rencontrée a un rang positif.
+    ranks.resize(max_lid);
+    ranks.fill(-1);
+    UniqueArray<Int32> order;
+    order.reserve(nb_cell);
+    UniqueArray<Int32> neighbours;
+    for (Int32 start_lid : start_cells) {
+      if (ranks[start_lid] != (-1))
+        continue;
+      ranks[start_lid] = 0;
+      order.add(start_lid);
+      for (Int32 index = order.size() - 1; index < order.size(); ++index) {
+        Cell cell = cells[order[index]];
+        neighbours.clear();
+        for (Face face : cell.faces()) {
+          if (face.nbCell() != 2)
+            continue;
+          Int32 opposite_lid = face.oppositeCell(cell).localId();
+          if (ranks[opposite_lid] == (-1)) {
+            ranks[opposite_lid] = 0;
+            neighbours.add(opposite_lid);
+          }
+        }
+        std::sort(neighbours.begin(), neighbours.end(), is_before);
+        order.addRange(neighbours);
+      }
+    }
+
+    const Int32 nb_ordered = order.size();
+    for (Int32 i = 0; i < nb_ordered; ++i)
+      ranks[order[i]] = nb_ordered - 1 - i;
+  }
+
+  //! Clé de chaque entité de \a items: plus petit rang des mailles connectées.
+  template <typename ItemType> void
+  _fillKeysFromCellRanks(ItemGroup items, ConstArrayView<Int32> cell_ranks, Array<UInt64>& keys)
+  {
+    ENUMERATE_ (ItemType, iitem, items) {
+      Int32 min_rank = -1;
+      for (CellLocalId cell_id : iitem->cellIds()) {
+        Int32 r = cell_ranks[cell_id];
+        if (min_rank == (-1) || r < min_rank)
+          min_rank = r;
+      }
+      // Les entités sans maille sont mises à la fin.
+      keys[iitem.itemLocalId()] = (min_rank == (-1)) ? ~UInt64(0) : static_cast<UInt64>(min_rank);
+    }
+  }
+
+  /*---------------------------------------------------------------------------*/
+  /*---------------------------------------------------------------------------*/
+  /*!
+   * \brief Clés de tri partagées par les fonctions de tri des familles.
+   *
+   * Lors d'un compactage, les familles sont triées les unes après les autres
+   * et les connectivités utilisent les nouveaux numéros locaux d'une famille
+   * avant que les variables (dont les coordonnées des noeuds) ne soient
+   * permutées. Les clés de toutes les familles sont donc calculées lors
+   * du premier tri d'un compactage, tant que le maillage est cohérent.
+   * Comme IMesh::timestamp() est incrémenté à la fin de chaque compactage,
+   * il permet de détecter le début d'un nouveau compactage.
+   */
+  class ItemsLocalIdRenumberingSortKeys
+  {
+   public:
+
+    ItemsLocalIdRenumberingSortKeys(IMesh* mesh, eItemsLocalIdRenumbering algo)
+    : m_mesh(mesh)
+    , m_algo(algo)
+    {
+      m_families.add(mesh->nodeFamily());
+      m_families.add(mesh->edgeFamily());
+      m_families.add(mesh->faceFamily());
+      m_families.add(mesh->cellFamily());
+    }
+
+   public:
+
+    ConstArrayView<IItemFamily*> families() const { return m_families; }
+
+    //! Clés des entités de \a family indexées par leur numéro local avant compactage.
+    ConstArrayView<UInt64> keys(IItemFamily* family)
+    {
+      Int64 timestamp = m_mesh->timestamp();
+      if (timestamp != m_timestamp) {
+        MeshItemsLocalIdRenumberer::computeSortKeys(m_mesh, m_families, m_algo, m_keys);
+        m_timestamp = timestamp;
+      }
+      for (Int32 i = 0, n = m_families.size(); i < n; ++i)
+        if (m_families[i] == family)
+          return m_keys[i];
+      ARCANE_FATAL("Family '{0}' is not handled by local id renumbering", family->name());
+    }
+
+   private:
+
+    IMesh* m_mesh = nullptr;
+    eItemsLocalIdRenumbering m_algo;
+    UniqueArray<IItemFamily*> m_families;
+    UniqueArray<UniqueArray<UInt64>> m_keys;
+    Int64 m_timestamp = -1;
+  };
+
+  /*---------------------------------------------------------------------------*/
+  /*---------------------------------------------------------------------------*/
+  /*!
+   * \brief Fonction de tri des entités suivant les clés de
+   * MeshItemsLocalIdRenumberer::computeSortKeys().
+   */
+  class ItemsLocalIdRenumberingSortFunction
+  : public IItemInternalSortFunction
+  {
+   public:
+
+    ItemsLocalIdRenumberingSortFunction(IItemFamily* family, eItemsLocalIdRenumbering algo,
+                                        std::shared_ptr<ItemsLocalIdRenumberingSortKeys> sort_keys)
+    : m_family(family)
+    , m_name(String("ArcaneLocalIdRenumbering") + _algoName(algo))
+    , m_sort_keys(sort_keys)
+    {}
+
+   public:
+
+    const String& name() const override { return m_name; }
+
+    void sortItems(ItemInternalMutableArrayView items) override
+    {
+      ConstArrayView<UInt64> keys(m_sort_keys->keys(m_family));
+      std::sort(std::begin(items), std::end(items), [=](const ItemInternal* item1, const ItemInternal* item2) {
+        // Il faut mettre les entités détruites en fin de liste
+        bool s1 = item1->isSuppressed();
+        bool s2 = item2->isSuppressed();
+        if (s1 != s2)
+          return s2;
+        if (s1)
+          return item1->uniqueId() < item2->uniqueId();
+        UInt64 k1 = keys[item1->localId()];
+        UInt64 k2 = keys[item2->localId()];
+        if (k1 != k2)
+          return k1 < k2;
+        return item1->uniqueId() < item2->uniqueId();
+      });
+    }
+
+   private:
+
+    IItemFamily* m_family = nullptr;
+    String m_name;
+    std::shared_ptr<ItemsLocalIdRenumberingSortKeys> m_sort_keys;
+  };
+} // namespace
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+MeshItemsLocalIdRenumberer::
+MeshItemsLocalIdRenumberer(IMesh* mesh)
+: TraceAccessor(mesh->traceMng())
+, m_mesh(mesh)
+{
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+void MeshItemsLocalIdRenumberer::
+computeSortKeys(IMesh* mesh, ConstArrayView<IItemFamily*> families,
+                eItemsLocalIdRenumbering algo, Array<UniqueArray<UInt64>>& keys)
+{
+  const Int32 nb_family = families.size();
+  keys.resize(nb_family);
+  for (Int32 i = 0; i < nb_family; ++i) {
+    keys[i].resize(families[i]->maxLocalId());
+    keys[i].fill(0);
+  }
+
+  if (algo == eItemsLocalIdRenumbering::ReverseCuthillMcKee) {
+    UniqueArray<Int32> cell_ranks;
+    _computeCellReverseCuthillMcKeeRanks(mesh, cell_ranks);
+    for (Int32 i = 0; i < nb_family; ++i) {
+      IItemFamily* family = families[i];
+      ItemGroup all_items = family->allItems();
+      Array<UInt64>& family_keys = keys[i];
+      eItemKind ik = family->itemKind();
+      switch (ik) {
+      case IK_Cell:
+        ENUMERATE_CELL (icell, all_items)
+          family_keys[icell.itemLocalId()] = cell_ranks[icell.itemLocalId()];
+        break;
+      case IK_Face:
+        _fillKeysFromCellRanks<Face>(all_items, cell_ranks, family_keys);
+        break;
+      case IK_Edge:
+        _fillKeysFromCellRanks<Edge>(all_items, cell_ranks, family_keys);
+        break;
+      case IK_Node:
+        _fillKeysFromCellRanks<Node>(all_items, cell_ranks, family_keys);
+        break;
+      default:
+        ARCANE_FATAL("Invalid item kind '{0}' for family '{1}'", ik, family->name());
+      }
+    }
+    return;
+  }
+
+  // Courbes de Morton ou de Hilbert sur les centres des entités.
+  // Les coordonnées sont ramenées dans la boîte englobante des noeuds
+  // du sous-domaine avec le même facteur d'échelle dans chaque direction.
+  const VariableNodeReal3& nodes_coord = mesh->nodesCoordinates();
+  const Int32 dim = std::clamp(mesh->dimension(), 1, 3);
+  Real3 bbox_min(FloatInfo<Real>::maxValue(), FloatInfo<Real>::maxValue(), FloatInfo<Real>::maxValue());
+  Real3 bbox_max(-FloatInfo<Real>::maxValue(), -FloatInfo<Real>::maxValue(), -FloatInfo<Real>::maxValue());
+  ENUMERATE_NODE (inode, mesh->allNodes()) {
+    bbox_min = math::min(bbox_min, nodes_coord[inode]);
+    bbox_max = math::max(bbox_max, nodes_coord[inode]);
+  }
+  Real3 extent = bbox_max - bbox_min;
+  Real max_extent = math::max(extent.x, math::max(extent.y, extent.z));
+  const Real max_coord = static_cast<Real>((1U << NB_BIT_PER_DIM) - 1);
+  const Real scale = (max_extent > 0.0) ? (max_coord / max_extent) : 0.0;
+  const bool is_hilbert = (algo == eItemsLocalIdRenumbering::HilbertCurve) && dim > 1;
+
+  auto compute_key = [&](Real3 center) {
+    Real3 p = (center - bbox_min) * scale;
+    UInt32 x[3] = { 0, 0, 0 };
+    const Real v[3] = { p.x, p.y, p.z };
+    for (Int32 d = 0; d < dim; ++d)
+      x[d] = static_cast<UInt32>(std::clamp(v[d], 0.0, max_coord));
+    if (is_hilbert)
+      _axesToHilbertTranspose(x, dim);
+    return _interleaveBits(x, dim);
+  };
+
+  for (Int32 i = 0; i < nb_family; ++i) {
+    IItemFamily* family = families[i];
+    ItemGroup all_items = family->allItems();
+    Array<UInt64>& family_keys = keys[i];
+    eItemKind ik = family->itemKind();
+    if (ik == IK_Node) {
+      ENUMERATE_NODE (inode, all_items)
+        family_keys[inode.itemLocalId()] = compute_key(nodes_coord[inode]);
+      continue;
+    }
+    if (ik != IK_Edge && ik != IK_Face && ik != IK_Cell)
+      ARCANE_FATAL("Invalid item kind '{0}' for family '{1}'", ik, family->name());
+    ENUMERATE_ITEMWITHNODES (iitem, all_items) {
+      Real3 center;
+      Int32 nb_node = 0;
+      for (NodeLocalId node_id : iitem->nodeIds()) {
+        center += nodes_coord[node_id];
+        ++nb_node;
+      }
+      if (nb_node > 0)
+        center /= static_cast<Real>(nb_node);
+      family_keys[iitem.itemLocalId()] = compute_key(center);
+    }
+  }
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+void MeshItemsLocalIdRenumberer::
+renumber(eItemsLocalIdRenumbering algo)
+{
+  if (m_mesh->isAmrActivated())
+    ARCANE_FATAL("Renumbering of local ids is not available for AMR mesh '{0}'", m_mesh->name());
+
+  const Int32 nb_iteration = 10;
+  info() << "Renumbering local ids of mesh '" << m_mesh->name() << "' algo=" << _algoName(algo);
+
+  GatherStatistics stats_before = _computeGatherStatistics();
+  Real time_before = _computeGradientTime(nb_iteration);
+  _printStatistics("before", stats_before, time_before);
+
+  auto sort_keys = std::make_shared<ItemsLocalIdRenumberingSortKeys>(m_mesh, algo);
+  for (IItemFamily* family : sort_keys->families())
+    family->setItemSortFunction(new ItemsLocalIdRenumberingSortFunction(family, algo, sort_keys));
+
+  {
+    Real t0 = platform::getRealTime();
+    m_mesh->modifier()->_modifierInternalApi()->sortAndCompactItems();
+    Real t1 = platform::getRealTime();
+    info() << "Time to renumber local ids = " << (t1 - t0) << "s";
+  }
+
+  GatherStatistics stats_after = _computeGatherStatistics();
+  Real time_after = _computeGradientTime(nb_iteration);
+  _printStatistics("after", stats_after, time_after);
+
+  if (time_after > 0.0)
+    info() << "Node to cell gradient speedup = " << (time_before / time_after);
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*!
+ * \brief Calcule les distances entre numéros locaux lors des accès indirects.
+ *
+ * - pour la connectivité maille/noeud, l'écart entre le plus grand et
+ *   le plus petit numéro local des noeuds de chaque maille,
+ * - pour la connectivité maille/maille (via les faces), l'écart entre les
+ *   numéros locaux des deux mailles de chaque face interne.
+ */
+MeshItemsLocalIdRenumberer::GatherStatistics MeshItemsLocalIdRenumberer::
+_computeGatherStatistics()
+{
+  GatherStatistics stats;
+
+  Int64 total_node_span = 0;
+  Int32 nb_cell = 0;
+  ENUMERATE_CELL (icell, m_mesh->allCells()) {
+    Int32 min_lid = -1;
+    Int32 max_lid = -1;
+    for (NodeLocalId node_id : icell->nodeIds()) {
+      Int32 lid = node_id.localId();
+      if (min_lid == (-1) || lid < min_lid)
+        min_lid = lid;
+      max_lid = math::max(max_lid, lid);
+    }
+    Int32 span = max_lid - min_lid;
+    total_node_span += span;
+    stats.m_max_cell_node_span = math::max(stats.m_max_cell_node_span, span);
+    ++nb_cell;
+  }
+  if (nb_cell > 0)
+    stats.m_mean_cell_node_span = static_cast<Real>(total_node_span) / static_cast<Real>(nb_cell);
+
+  Int64 total_cell_distance = 0;
+  Int32 nb_inner_face = 0;
+  ENUMERATE_FACE (iface, m_mesh->allFaces()) {
+    Face face = *iface;
+    if (face.nbCell() != 2)
+      continue;
+    Int32 distance = math::abs(face.cellId(0).localId() - face.cellId(1).localId());
+    total_cell_distance += distance;
+    stats.m_max_cell_cell_distance = math::max(stats.m_max_cell_cell_distance, distance);
+    ++nb_inner_face;
+  }
+  if (nb_inner_face > 0)
+    stats.m_mean_cell_cell_distance = static_cast<Real>(total_cell_distance) / static_cast<Real>(nb_inner_face);
+
+  return stats;
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*!
+ * \brief Temps (en secondes) de \a nb_iteration calculs d'un gradient aux
+ * mailles par moindres carrés à partir d'une valeur aux noeuds.
+ */
+Real MeshItemsLocalIdRenumberer::
+_computeGradientTime(Int32 nb_iteration)
+{
+  const VariableNodeReal3& nodes_coord = m_mesh->nodesCoordinates();
+  CellGroup all_cells = m_mesh->allCells();
+
+  UniqueArray<Real> node_values(m_mesh->nodeFamily()->maxLocalId());
+  ENUMERATE_NODE (inode, m_mesh->allNodes()) {
+    Real3 c = nodes_coord[inode];
+    node_values[inode.itemLocalId()] = c.x + 2.0 * c.y + 3.0 * c.z;
+  }
+  UniqueArray<Real3> cell_gradients(m_mesh->cellFamily()->maxLocalId());
+
+  Real t0 = platform::getRealTime();
+  for (Int32 iter = 0; iter < nb_iteration; ++iter) {
+    ENUMERATE_CELL (icell, all_cells) {
+      Real3 center;
+      Real cell_value = 0.0;
+      Int32 nb_node = 0;
+      for (NodeLocalId node_id : icell->nodeIds()) {
+        center += nodes_coord[node_id];
+        cell_value += node_values[node_id];
+        ++nb_node;
+      }
+      center /= static_cast<Real>(nb_node);
+      cell_value /= static_cast<Real>(nb_node);
+      Real3 gradient;
+      Real sum_d2 = 0.0;
+      for (NodeLocalId node_id : icell->nodeIds()) {
+        Real3 d = nodes_coord[node_id] - center;
+        gradient += (node_values[node_id] - cell_value) * d;
+        sum_d2 += math::dot(d, d);
+      }
+      if (sum_d2 > 0.0)
+        gradient /= sum_d2;
+      cell_gradients[icell.itemLocalId()] = gradient;
+    }
+  }
+  Real t1 = platform::getRealTime();
+
+  Real checksum = 0.0;
+  ENUMERATE_CELL (icell, all_cells)
+    checksum += cell_gradients[icell.itemLocalId()].normL2();
+  info(4) << "Node to cell gradient checksum=" << checksum;
+
+  return t1 - t0;
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+void MeshItemsLocalIdRenumberer::
+_printStatistics(const String& phase, const GatherStatistics& stats, Real gradient_time)
+{
+  info() << "LocalIdRenumbering (" << phase << ")"
+         << " cell/node mean_span=" << stats.m_mean_cell_node_span
+         << " max_span=" << stats.m_max_cell_node_span
+         << " cell/cell mean_distance=" << stats.m_mean_cell_cell_distance
+         << " max_distance=" << stats.m_max_cell_cell_distance
+         << " gradient_time=" << gradient_time << "s";
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+} // namespace Arcane::mesh
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
@@ -0,0 +1,92 @@
+﻿// -*- tab-width: 2; indent-tabs-mode: nil; coding: utf-8-with-signature -*-
+//-----------------------------------------------------------------------------
+// Copyright 2000-2024 CEA (www.cea.fr) IFPEN (www.ifpenergiesnouvelles.com)
+// See the top-level COPYRIGHT file for details.
+// SPDX-License-Identifier: Apache-2.0
+//-----------------------------------------------------------------------------
+/*---------------------------------------------------------------------------*/
+/* MeshItemsLocalIdRenumberer.h                                (C) 2000-2024 */
+/*                                                                           */
+/* Renumérotation des numéros locaux des entités d'un maillage.              */
+/*---------------------------------------------------------------------------*/
+#ifndef ARCANE_MESH_MESHITEMSLOCALIDRENUMBERER_H
+#define ARCANE_MESH_MESHITEMSLOCALIDRENUMBERER_H
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+#include "arcane/utils/TraceAccessor.h"
+
+#include "arcane/core/IMeshUtilities.h"
+
+#include "arcane/mesh/MeshGlobal.h"
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+namespace Arcane::mesh
+{
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*!
+ * \brief Renumérotation des numéros locaux des entités d'un maillage.
+ *
+ * Les entités des familles de noeuds, arêtes, faces et mailles sont triées
+ * suivant une clé calculée par computeSortKeys() lors d'un compactage trié
+ * du maillage.
+ *
+ * \sa IMeshUtilities::renumberItemsLocalId().
+ */
+class MeshItemsLocalIdRenumberer
+: public TraceAccessor
+{
+  //! Statistiques sur les distances d'accès entre numéros locaux
+  struct GatherStatistics
+  {
+    Real m_mean_cell_node_span = 0.0;
+    Int32 m_max_cell_node_span = 0;
+    Real m_mean_cell_cell_distance = 0.0;
+    Int32 m_max_cell_cell_distance = 0;
+  };
+
+ public:
+
+  explicit MeshItemsLocalIdRenumberer(IMesh* mesh);
+
+ public:
+
+  void renumber(eItemsLocalIdRenumbering algo);
+
+ public:
+
+  /*!
+   * \brief Calcule les clés de tri des entités de \a families pour \a algo.
+   *
+   * En retour, \a keys[i] est indexé par le numéro local des entités
+   * de \a families[i]. Les clés de toutes les familles doivent être calculées
+   * avant le début d'un compactage car celui-ci modifie les connectivités
+   * famille par famille.
+   */
+  static void computeSortKeys(IMesh* mesh, ConstArrayView<IItemFamily*> families,
+                              eItemsLocalIdRenumbering algo, Array<UniqueArray<UInt64>>& keys);
+
+ private:
+
+  IMesh* m_mesh = nullptr;
+
+ private:
+
+  GatherStatistics _computeGatherStatistics();
+  Real _computeGradientTime(Int32 nb_iteration);
+  void _printStatistics(const String& phase, const GatherStatistics& stats, Real gradient_time);
+};
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+} // namespace Arcane::mesh
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+#endif
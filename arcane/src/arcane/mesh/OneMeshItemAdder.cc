@@ -16,6 +16,7 @@
 #include "arcane/mesh/DynamicMesh.h"
 #include "arcane/mesh/DynamicMeshIncrementalBuilder.h"
 #include "arcane/mesh/ItemTools.h"
+#include "arcane/mesh/CellsItemsDeduplicator.h"
 
 #include "arcane/MeshUtils.h"
 #include "arcane/MeshToMeshTransposer.h"
@@ -1056,6 +1057,139 @@ _isReorder(Integer i_face, const ItemTypeInfo::LocalFace& lf, const CellInfo& ce
   return is_reorder;
 }
 
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*!
+ * \brief Ajoute en une seule fois les mailles décrites par \a cells_infos.
+ *
+ * Le résultat est identique à celui d'appels successifs à addOneCell()
+ * avec le sous-domaine \a sub_domain_id et la création des faces autorisée:
+ * les entités sont créées dans le même ordre et ont donc les mêmes
+ * uniqueId() et localId(). Cette méthode n'est valide que si le maillage
+ * ne contient encore aucune entité et si l'AMR n'est pas actif.
+ *
+ * Les noeuds, arêtes et faces uniques sont calculés au préalable (en
+ * multi-thread si possible) par CellsItemsDeduplicator. La création des
+ * entités et le remplissage des connectivités restent séquentiels mais
+ * n'effectuent plus de recherche dans la table des noeuds ni dans les
+ * connectivités des noeuds.
+ *
+ * \retval false si plusieurs mailles ont le même uniqueId(). Dans ce cas
+ * aucune entité n'est créée et il faut utiliser addOneCell().
+ */
+bool OneMeshItemAdder::
+addCellsBulk(Integer nb_cell, Int64ConstArrayView cells_infos,
+             Int32 sub_domain_id, Int32ArrayView cells)
+{
+  const bool is_check = arcaneIsCheck();
+  const bool has_edge = m_mesh_builder->hasEdge();
+
+  CellsItemsDeduplicator deduplicator(traceMng(), m_item_type_mng, m_mesh->dimension(), has_edge);
+  deduplicator.compute(nb_cell, cells_infos);
+  if (deduplicator.hasDuplicatedCell())
+    return false;
+
+  const Int32 rank = m_mesh_info.rank();
+  const bool add_to_cells = !cells.empty();
+  UniqueArray<Node> nodes(deduplicator.nbUniqueNode());
+  UniqueArray<Edge> edges(deduplicator.nbUniqueEdge());
+  UniqueArray<Face> faces(deduplicator.nbUniqueFace());
+
+  for (Integer i_cell = 0; i_cell < nb_cell; ++i_cell) {
+    ItemTypeInfo* cell_type_info = deduplicator.cellTypeInfo(i_cell);
+    const Int32 info_index = deduplicator.cellInfoIndex(i_cell);
+    const Int64 cell_uid = cells_infos[info_index];
+    if (is_check) {
+      if (!cell_type_info->isValidForCell())
+        ARCANE_FATAL("Type '{0}' is not allowed for 'Cell' (cell_uid={1})",
+                     cell_type_info->typeName(), cell_uid);
+      Int32 cell_dimension = cell_type_info->dimension();
+      if (cell_dimension >= 0 && cell_dimension != m_mesh->dimension())
+        ARCANE_FATAL("Incoherent dimension for cell uid={0} cell_dim={1} mesh_dim={2} type={3}",
+                     cell_uid, cell_dimension, m_mesh->dimension(), cell_type_info->typeName());
+    }
+
+    Cell cell = m_cell_family.allocOne(cell_uid, cell_type_info->itemTypeId());
+    cell.mutableItemBase().setOwner(sub_domain_id, rank);
+    ++m_mesh_info.nbCell();
+    if (add_to_cells)
+      cells[i_cell] = cell.localId();
+
+    // Noeuds
+    const Int32 node_offset = deduplicator.cellNodeOffset(i_cell);
+    for (Integer i_node = 0, n = cell_type_info->nbLocalNode(); i_node < n; ++i_node) {
+      const Int32 occurrence = node_offset + i_node;
+      const Int32 node_index = deduplicator.nodeIndex(occurrence);
+      if (deduplicator.nodeFirstOccurrence(node_index) == occurrence) {
+        ItemInternal* node_internal = m_node_family.allocOne(cells_infos[info_index + 1 + i_node]);
+        node_internal->setOwner(sub_domain_id, rank);
+        nodes[node_index] = node_internal;
+        ++m_mesh_info.nbNode();
+      }
+      Node node = nodes[node_index];
+      m_node_family.addCellToNode(node, cell);
+      m_cell_family.replaceNode(cell, i_node, node);
+    }
+
+    // Arêtes
+    const Int32 edge_offset = deduplicator.cellEdgeOffset(i_cell);
+    if (has_edge) {
+      for (Integer i_edge = 0, n = cell_type_info->nbLocalEdge(); i_edge < n; ++i_edge) {
+        const Int32 occurrence = edge_offset + i_edge;
+        const Int32 edge_index = deduplicator.edgeIndex(occurrence);
+        if (deduplicator.edgeFirstOccurrence(edge_index) == occurrence) {
+          Edge edge = m_edge_family.allocOne(m_next_edge_uid++);
+          edge.mutableItemBase().setOwner(sub_domain_id, rank);
+          for (Integer i = 0; i < 2; ++i) {
+            Node node = nodes[deduplicator.edgeNodeIndex(occurrence, i)];
+            m_edge_family.replaceNode(edge, i, node);
+            m_node_family.addEdgeToNode(node, edge);
+          }
+          edges[edge_index] = edge;
+          ++m_mesh_info.nbEdge();
+        }
+        Edge edge = edges[edge_index];
+        m_cell_family.replaceEdge(cell, i_edge, edge);
+        m_edge_family.addCellToEdge(edge, cell);
+      }
+    }
+
+    // Faces
+    const Int32 face_offset = deduplicator.cellFaceOffset(i_cell);
+    for (Integer i_face = 0, n = cell_type_info->nbLocalFace(); i_face < n; ++i_face) {
+      const Int32 occurrence = face_offset + i_face;
+      const Int32 face_index = deduplicator.faceIndex(occurrence);
+      if (deduplicator.faceFirstOccurrence(face_index) == occurrence) {
+        const ItemTypeInfo::LocalFace& lf = cell_type_info->localFace(i_face);
+        Face face = m_face_family.allocOne(m_next_face_uid++, ItemTypeId(lf.typeId()));
+        face.mutableItemBase().setOwner(sub_domain_id, rank);
+        Int32ConstArrayView face_nodes_index = deduplicator.faceNodesIndex(occurrence);
+        for (Integer i_node = 0, nb_node = lf.nbNode(); i_node < nb_node; ++i_node) {
+          Node node = nodes[face_nodes_index[i_node]];
+          m_face_family.replaceNode(face, i_node, node);
+          m_node_family.addFaceToNode(node, face);
+        }
+        if (has_edge) {
+          for (Integer i_edge = 0, nb_edge = lf.nbEdge(); i_edge < nb_edge; ++i_edge) {
+            Edge edge = edges[deduplicator.edgeIndex(edge_offset + lf.edge(i_edge))];
+            m_face_family.addEdgeToFace(face, edge);
+            m_edge_family.addFaceToEdge(edge, face);
+          }
+        }
+        faces[face_index] = face;
+        ++m_mesh_info.nbFace();
+      }
+      Face face = faces[face_index];
+      m_cell_family.replaceFace(cell, i_face, face);
+      if (deduplicator.isFaceReorder(occurrence))
+        m_face_family.addFrontCellToFace(face, cell);
+      else
+        m_face_family.addBackCellToFace(face, cell);
+    }
+  }
+  return true;
+}
+
 /*---------------------------------------------------------------------------*/
 /*---------------------------------------------------------------------------*/
 
@@ -1,11 +1,11 @@
 ﻿// -*- tab-width: 2; indent-tabs-mode: nil; coding: utf-8-with-signature -*-
 //-----------------------------------------------------------------------------
-// Copyright 2000-2022 CEA (www.cea.fr) IFPEN (www.ifpenergiesnouvelles.com)
+// Copyright 2000-2024 CEA (www.cea.fr) IFPEN (www.ifpenergiesnouvelles.com)
 // See the top-level COPYRIGHT file for details.
 // SPDX-License-Identifier: Apache-2.0
 //-----------------------------------------------------------------------------
 /*---------------------------------------------------------------------------*/
-/* OneMeshItemAdder.h                                          (C) 2000-2022 */
+/* OneMeshItemAdder.h                                          (C) 2000-2024 */
 /*                                                                           */
 /* Outil de création d'une maille                                            */
 /*---------------------------------------------------------------------------*/
@@ -83,6 +83,9 @@ public:
  
   ItemInternal* addOneCell(const FullCellInfo& cell_info);
 
+  bool addCellsBulk(Integer nb_cell, Int64ConstArrayView cells_infos,
+                    Int32 sub_domain_id, Int32ArrayView cells);
+
   // NOTE GG: A priori plus utilisé
   ARCANE_DEPRECATED_REASON("Y2022: Use addOneItem2() instead")
   ItemInternal* addOneItem(IItemFamily* family,
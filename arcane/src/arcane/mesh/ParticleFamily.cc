@@ -5,7 +5,7 @@
 // SPDX-License-Identifier: Apache-2.0
 //-----------------------------------------------------------------------------
 /*---------------------------------------------------------------------------*/
-/* ParticleFamily.cc                                           (C) 2000-2022 */
+/* ParticleFamily.cc                                           (C) 2000-2024 */
 /*                                                                           */
 /* Famille de particules.                                                    */
 /*---------------------------------------------------------------------------*/
@@ -379,7 +379,7 @@ readFromDump()
 void ParticleFamily::
 preAllocate(Integer nb_item)
 {
-  Integer nb_hash = itemsMap().buckets().size();
+  Integer nb_hash = itemsMap().nbBucket();
   Integer wanted_size = 2 * (nb_item + infos().nbItem());
   if (nb_hash < wanted_size)
     itemsMap().resize(wanted_size, true);
@@ -94,7 +94,7 @@ namespace mesh
 
     void preAllocate(Integer nb_item)
     {
-      Integer nb_hash = itemsMap().buckets().size();
+      Integer nb_hash = itemsMap().nbBucket();
       Integer wanted_size = 2 * (nb_item + infos().nbItem());
       if (nb_hash < wanted_size)
         itemsMap().resize(wanted_size, true);
@@ -1,11 +1,11 @@
 ﻿// -*- tab-width: 2; indent-tabs-mode: nil; coding: utf-8-with-signature -*-
 //-----------------------------------------------------------------------------
-// Copyright 2000-2023 CEA (www.cea.fr) IFPEN (www.ifpenergiesnouvelles.com)
+// Copyright 2000-2024 CEA (www.cea.fr) IFPEN (www.ifpenergiesnouvelles.com)
 // See the top-level COPYRIGHT file for details.
 // SPDX-License-Identifier: Apache-2.0
 //-----------------------------------------------------------------------------
 /*---------------------------------------------------------------------------*/
-/* UnstructuredMeshUtilities.cc                                (C) 2000-2023 */
+/* UnstructuredMeshUtilities.cc                                (C) 2000-2024 */
 /*                                                                           */
 /* Fonctions utilitaires sur un maillage.                                    */
 /*---------------------------------------------------------------------------*/
@@ -50,6 +50,7 @@
 #include "arcane/mesh/GraphDoFs.h"
 #include "arcane/mesh/BasicItemPairGroupComputeFunctor.h"
 #include "arcane/mesh/MeshNodeMerger.h"
+#include "arcane/mesh/MeshItemsLocalIdRenumberer.h"
 #include "arcane/mesh/ConnectivityNewWithDependenciesTypes.h"
 
 #include <algorithm>
@@ -815,6 +816,16 @@ mergeNodes(Int32ConstArrayView nodes_local_id,
 /*---------------------------------------------------------------------------*/
 /*---------------------------------------------------------------------------*/
 
+void UnstructuredMeshUtilities::
+renumberItemsLocalId(eItemsLocalIdRenumbering algo)
+{
+  mesh::MeshItemsLocalIdRenumberer renumberer(m_mesh);
+  renumberer.renumber(algo);
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
 } // End namespace Arcane
 
 /*---------------------------------------------------------------------------*/
@@ -1,11 +1,11 @@
 ﻿// -*- tab-width: 2; indent-tabs-mode: nil; coding: utf-8-with-signature -*-
 //-----------------------------------------------------------------------------
-// Copyright 2000-2022 CEA (www.cea.fr) IFPEN (www.ifpenergiesnouvelles.com)
+// Copyright 2000-2024 CEA (www.cea.fr) IFPEN (www.ifpenergiesnouvelles.com)
 // See the top-level COPYRIGHT file for details.
 // SPDX-License-Identifier: Apache-2.0
 //-----------------------------------------------------------------------------
 /*---------------------------------------------------------------------------*/
-/* UnstructuredMeshUtilities.h                                 (C) 2000-2016 */
+/* UnstructuredMeshUtilities.h                                 (C) 2000-2024 */
 /*                                                                           */
 /* Fonctions utilitaires sur un maillage.                                    */
 /*---------------------------------------------------------------------------*/
@@ -91,6 +91,8 @@ class UnstructuredMeshUtilities
   void mergeNodes(Int32ConstArrayView nodes_local_id,
                   Int32ConstArrayView nodes_to_merge_local_id) override;
 
+  void renumberItemsLocalId(eItemsLocalIdRenumbering algo) override;
+
  private:
 
   IMesh* m_mesh;
@@ -29,6 +29,8 @@ set( ARCANE_SOURCES
   FullItemInfo.h
   OneMeshItemAdder.cc
   OneMeshItemAdder.h
+  CellsItemsDeduplicator.cc
+  CellsItemsDeduplicator.h
   ExtraGhostCellsBuilder.cc
   ExtraGhostCellsBuilder.h
   ExtraGhostParticlesBuilder.cc
@@ -105,6 +107,8 @@ set( ARCANE_SOURCES
   MeshExchangeMng.h
   MeshNodeMerger.cc
   MeshNodeMerger.h
+  MeshItemsLocalIdRenumberer.cc
+  MeshItemsLocalIdRenumberer.h
   MeshUniqueIdMng.cc
   MeshUniqueIdMng.h
   MeshVariables.cc
@@ -0,0 +1,344 @@
+﻿// -*- tab-width: 2; indent-tabs-mode: nil; coding: utf-8-with-signature -*-
+//-----------------------------------------------------------------------------
+// Copyright 2000-2024 CEA (www.cea.fr) IFPEN (www.ifpenergiesnouvelles.com)
+// See the top-level COPYRIGHT file for details.
+// SPDX-License-Identifier: Apache-2.0
+//-----------------------------------------------------------------------------
+/*---------------------------------------------------------------------------*/
+/* MpiAutoTuneVariableSynchronizeDispatcher.cc                 (C) 2000-2024 */
+/*                                                                           */
+/* Choix automatique de l'implémentation de la synchronisation.              */
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+#include "arcane/utils/FatalErrorException.h"
+#include "arcane/utils/ITraceMng.h"
+#include "arcane/utils/MemoryView.h"
+#include "arcane/utils/PlatformUtils.h"
+
+#include "arcane/core/Properties.h"
+
+#include "arcane/parallel/mpi/MpiParallelMng.h"
+
+#include "arcane/impl/IDataSynchronizeBuffer.h"
+#include "arcane/impl/IDataSynchronizeImplementation.h"
+
+#include <map>
+#include <limits>
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*
+ * Cette implémentation choisit automatiquement parmi une liste
+ * d'implémentations candidates celle qui est la plus rapide.
+ *
+ * Le choix est fait pour chaque instance (donc pour chaque synchronizer)
+ * et pour chaque taille de type de donnée (ce qui détermine la taille des
+ * messages). Pendant les premières synchronisations, on utilise à tour de
+ * rôle chaque candidate et on mesure le temps passé dans beginSynchronize()
+ * et dans endSynchronize(). Le travail effectué par l'appelant entre ces
+ * deux appels n'est donc pas pris en compte. Lorsque chaque candidate a été utilisée \a m_nb_trial fois,
+ * on conserve pour chaque candidate le temps minimum, on prend le maximum
+ * sur l'ensemble des rangs et on choisit l'implémentation la plus rapide.
+ *
+ * Les synchronisations étant collectives, la séquence des appels est la même
+ * sur tous les rangs et le choix est donc identique partout.
+ *
+ * Le choix est conservé dans les propriétés de la famille pour être
+ * réutilisé en reprise. On conserve aussi dans ces propriétés le nombre de
+ * fois où le choix a été calculé, ce qui permet de vérifier qu'en reprise
+ * le choix sauvegardé est bien réutilisé.
+ */
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+namespace Arcane
+{
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*!
+ * \brief Implémentation de la synchronisation qui choisit automatiquement
+ * la plus rapide parmi plusieurs implémentations.
+ */
+class MpiAutoTuneVariableSynchronizeDispatcher
+: public AbstractDataSynchronizeImplementation
+{
+ public:
+
+  class Factory;
+
+  //! Implémentation candidate
+  struct Candidate
+  {
+    String m_name;
+    Ref<IDataSynchronizeImplementation> m_implementation;
+  };
+
+  //! Etat du choix pour une taille de type de donnée
+  struct TuningState
+  {
+    //! Nombre de synchronisations mesurées
+    Int32 m_nb_done = 0;
+    //! Temps minimum pour chaque candidate
+    UniqueArray<Real> m_min_times;
+    //! Indice de l'implémentation choisie (-1 si pas encore choisie)
+    Int32 m_selected = -1;
+  };
+
+ public:
+
+  explicit MpiAutoTuneVariableSynchronizeDispatcher(Factory* f);
+
+ protected:
+
+  void compute() override;
+  void beginSynchronize(IDataSynchronizeBuffer* ds_buf) override;
+  void endSynchronize(IDataSynchronizeBuffer* ds_buf) override;
+
+ private:
+
+  MpiParallelMng* m_mpi_parallel_mng = nullptr;
+  Properties m_properties;
+  String m_property_prefix;
+  Int32 m_nb_trial = 3;
+  UniqueArray<Candidate> m_candidates;
+  std::map<Int32, TuningState> m_tuning_states;
+
+  // Informations sur la synchronisation en cours
+  TuningState* m_current_state = nullptr;
+  Int32 m_current_datatype_size = 0;
+  Int32 m_current_index = -1;
+  //! Temps passé dans beginSynchronize() pour la synchronisation en cours
+  Real m_current_begin_elapsed_time = 0.0;
+
+ private:
+
+  TuningState& _getState(Int32 datatype_size);
+  void _selectBest(TuningState& state, Int32 datatype_size);
+  String _propertyName(Int32 datatype_size) const
+  {
+    return m_property_prefix + "_" + String::fromNumber(datatype_size);
+  }
+};
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+class MpiAutoTuneVariableSynchronizeDispatcher::Factory
+: public IDataSynchronizeImplementationFactory
+{
+ public:
+
+  Factory(MpiParallelMng* mpi_pm, const Properties& properties, const String& property_prefix,
+          Int32 nb_trial)
+  : m_mpi_parallel_mng(mpi_pm)
+  , m_properties(properties)
+  , m_property_prefix(property_prefix)
+  , m_nb_trial(nb_trial)
+  {}
+
+  Ref<IDataSynchronizeImplementation> createInstance() override
+  {
+    auto* x = new MpiAutoTuneVariableSynchronizeDispatcher(this);
+    return makeRef<IDataSynchronizeImplementation>(x);
+  }
+
+  void addCandidate(const String& name, Ref<IDataSynchronizeImplementationFactory> factory)
+  {
+    m_candidate_names.add(name);
+    m_candidate_factories.add(factory);
+  }
+
+ public:
+
+  MpiParallelMng* m_mpi_parallel_mng = nullptr;
+  Properties m_properties;
+  String m_property_prefix;
+  Int32 m_nb_trial = 3;
+  UniqueArray<String> m_candidate_names;
+  UniqueArray<Ref<IDataSynchronizeImplementationFactory>> m_candidate_factories;
+};
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*!
+ * \brief Créé une fabrique pour le choix automatique de l'implémentation.
+ *
+ * \a candidate_names et \a candidate_factories contiennent les
+ * implémentations candidates. Le choix est sauvegardé dans \a properties
+ * avec un nom commençant par \a property_prefix.
+ */
+extern "C++" Ref<IDataSynchronizeImplementationFactory>
+arcaneCreateMpiAutoTuneVariableSynchronizerFactory(MpiParallelMng* mpi_pm,
+                                                   const Properties& properties,
+                                                   const String& property_prefix,
+                                                   Int32 nb_trial,
+                                                   ConstArrayView<String> candidate_names,
+                                                   ConstArrayView<Ref<IDataSynchronizeImplementationFactory>> candidate_factories)
+{
+  if (candidate_names.size() != candidate_factories.size())
+    ARCANE_FATAL("Incoherent number of candidates names={0} factories={1}",
+                 candidate_names.size(), candidate_factories.size());
+  if (candidate_names.empty())
+    ARCANE_FATAL("No candidate implementation for synchronization auto-tuning");
+  auto* x = new MpiAutoTuneVariableSynchronizeDispatcher::Factory(mpi_pm, properties, property_prefix, nb_trial);
+  for (Int32 i = 0, n = candidate_names.size(); i < n; ++i)
+    x->addCandidate(candidate_names[i], candidate_factories[i]);
+  return makeRef<IDataSynchronizeImplementationFactory>(x);
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+MpiAutoTuneVariableSynchronizeDispatcher::
+MpiAutoTuneVariableSynchronizeDispatcher(Factory* f)
+: m_mpi_parallel_mng(f->m_mpi_parallel_mng)
+, m_properties(f->m_properties)
+, m_property_prefix(f->m_property_prefix)
+, m_nb_trial(std::max(f->m_nb_trial, 1))
+{
+  for (Int32 i = 0, n = f->m_candidate_names.size(); i < n; ++i)
+    m_candidates.add(Candidate{ f->m_candidate_names[i], f->m_candidate_factories[i]->createInstance() });
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+void MpiAutoTuneVariableSynchronizeDispatcher::
+compute()
+{
+  if (m_current_state)
+    ARCANE_FATAL("Can not call compute() during a synchronization");
+  for (Candidate& c : m_candidates) {
+    c.m_implementation->setDataSynchronizeInfo(_syncInfo());
+    c.m_implementation->compute();
+  }
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+MpiAutoTuneVariableSynchronizeDispatcher::TuningState&
+MpiAutoTuneVariableSynchronizeDispatcher::
+_getState(Int32 datatype_size)
+{
+  auto iter = m_tuning_states.find(datatype_size);
+  if (iter != m_tuning_states.end())
+    return iter->second;
+
+  TuningState& state = m_tuning_states[datatype_size];
+  const Int32 nb_candidate = m_candidates.size();
+  state.m_min_times.resize(nb_candidate);
+  state.m_min_times.fill(std::numeric_limits<Real>::max());
+
+  // Regarde si un choix a déjà été fait (par exemple lors d'une exécution
+  // précédente en cas de reprise).
+  String saved_name = m_properties.getStringWithDefault(_propertyName(datatype_size), String());
+  if (!saved_name.null()) {
+    for (Int32 i = 0; i < nb_candidate; ++i)
+      if (m_candidates[i].m_name == saved_name)
+        state.m_selected = i;
+  }
+  // S'il n'y a qu'une seule candidate, il n'y a pas de choix à faire.
+  if (nb_candidate == 1)
+    state.m_selected = 0;
+  return state;
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+void MpiAutoTuneVariableSynchronizeDispatcher::
+beginSynchronize(IDataSynchronizeBuffer* ds_buf)
+{
+  if (m_current_state)
+    ARCANE_FATAL("A synchronization is already in progress");
+
+  // La taille du type de donnée est la même sur tous les rangs, même
+  // pour ceux qui n'ont pas de message à envoyer.
+  Int32 datatype_size = ds_buf->datatypeSize();
+  TuningState& state = _getState(datatype_size);
+
+  m_current_state = &state;
+  m_current_datatype_size = datatype_size;
+  if (state.m_selected >= 0)
+    m_current_index = state.m_selected;
+  else
+    m_current_index = state.m_nb_done % m_candidates.size();
+
+  IDataSynchronizeImplementation* impl = m_candidates[m_current_index].m_implementation.get();
+  impl->setDataSynchronizeInfo(_syncInfo());
+  Real begin_time = platform::getRealTime();
+  impl->beginSynchronize(ds_buf);
+  m_current_begin_elapsed_time = platform::getRealTime() - begin_time;
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+void MpiAutoTuneVariableSynchronizeDispatcher::
+endSynchronize(IDataSynchronizeBuffer* ds_buf)
+{
+  TuningState* state = m_current_state;
+  if (!state)
+    ARCANE_FATAL("No synchronization in progress");
+
+  Real begin_time = platform::getRealTime();
+  m_candidates[m_current_index].m_implementation->endSynchronize(ds_buf);
+  Real elapsed_time = m_current_begin_elapsed_time + (platform::getRealTime() - begin_time);
+  m_current_state = nullptr;
+
+  if (state->m_selected >= 0)
+    return;
+
+  Real& min_time = state->m_min_times[m_current_index];
+  min_time = std::min(min_time, elapsed_time);
+  ++state->m_nb_done;
+  if (state->m_nb_done == (m_nb_trial * m_candidates.size()))
+    _selectBest(*state, m_current_datatype_size);
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*!
+ * \brief Choisit l'implémentation la plus rapide.
+ *
+ * Cette méthode est collective. Le temps d'une candidate est le maximum
+ * sur l'ensemble des rangs de son temps minimum.
+ */
+void MpiAutoTuneVariableSynchronizeDispatcher::
+_selectBest(TuningState& state, Int32 datatype_size)
+{
+  MpiParallelMng* pm = m_mpi_parallel_mng;
+  pm->reduce(Parallel::ReduceMax, state.m_min_times.view());
+
+  const Int32 nb_candidate = m_candidates.size();
+  Int32 best = 0;
+  for (Int32 i = 1; i < nb_candidate; ++i)
+    if (state.m_min_times[i] < state.m_min_times[best])
+      best = i;
+  state.m_selected = best;
+
+  const String& best_name = m_candidates[best].m_name;
+  String property_name = _propertyName(datatype_size);
+  m_properties.set(property_name, best_name);
+  String nb_tuning_name = property_name + "_nb_tuning";
+  m_properties.set(nb_tuning_name, m_properties.getInt32WithDefault(nb_tuning_name, 0) + 1);
+
+  ITraceMng* tm = pm->traceMng();
+  tm->info() << "Synchronize auto-tuning name=" << m_property_prefix
+              << " datatype_size=" << datatype_size
+              << " selected=" << best_name;
+  for (Int32 i = 0; i < nb_candidate; ++i)
+    tm->info(4) << "  implementation=" << m_candidates[i].m_name
+                << " time=" << state.m_min_times[i];
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+} // End namespace Arcane
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
@@ -26,6 +26,7 @@
 #include "arcane/core/IIOMng.h"
 #include "arcane/core/Timer.h"
 #include "arcane/core/IItemFamily.h"
+#include "arcane/core/Properties.h"
 #include "arcane/core/SerializeMessage.h"
 #include "arcane/core/parallel/IStat.h"
 
@@ -81,6 +82,15 @@ extern "C++" Ref<IDataSynchronizeImplementationFactory>
 arcaneCreateMpiDirectSendrecvVariableSynchronizerFactory(MpiParallelMng* mpi_pm);
 extern "C++" Ref<IDataSynchronizeImplementationFactory>
 arcaneCreateMpiLegacyVariableSynchronizerFactory(MpiParallelMng* mpi_pm);
+extern "C++" Ref<IDataSynchronizeImplementationFactory>
+arcaneCreateMpiPersistentVariableSynchronizerFactory(MpiParallelMng* mpi_pm);
+extern "C++" Ref<IDataSynchronizeImplementationFactory>
+arcaneCreateMpiAutoTuneVariableSynchronizerFactory(MpiParallelMng* mpi_pm,
+                                                   const Properties& properties,
+                                                   const String& property_prefix,
+                                                   Int32 nb_trial,
+                                                   ConstArrayView<String> candidate_names,
+                                                   ConstArrayView<Ref<IDataSynchronizeImplementationFactory>> candidate_factories);
 
 /*---------------------------------------------------------------------------*/
 /*---------------------------------------------------------------------------*/
@@ -265,6 +275,16 @@ class MpiParallelMngUtilsFactory
     }
     if (platform::getEnvironmentVariable("ARCANE_SYNCHRONIZE_VERSION")=="5")
       m_synchronizer_version = 5;
+    if (platform::getEnvironmentVariable("ARCANE_SYNCHRONIZE_VERSION")=="6")
+      m_synchronizer_version = 6;
+    {
+      String v = platform::getEnvironmentVariable("ARCANE_SYNCHRONIZE_VERSION");
+      if (v=="7" || v=="auto"){
+        m_synchronizer_version = 7;
+        if (auto nb_trial = Convert::Type<Int32>::tryParseFromEnvironment("ARCANE_SYNCHRONIZE_AUTOTUNE_NB_TRIAL",true))
+          m_autotune_nb_trial = std::clamp(nb_trial.value(),1,1000);
+      }
+    }
   }
  public:
 
@@ -315,6 +335,37 @@ class MpiParallelMngUtilsFactory
       throw NotSupportedException(A_FUNCINFO,"Synchronize implementation V5 is not supported with this version of MPI");
 #endif
     }
+    else if (m_synchronizer_version == 6){
+      if (do_print)
+        tm->info() << "Using MpiSynchronizer V6 (persistent requests)";
+      generic_factory = arcaneCreateMpiPersistentVariableSynchronizerFactory(mpi_pm);
+    }
+    else if (m_synchronizer_version == 7){
+      if (do_print)
+        tm->info() << "Using MpiSynchronizer auto-tuning nb_trial=" << m_autotune_nb_trial;
+      // Liste des implémentations parmi lesquelles on choisit la plus rapide.
+      UniqueArray<String> names;
+      UniqueArray<Ref<IDataSynchronizeImplementationFactory>> factories;
+      names.add("V1");
+      factories.add(arcaneCreateMpiLegacyVariableSynchronizerFactory(mpi_pm));
+      names.add("V2");
+      factories.add(arcaneCreateMpiVariableSynchronizerFactory(mpi_pm));
+      names.add("V3");
+      factories.add(arcaneCreateMpiDirectSendrecvVariableSynchronizerFactory(mpi_pm));
+      names.add("V4");
+      factories.add(arcaneCreateMpiBlockVariableSynchronizerFactory(mpi_pm,m_synchronize_block_size,m_synchronize_nb_sequence));
+#if defined(ARCANE_HAS_MPI_NEIGHBOR)
+      topology_info = createRef<VariableSynchronizerMpiCommunicator>(mpi_pm);
+      names.add("V5");
+      factories.add(arcaneCreateMpiNeighborVariableSynchronizerFactory(mpi_pm,topology_info));
+#endif
+      names.add("V6");
+      factories.add(arcaneCreateMpiPersistentVariableSynchronizerFactory(mpi_pm));
+      // Le choix est conservé dans les propriétés de la famille pour la reprise.
+      Properties properties(*group.itemFamily()->properties(),"SynchronizeAutoTune");
+      generic_factory = arcaneCreateMpiAutoTuneVariableSynchronizerFactory(mpi_pm,properties,group.name(),
+                                                                           m_autotune_nb_trial,names,factories);
+    }
     else{
       if (do_print)
         tm->info() << "Using MpiSynchronizer V1";
@@ -330,6 +381,7 @@ class MpiParallelMngUtilsFactory
   Integer m_synchronizer_version = 1;
   Int32 m_synchronize_block_size = 32000;
   Int32 m_synchronize_nb_sequence = 1;
+  Int32 m_autotune_nb_trial = 3;
 };
 
 /*---------------------------------------------------------------------------*/
@@ -0,0 +1,391 @@
+﻿// -*- tab-width: 2; indent-tabs-mode: nil; coding: utf-8-with-signature -*-
+//-----------------------------------------------------------------------------
+// Copyright 2000-2024 CEA (www.cea.fr) IFPEN (www.ifpenergiesnouvelles.com)
+// See the top-level COPYRIGHT file for details.
+// SPDX-License-Identifier: Apache-2.0
+//-----------------------------------------------------------------------------
+/*---------------------------------------------------------------------------*/
+/* MpiPersistentVariableSynchronizeDispatcher.cc               (C) 2000-2024 */
+/*                                                                           */
+/* Synchronisations des variables via des requêtes MPI persistantes.         */
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+#include "arcane/utils/MemoryView.h"
+#include "arcane/utils/FatalErrorException.h"
+#include "arcane/utils/ITraceMng.h"
+
+#include "arcane/parallel/mpi/MpiParallelMng.h"
+#include "arcane/parallel/mpi/MpiAdapter.h"
+#include "arcane/parallel/mpi/MpiTimeInterval.h"
+#include "arcane/parallel/IStat.h"
+
+#include "arcane/impl/IDataSynchronizeBuffer.h"
+#include "arcane/impl/IDataSynchronizeImplementation.h"
+
+#include <memory>
+#include <vector>
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*
+ * Cette implémentation est équivalente à MpiVariableSynchronizeDispatcher
+ * mais utilise des requêtes persistantes (MPI_Send_init/MPI_Recv_init).
+ *
+ * Une requête persistante est associée à une adresse et une taille de buffer.
+ * Les buffers de synchronisation étant conservés entre deux appels, ils ont
+ * en général la même adresse et la même taille pour un type de donnée
+ * donné. On conserve donc un petit cache de jeux de requêtes indexé par
+ * les adresses et tailles des buffers. Si aucun jeu ne correspond, on en crée
+ * un nouveau. Sinon, on se contente d'appeler MPI_Startall().
+ *
+ * Les requêtes sont libérées lors de l'appel à compute(), qui est appelé
+ * lorsque les informations de synchronisation changent (par exemple après
+ * un compactage ou un changement des numéros locaux des entités).
+ */
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+namespace Arcane
+{
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*!
+ * \brief Implémentation MPI de la synchronisation utilisant des requêtes
+ * persistantes.
+ */
+class MpiPersistentVariableSynchronizeDispatcher
+: public AbstractDataSynchronizeImplementation
+{
+ public:
+
+  class Factory;
+
+  /*!
+   * \brief Jeu de requêtes persistantes associé à un ensemble de buffers.
+   */
+  class PersistentRequestSet
+  {
+   public:
+
+    ~PersistentRequestSet() { _freeRequests(); }
+
+   public:
+
+    //! Indique si les buffers de \a ds_buf correspondent à ce jeu de requêtes.
+    bool isCompatible(IDataSynchronizeBuffer* ds_buf) const;
+    void build(IDataSynchronizeBuffer* ds_buf, MPI_Comm comm);
+
+   private:
+
+    void _freeRequests();
+
+   public:
+
+    // Adresses et tailles des buffers utilisés pour créer les requêtes.
+    UniqueArray<const std::byte*> m_receive_addresses;
+    UniqueArray<Int64> m_receive_sizes;
+    UniqueArray<const std::byte*> m_send_addresses;
+    UniqueArray<Int64> m_send_sizes;
+
+    UniqueArray<MPI_Request> m_receive_requests;
+    //! Indice dans le buffer du rang associé à chaque requête de réception
+    UniqueArray<Int32> m_receive_indexes;
+    UniqueArray<MPI_Request> m_send_requests;
+  };
+
+ public:
+
+  explicit MpiPersistentVariableSynchronizeDispatcher(Factory* f);
+
+ protected:
+
+  void compute() override;
+  void beginSynchronize(IDataSynchronizeBuffer* ds_buf) override;
+  void endSynchronize(IDataSynchronizeBuffer* ds_buf) override;
+
+ private:
+
+  MpiParallelMng* m_mpi_parallel_mng;
+  std::vector<std::unique_ptr<PersistentRequestSet>> m_request_sets;
+  //! Jeu de requêtes de la synchronisation en cours
+  PersistentRequestSet* m_current_set = nullptr;
+  UniqueArray<int> m_done_indexes;
+
+ private:
+
+  PersistentRequestSet* _getRequestSet(IDataSynchronizeBuffer* ds_buf);
+
+ private:
+
+  //! Nombre maximum de jeux de requêtes conservés.
+  static constexpr Int32 MAX_NB_REQUEST_SET = 8;
+};
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+class MpiPersistentVariableSynchronizeDispatcher::Factory
+: public IDataSynchronizeImplementationFactory
+{
+ public:
+
+  explicit Factory(MpiParallelMng* mpi_pm)
+  : m_mpi_parallel_mng(mpi_pm)
+  {}
+
+  Ref<IDataSynchronizeImplementation> createInstance() override
+  {
+    auto* x = new MpiPersistentVariableSynchronizeDispatcher(this);
+    return makeRef<IDataSynchronizeImplementation>(x);
+  }
+
+ public:
+
+  MpiParallelMng* m_mpi_parallel_mng = nullptr;
+};
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+extern "C++" Ref<IDataSynchronizeImplementationFactory>
+arcaneCreateMpiPersistentVariableSynchronizerFactory(MpiParallelMng* mpi_pm)
+{
+  auto* x = new MpiPersistentVariableSynchronizeDispatcher::Factory(mpi_pm);
+  return makeRef<IDataSynchronizeImplementationFactory>(x);
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+bool MpiPersistentVariableSynchronizeDispatcher::PersistentRequestSet::
+isCompatible(IDataSynchronizeBuffer* ds_buf) const
+{
+  Int32 nb_message = ds_buf->nbRank();
+  if (m_receive_addresses.size() != nb_message)
+    return false;
+  for (Int32 i = 0; i < nb_message; ++i) {
+    auto rbuf = ds_buf->receiveBuffer(i).bytes();
+    if (rbuf.data() != m_receive_addresses[i] || rbuf.size() != m_receive_sizes[i])
+      return false;
+    auto sbuf = ds_buf->sendBuffer(i).bytes();
+    if (sbuf.data() != m_send_addresses[i] || sbuf.size() != m_send_sizes[i])
+      return false;
+  }
+  return true;
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+void MpiPersistentVariableSynchronizeDispatcher::PersistentRequestSet::
+build(IDataSynchronizeBuffer* ds_buf, MPI_Comm comm)
+{
+  _freeRequests();
+
+  constexpr int serialize_tag = 523;
+  const MPI_Datatype mpi_dt = MP::Mpi::MpiBuiltIn::datatype(Byte());
+
+  Int32 nb_message = ds_buf->nbRank();
+  m_receive_addresses.resize(nb_message);
+  m_receive_sizes.resize(nb_message);
+  m_send_addresses.resize(nb_message);
+  m_send_sizes.resize(nb_message);
+
+  for (Int32 i = 0; i < nb_message; ++i) {
+    Int32 target_rank = ds_buf->targetRank(i);
+    auto rbuf = ds_buf->receiveBuffer(i).bytes();
+    m_receive_addresses[i] = rbuf.data();
+    m_receive_sizes[i] = rbuf.size();
+    // Il n'est pas nécessaire d'envoyer un message vide.
+    if (!rbuf.empty()) {
+      auto small_rbuf = rbuf.smallView();
+      MPI_Request request = MPI_REQUEST_NULL;
+      MPI_Recv_init(small_rbuf.data(), small_rbuf.size(), mpi_dt, target_rank,
+                    serialize_tag, comm, &request);
+      m_receive_requests.add(request);
+      m_receive_indexes.add(i);
+    }
+
+    auto sbuf = ds_buf->sendBuffer(i).bytes();
+    m_send_addresses[i] = sbuf.data();
+    m_send_sizes[i] = sbuf.size();
+    if (!sbuf.empty()) {
+      auto small_sbuf = sbuf.smallView();
+      MPI_Request request = MPI_REQUEST_NULL;
+      MPI_Send_init(small_sbuf.data(), small_sbuf.size(), mpi_dt, target_rank,
+                    serialize_tag, comm, &request);
+      m_send_requests.add(request);
+    }
+  }
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+void MpiPersistentVariableSynchronizeDispatcher::PersistentRequestSet::
+_freeRequests()
+{
+  // Il est possible que cette instance soit détruite après la fin de MPI.
+  // Dans ce cas on ne peut plus libérer les requêtes.
+  int is_finalized = 0;
+  MPI_Finalized(&is_finalized);
+  if (!is_finalized) {
+    for (MPI_Request& r : m_receive_requests)
+      if (r != MPI_REQUEST_NULL)
+        MPI_Request_free(&r);
+    for (MPI_Request& r : m_send_requests)
+      if (r != MPI_REQUEST_NULL)
+        MPI_Request_free(&r);
+  }
+  m_receive_requests.clear();
+  m_receive_indexes.clear();
+  m_send_requests.clear();
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+MpiPersistentVariableSynchronizeDispatcher::
+MpiPersistentVariableSynchronizeDispatcher(Factory* f)
+: m_mpi_parallel_mng(f->m_mpi_parallel_mng)
+{
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+void MpiPersistentVariableSynchronizeDispatcher::
+compute()
+{
+  if (m_current_set)
+    ARCANE_FATAL("Can not call compute() during a synchronization");
+  // Les informations de synchronisation ont changé. Les requêtes existantes
+  // ne sont plus valides.
+  m_request_sets.clear();
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+MpiPersistentVariableSynchronizeDispatcher::PersistentRequestSet*
+MpiPersistentVariableSynchronizeDispatcher::
+_getRequestSet(IDataSynchronizeBuffer* ds_buf)
+{
+  for (auto& x : m_request_sets)
+    if (x->isCompatible(ds_buf))
+      return x.get();
+
+  // Limite le nombre de jeux de requêtes conservés en supprimant le plus ancien.
+  if (static_cast<Int32>(m_request_sets.size()) >= MAX_NB_REQUEST_SET)
+    m_request_sets.erase(m_request_sets.begin());
+
+  MpiParallelMng* pm = m_mpi_parallel_mng;
+  double build_time = 0.0;
+  auto request_set = std::make_unique<PersistentRequestSet>();
+  {
+    MpiTimeInterval tit(&build_time);
+    request_set->build(ds_buf, pm->communicator());
+  }
+  pm->stat()->add("SyncPersistentInit", build_time, 1);
+  pm->traceMng()->debug() << "Build persistent requests for synchronization"
+                          << " nb_receive=" << request_set->m_receive_requests.size()
+                          << " nb_send=" << request_set->m_send_requests.size();
+  m_request_sets.push_back(std::move(request_set));
+  return m_request_sets.back().get();
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+void MpiPersistentVariableSynchronizeDispatcher::
+beginSynchronize(IDataSynchronizeBuffer* ds_buf)
+{
+  if (m_current_set)
+    ARCANE_FATAL("A synchronization is already in progress");
+
+  MpiParallelMng* pm = m_mpi_parallel_mng;
+  double prepare_time = 0.0;
+
+  {
+    MpiTimeInterval tit(&prepare_time);
+    PersistentRequestSet* rs = _getRequestSet(ds_buf);
+    m_current_set = rs;
+
+    // Poste les messages de réception
+    if (!rs->m_receive_requests.empty())
+      MPI_Startall(rs->m_receive_requests.size(), rs->m_receive_requests.data());
+
+    // Recopie les valeurs à envoyer dans les buffers d'envoi.
+    ds_buf->copyAllSend();
+
+    // Poste les messages d'envoi
+    if (!rs->m_send_requests.empty())
+      MPI_Startall(rs->m_send_requests.size(), rs->m_send_requests.data());
+  }
+  pm->stat()->add("SyncPrepare", prepare_time, ds_buf->totalSendSize());
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+void MpiPersistentVariableSynchronizeDispatcher::
+endSynchronize(IDataSynchronizeBuffer* ds_buf)
+{
+  PersistentRequestSet* rs = m_current_set;
+  if (!rs)
+    ARCANE_FATAL("No synchronization in progress");
+
+  MpiParallelMng* pm = m_mpi_parallel_mng;
+
+  double copy_time = 0.0;
+  double wait_time = 0.0;
+
+  // Comme dans MpiVariableSynchronizeDispatcher, recopie les valeurs dès
+  // qu'un message arrive. Une requête persistante terminée redevient
+  // inactive et n'est donc plus retournée par MPI_Waitsome.
+  int nb_request = rs->m_receive_requests.size();
+  m_done_indexes.resize(nb_request);
+  Int32 nb_remaining = nb_request;
+  while (nb_remaining > 0) {
+    int nb_done = 0;
+    {
+      MpiTimeInterval tit(&wait_time);
+      MPI_Waitsome(nb_request, rs->m_receive_requests.data(), &nb_done,
+                   m_done_indexes.data(), MPI_STATUSES_IGNORE);
+    }
+    if (nb_done == MPI_UNDEFINED)
+      break;
+    for (int k = 0; k < nb_done; ++k) {
+      MpiTimeInterval tit(&copy_time);
+      ds_buf->copyReceiveAsync(rs->m_receive_indexes[m_done_indexes[k]]);
+    }
+    nb_remaining -= nb_done;
+  }
+
+  // Attend que les envois se terminent avant de pouvoir réutiliser les buffers.
+  if (!rs->m_send_requests.empty()) {
+    MpiTimeInterval tit(&wait_time);
+    MPI_Waitall(rs->m_send_requests.size(), rs->m_send_requests.data(), MPI_STATUSES_IGNORE);
+  }
+
+  // S'assure que les copies des buffers sont bien terminées
+  ds_buf->barrier();
+
+  m_current_set = nullptr;
+
+  Int64 total_ghost_size = ds_buf->totalReceiveSize();
+  Int64 total_share_size = ds_buf->totalSendSize();
+  Int64 total_size = total_ghost_size + total_share_size;
+  pm->stat()->add("SyncCopy", copy_time, total_ghost_size);
+  pm->stat()->add("SyncWait", wait_time, total_size);
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+} // End namespace Arcane
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
@@ -1,11 +1,11 @@
 ﻿// -*- tab-width: 2; indent-tabs-mode: nil; coding: utf-8-with-signature -*-
 //-----------------------------------------------------------------------------
-// Copyright 2000-2023 CEA (www.cea.fr) IFPEN (www.ifpenergiesnouvelles.com)
+// Copyright 2000-2024 CEA (www.cea.fr) IFPEN (www.ifpenergiesnouvelles.com)
 // See the top-level COPYRIGHT file for details.
 // SPDX-License-Identifier: Apache-2.0
 //-----------------------------------------------------------------------------
 /*---------------------------------------------------------------------------*/
-/* MpiVariableSynchronizeDispatcher.cc                         (C) 2000-2023 */
+/* MpiVariableSynchronizeDispatcher.cc                         (C) 2000-2024 */
 /*                                                                           */
 /* Gestion spécifique MPI des synchronisations des variables.                */
 /*---------------------------------------------------------------------------*/
@@ -76,6 +76,7 @@ class MpiVariableSynchronizeDispatcher
   void compute() override {}
   void beginSynchronize(IDataSynchronizeBuffer* ds_buf) override;
   void endSynchronize(IDataSynchronizeBuffer* ds_buf) override;
+  bool isVariableSizeMessageSupported() const override { return true; }
 
  private:
 
@@ -19,6 +19,8 @@ set( ARCANE_SOURCES
   MpiBlockVariableSynchronizeDispatcher.cc
   MpiDirectSendrecvVariableSynchronizeDispatcher.cc
   MpiLegacyVariableSynchronizeDispatcher.cc
+  MpiPersistentVariableSynchronizeDispatcher.cc
+  MpiAutoTuneVariableSynchronizeDispatcher.cc
   MpiSerializeMessage.h
   MpiSerializeMessageList.h
   MpiTimerMng.cc
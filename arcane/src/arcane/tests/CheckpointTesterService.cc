@@ -1,11 +1,11 @@
 ﻿// -*- tab-width: 2; indent-tabs-mode: nil; coding: utf-8-with-signature -*-
 //-----------------------------------------------------------------------------
-// Copyright 2000-2022 CEA (www.cea.fr) IFPEN (www.ifpenergiesnouvelles.com)
+// Copyright 2000-2024 CEA (www.cea.fr) IFPEN (www.ifpenergiesnouvelles.com)
 // See the top-level COPYRIGHT file for details.
 // SPDX-License-Identifier: Apache-2.0
 //-----------------------------------------------------------------------------
 /*---------------------------------------------------------------------------*/
-/* CheckpointTesterService.cc                                  (C) 2000-2022 */
+/* CheckpointTesterService.cc                                  (C) 2000-2024 */
 /*                                                                           */
 /* Service de test des protections/reprises.                                 */
 /*---------------------------------------------------------------------------*/
@@ -35,6 +35,7 @@
 #include "arcane/IPrimaryMesh.h"
 #include "arcane/IMainFactory.h"
 #include "arcane/IParallelMng.h"
+#include "arcane/core/Properties.h"
 
 /*---------------------------------------------------------------------------*/
 /*---------------------------------------------------------------------------*/
@@ -106,6 +107,7 @@ class CheckpointTesterService
   String _getProperties();
   void _checkConnectivity();
   void _checkConnectivity(IItemFamily* family);
+  void _checkSynchronizeAutoTune(bool do_synchronize);
 };
 
 /*---------------------------------------------------------------------------*/
@@ -278,6 +280,10 @@ onTimeLoopContinueInit()
   ArrayShape ref_shape(dims);
   if (shape.dimensions()!=ref_shape.dimensions())
     ARCANE_FATAL("Invalid shape={0} ref_shape={1}",shape.dimensions(),ref_shape.dimensions());
+
+  // Vérifie que le choix de l'implémentation des synchronisations a été relu.
+  if (options()->checkSynchronizeAutoTune())
+    _checkSynchronizeAutoTune(false);
 }
 
 /*---------------------------------------------------------------------------*/
@@ -328,11 +334,47 @@ onTimeLoopBeginLoop()
     tm->stopComputeLoop(false);
   }
 
+  if (options()->checkSynchronizeAutoTune())
+    _checkSynchronizeAutoTune(true);
+
   if ((current_iteration%CHECKPOINT_PERIOD)==0){
     _writeCheckpoint();
   }
 }
 
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*!
+ * \brief Vérifie le choix automatique de l'implémentation des synchronisations.
+ *
+ * Ce test doit être lancé avec ARCANE_SYNCHRONIZE_VERSION=auto et
+ * ARCANE_SYNCHRONIZE_AUTOTUNE_NB_TRIAL=1. Il y a au plus 6 implémentations
+ * candidates et donc en synchronisant 6 fois les variables aux mailles, le
+ * choix est fait dès la première itération. Ce choix est conservé dans les
+ * propriétés de la famille et doit être réutilisé en reprise sans être
+ * recalculé. Le nombre de calculs du choix doit donc toujours valoir 1.
+ */
+void CheckpointTesterService::
+_checkSynchronizeAutoTune(bool do_synchronize)
+{
+  IItemFamily* cell_family = mesh()->cellFamily();
+  if (do_synchronize){
+    for( Integer i=0; i<6; ++i )
+      m_cells.synchronize();
+  }
+
+  Properties properties(*cell_family->properties(),"SynchronizeAutoTune");
+  String name = cell_family->allItems().name() + "_" + String::fromNumber((Int32)sizeof(Real));
+  String selected = properties.getStringWithDefault(name,String());
+  Int32 nb_tuning = properties.getInt32WithDefault(name+"_nb_tuning",0);
+  info() << "SynchronizeAutoTune name=" << name << " selected=" << selected
+         << " nb_tuning=" << nb_tuning;
+  if (selected.null())
+    ARCANE_FATAL("No synchronize auto-tuning choice for '{0}'",name);
+  if (nb_tuning!=1)
+    ARCANE_FATAL("Bad number of synchronize auto-tuning for '{0}' n={1} expected=1",name,nb_tuning);
+}
+
 /*---------------------------------------------------------------------------*/
 /*---------------------------------------------------------------------------*/
 
@@ -78,8 +78,13 @@
 #include "arcane/core/MeshVisitor.h"
 #include "arcane/core/MeshKind.h"
 #include "arcane/core/MeshEvents.h"
+#include "arcane/core/IItemInternalSortFunction.h"
+#include "arcane/core/ItemInternal.h"
+#include "arcane/core/internal/IMeshModifierInternal.h"
 
 #include <set>
+#include <map>
+#include <algorithm>
 
 #ifdef ARCANE_HAS_POLYHEDRAL_MESH_TOOLS
 #include "neo/Mesh.h"
@@ -213,6 +218,7 @@ class MeshUnitTest
   void _testCoherency();
   void _testFindOneItem();
   void _testEvents();
+  void _testRenumberItemsLocalId();
 };
 
 /*---------------------------------------------------------------------------*/
@@ -317,6 +323,8 @@ executeTest()
   _testCoherency();
   _testFindOneItem();
   _testEvents();
+  if (options()->testRenumberItemsLocalId())
+    _testRenumberItemsLocalId();
 }
 
 /*---------------------------------------------------------------------------*/
@@ -1694,6 +1702,125 @@ _testEvents()
 /*---------------------------------------------------------------------------*/
 /*---------------------------------------------------------------------------*/
 
+/*!
+ * \brief Fonction de tri qui mélange les entités suivant un hachage de
+ * leur uniqueId().
+ */
+class ShuffleItemSortFunction
+: public IItemInternalSortFunction
+{
+ public:
+
+  const String& name() const override { return m_name; }
+
+  void sortItems(ItemInternalMutableArrayView items) override
+  {
+    auto hash = [](Int64 uid) {
+      UInt64 h = static_cast<UInt64>(uid) * 0x9E3779B97F4A7C15ULL;
+      return h ^ (h >> 29);
+    };
+    std::sort(std::begin(items), std::end(items), [=](const ItemInternal* item1, const ItemInternal* item2) {
+      // Il faut mettre les entités détruites en fin de liste
+      bool s1 = item1->isSuppressed();
+      bool s2 = item2->isSuppressed();
+      if (s1 != s2)
+        return s2;
+      return hash(item1->uniqueId()) < hash(item2->uniqueId());
+    });
+  }
+
+ private:
+
+  String m_name = "TestShuffle";
+};
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+void MeshUnitTest::
+_testRenumberItemsLocalId()
+{
+  // Vérifie qu'après renumérotation les coordonnées et la connectivité
+  // exprimées en uniqueId() sont inchangées et que la localité est meilleure
+  // qu'avec une numérotation aléatoire.
+  ValueChecker vc(A_FUNCINFO);
+  IMesh* mesh = this->mesh();
+  IItemFamily* families[4] = { mesh->nodeFamily(), mesh->edgeFamily(),
+                               mesh->faceFamily(), mesh->cellFamily() };
+
+  // Écart moyen entre le plus petit et le plus grand numéro local
+  // des noeuds de chaque maille.
+  auto compute_mean_node_span = [&]() {
+    Int64 total_span = 0;
+    ENUMERATE_CELL (icell, allCells()) {
+      Int32 min_lid = -1;
+      Int32 max_lid = -1;
+      for (NodeLocalId node_id : icell->nodeIds()) {
+        Int32 lid = node_id.localId();
+        if (min_lid == (-1) || lid < min_lid)
+          min_lid = lid;
+        max_lid = math::max(max_lid, lid);
+      }
+      total_span += max_lid - min_lid;
+    }
+    return static_cast<Real>(total_span) / static_cast<Real>(allCells().size());
+  };
+  VariableNodeReal3& nodes_coord(mesh->nodesCoordinates());
+
+  std::map<Int64, Real3> ref_coords;
+  ENUMERATE_NODE (inode, allNodes()) {
+    ref_coords[inode->uniqueId()] = nodes_coord[inode];
+  }
+  std::map<Int64, Int64UniqueArray> ref_cell_nodes;
+  ENUMERATE_CELL (icell, allCells()) {
+    Int64UniqueArray& uids = ref_cell_nodes[icell->uniqueId()];
+    for (Node node : icell->nodes())
+      uids.add(node.uniqueId());
+  }
+  const Int32 nb_face = allFaces().size();
+
+  eItemsLocalIdRenumbering algos[3] = { eItemsLocalIdRenumbering::HilbertCurve,
+                                        eItemsLocalIdRenumbering::MortonCurve,
+                                        eItemsLocalIdRenumbering::ReverseCuthillMcKee };
+  for (eItemsLocalIdRenumbering algo : algos) {
+    for (IItemFamily* family : families)
+      family->setItemSortFunction(new ShuffleItemSortFunction());
+    mesh->modifier()->_modifierInternalApi()->sortAndCompactItems();
+    Real shuffled_span = compute_mean_node_span();
+
+    mesh->utilities()->renumberItemsLocalId(algo);
+    mesh->checkValidMesh();
+
+    Real renumbered_span = compute_mean_node_span();
+    info() << "RenumberItemsLocalId algo=" << static_cast<int>(algo)
+           << " mean_node_span shuffled=" << shuffled_span
+           << " renumbered=" << renumbered_span;
+    if (!(renumbered_span < shuffled_span))
+      ARCANE_FATAL("Renumbering does not improve locality algo={0} shuffled={1} renumbered={2}",
+                   static_cast<int>(algo), shuffled_span, renumbered_span);
+
+    vc.areEqual(allNodes().size(), (Int32)ref_coords.size(), "NbNode");
+    vc.areEqual(allCells().size(), (Int32)ref_cell_nodes.size(), "NbCell");
+    vc.areEqual(allFaces().size(), nb_face, "NbFace");
+    ENUMERATE_NODE (inode, allNodes()) {
+      vc.areEqual(nodes_coord[inode], ref_coords[inode->uniqueId()], "NodeCoord");
+    }
+    ENUMERATE_CELL (icell, allCells()) {
+      Int64UniqueArray uids;
+      for (Node node : icell->nodes())
+        uids.add(node.uniqueId());
+      vc.areEqualArray(uids.view(), ref_cell_nodes[icell->uniqueId()].view(), "CellNodes");
+    }
+  }
+
+  // Revient à la fonction de tri par défaut.
+  for (IItemFamily* family : families)
+    family->setItemSortFunction(nullptr);
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
 } // End namespace ArcaneTest
 
 /*---------------------------------------------------------------------------*/
@@ -49,6 +49,8 @@
 #include "arcane/core/IVariableMng.h"
 #include "arcane/core/IVariableSynchronizerMng.h"
 
+#include "arcane/accelerator/core/IAcceleratorMng.h"
+
 #include "arcane/SerializeBuffer.h"
 
 #include "arcane/tests/StdScalarMeshVariables.h"
@@ -58,6 +60,7 @@
 #include "arcane/tests/ParallelTester_axl.h"
 
 #include "arcane/parallel/BitonicSortT.H"
+#include "arcane/parallel/SampleSortT.H"
 #include "arcane/IParallelExchanger.h"
 #include "arcane/ISerializeMessage.h"
 
@@ -318,6 +321,8 @@ class ParallelTesterModule
   void _testSynchronize();
   void _testPartialSynchronize();
   void _testMultiSynchronize();
+  void _testSplitSynchronize();
+  void _testCompressedSynchronize();
   void _testPartialMultiSynchronize();
   void _testSameValuesOnAllReplica();
   void _testDifferentValuesOnAllReplica();
@@ -330,6 +335,7 @@ class ParallelTesterModule
   void _doInit();
   void _checkEnd();
   void _testBitonicSort();
+  void _testSampleSort();
   void _testPartialVariables();
   void _initParticleFamily(IItemFamily* family);
 };
@@ -576,6 +582,8 @@ testLoop()
     _testSynchronize();
     _testPartialSynchronize();
     _testMultiSynchronize();
+    _testSplitSynchronize();
+    _testCompressedSynchronize();
     _testPartialMultiSynchronize();
     _testSameValuesOnAllReplica();
     _testDifferentValuesOnAllReplica();
@@ -588,6 +596,7 @@ testLoop()
       _testAccumulate();
       _testGhostItemsReduceOperation();
       _testBitonicSort();
+      _testSampleSort();
       _testLoadBalance();
       _testGetVariableValues();
       _testGhostItemsReduceOperation();
@@ -1150,6 +1159,123 @@ _testMultiSynchronize()
 /*---------------------------------------------------------------------------*/
 /*---------------------------------------------------------------------------*/
 
+void ParallelTesterModule::
+_testSplitSynchronize()
+{
+  info() << "Test split synchronize";
+
+  IMesh* mesh = defaultMesh();
+
+  Integer wanted_value = m_global_iteration() + 3;
+  // Positionne les valeurs
+  {
+    m_nodes.setValues(wanted_value,mesh->ownNodes());
+    m_cells.setValues(wanted_value,mesh->ownCells());
+    m_array_cells.setValues(wanted_value,mesh->ownCells());
+  }
+
+  // Sépare les mailles propres qui ne sont pas envoyées aux autres
+  // sous-domaines des autres mailles. Les valeurs des premières peuvent
+  // être modifiées pendant la synchronisation.
+  IVariableSynchronizer* cell_sync = mesh->cellFamily()->allItemsSynchronizer();
+  CellGroup interior_cells = mesh->cellFamily()->findGroup("SplitSyncInteriorCells",true);
+  CellGroup other_cells = mesh->cellFamily()->findGroup("SplitSyncOtherCells",true);
+  {
+    UniqueArray<bool> is_shared(mesh->cellFamily()->maxLocalId(),false);
+    for( Integer i=0, n=cell_sync->communicatingRanks().size(); i<n; ++i )
+      for( Int32 lid : cell_sync->sharedItems(i) )
+        is_shared[lid] = true;
+    Int32UniqueArray interior_lids;
+    Int32UniqueArray other_lids;
+    ENUMERATE_CELL(icell,mesh->allCells()){
+      Cell cell = *icell;
+      if (cell.isOwn() && !is_shared[cell.localId()])
+        interior_lids.add(cell.localId());
+      else
+        other_lids.add(cell.localId());
+    }
+    interior_cells.setItems(interior_lids);
+    other_cells.setItems(other_lids);
+  }
+  Integer interior_value = wanted_value + 1;
+
+  // Utilise la file par défaut si elle existe pour les recopies
+  IAcceleratorMng* acc_mng = subDomain()->acceleratorMng();
+  RunQueue* queue = (acc_mng->isInitialized()) ? acc_mng->defaultQueue() : nullptr;
+  for( Integer i=0; i<m_nb_test_synchronize; ++i ){
+    // Synchronise les variables une par une
+    VariableList node_vars;
+    m_nodes.addToCollection(node_vars);
+    IVariableSynchronizer* node_sync = mesh->nodeFamily()->allItemsSynchronizer();
+    for( VariableCollection::Enumerator ivar(node_vars); ++ivar; ){
+      node_sync->beginSynchronize(*ivar,queue);
+      node_sync->endSynchronize();
+    }
+
+    // Synchronise une liste de variables
+    VariableList cell_vars;
+    m_cells.addToCollection(cell_vars);
+    m_array_cells.addToCollection(cell_vars);
+    cell_sync->beginSynchronize(cell_vars,nullptr);
+    // Modifie pendant la synchronisation les valeurs des mailles non partagées.
+    m_cells.setValues(interior_value,interior_cells);
+    m_array_cells.setValues(interior_value,interior_cells);
+    cell_sync->endSynchronize();
+  }
+
+  // Vérifie les valeurs. Les valeurs modifiées entre le début et la fin de la
+  // synchronisation doivent être conservées.
+  {
+    Integer nb_error = 0;
+    nb_error += m_nodes.checkValues(wanted_value,mesh->allNodes());
+    nb_error += m_cells.checkValues(wanted_value,other_cells);
+    nb_error += m_array_cells.checkValues(wanted_value,other_cells);
+    nb_error += m_cells.checkValues(interior_value,interior_cells);
+    nb_error += m_array_cells.checkValues(interior_value,interior_cells);
+    if (nb_error!=0)
+      ARCANE_FATAL("Error in split synchronize test: n={0}",nb_error);
+  }
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+void ParallelTesterModule::
+_testCompressedSynchronize()
+{
+  info() << "Test compressed synchronize";
+
+  IMesh* mesh = defaultMesh();
+
+  Integer wanted_value = m_global_iteration() + 4;
+  m_cells.setValues(wanted_value,mesh->ownCells());
+  m_array_cells.setValues(wanted_value,mesh->ownCells());
+
+  // Compresse tous les messages dont la taille le permet.
+  VariableList cell_vars;
+  m_cells.addToCollection(cell_vars);
+  m_array_cells.addToCollection(cell_vars);
+  for( VariableCollection::Enumerator ivar(cell_vars); ++ivar; )
+    (*ivar)->addTag("SyncCompressionThreshold","0");
+
+  IVariableSynchronizer* cell_sync = mesh->cellFamily()->allItemsSynchronizer();
+  for( VariableCollection::Enumerator ivar(cell_vars); ++ivar; )
+    cell_sync->synchronize(*ivar);
+  cell_sync->synchronize(cell_vars);
+
+  for( VariableCollection::Enumerator ivar(cell_vars); ++ivar; )
+    (*ivar)->removeTag("SyncCompressionThreshold");
+
+  Integer nb_error = 0;
+  nb_error += m_cells.checkValues(wanted_value,mesh->allCells());
+  nb_error += m_array_cells.checkValues(wanted_value,mesh->allCells());
+  if (nb_error!=0)
+    ARCANE_FATAL("Error in compressed synchronize test: n={0}",nb_error);
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
 void ParallelTesterModule::
 _writeAccumulateInfos(std::ostream& ofile,eItemKind ik,const String& msg)
 {
@@ -1629,6 +1755,72 @@ _testBitonicSort()
   }
 }
 
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*!
+ * \brief Teste le tri par échantillonnage.
+ *
+ * Vérifie que le résultat est le même qu'avec le tri bitonique et que
+ * les rangs et indices d'origine des clés sont corrects.
+ */
+void ParallelTesterModule::
+_testSampleSort()
+{
+  info() << "Test SampleSort";
+  IParallelMng* pm = subDomain()->parallelMng();
+  Int32 nb_rank = pm->commSize();
+
+  // Mélange les uniqueId() des mailles propres pour avoir des clés non triées.
+  Int64UniqueArray cells_key;
+  ENUMERATE_CELL(icell,ownCells()){
+    Int64 uid = icell->uniqueId().asInt64();
+    cells_key.add((uid * 7919) % 100003);
+  }
+
+  Parallel::SampleSort<Int64> sample_sorter(pm);
+  sample_sorter.setNbSamplePerRank(4);
+  sample_sorter.sort(cells_key);
+  Parallel::BitonicSort<Int64> bitonic_sorter(pm);
+  bitonic_sorter.setNeedIndexAndRank(false);
+  bitonic_sorter.sort(cells_key);
+
+  // Compare les listes globales triées.
+  Int64UniqueArray all_sample_keys;
+  pm->allGatherVariable(sample_sorter.keys(),all_sample_keys);
+  Int64UniqueArray all_bitonic_keys;
+  pm->allGatherVariable(bitonic_sorter.keys(),all_bitonic_keys);
+  if (all_sample_keys!=all_bitonic_keys)
+    ARCANE_FATAL("Bad sorted keys: sample_size={0} bitonic_size={1}",
+                 all_sample_keys.size(),all_bitonic_keys.size());
+
+  // Vérifie les rangs et indices d'origine
+  Int64UniqueArray all_keys;
+  pm->allGatherVariable(cells_key,all_keys);
+  Int32UniqueArray all_sizes(nb_rank);
+  Int32 my_size = cells_key.size();
+  pm->allGather(Int32ConstArrayView(1,&my_size),all_sizes);
+  Int32UniqueArray rank_offsets(nb_rank,0);
+  for( Int32 i=1; i<nb_rank; ++i )
+    rank_offsets[i] = rank_offsets[i-1] + all_sizes[i-1];
+
+  Int64ConstArrayView keys = sample_sorter.keys();
+  Int32ConstArrayView key_ranks = sample_sorter.keyRanks();
+  Int32ConstArrayView key_indexes = sample_sorter.keyIndexes();
+  Integer nb_error = 0;
+  for( Integer i=0, n=keys.size(); i<n; ++i ){
+    Int32 rank = key_ranks[i];
+    Int32 index = key_indexes[i];
+    if (rank<0 || rank>=nb_rank || index<0 || index>=all_sizes[rank] ||
+        all_keys[rank_offsets[rank]+index]!=keys[i]){
+      ++nb_error;
+      if (nb_error<10)
+        info() << "Bad key i=" << i << " key=" << keys[i] << " rank=" << rank << " index=" << index;
+    }
+  }
+  if (nb_error!=0)
+    ARCANE_FATAL("Errors in SampleSort nb_error={0}",nb_error);
+}
+
 /*---------------------------------------------------------------------------*/
 /*---------------------------------------------------------------------------*/
 
@@ -113,7 +113,7 @@ initializeTest()
 void AcceleratorFilterUnitTest::
 executeTest()
 {
-  for (Int32 i = 0; i < 7; ++i) {
+  for (Int32 i = 0; i < 8; ++i) {
     executeTest2(400, i);
     executeTest2(1000000, i);
   }
@@ -276,6 +276,24 @@ _executeTestDataType(Int32 size, Int32 test_id)
     t2_bis.resize(nb_out2);
     vc.areEqualArray(t2_bis.to1DSpan(), expected_t2.to1DSpan(), "OutputArray2 (test 6)");
   } break;
+  case 7: // Mode avec lambda de filtrage et entrée et sortie identiques
+  {
+    // Les implémentations cub/rocprim ne supportent pas que l'entrée et
+    // la sortie se recouvrent. Ce test n'est donc valide que sur l'hôte.
+    if (m_queue.isAcceleratorPolicy())
+      break;
+    auto filter_lambda = [] ARCCORE_HOST_DEVICE(const DataType& x) -> bool {
+      return (x > static_cast<DataType>(569));
+    };
+    Arcane::Accelerator::GenericFilterer generic_filterer(m_queue);
+    SmallSpan<DataType> inout_view = t1.to1DSmallSpan();
+    generic_filterer.applyIf<DataType>(inout_view, inout_view, filter_lambda);
+    Int32 nb_out = generic_filterer.nbOutputElement();
+    info() << "NB_OUT_accelerator_inplace=" << nb_out;
+    vc.areEqual(nb_filter, nb_out, "Filter");
+    t1.resize(nb_out);
+    vc.areEqualArray(t1.to1DSpan(), expected_t2.to1DSpan(), "OutputArray (test 7)");
+  } break;
   }
 }
 
@@ -12,6 +12,7 @@
 /*---------------------------------------------------------------------------*/
 
 #include "arcane/utils/ValueChecker.h"
+#include "arcane/utils/MemoryUtils.h"
 
 #include "arcane/core/BasicUnitTest.h"
 #include "arcane/core/ServiceFactory.h"
@@ -19,11 +20,15 @@
 #include "arcane/core/ItemGroup.h"
 #include "arcane/core/ItemGenericInfoListView.h"
 #include "arcane/core/IMesh.h"
+#include "arcane/core/IItemFamily.h"
+#include "arcane/core/IParticleFamily.h"
+#include "arcane/core/UnstructuredMeshConnectivity.h"
 
 #include "arcane/accelerator/core/IAcceleratorMng.h"
 #include "arcane/accelerator/core/RunQueue.h"
 
 #include "arcane/accelerator/RunCommandEnumerate.h"
+#include "arcane/accelerator/ItemUniqueIdToLocalIdMap.h"
 #include "arcane/accelerator/VariableViews.h"
 
 /*---------------------------------------------------------------------------*/
@@ -55,6 +60,8 @@ class AcceleratorItemInfoUnitTest
 
   void _executeTest1();
   void _executeTest2();
+  void _executeTest3();
+  void _executeTest4();
 };
 
 /*---------------------------------------------------------------------------*/
@@ -83,6 +90,8 @@ executeTest()
 {
   _executeTest1();
   _executeTest2();
+  _executeTest3();
+  _executeTest4();
 }
 
 /*---------------------------------------------------------------------------*/
@@ -184,6 +193,144 @@ _executeTest2()
 /*---------------------------------------------------------------------------*/
 /*---------------------------------------------------------------------------*/
 
+void AcceleratorItemInfoUnitTest::
+_executeTest3()
+{
+  ValueChecker vc(A_FUNCINFO);
+  IItemFamily* node_family = mesh()->nodeFamily();
+  auto* queue = subDomain()->acceleratorMng()->defaultQueue();
+  ax::ItemUniqueIdToLocalIdMap uid_map(*queue, node_family);
+
+  // Recherche tous les noeuds ainsi qu'un uniqueId qui n'existe pas.
+  NodeGroup all_nodes = allNodes();
+  const Int32 nb_node = all_nodes.size();
+  UniqueArray<Int64> unique_ids(MemoryUtils::getDefaultDataAllocator());
+  UniqueArray<Int32> local_ids(MemoryUtils::getDefaultDataAllocator());
+  unique_ids.resize(nb_node + 1);
+  local_ids.resize(nb_node + 1);
+  Int64 max_uid = 0;
+  ENUMERATE_ (Node, inode, all_nodes) {
+    Int64 uid = inode->uniqueId();
+    unique_ids[inode.index()] = uid;
+    max_uid = math::max(max_uid, uid);
+  }
+  unique_ids[nb_node] = max_uid + 1;
+
+  Int32 nb_not_found = uid_map.itemsUniqueIdToLocalId(local_ids.smallSpan(), unique_ids.constSmallSpan(), ax::eUniqueIdNotFoundPolicy::SetNullLocalId);
+  vc.areEqual(nb_not_found, 1, "NbNotFound");
+  ENUMERATE_ (Node, inode, all_nodes) {
+    vc.areEqual(local_ids[inode.index()], inode.itemLocalId(), "LocalId");
+  }
+  vc.areEqual(local_ids[nb_node], NULL_ITEM_LOCAL_ID, "NullLocalId");
+
+  bool has_exception = false;
+  try {
+    uid_map.itemsUniqueIdToLocalId(local_ids.smallSpan(), unique_ids.constSmallSpan(), ax::eUniqueIdNotFoundPolicy::Fatal);
+  }
+  catch (const FatalErrorException& ex) {
+    info() << "Expected exception: " << ex.message();
+    has_exception = true;
+  }
+  vc.areEqual(has_exception, true, "HasException");
+
+  // Utilise directement la vue dans un noyau pour retrouver les noeuds des mailles.
+  VariableCellInt32 var_nb_bad_node(VariableBuildInfo(mesh(), "TestNbBadNode"));
+  {
+    auto command = makeCommand(queue);
+    ax::ItemUniqueIdToLocalIdView uid_view = uid_map.view();
+    ItemGenericInfoListView nodes_info(node_family);
+    UnstructuredMeshConnectivityView connectivity_view(mesh());
+    auto cell_node_cv = connectivity_view.cellNode();
+    auto out_nb_bad_node = viewOut(command, var_nb_bad_node);
+    command << RUNCOMMAND_ENUMERATE (Cell, cell, allCells())
+    {
+      Int32 nb_bad = 0;
+      for (NodeLocalId node : cell_node_cv.nodes(cell)) {
+        if (uid_view.localId(nodes_info.uniqueId(node)) != node.localId())
+          ++nb_bad;
+      }
+      out_nb_bad_node[cell] = nb_bad;
+    };
+  }
+  ENUMERATE_ (Cell, icell, allCells()) {
+    vc.areEqual(var_nb_bad_node[icell], 0, "NbBadNode");
+  }
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*!
+ * \brief Teste la mise à jour de la table lors de l'ajout ou de la
+ * suppression de particules.
+ *
+ * Ces modifications ne changent pas IMesh::timestamp().
+ */
+void AcceleratorItemInfoUnitTest::
+_executeTest4()
+{
+  ValueChecker vc(A_FUNCINFO);
+  IItemFamily* family = mesh()->findItemFamily(IK_Particle, "AcceleratorItemInfoParticles", true);
+  IParticleFamily* pf = family->toParticleFamily();
+  auto* queue = subDomain()->acceleratorMng()->defaultQueue();
+  ax::ItemUniqueIdToLocalIdMap uid_map(*queue, family);
+
+  const Int32 nb_particle = 100;
+  const Int32 nb_new_particle = 20;
+  UniqueArray<Int64> unique_ids(MemoryUtils::getDefaultDataAllocator());
+  UniqueArray<Int32> local_ids(MemoryUtils::getDefaultDataAllocator());
+  UniqueArray<Int32> expected_local_ids;
+
+  // Recherche les uniqueId de \a unique_ids et compare avec la famille.
+  auto check_func = [&](Int32 expected_nb_not_found) {
+    const Int32 n = unique_ids.size();
+    local_ids.resize(n);
+    expected_local_ids.resize(n);
+    family->itemsUniqueIdToLocalId(expected_local_ids, unique_ids, false);
+    Int32 nb_not_found = uid_map.itemsUniqueIdToLocalId(local_ids.smallSpan(), unique_ids.constSmallSpan(),
+                                                        ax::eUniqueIdNotFoundPolicy::SetNullLocalId);
+    vc.areEqual(nb_not_found, expected_nb_not_found, "NbNotFound");
+    vc.areEqualArray(local_ids.constView(), expected_local_ids.constView(), "LocalIds");
+  };
+
+  // Ajoute des particules
+  {
+    UniqueArray<Int64> uids(nb_particle);
+    UniqueArray<Int32> lids(nb_particle);
+    for (Int32 i = 0; i < nb_particle; ++i)
+      uids[i] = i + 1;
+    pf->addParticles(uids, lids);
+    family->endUpdate();
+    unique_ids.copy(uids);
+  }
+  check_func(0);
+
+  // Supprime les particules de uniqueId pair et en ajoute de nouvelles.
+  // Les localId des particules supprimées peuvent être réutilisés.
+  {
+    UniqueArray<Int32> removed_lids;
+    ENUMERATE_ITEM (iitem, family->allItems()) {
+      if (((*iitem).uniqueId().asInt64() % 2) == 0)
+        removed_lids.add(iitem.itemLocalId());
+    }
+    pf->removeParticles(removed_lids);
+    family->endUpdate();
+    check_func(nb_particle / 2);
+
+    UniqueArray<Int64> uids(nb_new_particle);
+    UniqueArray<Int32> lids(nb_new_particle);
+    for (Int32 i = 0; i < nb_new_particle; ++i)
+      uids[i] = 1000 + i;
+    pf->addParticles(uids, lids);
+    family->endUpdate();
+    unique_ids.addRange(uids);
+  }
+  check_func(nb_particle / 2);
+  vc.areEqual(family->nbItem(), nb_particle / 2 + nb_new_particle, "NbParticle");
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
 } // namespace ArcaneTest
 
 /*---------------------------------------------------------------------------*/
@@ -0,0 +1,237 @@
+﻿// -*- tab-width: 2; indent-tabs-mode: nil; coding: utf-8-with-signature -*-
+//-----------------------------------------------------------------------------
+// Copyright 2000-2024 CEA (www.cea.fr) IFPEN (www.ifpenergiesnouvelles.com)
+// See the top-level COPYRIGHT file for details.
+// SPDX-License-Identifier: Apache-2.0
+//-----------------------------------------------------------------------------
+/*---------------------------------------------------------------------------*/
+/* AcceleratorSegmentedReduceUnitTest.cc                       (C) 2000-2024 */
+/*                                                                           */
+/* Service de test des réductions par segment et des histogrammes.           */
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+#include "arcane/utils/NumArray.h"
+
+#include "arcane/utils/ValueChecker.h"
+
+#include "arcane/core/BasicUnitTest.h"
+#include "arcane/core/ServiceFactory.h"
+#include "arcane/core/IUnitTest.h"
+
+#include "arcane/accelerator/core/RunQueueBuildInfo.h"
+#include "arcane/accelerator/core/Runner.h"
+#include "arcane/accelerator/core/IAcceleratorMng.h"
+
+#include "arcane/accelerator/SegmentedReduce.h"
+#include "arcane/accelerator/Histogram.h"
+
+#include <random>
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+namespace ArcaneTest
+{
+using namespace Arcane;
+namespace ax = Arcane::Accelerator;
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*!
+ * \brief Service de test des classes 'GenericSegmentedReducer' et 'GenericHistogram'.
+ */
+class AcceleratorSegmentedReduceUnitTest
+: public BasicService
+, public IUnitTest
+{
+ public:
+
+  explicit AcceleratorSegmentedReduceUnitTest(const ServiceBuildInfo& cb);
+
+ public:
+
+  void initializeTest() override;
+  void executeTest() override;
+  void finalizeTest() override {}
+
+ private:
+
+  ax::RunQueue* m_queue = nullptr;
+
+ public:
+
+  template <typename DataType> void _executeTestSegmentedReduce(Int32 nb_segment);
+  void _executeTestHistogram(Int32 size);
+};
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+ARCANE_REGISTER_SERVICE(AcceleratorSegmentedReduceUnitTest,
+                        ServiceProperty("AcceleratorSegmentedReduceUnitTest", ST_CaseOption),
+                        ARCANE_SERVICE_INTERFACE(IUnitTest));
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+AcceleratorSegmentedReduceUnitTest::
+AcceleratorSegmentedReduceUnitTest(const ServiceBuildInfo& sb)
+: BasicService(sb)
+{
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+void AcceleratorSegmentedReduceUnitTest::
+initializeTest()
+{
+  m_queue = subDomain()->acceleratorMng()->defaultQueue();
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+void AcceleratorSegmentedReduceUnitTest::
+executeTest()
+{
+  for (Int32 n : { 1, 57, 100000 }) {
+    _executeTestSegmentedReduce<Int64>(n);
+    _executeTestSegmentedReduce<Int32>(n);
+    _executeTestSegmentedReduce<double>(n);
+  }
+  _executeTestHistogram(400);
+  _executeTestHistogram(1000000);
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+template <typename DataType> void AcceleratorSegmentedReduceUnitTest::
+_executeTestSegmentedReduce(Int32 nb_segment)
+{
+  ValueChecker vc(A_FUNCINFO);
+
+  info() << "Execute SegmentedReduce Test nb_segment=" << nb_segment;
+
+  std::seed_seq rng_seed{ 37, 49, 23 };
+  std::mt19937 randomizer(rng_seed);
+  std::uniform_int_distribution<> rng_distrib(0, 12);
+
+  // Génère des segments de taille aléatoire (éventuellement vides)
+  NumArray<Int32, MDDim1> offsets(nb_segment + 1);
+  offsets[0] = 0;
+  for (Int32 i = 0; i < nb_segment; ++i)
+    offsets[i + 1] = offsets[i] + rng_distrib(randomizer);
+  const Int32 nb_value = offsets[nb_segment];
+
+  NumArray<DataType, MDDim1> values(nb_value);
+  for (Int32 i = 0; i < nb_value; ++i) {
+    DataType v = static_cast<DataType>(2 + rng_distrib(randomizer) + ((i * 7) % 234));
+    if ((i % 3) == 0)
+      v = -v;
+    values[i] = v;
+  }
+
+  NumArray<DataType, MDDim1> expected_sum(nb_segment);
+  NumArray<DataType, MDDim1> expected_min(nb_segment);
+  NumArray<DataType, MDDim1> expected_max(nb_segment);
+  for (Int32 i = 0; i < nb_segment; ++i) {
+    DataType sum_value = 0;
+    DataType min_value = std::numeric_limits<DataType>::max();
+    DataType max_value = std::numeric_limits<DataType>::lowest();
+    for (Int32 j = offsets[i]; j < offsets[i + 1]; ++j) {
+      sum_value += values[j];
+      min_value = math::min(min_value, values[j]);
+      max_value = math::max(max_value, values[j]);
+    }
+    expected_sum[i] = sum_value;
+    expected_min[i] = min_value;
+    expected_max[i] = max_value;
+  }
+
+  SmallSpan<const DataType> values_view(values.to1DSmallSpan());
+  SmallSpan<const Int32> offsets_view(offsets.to1DSmallSpan());
+  NumArray<DataType, MDDim1> result(nb_segment);
+
+  ax::GenericSegmentedReducer reducer(*m_queue);
+
+  reducer.applySum(values_view, offsets_view, result.to1DSmallSpan(), A_FUNCINFO);
+  m_queue->barrier();
+  vc.areEqualArray(result.to1DSpan(), expected_sum.to1DSpan(), "SegmentedSum");
+
+  reducer.applyMin(values_view, offsets_view, result.to1DSmallSpan(), A_FUNCINFO);
+  m_queue->barrier();
+  vc.areEqualArray(result.to1DSpan(), expected_min.to1DSpan(), "SegmentedMin");
+
+  reducer.applyMax(values_view, offsets_view, result.to1DSmallSpan(), A_FUNCINFO);
+  m_queue->barrier();
+  vc.areEqualArray(result.to1DSpan(), expected_max.to1DSpan(), "SegmentedMax");
+
+  {
+    auto getter = [=] ARCCORE_HOST_DEVICE(Int32 index) -> DataType {
+      return values_view[index];
+    };
+    ax::ScannerSumOperator<DataType> op;
+    reducer.applyWithIndex(offsets_view, result.to1DSmallSpan(), op.defaultValue(), getter, op, A_FUNCINFO);
+    m_queue->barrier();
+    vc.areEqualArray(result.to1DSpan(), expected_sum.to1DSpan(), "SegmentedSumWithIndex");
+  }
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+void AcceleratorSegmentedReduceUnitTest::
+_executeTestHistogram(Int32 size)
+{
+  ValueChecker vc(A_FUNCINFO);
+
+  info() << "Execute Histogram Test size=" << size;
+
+  constexpr Int32 nb_bin = 37;
+  std::seed_seq rng_seed{ 13, 49, 23 };
+  std::mt19937 randomizer(rng_seed);
+  std::uniform_int_distribution<> rng_distrib(-10, nb_bin + 10);
+
+  NumArray<Int32, MDDim1> bin_indexes(size);
+  NumArray<Real, MDDim1> real_values(size);
+  NumArray<Int32, MDDim1> expected(nb_bin);
+  expected.fill(0);
+  for (Int32 i = 0; i < size; ++i) {
+    Int32 bin = rng_distrib(randomizer);
+    bin_indexes[i] = bin;
+    // Utilise le milieu de l'intervalle pour éviter les problèmes d'arrondi.
+    real_values[i] = 2.0 * (static_cast<Real>(bin) + 0.5);
+    if (bin >= 0 && bin < nb_bin)
+      ++expected[bin];
+  }
+
+  NumArray<Int32, MDDim1> histogram(nb_bin);
+  ax::GenericHistogram generic_histogram(*m_queue);
+  {
+    SmallSpan<const Int32> in_view(bin_indexes.to1DSmallSpan());
+    auto getter = [=] ARCCORE_HOST_DEVICE(Int32 index) -> Int32 {
+      return in_view[index];
+    };
+    generic_histogram.applyWithBinIndex(size, getter, histogram.to1DSmallSpan(), A_FUNCINFO);
+    m_queue->barrier();
+    vc.areEqualArray(histogram.to1DSpan(), expected.to1DSpan(), "HistogramWithBinIndex");
+  }
+  {
+    histogram.fill(-1);
+    SmallSpan<const Real> in_view(real_values.to1DSmallSpan());
+    generic_histogram.applyEven(in_view, histogram.to1DSmallSpan(), 0.0, 2.0 * nb_bin, A_FUNCINFO);
+    m_queue->barrier();
+    vc.areEqualArray(histogram.to1DSpan(), expected.to1DSpan(), "HistogramEven");
+  }
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+} // End namespace ArcaneTest
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
@@ -0,0 +1,190 @@
+﻿// -*- tab-width: 2; indent-tabs-mode: nil; coding: utf-8-with-signature -*-
+//-----------------------------------------------------------------------------
+// Copyright 2000-2024 CEA (www.cea.fr) IFPEN (www.ifpenergiesnouvelles.com)
+// See the top-level COPYRIGHT file for details.
+// SPDX-License-Identifier: Apache-2.0
+//-----------------------------------------------------------------------------
+/*---------------------------------------------------------------------------*/
+/* AcceleratorSorterUnitTest.cc                                (C) 2000-2024 */
+/*                                                                           */
+/* Service de test des algorithmes de tri sur accélérateur.                  */
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+#include "arcane/utils/NumArray.h"
+
+#include "arcane/utils/ValueChecker.h"
+
+#include "arcane/core/BasicUnitTest.h"
+#include "arcane/core/ServiceFactory.h"
+#include "arcane/core/IUnitTest.h"
+
+#include "arcane/accelerator/core/RunQueueBuildInfo.h"
+#include "arcane/accelerator/core/Runner.h"
+#include "arcane/accelerator/core/IAcceleratorMng.h"
+
+#include "arcane/accelerator/Sort.h"
+
+#include <random>
+#include <algorithm>
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+namespace ArcaneTest
+{
+using namespace Arcane;
+namespace ax = Arcane::Accelerator;
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*!
+ * \brief Service de test de la classe 'GenericSorter'.
+ */
+class AcceleratorSorterUnitTest
+: public BasicService
+, public IUnitTest
+{
+ public:
+
+  explicit AcceleratorSorterUnitTest(const ServiceBuildInfo& cb);
+
+ public:
+
+  void initializeTest() override;
+  void executeTest() override;
+  void finalizeTest() override {}
+
+ private:
+
+  ax::RunQueue* m_queue = nullptr;
+
+ public:
+
+  template <typename KeyType> void _executeTestDataType(Int32 size);
+
+ private:
+
+  void executeTest2(Int32 size);
+};
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+ARCANE_REGISTER_SERVICE(AcceleratorSorterUnitTest,
+                        ServiceProperty("AcceleratorSorterUnitTest", ST_CaseOption),
+                        ARCANE_SERVICE_INTERFACE(IUnitTest));
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+AcceleratorSorterUnitTest::
+AcceleratorSorterUnitTest(const ServiceBuildInfo& sb)
+: BasicService(sb)
+{
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+void AcceleratorSorterUnitTest::
+initializeTest()
+{
+  m_queue = subDomain()->acceleratorMng()->defaultQueue();
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+void AcceleratorSorterUnitTest::
+executeTest()
+{
+  executeTest2(1);
+  executeTest2(400);
+  executeTest2(1000000);
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+void AcceleratorSorterUnitTest::
+executeTest2(Int32 size)
+{
+  _executeTestDataType<Int64>(size);
+  _executeTestDataType<Int32>(size);
+  _executeTestDataType<double>(size);
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+template <typename KeyType> void AcceleratorSorterUnitTest::
+_executeTestDataType(Int32 size)
+{
+  ValueChecker vc(A_FUNCINFO);
+
+  info() << "Execute Sorter Test1 size=" << size;
+
+  constexpr Int32 min_size_display = 100;
+  const Int32 n1 = size;
+
+  NumArray<KeyType, MDDim1> keys(n1);
+  NumArray<Int32, MDDim1> values(n1);
+  NumArray<KeyType, MDDim1> sorted_keys(n1);
+  NumArray<Int32, MDDim1> sorted_values(n1);
+
+  std::seed_seq rng_seed{ 37, 49, 23 };
+  std::mt19937 randomizer(rng_seed);
+  std::uniform_int_distribution<> rng_distrib(0, 32);
+  // Génère des clés avec des doublons et des valeurs négatives pour
+  // vérifier la stabilité et la gestion du signe.
+  UniqueArray<std::pair<KeyType, Int32>> expected(n1);
+  for (Int32 i = 0; i < n1; ++i) {
+    int to_add = 2 + (rng_distrib(randomizer));
+    KeyType v = static_cast<KeyType>(to_add + ((i * 7) % 2348));
+    if ((i % 3) == 0)
+      v = -v;
+    keys[i] = v;
+    values[i] = i;
+    expected[i] = std::make_pair(v, i);
+  }
+  std::stable_sort(expected.begin(), expected.end(),
+                   [](const auto& a, const auto& b) { return a.first < b.first; });
+
+  NumArray<KeyType, MDDim1> expected_keys(n1);
+  NumArray<Int32, MDDim1> expected_values(n1);
+  for (Int32 i = 0; i < n1; ++i) {
+    expected_keys[i] = expected[i].first;
+    expected_values[i] = expected[i].second;
+  }
+  if (n1 < min_size_display) {
+    info() << "Keys=" << keys.to1DSpan();
+    info() << "Expected Keys=" << expected_keys.to1DSpan();
+  }
+
+  ax::GenericSorter sorter(*m_queue);
+
+  {
+    sorter.applyKeys(SmallSpan<const KeyType>(keys.to1DSmallSpan()), sorted_keys.to1DSmallSpan(), A_FUNCINFO);
+    m_queue->barrier();
+    if (n1 < min_size_display)
+      info() << "Out Keys=" << sorted_keys.to1DSpan();
+    vc.areEqualArray(sorted_keys.to1DSpan(), expected_keys.to1DSpan(), "SortKeys");
+  }
+  {
+    sorted_keys.fill(0);
+    sorter.applyPairs(SmallSpan<const KeyType>(keys.to1DSmallSpan()), sorted_keys.to1DSmallSpan(),
+                      SmallSpan<const Int32>(values.to1DSmallSpan()), sorted_values.to1DSmallSpan(), A_FUNCINFO);
+    m_queue->barrier();
+    vc.areEqualArray(sorted_keys.to1DSpan(), expected_keys.to1DSpan(), "SortPairsKeys");
+    vc.areEqualArray(sorted_values.to1DSpan(), expected_values.to1DSpan(), "SortPairsValues");
+  }
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+} // End namespace ArcaneTest
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
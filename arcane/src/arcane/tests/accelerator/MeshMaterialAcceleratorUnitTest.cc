@@ -43,6 +43,7 @@
 #include "arcane/materials/MeshEnvironmentVariableRef.h"
 #include "arcane/materials/EnvItemVector.h"
 #include "arcane/materials/CellToAllEnvCellConverter.h"
+#include "arcane/core/materials/CellMaterialVariableSoAArrayRef.h"
 
 #include "arcane/accelerator/core/Runner.h"
 #include "arcane/accelerator/core/IAcceleratorMng.h"
@@ -124,11 +125,13 @@ class MeshMaterialAcceleratorUnitTest
   // sur accélérateur
 
   void _executeTest1(Integer nb_z, EnvCellVectorView env1);
+  void _executeTestPart(Integer nb_z);
   void _executeTest2(Integer nb_z);
   void _executeTest3(Integer nb_z);
   void _executeTest4(Integer nb_z);
   void _executeTest5(Integer nb_z, MatCellVectorView mat);
   void _executeTest6();
+  void _executeTestSoAArray(MatCellVectorView mat);
   void _checkEnvValues1();
   void _checkMatValues1();
   void _checkEnvironmentValues();
@@ -333,6 +336,7 @@ executeTest()
   {
     _executeTest1(nb_z, m_env1->envView());
     _executeTest1(nb_z, sub_ev1);
+    _executeTestPart(nb_z);
   }
   {
     _executeTest2(nb_z);
@@ -343,6 +347,7 @@ executeTest()
     IMeshEnvironment* env2 = m_mm_mng->environments()[1];
     IMeshMaterial* mat2 = env2->materials()[1];
     _executeTest5(nb_z, mat2->matView());
+    _executeTestSoAArray(mat2->matView());
   }
   {
     _executeTest6();
@@ -429,6 +434,59 @@ _executeTest1(Integer nb_z, EnvCellVectorView env1)
   _checkEnvValues1();
 }
 
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*!
+ * \brief Test du RUNCOMMAND_MAT_ENUMERATE(EnvPartCell, ...
+ * en itérant séparément sur la partie pure et la partie impure du milieu.
+ */
+void MeshMaterialAcceleratorUnitTest::
+_executeTestPart(Integer nb_z)
+{
+  info() << "Execute Test Part";
+  _initializeVariables(m_env1->envView());
+
+  // Ref CPU
+  for (Integer z = 0, iz = nb_z; z < iz; ++z) {
+    ENUMERATE_ENVCELL (i, m_env1) {
+      m_mat_a_ref[i] = m_mat_b_ref[i] + m_mat_c_ref[i] * m_mat_d_ref[i] + m_mat_e_ref[i];
+    }
+  }
+
+  auto queue = makeQueue(m_runner);
+  for (Integer z = 0, iz = nb_z; z < iz; ++z) {
+    auto cmd = makeCommand(queue);
+    auto out_a = ax::viewOut(cmd, m_mat_a);
+    auto in_b = ax::viewIn(cmd, m_mat_b);
+    auto in_c = ax::viewIn(cmd, m_mat_c);
+    auto in_d = ax::viewIn(cmd, m_mat_d);
+    auto in_e = ax::viewIn(cmd, m_mat_e);
+    cmd << RUNCOMMAND_MAT_ENUMERATE(EnvPartCell, evi, m_env1->pureEnvItems())
+    {
+      out_a[evi] = in_b[evi] + in_c[evi] * in_d[evi] + in_e[evi];
+    };
+    cmd << RUNCOMMAND_MAT_ENUMERATE(EnvPartCell, evi, m_env1->impureEnvItems())
+    {
+      out_a[evi] = in_b[evi] + in_c[evi] * in_d[evi] + in_e[evi];
+    };
+  }
+
+  _checkEnvValues1();
+
+  // Vérifie le nombre d'itérations avec une réduction
+  {
+    auto cmd = makeCommand(queue);
+    ax::ReducerSum2<Int32> nb_pure(cmd);
+    cmd << RUNCOMMAND_MAT_ENUMERATE(EnvPartCell, evi, m_env1->pureEnvItems(), nb_pure)
+    {
+      nb_pure.combine(1);
+    };
+    Int32 expected_nb_pure = m_env1->pureEnvItems().nbItem();
+    if (nb_pure.reducedValue() != expected_nb_pure)
+      ARCANE_FATAL("Bad number of pure cells v={0} expected={1}", nb_pure.reducedValue(), expected_nb_pure);
+  }
+}
+
 /*---------------------------------------------------------------------------*/
 /*---------------------------------------------------------------------------*/
 /*!
@@ -484,6 +542,50 @@ _executeTest5(Integer nb_z, MatCellVectorView mat1)
   }
 }
 
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*!
+ * \brief Test des vues sur les variables tableaux rangées par composante.
+ */
+void MeshMaterialAcceleratorUnitTest::
+_executeTestSoAArray(MatCellVectorView mat1)
+{
+  info() << "Execute Test SoAArray";
+  const Int32 nb_component = 3;
+  MaterialVariableCellSoAArrayReal soa_var(MaterialVariableBuildInfo(m_mm_mng, "MatSoAArray"), nb_component);
+
+  auto queue = makeQueue(m_runner);
+  {
+    auto cmd = makeCommand(queue);
+    auto in_b = ax::viewIn(cmd, m_mat_b);
+    auto out_soa = ax::viewOut(cmd, soa_var);
+    cmd << RUNCOMMAND_MAT_ENUMERATE(MatAndGlobalCell, vi, mat1)
+    {
+      auto [mvi, cid] = vi();
+      for (Int32 k = 0, n = out_soa.nbComponent(); k < n; ++k)
+        out_soa(mvi, k) = in_b[mvi] * static_cast<Real>(k + 1);
+    };
+  }
+  {
+    auto cmd = makeCommand(queue);
+    auto in_soa = ax::viewIn(cmd, soa_var);
+    auto out_a = ax::viewOut(cmd, m_mat_a);
+    cmd << RUNCOMMAND_MAT_ENUMERATE(MatAndGlobalCell, vi, mat1)
+    {
+      auto [mvi, cid] = vi();
+      out_a[mvi] = in_soa(mvi, 0) + in_soa(mvi, nb_component - 1);
+    };
+  }
+
+  ValueChecker vc(A_FUNCINFO);
+  ENUMERATE_MATCELL (i, mat1) {
+    Real b = m_mat_b[i];
+    for (Int32 k = 0; k < nb_component; ++k)
+      vc.areEqual(soa_var(i, k), b * static_cast<Real>(k + 1), "SoAValue");
+    vc.areEqual(m_mat_a[i], b * static_cast<Real>(1 + nb_component), "SoASum");
+  }
+}
+
 /*---------------------------------------------------------------------------*/
 /*---------------------------------------------------------------------------*/
 /*!
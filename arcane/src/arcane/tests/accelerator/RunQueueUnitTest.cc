@@ -21,6 +21,7 @@
 #include "arcane/accelerator/core/RunQueueBuildInfo.h"
 #include "arcane/accelerator/core/Runner.h"
 #include "arcane/accelerator/core/RunQueueEvent.h"
+#include "arcane/accelerator/core/RunQueueGraph.h"
 #include "arcane/accelerator/core/IAcceleratorMng.h"
 
 #include "arcane/accelerator/NumArrayViews.h"
@@ -67,6 +68,7 @@ class RunQueueUnitTest
   void _executeTest2();
   void _executeTest3();
   void _executeTest4();
+  void _executeTest5();
 };
 
 /*---------------------------------------------------------------------------*/
@@ -117,6 +119,7 @@ executeTest()
   _executeTest1(true);
   _executeTest3();
   _executeTest4();
+  _executeTest5();
   m_runner->setConcurrentQueueCreation(old_v);
 }
 
@@ -355,6 +358,73 @@ _executeTest4()
 /*---------------------------------------------------------------------------*/
 /*---------------------------------------------------------------------------*/
 
+void RunQueueUnitTest::
+_executeTest5()
+{
+  info() << "Test RunQueue capture";
+  ValueChecker vc(A_FUNCINFO);
+
+  auto queue = makeQueue(m_runner);
+  if (queue.executionPolicy() == ax::eExecutionPolicy::SYCL) {
+    info() << "Capture is not supported with SYCL";
+    return;
+  }
+
+  const Int32 nb_value = 100000;
+  const Int32 nb_launch = 5;
+  NumArray<Int32, MDDim1> array1(nb_value);
+  NumArray<Int32, MDDim1> array2(nb_value);
+  array1.fill(0);
+  array2.fill(0);
+
+  queue.beginCapture();
+  vc.areEqual(queue.isCapturing(), true, "IsCapturing");
+  {
+    auto command = makeCommand(queue);
+    auto v1 = viewInOut(command, array1);
+    command << RUNCOMMAND_LOOP1(iter, nb_value)
+    {
+      auto [i] = iter();
+      v1[i] += i;
+    };
+  }
+  {
+    auto command = makeCommand(queue);
+    auto v1 = viewIn(command, array1);
+    auto v2 = viewOut(command, array2);
+    command << RUNCOMMAND_LOOP1(iter, nb_value)
+    {
+      auto [i] = iter();
+      v2[i] = v1[i] + 1;
+    };
+  }
+  Ref<ax::RunQueueGraph> graph = queue.endCapture();
+  vc.areEqual(queue.isCapturing(), false, "IsCapturing2");
+  info() << "Captured graph nb_command=" << graph->nbCommand();
+
+  // Les commandes ne doivent pas avoir été exécutées pendant la capture.
+  for (Int32 i = 0; i < nb_value; ++i) {
+    vc.areEqual(array1[i], 0, "Array1 after capture");
+    vc.areEqual(array2[i], 0, "Array2 after capture");
+  }
+
+  {
+    ax::RunQueue::ScopedAsync sc(&queue);
+    for (Int32 k = 0; k < nb_launch; ++k)
+      queue.launchGraph(graph);
+    queue.barrier();
+  }
+  vc.areEqual(graph->nbLaunch(), static_cast<Int64>(nb_launch), "NbLaunch");
+
+  for (Int32 i = 0; i < nb_value; ++i) {
+    vc.areEqual(array1[i], i * nb_launch, "Array1");
+    vc.areEqual(array2[i], i * nb_launch + 1, "Array2");
+  }
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
 } // End namespace ArcaneTest
 
 /*---------------------------------------------------------------------------*/
@@ -0,0 +1,511 @@
+﻿// -*- tab-width: 2; indent-tabs-mode: nil; coding: utf-8-with-signature -*-
+//-----------------------------------------------------------------------------
+// Copyright 2000-2024 CEA (www.cea.fr) IFPEN (www.ifpenergiesnouvelles.com)
+// See the top-level COPYRIGHT file for details.
+// SPDX-License-Identifier: Apache-2.0
+//-----------------------------------------------------------------------------
+/*---------------------------------------------------------------------------*/
+/* FlatHashTableMap.h                                          (C) 2000-2024 */
+/*                                                                           */
+/* Tableau associatif à adressage ouvert.                                    */
+/*---------------------------------------------------------------------------*/
+#ifndef ARCANE_UTILS_FLATHASHTABLEMAP_H
+#define ARCANE_UTILS_FLATHASHTABLEMAP_H
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+#include "arcane/utils/Array.h"
+#include "arcane/utils/FatalErrorException.h"
+
+#include <type_traits>
+#include <algorithm>
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+namespace Arcane
+{
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*!
+ * \brief Tableau associatif à adressage ouvert.
+ *
+ * Cette classe a la même interface que HashTableMapT mais utilise un
+ * adressage ouvert de type 'Robin Hood' avec suppression par décalage
+ * arrière (backward shift deletion) au lieu de listes chaînées.
+ *
+ * Les couples (clé,valeur) sont conservés de manière contiguë dans un tableau
+ * (accessible via dataView()) et la table de hachage ne contient pour chaque
+ * case que la distance à la case idéale, une empreinte de la clé et
+ * l'indice du couple dans ce tableau. Cela limite les défauts de cache lors
+ * des recherches et rend le parcours de tous les éléments linéaire en mémoire.
+ *
+ * Contrairement à HashTableMapT, les pointeurs sur les couples (Data*)
+ * retournés par lookup() ou lookupAdd() ne sont valides que jusqu'à la
+ * prochaine modification (ajout ou suppression) de la table. La suppression
+ * d'un élément déplace le dernier élément de dataView() à la place de
+ * l'élément supprimé.
+ *
+ * \a KeyType doit être un type intégral.
+ */
+template <typename KeyType, typename ValueType>
+class FlatHashTableMapT
+{
+  static_assert(std::is_integral_v<KeyType>, "KeyType has to be an integral type");
+
+ public:
+
+  //! Couple (clé,valeur) de la table
+  struct Data
+  {
+   public:
+
+    Data() = default;
+    Data(KeyType key, const ValueType& value)
+    : m_key(key)
+    , m_value(value)
+    {}
+
+   public:
+
+    KeyType key() const { return m_key; }
+    const ValueType& value() const { return m_value; }
+    ValueType& value() { return m_value; }
+    //! Modifie la valeur de l'instance.
+    void setValue(const ValueType& avalue) { m_value = avalue; }
+    /*!
+     * \brief Change la valeur de la clé.
+     *
+     * Après avoir changé la valeur d'une ou plusieurs clés, il faut faire un rehash().
+     */
+    void setKey(KeyType new_key) { m_key = new_key; }
+
+   public:
+
+    KeyType m_key = {}; //!< Clé de recherche
+    ValueType m_value = {}; //!< Valeur de l'élément
+  };
+
+ private:
+
+  //! Case de la table de hachage
+  struct Bucket
+  {
+    //! Distance à la case idéale (+1) sur les 24 bits de poids fort et empreinte de la clé sur les 8 autres. 0 si la case est vide.
+    UInt32 m_dist_and_fingerprint = 0;
+    //! Indice dans m_data du couple associé
+    Int32 m_data_index = 0;
+  };
+
+  static constexpr UInt32 DIST_INC = 1U << 8;
+  static constexpr UInt32 FINGERPRINT_MASK = DIST_INC - 1;
+  static constexpr Int32 MIN_NB_BUCKET = 16;
+  static constexpr Int32 MAX_NB_BUCKET = 1 << 30;
+  //! Taux de remplissage maximal avant agrandissement
+  static constexpr double MAX_LOAD_FACTOR = 0.8;
+  //! Nombre de clés traitées par bloc dans lookupMany()
+  static constexpr Int32 LOOKUP_BLOCK_SIZE = 16;
+
+ public:
+
+  FlatHashTableMapT()
+  {
+    _rehash(MIN_NB_BUCKET);
+  }
+
+  //! Crée une table pouvant contenir \a nb_element éléments sans être agrandie
+  explicit FlatHashTableMapT(Int32 nb_element)
+  {
+    _rehash(_nbBucketForNbElement(nb_element));
+  }
+
+ public:
+
+  //! Nombre d'éléments de la table
+  Int32 count() const { return m_data.size(); }
+
+  //! Nombre de cases de la table de hachage
+  Int32 nbBucket() const { return m_buckets.size(); }
+
+  //! \a true si une valeur avec la clé \a id est présente
+  bool hasKey(KeyType id) const
+  {
+    return _findBucket(id, _hash(id)) >= 0;
+  }
+
+  //! Supprime tous les éléments de la table
+  void clear()
+  {
+    m_data.clear();
+    m_buckets.fill(Bucket{});
+  }
+
+  /*!
+   * \brief Recherche la valeur correspondant à la clé \a id.
+   *
+   * \return la structure associé à la clé \a id (nullptr si aucune)
+   */
+  Data* lookup(KeyType id)
+  {
+    Int32 b = _findBucket(id, _hash(id));
+    return (b < 0) ? nullptr : &m_data[m_buckets[b].m_data_index];
+  }
+
+  /*!
+   * \brief Recherche la valeur correspondant à la clé \a id.
+   *
+   * \return la structure associé à la clé \a id (nullptr si aucune)
+   */
+  const Data* lookup(KeyType id) const
+  {
+    Int32 b = _findBucket(id, _hash(id));
+    return (b < 0) ? nullptr : &m_data[m_buckets[b].m_data_index];
+  }
+
+  /*!
+   * \brief Recherche la valeur correspondant à la clé \a id.
+   *
+   * Une exception est générée si la valeur n'est pas trouvé.
+   */
+  ValueType& lookupValue(KeyType id)
+  {
+    Data* d = lookup(id);
+    if (!d)
+      _throwNotFound(id);
+    return d->m_value;
+  }
+
+  /*!
+   * \brief Recherche la valeur correspondant à la clé \a id.
+   *
+   * Une exception est générée si la valeur n'est pas trouvé.
+   */
+  const ValueType& lookupValue(KeyType id) const
+  {
+    const Data* d = lookup(id);
+    if (!d)
+      _throwNotFound(id);
+    return d->m_value;
+  }
+
+  //! Identique à lookupValue()
+  ValueType& operator[](KeyType id) { return lookupValue(id); }
+
+  //! Identique à lookupValue()
+  const ValueType& operator[](KeyType id) const { return lookupValue(id); }
+
+  /*!
+   * \brief Ajoute la valeur \a value correspondant à la clé \a id
+   *
+   * Si une valeur correspondant à \a id existe déjà, elle est remplacée.
+   *
+   * \retval true si la clé est ajoutée
+   * \retval false si la clé existe déjà et est remplacée
+   */
+  bool add(KeyType id, const ValueType& value)
+  {
+    UInt64 h = _hash(id);
+    Int32 b = _findBucket(id, h);
+    if (b >= 0) {
+      m_data[m_buckets[b].m_data_index].m_value = value;
+      return false;
+    }
+    _addNew(id, value, h);
+    return true;
+  }
+
+  /*!
+   * \brief Supprime la valeur associée à la clé \a id
+   *
+   * Une exception est générée si la valeur n'est pas trouvé.
+   */
+  void remove(KeyType id)
+  {
+    Int32 b = _findBucket(id, _hash(id));
+    if (b < 0)
+      _throwNotFound(id);
+    const Int32 data_index = m_buckets[b].m_data_index;
+
+    // Décale vers l'arrière les éléments suivants qui ne sont pas
+    // dans leur case idéale.
+    Int32 next_b = _nextBucket(b);
+    while (m_buckets[next_b].m_dist_and_fingerprint >= (DIST_INC * 2)) {
+      m_buckets[b].m_dist_and_fingerprint = m_buckets[next_b].m_dist_and_fingerprint - DIST_INC;
+      m_buckets[b].m_data_index = m_buckets[next_b].m_data_index;
+      b = next_b;
+      next_b = _nextBucket(next_b);
+    }
+    m_buckets[b] = Bucket{};
+
+    // Pour que les couples restent contigus, déplace le dernier
+    // à la place de celui supprimé.
+    const Int32 last_index = m_data.size() - 1;
+    if (data_index != last_index) {
+      Int32 last_b = _findBucketOfDataIndex(m_data[last_index].m_key, last_index);
+      m_buckets[last_b].m_data_index = data_index;
+      m_data[data_index] = m_data[last_index];
+    }
+    m_data.resize(last_index);
+  }
+
+  /*!
+   * \brief Recherche ou ajoute la valeur correspondant à la clé \a id.
+   *
+   * Si la clé \a id est déjà dans la table, retourne une référence sur cette
+   * valeur et positionne \a is_add à \c false. Sinon, ajoute la clé \a id
+   * avec pour valeur \a value et positionne \a is_add à \c true.
+   *
+   * La structure retournée n'est jamais nulle mais n'est valide que jusqu'à
+   * la prochaine modification de la table.
+   */
+  Data* lookupAdd(KeyType id, const ValueType& value, bool& is_add)
+  {
+    UInt64 h = _hash(id);
+    Int32 b = _findBucket(id, h);
+    if (b >= 0) {
+      is_add = false;
+      return &m_data[m_buckets[b].m_data_index];
+    }
+    is_add = true;
+    return _addNew(id, value, h);
+  }
+
+  /*!
+   * \brief Recherche ou ajoute la valeur correspondant à la clé \a id.
+   *
+   * Si la clé \a id n'est pas dans la table, elle est ajoutée avec
+   * pour valeur \a ValueType().
+   */
+  Data* lookupAdd(KeyType id)
+  {
+    bool is_add = false;
+    return lookupAdd(id, ValueType(), is_add);
+  }
+
+  /*!
+   * \brief Redimensionne la table de hachage.
+   *
+   * Le nombre de cases est la plus petite puissance de 2 supérieure à
+   * \a new_size et permettant de contenir les éléments actuels.
+   * Le paramètre \a use_prime n'est conservé que pour être compatible avec
+   * HashTableMapT et n'est pas utilisé.
+   */
+  void resize(Int32 new_size, [[maybe_unused]] bool use_prime = false)
+  {
+    if (new_size == 0) {
+      clear();
+      return;
+    }
+    Int32 nb_bucket = std::max(_nbBucketForNbElement(count()), _nextPowerOfTwo(new_size));
+    if (nb_bucket != nbBucket())
+      _rehash(nb_bucket);
+  }
+
+  //! Repositionne les données après changement de valeur des clés
+  void rehash()
+  {
+    _rehash(nbBucket());
+  }
+
+  //! Vue sur les couples (clé,valeur) de la table
+  ArrayView<Data> dataView() { return m_data.view(); }
+
+  //! Vue sur les couples (clé,valeur) de la table
+  ConstArrayView<Data> dataView() const { return m_data.constView(); }
+
+ public:
+
+  //! Applique le fonctor \a lambda à tous les éléments de la collection
+  template <class Lambda> void
+  each(const Lambda& lambda)
+  {
+    for (Data& d : m_data)
+      lambda(&d);
+  }
+
+  /*!
+   * \brief Applique le fonctor \a lambda à tous les éléments de la collection
+   * et utilise x->value() (de type ValueType) comme argument.
+   */
+  template <class Lambda> void
+  eachValue(const Lambda& lambda)
+  {
+    for (Data& d : m_data)
+      lambda(d.m_value);
+  }
+
+  /*!
+   * \brief Recherche les valeurs correspondant aux clés \a ids.
+   *
+   * Pour chaque indice \a i de \a ids, appelle `lambda(i,data)` avec
+   * \a data la structure associée à la clé `ids[i]` (nullptr si aucune).
+   *
+   * Les clés sont traitées par blocs: les cases de la table pour toutes
+   * les clés d'un bloc sont préchargées avant la recherche, ce qui permet
+   * de recouvrir les latences mémoire lorsque la table est grande.
+   */
+  template <class Lambda> void
+  lookupMany(ConstArrayView<KeyType> ids, const Lambda& lambda) const
+  {
+    UInt64 hashes[LOOKUP_BLOCK_SIZE];
+    const Int32 n = ids.size();
+    const Bucket* buckets = m_buckets.data();
+    for (Int32 begin = 0; begin < n; begin += LOOKUP_BLOCK_SIZE) {
+      const Int32 block_size = std::min(LOOKUP_BLOCK_SIZE, n - begin);
+      for (Int32 i = 0; i < block_size; ++i) {
+        UInt64 h = _hash(ids[begin + i]);
+        hashes[i] = h;
+        _prefetch(buckets + _bucketIndex(h));
+      }
+      for (Int32 i = 0; i < block_size; ++i) {
+        Int32 b = _findBucket(ids[begin + i], hashes[i]);
+        lambda(begin + i, (b < 0) ? nullptr : &m_data[buckets[b].m_data_index]);
+      }
+    }
+  }
+
+ private:
+
+  UniqueArray<Data> m_data;
+  UniqueArray<Bucket> m_buckets;
+  //! Décalage pour obtenir l'indice de la case à partir du hash
+  Int32 m_shift = 64;
+  //! Nombre maximum d'éléments avant agrandissement
+  Int32 m_max_count = 0;
+
+ private:
+
+  //! Mélange des bits de la clé (finaliseur de MurmurHash3)
+  static UInt64 _hash(KeyType key)
+  {
+    UInt64 h = static_cast<UInt64>(key);
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ULL;
+    h ^= h >> 33;
+    return h;
+  }
+  static UInt32 _distAndFingerprint(UInt64 h)
+  {
+    return DIST_INC | static_cast<UInt32>(h & FINGERPRINT_MASK);
+  }
+  Int32 _bucketIndex(UInt64 h) const
+  {
+    return static_cast<Int32>(h >> m_shift);
+  }
+  Int32 _nextBucket(Int32 b) const
+  {
+    ++b;
+    return (b == m_buckets.size()) ? 0 : b;
+  }
+  static void _prefetch([[maybe_unused]] const void* ptr)
+  {
+#if defined(__GNUC__)
+    __builtin_prefetch(ptr);
+#endif
+  }
+
+  //! Indice de la case contenant la clé \a id de hash \a h (-1 si aucune)
+  Int32 _findBucket(KeyType id, UInt64 h) const
+  {
+    UInt32 dist_and_fingerprint = _distAndFingerprint(h);
+    Int32 b = _bucketIndex(h);
+    const Bucket* buckets = m_buckets.data();
+    const Data* data = m_data.data();
+    for (;;) {
+      const Bucket& bucket = buckets[b];
+      if (bucket.m_dist_and_fingerprint == dist_and_fingerprint) {
+        if (data[bucket.m_data_index].m_key == id)
+          return b;
+      }
+      else if (dist_and_fingerprint > bucket.m_dist_and_fingerprint)
+        return (-1);
+      dist_and_fingerprint += DIST_INC;
+      b = _nextBucket(b);
+    }
+  }
+
+  //! Indice de la case référençant le couple d'indice \a data_index et de clé \a id
+  Int32 _findBucketOfDataIndex(KeyType id, Int32 data_index) const
+  {
+    Int32 b = _bucketIndex(_hash(id));
+    while (m_buckets[b].m_dist_and_fingerprint == 0 || m_buckets[b].m_data_index != data_index)
+      b = _nextBucket(b);
+    return b;
+  }
+
+  //! Ajoute un couple dont la clé n'est pas présente dans la table
+  Data* _addNew(KeyType id, const ValueType& value, UInt64 h)
+  {
+    if (m_data.size() >= m_max_count)
+      _rehash(static_cast<Int64>(nbBucket()) * 2);
+    const Int32 data_index = m_data.size();
+    m_data.add(Data(id, value));
+    _insertBucket(h, data_index);
+    return &m_data[data_index];
+  }
+
+  //! Insère dans la table de hachage la case pour le couple d'indice \a data_index.
+  void _insertBucket(UInt64 h, Int32 data_index)
+  {
+    Bucket bucket{ _distAndFingerprint(h), data_index };
+    Int32 b = _bucketIndex(h);
+    while (bucket.m_dist_and_fingerprint < m_buckets[b].m_dist_and_fingerprint) {
+      bucket.m_dist_and_fingerprint += DIST_INC;
+      b = _nextBucket(b);
+    }
+    // Décale vers l'avant les éléments jusqu'à la prochaine case vide.
+    while (m_buckets[b].m_dist_and_fingerprint != 0) {
+      std::swap(bucket, m_buckets[b]);
+      bucket.m_dist_and_fingerprint += DIST_INC;
+      b = _nextBucket(b);
+    }
+    m_buckets[b] = bucket;
+  }
+
+  void _rehash(Int64 wanted_nb_bucket)
+  {
+    if (wanted_nb_bucket > MAX_NB_BUCKET)
+      ARCANE_FATAL("Too many buckets for hash table n={0} max={1}", wanted_nb_bucket, MAX_NB_BUCKET);
+    const Int32 nb_bucket = static_cast<Int32>(wanted_nb_bucket);
+    Int32 nb_bit = 0;
+    while ((1 << nb_bit) < nb_bucket)
+      ++nb_bit;
+    m_shift = 64 - nb_bit;
+    m_max_count = static_cast<Int32>(static_cast<double>(nb_bucket) * MAX_LOAD_FACTOR);
+    m_buckets.resize(nb_bucket);
+    m_buckets.fill(Bucket{});
+    for (Int32 i = 0, n = m_data.size(); i < n; ++i)
+      _insertBucket(_hash(m_data[i].m_key), i);
+  }
+
+  static Int32 _nextPowerOfTwo(Int32 n)
+  {
+    Int32 v = MIN_NB_BUCKET;
+    while (v < n && v < MAX_NB_BUCKET)
+      v *= 2;
+    return v;
+  }
+
+  static Int32 _nbBucketForNbElement(Int32 nb_element)
+  {
+    return _nextPowerOfTwo(static_cast<Int32>(static_cast<double>(nb_element) / MAX_LOAD_FACTOR) + 1);
+  }
+
+  [[noreturn]] static void _throwNotFound(KeyType id)
+  {
+    ARCANE_FATAL("Can not find key '{0}' in hash table", id);
+  }
+};
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+} // namespace Arcane
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+#endif
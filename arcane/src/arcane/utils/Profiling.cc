@@ -253,6 +253,8 @@ add(const ForLoopOneExecStat& s)
   ++m_nb_call;
   m_nb_chunk += s.nbChunk();
   m_exec_time += s.execTime();
+  m_nb_element += s.nbElement();
+  m_nb_byte += s.nbByte();
 }
 
 /*---------------------------------------------------------------------------*/
@@ -106,6 +106,12 @@ class ARCANE_UTILS_EXPORT ForLoopOneExecStat
   //! Positionne le temps de fin de la boucle en nanoseconde
   void setEndTime(Int64 v) { m_end_time = v; }
 
+  //! Positionne le nombre d'éléments de la boucle
+  void setNbElement(Int64 v) { m_nb_element = v; }
+
+  //! Positionne le nombre d'octets des données accédées par la boucle
+  void setNbByte(Int64 v) { m_nb_byte = v; }
+
   //! Nombre de chunks
   Int64 nbChunk() const { return m_nb_chunk; }
 
@@ -117,11 +123,25 @@ class ARCANE_UTILS_EXPORT ForLoopOneExecStat
    */
   Int64 execTime() const { return m_end_time - m_begin_time; }
 
+  //! Nombre d'éléments de la boucle
+  Int64 nbElement() const { return m_nb_element; }
+
+  /*!
+   * \brief Nombre d'octets des données accédées par la boucle.
+   *
+   * Il s'agit de la taille des données associées aux vues créées pour
+   * la boucle. Cela permet de calculer une estimation de la bande passante
+   * mémoire obtenue.
+   */
+  Int64 nbByte() const { return m_nb_byte; }
+
   void reset()
   {
     m_nb_chunk = 0;
     m_begin_time = 0;
     m_end_time = 0;
+    m_nb_element = 0;
+    m_nb_byte = 0;
   }
 
  private:
@@ -134,6 +154,12 @@ class ARCANE_UTILS_EXPORT ForLoopOneExecStat
 
   // Temps de fin d'exécution
   Int64 m_end_time = 0;
+
+  // Nombre d'éléments de la boucle
+  Int64 m_nb_element = 0;
+
+  // Nombre d'octets des données accédées
+  Int64 m_nb_byte = 0;
 };
 
 /*---------------------------------------------------------------------------*/
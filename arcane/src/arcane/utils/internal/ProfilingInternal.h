@@ -44,12 +44,31 @@ struct ARCANE_UTILS_EXPORT ForLoopProfilingStat
   Int64 nbCall() const { return m_nb_call; }
   Int64 nbChunk() const { return m_nb_chunk; }
   Int64 execTime() const { return m_exec_time; }
+  Int64 nbElement() const { return m_nb_element; }
+  Int64 nbByte() const { return m_nb_byte; }
+
+  //! Temps moyen d'exécution d'un appel (en nanoseconde)
+  Int64 meanTime() const { return (m_nb_call == 0) ? 0 : (m_exec_time / m_nb_call); }
+
+  /*!
+   * \brief Bande passante mémoire obtenue (en Go/s).
+   *
+   * Cette valeur est calculée à partir du nombre d'octets des vues
+   * utilisées par la boucle et n'est donc qu'une estimation.
+   */
+  double bandwidth() const
+  {
+    // Les temps sont en nanoseconde, ce qui donne directement des Go/s.
+    return (m_exec_time == 0) ? 0.0 : (static_cast<double>(m_nb_byte) / static_cast<double>(m_exec_time));
+  }
 
  private:
 
   Int64 m_nb_call = 0;
   Int64 m_nb_chunk = 0;
   Int64 m_exec_time = 0;
+  Int64 m_nb_element = 0;
+  Int64 m_nb_byte = 0;
 };
 
 /*---------------------------------------------------------------------------*/
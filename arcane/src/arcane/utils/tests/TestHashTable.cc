@@ -1,6 +1,6 @@
 ﻿// -*- tab-width: 2; indent-tabs-mode: nil; coding: utf-8-with-signature -*-
 //-----------------------------------------------------------------------------
-// Copyright 2000-2023 CEA (www.cea.fr) IFPEN (www.ifpenergiesnouvelles.com)
+// Copyright 2000-2024 CEA (www.cea.fr) IFPEN (www.ifpenergiesnouvelles.com)
 // See the top-level COPYRIGHT file for details.
 // SPDX-License-Identifier: Apache-2.0
 //-----------------------------------------------------------------------------
@@ -8,8 +8,11 @@
 #include <gtest/gtest.h>
 
 #include "arcane/utils/HashTableMap.h"
+#include "arcane/utils/FlatHashTableMap.h"
 #include "arcane/utils/String.h"
 
+#include <map>
+
 /*---------------------------------------------------------------------------*/
 /*---------------------------------------------------------------------------*/
 
@@ -91,3 +94,96 @@ TEST(TestHashTable, Misc)
 
 /*---------------------------------------------------------------------------*/
 /*---------------------------------------------------------------------------*/
+
+TEST(TestHashTable, FlatMisc)
+{
+  {
+    FlatHashTableMapT<Int64, Int32> hash1;
+
+    ASSERT_EQ(hash1.count(), 0);
+    ASSERT_TRUE(hash1.add(25, 1));
+    ASSERT_EQ(hash1.count(), 1);
+
+    ASSERT_TRUE(hash1.add(32, 2));
+    ASSERT_EQ(hash1.count(), 2);
+
+    ASSERT_FALSE(hash1.add(32, 3));
+    ASSERT_EQ(hash1.count(), 2);
+
+    ASSERT_TRUE(hash1.hasKey(32));
+    ASSERT_FALSE(hash1.hasKey(47));
+    ASSERT_EQ(hash1.lookup(47), nullptr);
+
+    ASSERT_EQ(hash1[32], 3);
+    ASSERT_EQ(hash1[25], 1);
+
+    hash1.remove(32);
+    ASSERT_FALSE(hash1.hasKey(32));
+    ASSERT_EQ(hash1.count(), 1);
+    ASSERT_EQ(hash1[25], 1);
+
+    bool is_add = false;
+    FlatHashTableMapT<Int64, Int32>::Data* d = hash1.lookupAdd(32, 4, is_add);
+    ASSERT_TRUE(is_add);
+    ASSERT_EQ(d->value(), 4);
+    d = hash1.lookupAdd(32, 5, is_add);
+    ASSERT_FALSE(is_add);
+    ASSERT_EQ(d->value(), 4);
+    ASSERT_EQ(hash1.count(), 2);
+
+    hash1.clear();
+    ASSERT_EQ(hash1.count(), 0);
+    ASSERT_FALSE(hash1.hasKey(25));
+  }
+  {
+    // Compare avec std::map après une suite d'ajouts et de suppressions
+    // qui provoquent des agrandissements et des décalages.
+    FlatHashTableMapT<Int64, Int32> hash2;
+    std::map<Int64, Int32> ref_map;
+    const Int32 n = 20000;
+    for (Int32 i = 0; i < n; ++i) {
+      Int64 key = (static_cast<Int64>(i) * 7919) % 30011;
+      hash2.add(key, i);
+      ref_map[key] = i;
+      if ((i % 3) == 0) {
+        Int64 key_to_remove = (static_cast<Int64>(i / 2) * 7919) % 30011;
+        if (ref_map.erase(key_to_remove) == 1)
+          hash2.remove(key_to_remove);
+      }
+    }
+    ASSERT_EQ(hash2.count(), static_cast<Int32>(ref_map.size()));
+    for (const auto& [key, value] : ref_map)
+      ASSERT_EQ(hash2[key], value);
+    for (const auto& d : hash2.dataView())
+      ASSERT_EQ(ref_map[d.key()], d.value());
+
+    hash2.resize(100000, true);
+    ASSERT_EQ(hash2.count(), static_cast<Int32>(ref_map.size()));
+    for (const auto& [key, value] : ref_map)
+      ASSERT_EQ(hash2[key], value);
+
+    // Change toutes les clés puis reconstruit la table.
+    for (auto& d : hash2.dataView())
+      d.setKey(d.key() + 100000);
+    hash2.rehash();
+    for (const auto& [key, value] : ref_map)
+      ASSERT_EQ(hash2[key + 100000], value);
+
+    UniqueArray<Int64> keys;
+    for (Int64 k = 0; k < 200; ++k)
+      keys.add(k + 100000);
+    Int32 nb_found = 0;
+    hash2.lookupMany(keys, [&](Int32 index, const FlatHashTableMapT<Int64, Int32>::Data* data) {
+      auto iter = ref_map.find(keys[index] - 100000);
+      ASSERT_EQ(data != nullptr, iter != ref_map.end());
+      if (data) {
+        ASSERT_EQ(data->value(), iter->second);
+        ++nb_found;
+      }
+    });
+    ASSERT_TRUE(nb_found > 0);
+  }
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/